@@ -0,0 +1,247 @@
+/**
+ * src/bench/benchlayout.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "benchlayout.h"
+
+#include "../circuits/circuitislands.h"
+
+#include "../circuits/nodes/circuitcable.h"
+#include "../circuits/nodes/powersourcenode.h"
+#include "../circuits/nodes/onoffswitchnode.h"
+#include "../circuits/nodes/simplecircuitnode.h"
+#include "../circuits/nodes/lightbulbnode.h"
+
+BenchLayout::BenchLayout(ModeManager *mgr, Type type, int size)
+    : mModeMgr(mgr)
+    , mType(type)
+    , mSize(qMax(1, size))
+{
+    switch (mType)
+    {
+    case Type::RelayRack:
+        buildRelayRack();
+        break;
+    case Type::ContactChain:
+        buildContactChain();
+        break;
+    case Type::BifilarMesh:
+        buildBifilarMesh();
+        break;
+    case Type::ManySources:
+        buildManySources();
+        break;
+    default:
+        Q_UNREACHABLE();
+        break;
+    }
+
+    // Contacts start closed, layout starts unpowered
+    for(OnOffSwitchNode *contact : std::as_const(mContacts))
+        contact->setOn(true);
+
+    mTestContact = mContacts.at(mContacts.size() / 2);
+}
+
+BenchLayout::~BenchLayout()
+{
+    // Remove all circuits before deleting nodes
+    setPowered(false);
+
+    qDeleteAll(mCables);
+    mCables.clear();
+
+    qDeleteAll(mNodes);
+    mNodes.clear();
+}
+
+QString BenchLayout::typeName(Type type)
+{
+    switch (type)
+    {
+    case Type::RelayRack:
+        return QLatin1String("relay_rack");
+    case Type::ContactChain:
+        return QLatin1String("contact_chain");
+    case Type::BifilarMesh:
+        return QLatin1String("bifilar_mesh");
+    case Type::ManySources:
+        return QLatin1String("many_sources");
+    default:
+        break;
+    }
+
+    return QString();
+}
+
+void BenchLayout::setPowered(bool on)
+{
+    CircuitIslands::NodeList sources;
+    sources.reserve(mSources.size());
+    for(PowerSourceNode *source : std::as_const(mSources))
+        sources.append(source);
+
+    CircuitIslands::setSourcesEnabled(sources, on);
+}
+
+void BenchLayout::setContactClosed(bool closed)
+{
+    mTestContact->setOn(closed);
+}
+
+template<typename Node>
+Node *BenchLayout::addNode()
+{
+    Node *node = new Node(mModeMgr);
+    mNodes.append(node);
+    return node;
+}
+
+void BenchLayout::connectNodes(AbstractCircuitNode *node1, int contact1,
+                               AbstractCircuitNode *node2, int contact2)
+{
+    // Always bifilar, like cables created by CircuitScene
+    CircuitCable *cable = new CircuitCable(mModeMgr);
+    mCables.append(cable);
+
+    CableItem cableItem;
+    cableItem.cable.cable = cable;
+    cableItem.cable.side = CableSide::A;
+    cableItem.nodeContact = contact1;
+    cableItem.cable.pole = CircuitPole::First;
+    node1->attachCable(cableItem);
+
+    cableItem.cable.pole = CircuitPole::Second;
+    node1->attachCable(cableItem);
+
+    cableItem.cable.side = CableSide::B;
+    cableItem.nodeContact = contact2;
+    cableItem.cable.pole = CircuitPole::First;
+    node2->attachCable(cableItem);
+
+    cableItem.cable.pole = CircuitPole::Second;
+    node2->attachCable(cableItem);
+}
+
+void BenchLayout::buildRelayRack()
+{
+    PowerSourceNode *source = addNode<PowerSourceNode>();
+    mSources.append(source);
+
+    AbstractCircuitNode *prev = source;
+    int prevContact = 0;
+
+    for(int i = 0; i < mSize; i++)
+    {
+        // Busbar node: 0 = from previous, 2 = to next, 3 = branch
+        SimpleCircuitNode *bus = addNode<SimpleCircuitNode>();
+        connectNodes(prev, prevContact, bus, 0);
+
+        OnOffSwitchNode *contact = addNode<OnOffSwitchNode>();
+        mContacts.append(contact);
+        connectNodes(bus, 3, contact, 0);
+
+        LightBulbNode *load = addNode<LightBulbNode>();
+        connectNodes(contact, 1, load, 0);
+
+        prev = bus;
+        prevContact = 2;
+    }
+}
+
+void BenchLayout::buildContactChain()
+{
+    PowerSourceNode *source = addNode<PowerSourceNode>();
+    mSources.append(source);
+
+    AbstractCircuitNode *prev = source;
+    int prevContact = 0;
+
+    for(int i = 0; i < mSize; i++)
+    {
+        OnOffSwitchNode *contact = addNode<OnOffSwitchNode>();
+        mContacts.append(contact);
+        connectNodes(prev, prevContact, contact, 0);
+
+        prev = contact;
+        prevContact = 1;
+    }
+
+    LightBulbNode *load = addNode<LightBulbNode>();
+    connectNodes(prev, prevContact, load, 0);
+}
+
+void BenchLayout::buildBifilarMesh()
+{
+    PowerSourceNode *source = addNode<PowerSourceNode>();
+    mSources.append(source);
+
+    SimpleCircuitNode *prevA = nullptr;
+    SimpleCircuitNode *prevB = nullptr;
+
+    for(int i = 0; i < mSize; i++)
+    {
+        // Rail nodes: 0 = from previous, 2 = to next, 3 = rung
+        SimpleCircuitNode *railA = addNode<SimpleCircuitNode>();
+        SimpleCircuitNode *railB = addNode<SimpleCircuitNode>();
+
+        // Enable all contacts
+        railA->setDisabledContact(0);
+        railB->setDisabledContact(0);
+
+        if(prevA)
+        {
+            connectNodes(prevA, 2, railA, 0);
+            connectNodes(prevB, 2, railB, 0);
+        }
+        else
+        {
+            connectNodes(source, 0, railA, 0);
+        }
+
+        OnOffSwitchNode *contact = addNode<OnOffSwitchNode>();
+        mContacts.append(contact);
+        connectNodes(railA, 3, contact, 0);
+        connectNodes(contact, 1, railB, 3);
+
+        prevA = railA;
+        prevB = railB;
+    }
+
+    LightBulbNode *load = addNode<LightBulbNode>();
+    connectNodes(prevB, 2, load, 0);
+}
+
+void BenchLayout::buildManySources()
+{
+    for(int i = 0; i < mSize; i++)
+    {
+        PowerSourceNode *source = addNode<PowerSourceNode>();
+        mSources.append(source);
+
+        OnOffSwitchNode *contact = addNode<OnOffSwitchNode>();
+        mContacts.append(contact);
+        connectNodes(source, 0, contact, 0);
+
+        LightBulbNode *load = addNode<LightBulbNode>();
+        connectNodes(contact, 1, load, 0);
+    }
+}
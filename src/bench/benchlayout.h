@@ -0,0 +1,96 @@
+/**
+ * src/bench/benchlayout.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef BENCHLAYOUT_H
+#define BENCHLAYOUT_H
+
+#include <QVector>
+#include <QString>
+
+class ModeManager;
+
+class AbstractCircuitNode;
+class CircuitCable;
+class PowerSourceNode;
+class OnOffSwitchNode;
+
+/*!
+ * \brief The BenchLayout class
+ *
+ * Synthetic circuit layout built directly from nodes and cables,
+ * without scenes or graphics items.
+ * Contacts are simulated by OnOffSwitchNode, loads by LightBulbNode.
+ */
+class BenchLayout
+{
+public:
+    enum class Type
+    {
+        RelayRack = 0, // Busbar feeding N contact + load branches
+        ContactChain,  // N contacts in series before a single load
+        BifilarMesh,   // Ladder of 2 x N nodes with N contact rungs
+        ManySources,   // N independent sources with contact and load
+        NTypes
+    };
+
+    BenchLayout(ModeManager *mgr, Type type, int size);
+    ~BenchLayout();
+
+    static QString typeName(Type type);
+
+    inline Type type() const { return mType; }
+    inline int size() const { return mSize; }
+
+    inline int nodeCount() const { return mNodes.size(); }
+    inline int cableCount() const { return mCables.size(); }
+
+    void setPowered(bool on);
+    void setContactClosed(bool closed);
+
+private:
+    template <typename Node>
+    Node *addNode();
+
+    void connectNodes(AbstractCircuitNode *node1, int contact1,
+                      AbstractCircuitNode *node2, int contact2);
+
+    void buildRelayRack();
+    void buildContactChain();
+    void buildBifilarMesh();
+    void buildManySources();
+
+private:
+    ModeManager *mModeMgr;
+    Type mType;
+    int mSize;
+
+    QVector<AbstractCircuitNode *> mNodes;
+    QVector<CircuitCable *> mCables;
+
+    QVector<PowerSourceNode *> mSources;
+    QVector<OnOffSwitchNode *> mContacts;
+
+    // Contact toggled by contact events
+    OnOffSwitchNode *mTestContact = nullptr;
+};
+
+#endif // BENCHLAYOUT_H
@@ -0,0 +1,283 @@
+/**
+ * src/bench/main_bench.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <QElapsedTimer>
+#include <QTextStream>
+
+#include "info.h"
+
+#include "../views/modemanager.h"
+#include "../circuits/electriccircuit.h"
+#include "../circuits/circuitgraph.h"
+#include "../circuits/circuitislands.h"
+
+#include "benchlayout.h"
+#include "allocationcounter.h"
+
+#include <functional>
+
+struct BenchResult
+{
+    qint64 nanos = 0;
+    qint64 circuitsCreated = 0;
+    qint64 circuitsDestroyed = 0;
+    qint64 passNodeCalls = 0;
+    qint64 pathNodesRechecked = 0;
+    qint64 shuntCandidates = 0;
+    qint64 graphRebuilds = 0;
+    qint64 poolHits = 0;
+    qint64 poolMisses = 0;
+    qint64 allocations = 0;
+
+    inline double poolHitRate() const
+    {
+        const qint64 total = poolHits + poolMisses;
+        if(!total)
+            return 0;
+        return 100.0 * double(poolHits) / double(total);
+    }
+
+    inline BenchResult& operator +=(const BenchResult& other)
+    {
+        nanos += other.nanos;
+        circuitsCreated += other.circuitsCreated;
+        circuitsDestroyed += other.circuitsDestroyed;
+        passNodeCalls += other.passNodeCalls;
+        pathNodesRechecked += other.pathNodesRechecked;
+        shuntCandidates += other.shuntCandidates;
+        graphRebuilds += other.graphRebuilds;
+        poolHits += other.poolHits;
+        poolMisses += other.poolMisses;
+        allocations += other.allocations;
+        return *this;
+    }
+};
+
+static BenchResult measureEvent(const std::function<void()>& func)
+{
+    ElectricCircuit::resetStats();
+    CircuitGraph::resetStats();
+
+    const qint64 allocStart = AllocationCounter::count();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    func();
+
+    BenchResult result;
+    result.nanos = timer.nsecsElapsed();
+    result.allocations = AllocationCounter::count() - allocStart;
+
+    const ElectricCircuit::Stats& stats = ElectricCircuit::stats();
+    result.circuitsCreated = stats.circuitsCreated;
+    result.circuitsDestroyed = stats.circuitsDestroyed;
+    result.passNodeCalls = stats.passNodeCalls;
+    result.pathNodesRechecked = stats.pathNodesRechecked;
+    result.shuntCandidates = stats.shuntCandidates;
+    result.graphRebuilds = CircuitGraph::stats().nodeRebuilds;
+
+    // Count both circuit objects and their item storage
+    result.poolHits = stats.poolHits + stats.itemsPoolHits;
+    result.poolMisses = stats.poolMisses + stats.itemsPoolMisses;
+    return result;
+}
+
+static void printResult(QTextStream& out, bool csv,
+                        const BenchLayout& layout, const QString& eventName,
+                        const BenchResult& total, int repeat)
+{
+    const double avgMillis = double(total.nanos) / repeat / 1000000.0;
+
+    if(csv)
+    {
+        out << BenchLayout::typeName(layout.type()) << ','
+            << layout.size() << ','
+            << eventName << ','
+            << QString::number(avgMillis, 'f', 4) << ','
+            << total.circuitsCreated / repeat << ','
+            << total.circuitsDestroyed / repeat << ','
+            << total.passNodeCalls / repeat << ','
+            << total.pathNodesRechecked / repeat << ','
+            << total.shuntCandidates / repeat << ','
+            << total.graphRebuilds / repeat << ','
+            << QString::number(total.poolHitRate(), 'f', 1) << ','
+            << total.allocations / repeat << Qt::endl;
+        return;
+    }
+
+    out << qSetFieldWidth(16) << Qt::left << BenchLayout::typeName(layout.type())
+        << qSetFieldWidth(8) << Qt::right << layout.size()
+        << qSetFieldWidth(16) << eventName
+        << qSetFieldWidth(12) << QString::number(avgMillis, 'f', 4)
+        << qSetFieldWidth(12) << total.circuitsCreated / repeat
+        << qSetFieldWidth(12) << total.circuitsDestroyed / repeat
+        << qSetFieldWidth(12) << total.passNodeCalls / repeat
+        << qSetFieldWidth(12) << total.pathNodesRechecked / repeat
+        << qSetFieldWidth(12) << total.shuntCandidates / repeat
+        << qSetFieldWidth(12) << total.graphRebuilds / repeat
+        << qSetFieldWidth(12) << QString::number(total.poolHitRate(), 'f', 1)
+        << qSetFieldWidth(12) << total.allocations / repeat
+        << qSetFieldWidth(0) << Qt::endl;
+}
+
+static void runLayout(ModeManager *mgr, BenchLayout::Type type, int size,
+                      int repeat, bool csv, QTextStream& out)
+{
+    BenchLayout layout(mgr, type, size);
+
+    BenchResult powerOn, powerOff, contactOpen, contactClose;
+
+    for(int i = 0; i < repeat; i++)
+    {
+        // createCircuitsFromPowerNode()
+        powerOn += measureEvent([&layout]() { layout.setPowered(true); });
+
+        // disableOrTerminate()
+        contactOpen += measureEvent([&layout]() { layout.setContactClosed(false); });
+
+        // createCircuitsFromOtherNode()
+        contactClose += measureEvent([&layout]() { layout.setContactClosed(true); });
+
+        powerOff += measureEvent([&layout]() { layout.setPowered(false); });
+    }
+
+    printResult(out, csv, layout, QLatin1String("power_on"), powerOn, repeat);
+    printResult(out, csv, layout, QLatin1String("contact_open"), contactOpen, repeat);
+    printResult(out, csv, layout, QLatin1String("contact_close"), contactClose, repeat);
+    printResult(out, csv, layout, QLatin1String("power_off"), powerOff, repeat);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(AppProduct);
+    QCoreApplication::setApplicationVersion(AppVersion);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QLatin1String("Electric circuit path search benchmark"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption layoutOption({QLatin1String("l"), QLatin1String("layout")},
+                                    QLatin1String("Layout type: relay_rack, contact_chain, bifilar_mesh, many_sources or all."),
+                                    QLatin1String("layout"), QLatin1String("all"));
+    parser.addOption(layoutOption);
+
+    QCommandLineOption sizeOption({QLatin1String("n"), QLatin1String("size")},
+                                  QLatin1String("Layout size (relays, contacts, rungs or sources)."),
+                                  QLatin1String("size"), QLatin1String("100"));
+    parser.addOption(sizeOption);
+
+    QCommandLineOption repeatOption({QLatin1String("r"), QLatin1String("repeat")},
+                                    QLatin1String("Number of repetitions of each event."),
+                                    QLatin1String("repeat"), QLatin1String("5"));
+    parser.addOption(repeatOption);
+
+    QCommandLineOption csvOption(QLatin1String("csv"),
+                                 QLatin1String("Print results as CSV."));
+    parser.addOption(csvOption);
+
+    QCommandLineOption fullRecomputeOption(QLatin1String("full-recompute"),
+                                           QLatin1String("Disable incremental recomputation, always walk full paths."));
+    parser.addOption(fullRecomputeOption);
+
+    QCommandLineOption shuntOption(QLatin1String("shunt-detection"),
+                                   QLatin1String("Enable detection of circuits shunted by other circuits."));
+    parser.addOption(shuntOption);
+
+    QCommandLineOption directOption(QLatin1String("direct-connections"),
+                                    QLatin1String("Do not use compiled graph, ask nodes for connections each time."));
+    parser.addOption(directOption);
+
+    QCommandLineOption serialIslandsOption(QLatin1String("serial-islands"),
+                                           QLatin1String("Do not compile independent circuit islands in parallel."));
+    parser.addOption(serialIslandsOption);
+
+    parser.process(app);
+
+    const int size = qMax(1, parser.value(sizeOption).toInt());
+    const int repeat = qMax(1, parser.value(repeatOption).toInt());
+    const bool csv = parser.isSet(csvOption);
+    const QString layoutName = parser.value(layoutOption);
+
+    ElectricCircuit::setIncrementalRecompute(!parser.isSet(fullRecomputeOption));
+    ElectricCircuit::setShuntDetectionEnabled(parser.isSet(shuntOption));
+    CircuitGraph::setEnabled(!parser.isSet(directOption));
+    CircuitIslands::setParallelEnabled(!parser.isSet(serialIslandsOption));
+
+    QTextStream out(stdout);
+
+    if(csv)
+    {
+        out << "layout,size,event,avg_ms,circuits_created,circuits_destroyed,"
+               "pass_node_calls,path_nodes_rechecked,shunt_candidates,graph_rebuilds,pool_hit_percent,allocations" << Qt::endl;
+    }
+    else
+    {
+        if(!AllocationCounter::countsMalloc())
+            out << "NOTE: only C++ allocations are counted on this platform" << Qt::endl;
+
+        out << qSetFieldWidth(16) << Qt::left << "layout"
+            << qSetFieldWidth(8) << Qt::right << "size"
+            << qSetFieldWidth(16) << "event"
+            << qSetFieldWidth(12) << "avg ms"
+            << qSetFieldWidth(12) << "created"
+            << qSetFieldWidth(12) << "destroyed"
+            << qSetFieldWidth(12) << "pass node"
+            << qSetFieldWidth(12) << "rechecked"
+            << qSetFieldWidth(12) << "shunt cand"
+            << qSetFieldWidth(12) << "rebuilds"
+            << qSetFieldWidth(12) << "pool hit %"
+            << qSetFieldWidth(12) << "allocs"
+            << qSetFieldWidth(0) << Qt::endl;
+    }
+
+    ModeManager modeMgr;
+
+    // Nodes react only during simulation
+    modeMgr.setMode(FileMode::Simulation);
+
+    bool found = false;
+    for(int t = 0; t < int(BenchLayout::Type::NTypes); t++)
+    {
+        const BenchLayout::Type type = BenchLayout::Type(t);
+        if(layoutName != QLatin1String("all") && layoutName != BenchLayout::typeName(type))
+            continue;
+
+        found = true;
+        runLayout(&modeMgr, type, size, repeat, csv, out);
+    }
+
+    modeMgr.setMode(FileMode::Editing);
+
+    if(!found)
+    {
+        QTextStream(stderr) << "Unknown layout: " << layoutName << Qt::endl;
+        return 1;
+    }
+
+    return 0;
+}
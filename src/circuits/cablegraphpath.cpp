@@ -0,0 +1,549 @@
+/**
+ * src/circuits/cablegraphpath.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2024 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "cablegraphpath.h"
+
+#include <QRectF>
+
+#include <QJsonObject>
+#include <QJsonArray>
+
+Connector::Direction CableGraphPath::getEnterDirection(int tileIdx) const
+{
+    if(tileIdx == 0)
+        return mStartDirection;
+
+    if(tileIdx >= mTiles.size())
+        return Connector::Direction::South; // Error
+
+    const TileLocation& tile = mTiles.at(tileIdx);
+    const TileLocation& prevTile = mTiles.at(tileIdx - 1);
+    return getDirection(tile, prevTile);
+}
+
+Connector::Direction CableGraphPath::getExitDirection(int tileIdx) const
+{
+    if(tileIdx == mTiles.size() - 1)
+        return mEndDirection;
+
+    if(tileIdx >= mTiles.size())
+        return Connector::Direction::South; // Error
+
+    const TileLocation& tile = mTiles.at(tileIdx);
+    const TileLocation& nextTile = mTiles.at(tileIdx + 1);
+    return getDirection(tile, nextTile);
+}
+
+bool CableGraphPath::addTile(const TileLocation &l)
+{
+    if(mPathIsComplete)
+        return false;
+
+    if(!mTiles.isEmpty())
+    {
+        if(mTiles.last() == l)
+            return false; // Cannot add same tile twice
+
+        const TileLocation& prevTile = mTiles.last();
+        if(prevTile.x != l.x && prevTile.y != l.y)
+        {
+            // Adjacent tiles must have one coordinate in common
+            return false;
+        }
+
+        const auto newPrevTileExitDir = getDirection(mTiles.last(), l);
+        const auto newTileStartDir = ~newPrevTileExitDir; // Opposite
+        if(!mExitDirectionIsFree)
+        {
+            // We didn't respect last exit direction
+            if(newPrevTileExitDir != mWantedExitDirection)
+                return false;
+        }
+
+        // Check we are not going back
+        const auto prevTileStartDir = getEnterDirection(mTiles.size() - 1);
+        if(newPrevTileExitDir == prevTileStartDir)
+            return false;
+
+        // Cable can pass on same tile twice if:
+        // - it's not same as previous tile
+        // - Both times it passes it does not bend, but goes straight
+        // - Direction is different in the 2 passages
+
+        int idx = mTiles.indexOf(l);
+        if(idx >= 0)
+        {
+            // Check if first passage was straigh
+            const auto enterDir1 = getEnterDirection(idx);
+            const auto exitDir1 = getExitDirection(idx);
+            if(enterDir1 != ~exitDir1)
+                return false; // Directions are not opposite, it bends
+
+            if(newTileStartDir == enterDir1 || newTileStartDir == exitDir1)
+                return false; // Both passages have same direction
+
+            // We do not want to bend second passage
+            mExitDirectionIsFree = false;
+            mWantedExitDirection = ~newTileStartDir; // Opposite
+        }
+        else
+        {
+            // Reset
+            mExitDirectionIsFree = true;
+        }
+    }
+
+    mTiles.append(l);
+    return true;
+}
+
+Connector::Direction CableGraphPath::startDirection() const
+{
+    return mStartDirection;
+}
+
+bool CableGraphPath::setStartDirection(Connector::Direction newStartDirection)
+{
+    if(!mTiles.isEmpty())
+        return false; // Must be set before adding tiles
+
+    mStartDirection = newStartDirection;
+    return true;
+}
+
+Connector::Direction CableGraphPath::endDirection() const
+{
+    return mEndDirection;
+}
+
+bool CableGraphPath::setEndDirection(Connector::Direction newEndDirection)
+{
+    if(mTiles.isEmpty())
+        return false; // Must add tiles first
+
+    if(!mExitDirectionIsFree && newEndDirection != mWantedExitDirection)
+    {
+        // We didn't respect last exit direction
+        return false;
+    }
+
+    if(getEnterDirection(mTiles.size() - 1) == newEndDirection)
+        return false; // Cannot enter and exit on same direction
+
+    mEndDirection = newEndDirection;
+
+    mPathIsComplete = true;
+
+    return true;
+}
+
+TileLocation CableGraphPath::sideA() const
+{
+    if(isEmpty())
+        return TileLocation::invalid;
+
+    if(isZeroLength())
+        return first();
+
+    return first() + startDirection();
+}
+
+TileLocation CableGraphPath::sideB() const
+{
+    if(isEmpty())
+        return TileLocation::invalid;
+
+    if(isZeroLength())
+        return last();
+
+    return last() + endDirection();
+}
+
+bool CableGraphPath::removeLastLine()
+{
+    if(mTiles.isEmpty() || isZeroLength())
+        return false;
+
+    if(mPathIsComplete)
+    {
+        // Remove end connector direction
+        mPathIsComplete = false;
+        return true;
+    }
+
+    if(mTiles.size() == 1)
+    {
+        // Remove first
+        mTiles.removeLast();
+        return true;
+    }
+
+    // Remove last straight line
+    const auto startDir = getEnterDirection(mTiles.size() - 1);
+    while(mTiles.size() > 1) // Do not remove first
+    {
+        const auto otherStartDir = getEnterDirection(mTiles.size() - 1);
+        if(otherStartDir != startDir)
+            break; // We reached a bend
+
+        mTiles.removeLast();
+    }
+
+    return true;
+}
+
+bool CableGraphPath::isPointInsideCableTiles(const QPointF &pos) const
+{
+    // This is smaller than total bounding rects (Think L-shaped cables)
+    // But it's more than shape (Which has just pen width)
+    for(const TileLocation& tile : mTiles)
+    {
+        const QRectF tileRect(tile.toPoint(),
+                              QSizeF(TileLocation::Size,
+                                     TileLocation::Size));
+        if(tileRect.contains(pos))
+            return true;
+    }
+
+    return false;
+}
+
+CableGraphPath CableGraphPath::tryMerge(const CableGraphPath &other) const
+{
+    // No point in merging zero length cables
+    if(isZeroLength() || other.isZeroLength())
+        return {}; // Return empty
+
+    CableGraphPath totalPath;
+
+    TileLocation ourNextFirst = this->first() + this->startDirection();
+    if(ourNextFirst == other.first()
+            && other.startDirection() == ~this->startDirection())
+    {
+        // Pass other cable reversed and then ourselves
+        totalPath.setStartDirection(other.endDirection());
+        for(int i = other.getTilesCount() - 1; i >= 0; i--)
+        {
+            if(!totalPath.addTile(other.at(i)))
+            {
+                return {};
+            }
+        }
+
+        for(int i = 0; i < this->getTilesCount(); i++)
+        {
+            if(!totalPath.addTile(this->at(i)))
+            {
+                return {};
+            }
+        }
+
+        if(!totalPath.setEndDirection(this->endDirection()))
+            return {};
+
+        return totalPath;
+    }
+
+    if(ourNextFirst == other.last()
+            && other.endDirection() == ~this->startDirection())
+    {
+        // Pass other cable and then ourselves
+        totalPath.setStartDirection(other.startDirection());
+        for(int i = 0; i < other.getTilesCount(); i++)
+        {
+            if(!totalPath.addTile(other.at(i)))
+            {
+                return {};
+            }
+        }
+
+        for(int i = 0; i < this->getTilesCount(); i++)
+        {
+            if(!totalPath.addTile(this->at(i)))
+            {
+                return {};
+            }
+        }
+
+        if(!totalPath.setEndDirection(this->endDirection()))
+            return {};
+
+        return totalPath;
+    }
+
+    TileLocation ourNextLast = this->last() + this->endDirection();
+    if(ourNextLast == other.first()
+            && other.startDirection() == ~this->endDirection())
+    {
+        // Pass ourselves and then other cable
+        totalPath.setStartDirection(this->startDirection());
+
+        for(int i = 0; i < this->getTilesCount(); i++)
+        {
+            if(!totalPath.addTile(this->at(i)))
+            {
+                return {};
+            }
+        }
+
+        for(int i = 0; i < other.getTilesCount(); i++)
+        {
+            if(!totalPath.addTile(other.at(i)))
+            {
+                return {};
+            }
+        }
+
+        if(!totalPath.setEndDirection(other.endDirection()))
+            return {};
+
+        return totalPath;
+    }
+
+    if(ourNextLast == other.last()
+            && other.endDirection() == ~this->endDirection())
+    {
+        // Pass ourselves and then other cable reversed
+        totalPath.setStartDirection(this->startDirection());
+
+        for(int i = 0; i < this->getTilesCount(); i++)
+        {
+            if(!totalPath.addTile(this->at(i)))
+            {
+                return {};
+            }
+        }
+
+        for(int i = other.getTilesCount() - 1; i >= 0; i--)
+        {
+            if(!totalPath.addTile(other.at(i)))
+            {
+                return {};
+            }
+        }
+
+        if(!totalPath.setEndDirection(other.startDirection()))
+            return {};
+
+        return totalPath;
+    }
+
+    // Return empty
+    return {};
+}
+
+bool CableGraphPath::splitted(const TileLocation splitLoc, SplitPair& result) const
+{
+    if(isZeroLength() || !mTiles.contains(splitLoc))
+        return false; // Nothing to split
+
+    CableGraphPath a, b;
+
+    // Set a start
+    a.setStartDirection(this->startDirection());
+
+    int tileIdx = 0;
+    for(; tileIdx < mTiles.size(); tileIdx++)
+    {
+        const TileLocation& tile = mTiles.at(tileIdx);
+
+        if(tile == splitLoc)
+        {
+            // We reached node tile
+            if(a.isEmpty())
+                break; // No path before tile
+
+            // Set end direction
+            a.setEndDirection(getDirection(a.last(), splitLoc));
+            break;
+        }
+
+        // Copy first half to a
+        a.addTile(tile);
+    }
+
+    // Skip splitLoc tile
+    tileIdx++;
+
+    for(; tileIdx < mTiles.size(); tileIdx++)
+    {
+        const TileLocation& tile = mTiles.at(tileIdx);
+
+        if(b.isEmpty())
+        {
+            // Set b start direction
+            b.setStartDirection(getDirection(tile, splitLoc));
+        }
+
+        // Copy second half to b
+        b.addTile(tile);
+    }
+
+    b.setEndDirection(this->endDirection());
+
+    result.first = a;
+    result.second = b;
+    return true;
+}
+
+CableGraphPath CableGraphPath::translatedBy(int16_t dx, int16_t dy) const
+{
+    if(isZeroLength() || isEmpty())
+        return {};
+
+    CableGraphPath translated;
+    translated.setStartDirection(startDirection());
+
+    for(const TileLocation tile : mTiles)
+    {
+        translated.addTile(tile.adjusted(dx, dy));
+    }
+
+    translated.setEndDirection(endDirection());
+
+    return translated;
+}
+
+CableGraphPath CableGraphPath::createZeroLength(const TileLocation &a, const TileLocation &b)
+{
+    CableGraphPath path;
+    path.mIsZeroLength = true;
+
+    if(a.x == b.x)
+    {
+        Q_ASSERT_X(std::abs(a.y - b.y) == 1,
+                   "CableGraphPath::createZeroLength",
+                   "horizontal not adjacent");
+        path.mStartDirection = getDirection(b, a); // Opposite
+    }
+    else if(a.y == b.y)
+    {
+        Q_ASSERT_X(std::abs(a.x - b.x) == 1,
+                   "CableGraphPath::createZeroLength",
+                   "vertical not adjacent");
+        path.mStartDirection = getDirection(b, a); // Opposite
+    }
+    else
+    {
+        // Tiles are not adjacent
+        Q_ASSERT_X(false, "CableGraphPath::createZeroLength", "tiles not adjacent");
+    }
+
+    path.mTiles.append(a);
+    path.mTiles.append(b);
+    path.mEndDirection = ~path.mStartDirection;
+
+    return path;
+}
+
+CableGraphPath CableGraphPath::loadFromJSON(const QJsonObject &obj)
+{
+    const QJsonArray tiles = obj.value("tiles").toArray();
+
+
+    CableGraphPath result;
+
+    int startDir = obj.value("start_dir").toInt();
+    int endDir = obj.value("end_dir").toInt();
+
+    result.setStartDirection(Connector::Direction(startDir));
+
+    for(const QJsonValue& v : tiles)
+    {
+        const QJsonObject tileObj = v.toObject();
+        TileLocation tile;
+        tile.x = int16_t(tileObj.value("x").toInt());
+        tile.y = int16_t(tileObj.value("y").toInt());
+        result.addTile(tile);
+    }
+
+    result.setEndDirection(Connector::Direction(endDir));
+
+    if(!result.isComplete())
+        return {};
+
+    return result;
+}
+
+void CableGraphPath::saveToJSON(const CableGraphPath &path, QJsonObject &obj)
+{
+    assert(!path.isZeroLength());
+
+    const bool needsReverse = path.needsReversing();
+
+    QJsonArray tiles;
+    for(const TileLocation tile : path.tiles())
+    {
+        QJsonObject tileObj;
+        tileObj["x"] = tile.x;
+        tileObj["y"] = tile.y;
+
+        if(needsReverse)
+            tiles.prepend(tileObj);
+        else
+            tiles.append(tileObj);
+    }
+    obj["tiles"] = tiles;
+
+    if(needsReverse)
+    {
+        obj["start_dir"] = int(path.endDirection());
+        obj["end_dir"] = int(path.startDirection());
+    }
+    else
+    {
+        obj["start_dir"] = int(path.startDirection());
+        obj["end_dir"] = int(path.endDirection());
+    }
+}
+
+bool CableGraphPath::needsReversing() const
+{
+    if(tiles().size() == 1)
+    {
+        return startDirection() < endDirection();
+    }
+    else if(tiles().size() > 1)
+    {
+        if(first().x == last().x)
+            return first().y > last().y;
+
+        return first().x > last().x;
+    }
+
+    return false;
+}
+
+Connector::Direction CableGraphPath::getDirection(const TileLocation &a, const TileLocation &b)
+{
+    if(a.x == b.x)
+    {
+        if(a.y > b.y)
+            return Connector::Direction::North;
+        return Connector::Direction::South;
+    }
+
+    // Tiles have same y
+    if(a.x > b.x)
+        return Connector::Direction::West;
+    return Connector::Direction::East;
+}
@@ -0,0 +1,123 @@
+/**
+ * src/circuits/cablegraphpath.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2024 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef CABLEGRAPHPATH_H
+#define CABLEGRAPHPATH_H
+
+#include <QVector>
+
+#include <utility>
+
+#include "../utils/tilerotate.h"
+
+class QJsonObject;
+
+class CableGraphPath
+{
+public:
+    CableGraphPath() = default;
+
+    inline const QVector<TileLocation>& tiles() const
+    {
+        return mTiles;
+    }
+
+    inline int getTilesCount() const
+    {
+        return mTiles.size();
+    }
+
+    inline bool isEmpty() const
+    {
+        return mTiles.isEmpty();
+    }
+
+    inline bool validNotZero() const
+    {
+        return !isEmpty() && !isZeroLength() && isComplete();
+    }
+
+    inline TileLocation first() const { return mTiles.first(); }
+    inline TileLocation last() const { return mTiles.last(); }
+    inline TileLocation at(int i) const { return mTiles.at(i); }
+
+    Connector::Direction getEnterDirection(int tileIdx) const;
+    Connector::Direction getExitDirection(int tileIdx) const;
+
+    bool addTile(const TileLocation& l);
+
+    Connector::Direction startDirection() const;
+    bool setStartDirection(Connector::Direction newStartDirection);
+
+    Connector::Direction endDirection() const;
+    bool setEndDirection(Connector::Direction newEndDirection);
+
+    // Tiles where nodes connected to cable sides are placed
+    TileLocation sideA() const;
+    TileLocation sideB() const;
+
+    bool removeLastLine();
+
+    bool isPointInsideCableTiles(const QPointF& pos) const;
+
+    inline bool isZeroLength() const
+    {
+        return mIsZeroLength;
+    }
+
+    inline bool isComplete() const
+    {
+        return mPathIsComplete;
+    }
+
+    CableGraphPath tryMerge(const CableGraphPath& other) const;
+
+    typedef std::pair<CableGraphPath, CableGraphPath> SplitPair;
+    bool splitted(const TileLocation splitLoc, SplitPair& result) const;
+
+    CableGraphPath translatedBy(int16_t dx, int16_t dy) const;
+
+    static CableGraphPath createZeroLength(const TileLocation& a,
+                                           const TileLocation& b);
+
+    static CableGraphPath loadFromJSON(const QJsonObject& obj);
+    static void saveToJSON(const CableGraphPath& path, QJsonObject& obj);
+
+    bool needsReversing() const;
+
+private:
+    static Connector::Direction getDirection(const TileLocation& a,
+                                             const TileLocation& b);
+
+private:
+    QVector<TileLocation> mTiles;
+    Connector::Direction mStartDirection;
+    Connector::Direction mEndDirection;
+
+    bool mExitDirectionIsFree = true;
+    Connector::Direction mWantedExitDirection = Connector::Direction::South;
+
+    bool mPathIsComplete = false;
+    bool mIsZeroLength = false;
+};
+
+#endif // CABLEGRAPHPATH_H
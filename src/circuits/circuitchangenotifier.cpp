@@ -0,0 +1,171 @@
+/**
+ * src/circuits/circuitchangenotifier.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "circuitchangenotifier.h"
+
+#include "nodes/abstractcircuitnode.h"
+#include "nodes/circuitcable.h"
+
+#include <QTimerEvent>
+
+#include <utility>
+
+CircuitChangeNotifier::CircuitChangeNotifier(QObject *parent)
+    : QObject{parent}
+{
+
+}
+
+CircuitChangeNotifier::~CircuitChangeNotifier()
+{
+    // Objects are deleted before us, nothing to deliver
+    Q_ASSERT(mPendingNodes.isEmpty());
+    Q_ASSERT(mPendingCables.isEmpty());
+}
+
+void CircuitChangeNotifier::setEnabled(bool val)
+{
+    if(mEnabled == val)
+        return;
+
+    // Deliver changes queued so far
+    if(!val)
+        flush();
+
+    mEnabled = val;
+}
+
+void CircuitChangeNotifier::setFrameInterval(int millis)
+{
+    mFrameInterval = qBound(1, millis, 1000);
+
+    if(mFrameTimer.isActive())
+        mFrameTimer.start(mFrameInterval, this);
+}
+
+void CircuitChangeNotifier::nodeCircuitsChanged(AbstractCircuitNode *node)
+{
+    if(!mEnabled)
+    {
+        node->mNotifiedCircuitsState = node->circuitsState();
+        emit node->circuitsChanged();
+        return;
+    }
+
+    if(node->mCircuitsChangePending)
+        return;
+
+    node->mCircuitsChangePending = true;
+    mPendingNodes.insert(node);
+    scheduleFlush();
+}
+
+void CircuitChangeNotifier::cablePowerChanged(CircuitCable *cable)
+{
+    if(!mEnabled)
+    {
+        cable->mNotifiedPower = cable->powered();
+        cable->mNotifiedFlags = cable->getFlags();
+        emit cable->powerChanged(cable->mNotifiedPower);
+        return;
+    }
+
+    if(cable->mPowerChangePending)
+        return;
+
+    cable->mPowerChangePending = true;
+    mPendingCables.insert(cable);
+    scheduleFlush();
+}
+
+void CircuitChangeNotifier::removeNode(AbstractCircuitNode *node)
+{
+    if(!node->mCircuitsChangePending)
+        return;
+
+    node->mCircuitsChangePending = false;
+    mPendingNodes.remove(node);
+}
+
+void CircuitChangeNotifier::removeCable(CircuitCable *cable)
+{
+    if(!cable->mPowerChangePending)
+        return;
+
+    cable->mPowerChangePending = false;
+    mPendingCables.remove(cable);
+}
+
+void CircuitChangeNotifier::flush()
+{
+    mFrameTimer.stop();
+
+    // Receivers might cause new changes, they go to next frame
+    const QSet<AbstractCircuitNode *> nodes = std::exchange(mPendingNodes, {});
+    const QSet<CircuitCable *> cables = std::exchange(mPendingCables, {});
+
+    for(AbstractCircuitNode *node : nodes)
+    {
+        node->mCircuitsChangePending = false;
+
+        // Skip circuits added and then removed
+        AbstractCircuitNode::CircuitsState state = node->circuitsState();
+        if(state == node->mNotifiedCircuitsState)
+            continue;
+
+        node->mNotifiedCircuitsState = std::move(state);
+        emit node->circuitsChanged();
+    }
+
+    for(CircuitCable *cable : cables)
+    {
+        cable->mPowerChangePending = false;
+
+        // Flags alone can change drawn color
+        const CablePower power = cable->powered();
+        const CircuitFlags flags = cable->getFlags();
+        if(power == cable->mNotifiedPower && flags == cable->mNotifiedFlags)
+            continue;
+
+        cable->mNotifiedPower = power;
+        cable->mNotifiedFlags = flags;
+        emit cable->powerChanged(power);
+    }
+}
+
+void CircuitChangeNotifier::timerEvent(QTimerEvent *e)
+{
+    if(e->timerId() == mFrameTimer.timerId())
+    {
+        flush();
+        return;
+    }
+
+    QObject::timerEvent(e);
+}
+
+void CircuitChangeNotifier::scheduleFlush()
+{
+    if(!mFrameTimer.isActive())
+        mFrameTimer.start(mFrameInterval, this);
+}
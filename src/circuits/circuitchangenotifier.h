@@ -0,0 +1,87 @@
+/**
+ * src/circuits/circuitchangenotifier.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef CIRCUITCHANGENOTIFIER_H
+#define CIRCUITCHANGENOTIFIER_H
+
+#include <QObject>
+#include <QBasicTimer>
+#include <QSet>
+
+class AbstractCircuitNode;
+class CircuitCable;
+
+/*!
+ * \brief The CircuitChangeNotifier class
+ *
+ * Coalesces circuit change notifications of nodes and cables.
+ * A circuit can be added and removed many times in the same event loop turn,
+ * so instead of emitting a signal each time objects are queued once
+ * and signals are emitted at next display frame.
+ *
+ * On flush, only objects whose state actually differs from
+ * last notified state emit AbstractCircuitNode::circuitsChanged()
+ * or CircuitCable::powerChanged().
+ *
+ * When disabled, signals are emitted immediately.
+ */
+class CircuitChangeNotifier : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int DefaultFrameIntervalMillis = 16;
+
+    explicit CircuitChangeNotifier(QObject *parent = nullptr);
+    ~CircuitChangeNotifier();
+
+    inline bool isEnabled() const { return mEnabled; }
+    void setEnabled(bool val);
+
+    inline int frameInterval() const { return mFrameInterval; }
+    void setFrameInterval(int millis);
+
+    void nodeCircuitsChanged(AbstractCircuitNode *node);
+    void cablePowerChanged(CircuitCable *cable);
+
+    void removeNode(AbstractCircuitNode *node);
+    void removeCable(CircuitCable *cable);
+
+    // Emit all pending notifications now
+    void flush();
+
+protected:
+    void timerEvent(QTimerEvent *e) override;
+
+private:
+    void scheduleFlush();
+
+private:
+    QSet<AbstractCircuitNode *> mPendingNodes;
+    QSet<CircuitCable *> mPendingCables;
+
+    QBasicTimer mFrameTimer;
+    int mFrameInterval = DefaultFrameIntervalMillis;
+    bool mEnabled = true;
+};
+
+#endif // CIRCUITCHANGENOTIFIER_H
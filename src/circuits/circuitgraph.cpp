@@ -0,0 +1,404 @@
+/**
+ * src/circuits/circuitgraph.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "circuitgraph.h"
+
+#include "nodes/abstractcircuitnode.h"
+#include "nodes/circuitcable.h"
+
+#include <QThreadPool>
+#include <QSemaphore>
+
+#include <algorithm>
+
+QVector<CircuitGraph::NodeEntry> CircuitGraph::mNodes;
+QVector<int> CircuitGraph::mFreeIds;
+
+QVector<int> CircuitGraph::mRows;
+QVector<CircuitGraph::Edge> CircuitGraph::mEdges;
+int CircuitGraph::mGarbageRows = 0;
+int CircuitGraph::mGarbageEdges = 0;
+
+quint64 CircuitGraph::mGeneration = 1;
+quint64 CircuitGraph::mTopologyEpoch = 1;
+bool CircuitGraph::mEnabled = true;
+CircuitGraph::Stats CircuitGraph::mStats;
+
+// Do not bother compacting small arrays
+static constexpr int MinGarbageToCompact = 256;
+
+// Thread overhead is not worth it for few nodes
+static constexpr int MinNodesToCompileInParallel = 256;
+
+CircuitGraph::Edges CircuitGraph::connections(AbstractCircuitNode *node,
+                                              const CableItem &source,
+                                              bool invertDir)
+{
+    mStats.lookups++;
+
+    if(!mEnabled || source.nodeContact < 0 ||
+            source.nodeContact >= node->getContactCount())
+        return directConnections(node, source, invertDir);
+
+    const int id = nodeId(node);
+
+    NodeEntry *entry = &mNodes[id];
+    if(needsRebuild(*entry))
+    {
+        buildNode(*entry);
+
+        // Compaction moves arrays
+        entry = &mNodes[id];
+    }
+
+    const int row = entry->firstRow + rowIndex(source.nodeContact,
+                                               source.cable.pole,
+                                               invertDir);
+
+    const Edge *first = mEdges.constData() + entry->firstEdge;
+
+    Edges result;
+    result.append(first + mRows.at(row), mRows.at(row + 1) - mRows.at(row));
+    return result;
+}
+
+void CircuitGraph::setEnabled(bool val)
+{
+    if(mEnabled == val)
+        return;
+
+    mEnabled = val;
+    invalidateAll();
+}
+
+void CircuitGraph::invalidateAll()
+{
+    mGeneration++;
+}
+
+void CircuitGraph::compileNodes(const QVector<NodeList> &groups)
+{
+    if(!mEnabled)
+        return;
+
+    // Collect stale nodes on calling thread, node ids are not thread safe
+    QVector<NodeList> staleGroups;
+    staleGroups.reserve(groups.size());
+
+    int staleCount = 0;
+    for(const NodeList& group : groups)
+    {
+        NodeList stale;
+        for(AbstractCircuitNode *node : group)
+        {
+            if(needsRebuild(mNodes.at(nodeId(node))))
+                stale.append(node);
+        }
+
+        if(stale.isEmpty())
+            continue;
+
+        staleCount += stale.size();
+        staleGroups.append(stale);
+    }
+
+    if(staleGroups.isEmpty())
+        return;
+
+    // Each group writes only its own slot
+    QVector<QVector<Table>> results(staleGroups.size());
+    QVector<Table> *resultData = results.data();
+
+    auto compileGroups = [&staleGroups, resultData](int first, int step)
+    {
+        for(int i = first; i < staleGroups.size(); i += step)
+        {
+            const NodeList& group = staleGroups.at(i);
+            QVector<Table>& groupResult = resultData[i];
+            groupResult.resize(group.size());
+
+            for(int j = 0; j < group.size(); j++)
+                compileNode(group.at(j), groupResult[j]);
+        }
+    };
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int taskCount = qMin(int(staleGroups.size()), pool->maxThreadCount());
+
+    if(taskCount < 2 || staleCount < MinNodesToCompileInParallel)
+    {
+        compileGroups(0, 1);
+    }
+    else
+    {
+        QSemaphore done;
+        for(int task = 0; task < taskCount; task++)
+        {
+            pool->start([&compileGroups, &done, task, taskCount]()
+            {
+                compileGroups(task, taskCount);
+                done.release();
+            });
+        }
+
+        done.acquire(taskCount);
+        mStats.parallelRebuilds += staleCount;
+    }
+
+    // Merge in arrays
+    for(const QVector<Table>& groupResult : std::as_const(results))
+    {
+        for(const Table& compiled : groupResult)
+            storeNode(mNodes[compiled.node->mGraphId], compiled);
+    }
+}
+
+void CircuitGraph::nodeTables(const NodeList &nodes, QVector<Table> &tables)
+{
+    tables.resize(nodes.size());
+    mStats.lookups += nodes.size();
+
+    if(!mEnabled)
+    {
+        // Ask nodes directly
+        for(int i = 0; i < nodes.size(); i++)
+            compileNode(nodes.at(i), tables[i]);
+        return;
+    }
+
+    compileNodes({nodes});
+
+    for(int i = 0; i < nodes.size(); i++)
+    {
+        const NodeEntry& entry = mNodes.at(nodeId(nodes.at(i)));
+        Q_ASSERT(!needsRebuild(entry));
+
+        Table& table = tables[i];
+        table.node = entry.node;
+
+        table.rows.clear();
+        table.rows.append(mRows.constData() + entry.firstRow, entry.rowCount);
+
+        table.edges.clear();
+        table.edges.append(mEdges.constData() + entry.firstEdge, table.rows.last());
+    }
+}
+
+void CircuitGraph::cableEndChanged(CircuitCable *cable, CableSide side)
+{
+    mTopologyEpoch++;
+
+    // Node on opposite side stores this end in its edges
+    const CableEnd otherEnd = cable->getNode(~side);
+    if(otherEnd.node)
+        otherEnd.node->markConnectionsChanged();
+}
+
+void CircuitGraph::removeNode(AbstractCircuitNode *node)
+{
+    mTopologyEpoch++;
+
+    if(node->mGraphId < 0)
+        return;
+
+    NodeEntry &entry = mNodes[node->mGraphId];
+    mGarbageRows += entry.rowCount;
+    mGarbageEdges += entry.edgeCapacity;
+    entry = NodeEntry();
+
+    mFreeIds.append(node->mGraphId);
+    node->mGraphId = -1;
+
+    if(mFreeIds.size() == mNodes.size())
+    {
+        // Last node removed, release memory
+        mNodes.clear();
+        mFreeIds.clear();
+        mRows.clear();
+        mRows.squeeze();
+        mEdges.clear();
+        mEdges.squeeze();
+        mGarbageRows = 0;
+        mGarbageEdges = 0;
+    }
+}
+
+void CircuitGraph::resetStats()
+{
+    mStats = Stats();
+}
+
+int CircuitGraph::nodeId(AbstractCircuitNode *node)
+{
+    if(node->mGraphId >= 0)
+        return node->mGraphId;
+
+    if(!mFreeIds.isEmpty())
+    {
+        node->mGraphId = mFreeIds.takeLast();
+    }
+    else
+    {
+        node->mGraphId = mNodes.size();
+        mNodes.append(NodeEntry());
+    }
+
+    NodeEntry &entry = mNodes[node->mGraphId];
+    entry.node = node;
+    entry.generation = 0; // Force first build
+    return node->mGraphId;
+}
+
+bool CircuitGraph::needsRebuild(const NodeEntry &entry)
+{
+    return entry.generation != mGeneration ||
+            entry.epoch != entry.node->connectionsEpoch() ||
+            entry.rowCount != entry.node->getContactCount() * RowsPerContact + 1;
+}
+
+void CircuitGraph::buildNode(NodeEntry &entry)
+{
+    Table compiled;
+    compileNode(entry.node, compiled);
+    storeNode(entry, compiled);
+}
+
+void CircuitGraph::compileNode(AbstractCircuitNode *node, Table &compiled)
+{
+    compiled.node = node;
+    compiled.rows.clear();
+    compiled.edges.clear();
+
+    const int contactCount = node->getContactCount();
+    for(int contact = 0; contact < contactCount; contact++)
+    {
+        for(CircuitPole pole : {CircuitPole::First, CircuitPole::Second})
+        {
+            for(bool invertDir : {false, true})
+            {
+                Q_ASSERT(compiled.rows.size() == rowIndex(contact, pole, invertDir));
+                compiled.rows.append(compiled.edges.size());
+
+                CableItem source;
+                source.nodeContact = contact;
+                source.cable.pole = pole;
+
+                const Edges rowEdges = directConnections(node, source, invertDir);
+                compiled.edges.append(rowEdges.constData(), rowEdges.size());
+            }
+        }
+    }
+
+    compiled.rows.append(compiled.edges.size());
+}
+
+void CircuitGraph::storeNode(NodeEntry &entry, const Table &compiled)
+{
+    Q_ASSERT(entry.node == compiled.node);
+
+    mStats.nodeRebuilds++;
+
+    const auto& rows = compiled.rows;
+    const auto& edges = compiled.edges;
+
+    // Reuse previous space if possible
+    if(rows.size() != entry.rowCount)
+    {
+        mGarbageRows += entry.rowCount;
+        entry.firstRow = mRows.size();
+        entry.rowCount = rows.size();
+        mRows.resize(mRows.size() + rows.size());
+    }
+
+    if(edges.size() > entry.edgeCapacity)
+    {
+        mGarbageEdges += entry.edgeCapacity;
+        entry.firstEdge = mEdges.size();
+        entry.edgeCapacity = edges.size();
+        mEdges.resize(mEdges.size() + edges.size());
+    }
+
+    std::copy(rows.cbegin(), rows.cend(), mRows.begin() + entry.firstRow);
+    std::copy(edges.cbegin(), edges.cend(), mEdges.begin() + entry.firstEdge);
+
+    entry.epoch = compiled.node->connectionsEpoch();
+    entry.generation = mGeneration;
+
+    if(mGarbageEdges > MinGarbageToCompact && mGarbageEdges > edgeCount())
+        compact();
+    else if(mGarbageRows > MinGarbageToCompact && mGarbageRows > mRows.size() - mGarbageRows)
+        compact();
+}
+
+void CircuitGraph::compact()
+{
+    mStats.compactions++;
+
+    QVector<int> rows;
+    rows.reserve(mRows.size() - mGarbageRows);
+
+    QVector<Edge> edges;
+    edges.reserve(edgeCount());
+
+    for(NodeEntry &entry : mNodes)
+    {
+        if(!entry.node)
+            continue;
+
+        const int firstRow = rows.size();
+        for(int i = 0; i < entry.rowCount; i++)
+            rows.append(mRows.at(entry.firstRow + i));
+
+        const int firstEdge = edges.size();
+        for(int i = 0; i < entry.edgeCapacity; i++)
+            edges.append(mEdges.at(entry.firstEdge + i));
+
+        entry.firstRow = firstRow;
+        entry.firstEdge = firstEdge;
+    }
+
+    mRows = std::move(rows);
+    mEdges = std::move(edges);
+    mGarbageRows = 0;
+    mGarbageEdges = 0;
+}
+
+CircuitGraph::Edges CircuitGraph::directConnections(AbstractCircuitNode *node,
+                                                    const CableItem &source,
+                                                    bool invertDir)
+{
+    const auto connections = node->getActiveConnections(source, invertDir);
+
+    Edges result;
+    for(const CableItemFlags& conn : connections)
+    {
+        Edge edge;
+        static_cast<CableItemFlags&>(edge) = conn;
+
+        if(conn.cable.cable)
+            edge.otherEnd = conn.cable.cable->getNode(~conn.cable.side);
+
+        result.append(edge);
+    }
+
+    return result;
+}
@@ -0,0 +1,173 @@
+/**
+ * src/circuits/circuitgraph.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef CIRCUITGRAPH_H
+#define CIRCUITGRAPH_H
+
+#include "../enums/cabletypes.h"
+
+#include <QVarLengthArray>
+#include <QVector>
+
+class AbstractCircuitNode;
+class CircuitCable;
+
+/*!
+ * \brief The CircuitGraph class
+ *
+ * Compiled adjacency of circuit nodes, used by path search.
+ *
+ * Active connections of each node are stored in contiguous arrays
+ * (compressed sparse rows), one row per (contact, pole, direction).
+ * Every edge also stores the opposite end of its cable so that
+ * walking does not need to go through CircuitCable objects.
+ *
+ * Rows of a node are rebuilt lazily on first lookup after
+ * its connections epoch changed, see AbstractCircuitNode::markConnectionsChanged().
+ * Space of rebuilt nodes is reused if big enough, otherwise
+ * arrays are compacted when garbage exceeds live data.
+ */
+class CircuitGraph
+{
+public:
+    // One row for each pole and direction of every contact
+    static constexpr int RowsPerContact = 4;
+
+    static inline int rowIndex(int contact, CircuitPole pole, bool invertDir)
+    {
+        return contact * RowsPerContact + int(pole) * 2 + (invertDir ? 1 : 0);
+    }
+
+    struct Edge : CableItemFlags
+    {
+        // Node at opposite side of edge cable, if any
+        CableEnd otherEnd;
+    };
+
+    // Copied out so that lookups are not invalidated by rebuilds
+    typedef QVarLengthArray<Edge, 4> Edges;
+
+    typedef QVector<AbstractCircuitNode *> NodeList;
+
+    // All rows of one node, edge offsets of each row
+    // followed by end of last row
+    struct Table
+    {
+        AbstractCircuitNode *node = nullptr;
+        QVarLengthArray<int, 33> rows;
+        QVarLengthArray<Edge, 32> edges;
+
+        inline const Edge *rowBegin(int contact, CircuitPole pole, bool invertDir) const
+        {
+            return edges.constData() + rows.at(rowIndex(contact, pole, invertDir));
+        }
+
+        inline int rowSize(int contact, CircuitPole pole, bool invertDir) const
+        {
+            const int row = rowIndex(contact, pole, invertDir);
+            return rows.at(row + 1) - rows.at(row);
+        }
+    };
+
+    struct Stats
+    {
+        qint64 lookups = 0;
+        qint64 nodeRebuilds = 0;
+        qint64 compactions = 0;
+        qint64 parallelRebuilds = 0;
+    };
+
+    static Edges connections(AbstractCircuitNode *node,
+                             const CableItem& source,
+                             bool invertDir = false);
+
+    // When disabled, nodes are asked directly each time
+    static inline bool isEnabled() { return mEnabled; }
+    static void setEnabled(bool val);
+
+    // Node configuration might have changed, rebuild all nodes
+    static void invalidateAll();
+
+    // Rebuild stale nodes ahead of lookups.
+    // Groups are compiled on worker threads, one group never
+    // split between threads. Results are stored on calling thread.
+    static void compileNodes(const QVector<NodeList>& groups);
+
+    // Bulk query, copies tables of all nodes rebuilding stale ones first
+    static void nodeTables(const NodeList& nodes, QVector<Table>& tables);
+
+    static void cableEndChanged(CircuitCable *cable, CableSide side);
+    static void removeNode(AbstractCircuitNode *node);
+
+    // Changes when cables are connected or nodes removed
+    static inline quint64 topologyEpoch() { return mTopologyEpoch; }
+
+    static inline const Stats& stats() { return mStats; }
+    static void resetStats();
+
+    static inline int nodeCount() { return mNodes.size() - mFreeIds.size(); }
+    static inline int edgeCount() { return mEdges.size() - mGarbageEdges; }
+
+private:
+    struct NodeEntry
+    {
+        AbstractCircuitNode *node = nullptr;
+        quint64 epoch = 0;
+        quint64 generation = 0;
+
+        // Rows store edge offsets relative to firstEdge
+        // and have an extra element to end last row
+        int firstRow = 0;
+        int rowCount = 0;
+        int firstEdge = 0;
+        int edgeCapacity = 0;
+    };
+
+    static int nodeId(AbstractCircuitNode *node);
+    static bool needsRebuild(const NodeEntry& entry);
+    static void buildNode(NodeEntry& entry);
+    static void compact();
+
+    // Only reads node state, safe to call from worker threads
+    static void compileNode(AbstractCircuitNode *node, Table& compiled);
+    static void storeNode(NodeEntry& entry, const Table& compiled);
+
+    static Edges directConnections(AbstractCircuitNode *node,
+                                   const CableItem& source,
+                                   bool invertDir);
+
+private:
+    static QVector<NodeEntry> mNodes;
+    static QVector<int> mFreeIds;
+
+    static QVector<int> mRows;
+    static QVector<Edge> mEdges;
+    static int mGarbageRows;
+    static int mGarbageEdges;
+
+    static quint64 mGeneration;
+    static quint64 mTopologyEpoch;
+    static bool mEnabled;
+    static Stats mStats;
+};
+
+#endif // CIRCUITGRAPH_H
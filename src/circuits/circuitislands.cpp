@@ -0,0 +1,131 @@
+/**
+ * src/circuits/circuitislands.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "circuitislands.h"
+
+#include "circuitgraph.h"
+
+#include "nodes/abstractcircuitnode.h"
+#include "nodes/circuitcable.h"
+
+#include <QHash>
+
+QVector<CircuitIslands::Island> CircuitIslands::mIslands;
+CircuitIslands::NodeList CircuitIslands::mCachedSources;
+quint64 CircuitIslands::mCachedEpoch = 0;
+bool CircuitIslands::mParallelEnabled = true;
+
+const QVector<CircuitIslands::Island> &CircuitIslands::findIslands(const NodeList &sources)
+{
+    if(mCachedEpoch == CircuitGraph::topologyEpoch() && mCachedSources == sources)
+        return mIslands;
+
+    mIslands.clear();
+    mCachedSources = sources;
+    mCachedEpoch = CircuitGraph::topologyEpoch();
+
+    QHash<AbstractCircuitNode *, int> islandOf;
+    NodeList queue;
+
+    for(AbstractCircuitNode *source : sources)
+    {
+        auto it = islandOf.constFind(source);
+        if(it != islandOf.constEnd())
+        {
+            // Reached by a previous source
+            mIslands[it.value()].sources.append(source);
+            continue;
+        }
+
+        const int islandIdx = mIslands.size();
+        mIslands.append(Island());
+
+        Island &island = mIslands.last();
+        island.sources.append(source);
+
+        // Breadth first visit, all contacts of a node
+        // are considered connected to each other
+        islandOf.insert(source, islandIdx);
+        queue.append(source);
+
+        while(!queue.isEmpty())
+        {
+            AbstractCircuitNode *node = queue.takeLast();
+            island.nodes.append(node);
+
+            for(const AbstractCircuitNode::NodeContact& contact : node->getContacts())
+            {
+                if(!contact.cable)
+                    continue;
+
+                AbstractCircuitNode *other = contact.cable->getNode(~contact.cableSide).node;
+                if(!other || islandOf.contains(other))
+                    continue;
+
+                islandOf.insert(other, islandIdx);
+                queue.append(other);
+            }
+        }
+    }
+
+    return mIslands;
+}
+
+void CircuitIslands::setSourcesEnabled(const NodeList &sources, bool enabled)
+{
+    if(!enabled || !mParallelEnabled)
+    {
+        for(AbstractCircuitNode *source : sources)
+            source->setSourceEnabled(enabled);
+        return;
+    }
+
+    const QVector<Island> islands = findIslands(sources);
+
+    if(CircuitGraph::isEnabled())
+    {
+        QVector<CircuitGraph::NodeList> groups;
+        groups.reserve(islands.size());
+        for(const Island& island : islands)
+            groups.append(island.nodes);
+
+        CircuitGraph::compileNodes(groups);
+    }
+
+    // Enabling sources can create and destroy circuits
+    // so islands are solved on main thread
+    for(const Island& island : islands)
+    {
+        for(AbstractCircuitNode *source : island.sources)
+            source->setSourceEnabled(true);
+    }
+}
+
+void CircuitIslands::clearCache()
+{
+    mIslands.clear();
+    mIslands.squeeze();
+    mCachedSources.clear();
+    mCachedSources.squeeze();
+    mCachedEpoch = 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * src/circuits/circuitislands.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef CIRCUITISLANDS_H
+#define CIRCUITISLANDS_H
+
+#include <QVector>
+
+class AbstractCircuitNode;
+
+/*!
+ * \brief The CircuitIslands class
+ *
+ * Splits circuit nodes in electrically independent islands,
+ * that is groups of nodes connected by cables.
+ * Islands only change when cables are edited so they are cached
+ * until CircuitGraph::topologyEpoch() changes.
+ *
+ * When many sources are enabled together, connections of all islands
+ * are compiled in parallel and then sources are enabled island by island.
+ */
+class CircuitIslands
+{
+public:
+    typedef QVector<AbstractCircuitNode *> NodeList;
+
+    struct Island
+    {
+        NodeList sources;
+        NodeList nodes;
+    };
+
+    static const QVector<Island>& findIslands(const NodeList& sources);
+
+    static void setSourcesEnabled(const NodeList& sources, bool enabled);
+
+    // When disabled, sources are enabled one by one without precompiling
+    static inline bool isParallelEnabled() { return mParallelEnabled; }
+    static inline void setParallelEnabled(bool val) { mParallelEnabled = val; }
+
+    static void clearCache();
+
+private:
+    static QVector<Island> mIslands;
+    static NodeList mCachedSources;
+    static quint64 mCachedEpoch;
+    static bool mParallelEnabled;
+};
+
+#endif // CIRCUITISLANDS_H
@@ -24,6 +24,7 @@
 
 #include "view/circuitlistmodel.h"
 #include "../views/modemanager.h"
+#include "../views/guimodefrontend.h"
 
 #include "graphs/abstractnodegraphitem.h"
 #include "graphs/cablegraphitem.h"
@@ -32,11 +33,11 @@
 
 #include "../objects/simulationobjectcopyhelper.h"
 
+#include "../utils/phasereport.h"
+
 #include <QGraphicsPathItem>
 #include <QPen>
 
-#include <unordered_set>
-
 #include <QKeyEvent>
 #include <QGraphicsSceneMouseEvent>
 
@@ -49,118 +50,20 @@
 
 #include <QGuiApplication>
 
-#include "edit/nodeeditfactory.h"
+#include <QTimerEvent>
+#include <QElapsedTimer>
 
-template <typename Func>
-bool spiral_helper(const TileLocation& origin,
-                   TileLocation &outTile,
-                   Func func)
-{
-    // Loop in a square spiral around origin
-    // For each tile, func is called
-    // If func returns true, looping is stopped
-    const int N = 1000;
-    int16_t x = 0;
-    int16_t y = 0;
-    for(int i = 0; i < N; ++i)
-    {
-        const TileLocation tile = origin.adjusted(x, y);
-        if(func(tile))
-        {
-            outTile = tile;
-            return true;
-        }
-
-        if(std::abs(x) <= std::abs(y) && (x != y || x >= 0))
-            x += ((y >= 0) ? 1 : -1);
-        else
-            y += ((x >= 0) ? -1 : 1);
-    }
-
-    return false;
-}
-
-template <typename TileHasNode, typename GetCablePairAt>
-bool cablePathIsValid_helper(const CableGraphPath &cablePath,
-                             TileHasNode hasNode, GetCablePairAt getCablePairAt)
-{
-    // Check all tiles are free
-    if(cablePath.isZeroLength())
-        return true;
-
-    std::unordered_set<TileLocation, TileLocationHash> repeatedTiles;
-
-    for(int i = 0; i < cablePath.getTilesCount(); i++)
-    {
-        TileLocation tile = cablePath.at(i);
-
-        if(hasNode(tile))
-        {
-            return false;
-        }
-
-        CircuitScene::TileCablePathPair pair = getCablePairAt(tile);
-
-        if(!pair.first && !pair.second)
-        {
-            // Tile is free, check next one
-            repeatedTiles.insert(tile);
-            continue;
-        }
-
-        if(pair.first && pair.second)
-        {
-            // There are already 2 cables on this tile
-            return false;
-        }
-
-        // At this point tile has 1 cable, either first or second
-        if(repeatedTiles.find(tile) != repeatedTiles.cend())
-        {
-            // Cable passes 2 times on same tile
-            // Then this tile cannot have other cables
-            return false;
-        }
-        repeatedTiles.insert(tile);
-
-        // Check if other cable can co-exist with us in same tile
-        const CableGraphPath& otherPath = pair.first ? pair.first.value() : pair.second.value();
-        int otherIdx = otherPath.tiles().indexOf(tile);
-        Q_ASSERT_X(otherIdx >= 0,
-                   "cablePathIsValid_helper",
-                   "other cable does not contain tile");
-
-        const bool isLastTile = i == cablePath.getTilesCount() - 1;
-        const bool canCheckExit = !isLastTile || cablePath.isComplete();
-
-        // Check if first passage was straigh
-        const auto enterDir1 = cablePath.getEnterDirection(i);
-        const auto exitDir1 = cablePath.getExitDirection(i);
-        if(canCheckExit && enterDir1 != ~exitDir1)
-        {
-            // Directions are not opposite, it bends
-            return false;
-        }
-
-        const auto enterDir2 = otherPath.getEnterDirection(otherIdx);
-        const auto exitDir2 = otherPath.getExitDirection(otherIdx);
-        if(enterDir2 != ~exitDir2)
-        {
-            // Directions are not opposite, it bends
-            return false;
-        }
-
-        if(enterDir1 == enterDir2 || enterDir1 == exitDir2)
-            return false; // Both passages have same direction
-    }
+#include "edit/nodeeditfactory.h"
 
-    return true;
-}
+// Keep graphics of recently hidden scenes, user might switch back
+static constexpr int ReleaseGraphicsDelayMillis = 2 * 60 * 1000;
 
 CircuitScene::CircuitScene(CircuitListModel *parent)
     : QGraphicsScene{parent}
+    , CircuitSheetLayout(parent->modeMgr(), this)
 {
-
+    // Index is built when scene is first shown
+    setItemIndexMethod(QGraphicsScene::NoIndex);
 }
 
 CircuitScene::~CircuitScene()
@@ -185,13 +88,9 @@ void CircuitScene::setMode(FileMode newMode, FileMode oldMode)
         // Recalculate circuit
         calculateConnections();
 
-        // Cut scene rect to items bounding rect
-        QRectF br = itemsBoundingRect();
-
-        // Add some margin
-        br.adjust(-TileLocation::HalfSize, -TileLocation::HalfSize,
-                  TileLocation::HalfSize, TileLocation::HalfSize);
-        setSceneRect(br);
+        // Otherwise done when graphics are loaded
+        if(mGraphicsLoaded)
+            fitSceneRectToItems();
     }
 
     if(newMode == FileMode::Editing)
@@ -200,10 +99,13 @@ void CircuitScene::setMode(FileMode newMode, FileMode oldMode)
         setSceneRect(QRectF());
     }
 
-    const bool powerSourceEnabled = newMode == FileMode::Simulation;
-    for(AbstractCircuitNode *powerSource : std::as_const(mPowerSources))
+    // Sources of all scenes are enabled together by CircuitListModel
+    if(newMode != FileMode::Simulation)
     {
-        powerSource->setSourceEnabled(powerSourceEnabled);
+        for(AbstractCircuitNode *powerSource : powerSources())
+        {
+            powerSource->setSourceEnabled(false);
+        }
     }
 
     // Background changes between modes
@@ -216,25 +118,16 @@ void CircuitScene::addNode(AbstractNodeGraphItem *item)
 
     modeMgr()->setEditingSubMode(EditingSubMode::Default);
 
-    if(!isLocationFree(item->location()))
-    {
-        // Assign a new location to node
-        item->setLocation(getFreeLocationNear(item->location()));
-    }
+    // Node might be moved to a free location
+    AbstractCircuitNode *node = item->getAbstractNode();
+    insertNode(node, item->location(), item->rotate());
+    item->setLocation(nodePlacement(node).location);
 
-    mItemMap.insert({item->location(), item});
+    mNodeGraphs.insert({node, item});
 
     // Add item after having inserted it in the map
     addItem(item);
 
-    AbstractCircuitNode *node = item->getAbstractNode();
-
-    if(node->isSourceNode(false))
-    {
-        node->setSourceEnabled(false);
-        mPowerSources.append(node);
-    }
-
     setHasUnsavedChanges(true);
 }
 
@@ -243,712 +136,86 @@ void CircuitScene::removeNode(AbstractNodeGraphItem *item)
     if(item == itemBeingMoved())
         endMovingItem();
 
-    Q_ASSERT_X(getNodeAt(item->location()) == item,
+    AbstractCircuitNode *node = item->getAbstractNode();
+
+    Q_ASSERT_X(getNodeAt(nodePlacement(node).location) == item,
                "removeNode", "item location is not in item map");
 
     removeItem(item);
-    mItemMap.erase(item->location());
-
-    AbstractCircuitNode *node = item->getAbstractNode();
-
-    if(node->isSourceNode(false))
-    {
-        node->setSourceEnabled(false);
-        mPowerSources.removeOne(node);
-    }
+    mNodeGraphs.erase(node);
 
     delete item;
-    delete node;
+    deleteNode(node);
 
     setHasUnsavedChanges(true);
 }
 
-void CircuitScene::addCable(CableGraphItem *item)
-{
-    modeMgr()->setEditingSubMode(EditingSubMode::Default);
-
-    Q_ASSERT(item->cable());
-
-    if(!cablePathIsValid(item->cablePath(), nullptr))
-        return; // TODO: error
-
-    addItem(item);
-    mCables.insert({item->cable(), item});
-
-    // Add cable tiles
-    addCableTiles(item);
-
-    if(item->validNotZero())
-        setHasUnsavedChanges(true);
-}
-
 void CircuitScene::removeCable(CircuitCable *cable)
 {
-    bool zeroLength = false;
-
-    auto it = mCables.find(cable);
-    if(it != mCables.end())
-    {
-        // Delete graph item
-        CableGraphItem *item = it->second;
-        mCables.erase(it);
-
-        zeroLength = item->cableZeroLength();
-
-        removeCableTiles(item);
-
-        if(item == mEditingCable)
-            endEditCable(false);
-
-        delete item;
-    }
-
-    delete cable;
-
-    if(!zeroLength)
-        setHasUnsavedChanges(true);
+    deleteCable(cable);
 }
 
 CableGraphItem *CircuitScene::graphForCable(CircuitCable *cable) const
 {
-    auto it = mCables.find(cable);
-    if(it == mCables.end())
+    auto it = mCableGraphs.find(cable);
+    if(it == mCableGraphs.end())
         return nullptr;
     return it->second;
 }
 
-TileLocation CircuitScene::getFreeLocationNear(TileLocation origin)
-{
-    if(!origin.isValid())
-        origin = {0, 0};
-
-    TileLocation result = TileLocation::invalid;
-    bool success = spiral_helper(origin, result, [this](const TileLocation& tile)
-    {
-        return isLocationFree(tile);
-    });
-
-    if(success)
-        return result;
-
-    return TileLocation::invalid;
-}
-
-bool CircuitScene::isLocationFree(TileLocation l) const
-{
-    if(getItemAt(l))
-        return false;
-
-    auto pair = getCablesAt(l);
-    if(pair.first || pair.second)
-        return false;
-
-    return true;
-}
-
 AbstractNodeGraphItem *CircuitScene::getNodeAt(TileLocation l) const
 {
-    auto it = mItemMap.find(l);
-    if(it == mItemMap.cend())
+    AbstractCircuitNode *node = nodeAt(l);
+    if(!node)
         return nullptr;
-    return it->second;
+    return getGraphForNode(node);
 }
 
-CircuitScene::TileCablePair CircuitScene::getCablesAt(TileLocation l) const
+CircuitScene::TileCableGraphPair CircuitScene::getCablesAt(TileLocation l) const
 {
-    auto it = mCableTiles.find(l);
-    if(it == mCableTiles.cend())
-        return {nullptr, nullptr};
-    return it->second;
-}
-
-bool CircuitScene::cablePathIsValid(const CableGraphPath &cablePath, CableGraphItem *item) const
-{
-    auto hasNode = [this](const TileLocation& tile) -> bool
-    {
-        return getItemAt(tile) != nullptr;
-    };
-
-    auto getCablePairAt = [this, item](const TileLocation& tile) -> TileCablePathPair
-    {
-        const TileCablePair cablePair = getCablesAt(tile);
-
-        TileCablePathPair pathPair;
-
-        // Do not consider ourselves
-        if(cablePair.first && cablePair.first != item)
-            pathPair.first = cablePair.first->cablePath();
-        if(cablePair.second && cablePair.second != item)
-            pathPair.second = cablePair.second->cablePath();
-
-        return pathPair;
-    };
-
-    return cablePathIsValid_helper(cablePath, hasNode, getCablePairAt);
-}
-
-bool CircuitScene::updateItemLocation(TileLocation newLocation, AbstractNodeGraphItem *item)
-{
-    // Only current moving item can pass (temporarily)
-    // on occupied locations to allow jump them
-    bool allowed = isLocationFree(newLocation);
-    if(!allowed)
-    {
-        if(mItemBeingMoved != item)
-            return false;
-
-        // Fake allowing invalid move for currently moving item.
-        // We do not update the map so it will be reverted
-        // to it's last valid position on move end.
-        return true;
-    }
-
-    // For untracked items, use last location
-    TileLocation oldLocation = item->location();
-
-    if(mItemBeingMoved == item)
-    {
-        // For moved items use last valid location
-        // to remove old map entry
-        oldLocation = mLastMovedItemValidLocation;
+    const TileCablePair pair = cablesAt(l);
 
-        // Store location to revert future invalid moves
-        mLastMovedItemValidLocation = newLocation;
-    }
-
-    Q_ASSERT_X(getItemAt(oldLocation) == item,
-               "updateItemLocation", "Item old location is not in map");
-
-    // Update location in map
-    mItemMap.erase(oldLocation);
-    mItemMap.insert({newLocation, item});
-
-    setHasUnsavedChanges(true);
-
-    return true;
-}
-
-void CircuitScene::calculateConnections()
-{
-    QVector<CircuitCable *> verifiedCables;
-
-    auto cableCopy = mCables;
-    for(const auto& it : cableCopy)
-    {
-        CableGraphItem *item = it.second;
-        if(checkCable(item))
-        {
-            verifiedCables.append(item->cable());
-        }
-        else
-        {
-            if(!item->validNotZero())
-            {
-                // Unconnected zero length cable, delete it
-                removeCable(item->cable());
-            }
-        }
-    }
-
-    for(const auto& it : mItemMap)
-    {
-        AbstractNodeGraphItem *item = it.second;
-        checkItem(item, verifiedCables);
-    }
-
-    // Delete unconnected zero length cables and empty cables
-    // Copy to avoid invalidating iterators while looping
-    cableCopy = mCables;
-    for(auto it = cableCopy.begin(); it != cableCopy.end(); it++)
-    {
-        CableGraphItem *item = it->second;
-        if(item->cableZeroLength() && verifiedCables.contains(item->cable()))
-            continue;
-
-        if(!item->validNotZero())
-        {
-            removeCable(item->cable());
-        }
-    }
-}
-
-void CircuitScene::connectItems(AbstractCircuitNode *node1, AbstractCircuitNode *node2, const Connector &c1, const Connector &c2, QVector<CircuitCable *> &verifiedCables)
-{
-    const auto& contacts1 = node1->getContacts();
-    const auto& contacts2 = node2->getContacts();
-
-    CircuitCable *cableA = contacts1.at(c1.nodeContact).cable;
-
-    if(!cableA || !verifiedCables.contains(cableA))
-    {
-        CircuitCable *cableB = contacts2.at(c2.nodeContact).cable;
-        if(cableB != cableA || !cableB)
-        {
-            if(cableA)
-            {
-                node1->detachCable(c1.nodeContact);
-
-                auto item = graphForCable(cableA);
-                if(!item || !item->validNotZero())
-                {
-                    removeCable(cableA);
-                    cableA = nullptr;
-                }
-            }
-
-            if(cableB)
-            {
-                node2->detachCable(c2.nodeContact);
-
-                auto item = graphForCable(cableB);
-                if(!item || !item->validNotZero())
-                {
-                    removeCable(cableB);
-                    cableB = nullptr;
-                }
-            }
-
-            CircuitCable *newCable = new CircuitCable(circuitsModel()->modeMgr(), this);
-
-            // First we set graph path
-            CableGraphItem *item = new CableGraphItem(newCable);
-            item->setPos(0, 0);
-            item->setCablePath(CableGraphPath::createZeroLength(c1.location,
-                                                                c2.location));
-
-            // Then we create cable connection
-            CableItem cableItem;
-            cableItem.cable.cable = newCable;
-            cableItem.cable.side = CableSide::A;
-            cableItem.nodeContact = c1.nodeContact;
-            cableItem.cable.pole = CircuitPole::First;
-            node1->attachCable(cableItem);
-
-            cableItem.cable.pole = CircuitPole::Second;
-            node1->attachCable(cableItem);
-
-            cableItem.cable.side = CableSide::B;
-            cableItem.nodeContact = c2.nodeContact;
-            cableItem.cable.pole = CircuitPole::First;
-            node2->attachCable(cableItem);
-
-            cableItem.cable.pole = CircuitPole::Second;
-            node2->attachCable(cableItem);
-
-            cableA = newCable;
-            verifiedCables.append(cableA);
-
-            addCable(item);
-        }
-    }
-}
-
-bool CircuitScene::checkCable(CableGraphItem *item)
-{
-    if(item->sideA() == TileLocation::invalid || item->sideB() == TileLocation::invalid)
-        return false;
-
-    TileLocation nodeLocA = item->sideA();
-    TileLocation nodeLocB = item->sideB();
-
-    AbstractNodeGraphItem *itemA = getItemAt(nodeLocA);
-    AbstractNodeGraphItem *itemB = getItemAt(nodeLocB);
-
-    if(item->validNotZero())
-    {
-        // If there is no node next to us,
-        // check if there are other cables to merge with
-        if(!itemA)
-        {
-            const TileCablePair pair = getCablesAt(nodeLocA);
-
-            CableGraphPath merged;
-            CableGraphItem *other = nullptr;
-
-            if(pair.first)
-            {
-                merged = item->cablePath().tryMerge(pair.first->cablePath());
-                other = pair.first;
-            }
-            if(merged.isEmpty() && pair.second)
-            {
-                merged = item->cablePath().tryMerge(pair.second->cablePath());
-                other = pair.second;
-            }
-
-            if(!merged.isEmpty())
-            {
-                // We cannot delete other cable because
-                // this function is called iterating cable list
-                // so we set it to empty path and it will be garbage collected
-                other->setCablePath(CableGraphPath{});
-
-                // Set our path to merged
-                item->setCablePath(merged);
-
-                // Retry searching nodes
-                nodeLocA = item->sideA();
-                itemA = getItemAt(nodeLocA);
-            }
-        }
-
-        if(!itemB)
-        {
-            const TileCablePair pair = getCablesAt(nodeLocB);
-
-            CableGraphPath merged;
-            CableGraphItem *other = nullptr;
-
-            if(pair.first)
-            {
-                merged = item->cablePath().tryMerge(pair.first->cablePath());
-                other = pair.first;
-            }
-            if(merged.isEmpty() && pair.second)
-            {
-                merged = item->cablePath().tryMerge(pair.second->cablePath());
-                other = pair.second;
-            }
-
-            if(!merged.isEmpty())
-            {
-                // We cannot delete other cable because
-                // this function is called iterating cable list
-                // so we set it to empty path and it will be garbage collected
-                other->setCablePath(CableGraphPath{});
-
-                // Set our path to merged
-                item->setCablePath(merged);
-
-                // Retry searching nodes
-                nodeLocB = item->sideB();
-                itemB = getItemAt(nodeLocB);
-            }
-        }
-    }
-
-    AbstractCircuitNode *nodeA = itemA ? itemA->getAbstractNode() : nullptr;
-    AbstractCircuitNode *nodeB = itemB ? itemB->getAbstractNode() : nullptr;
-
-    CircuitCable *cable = item->cable();
-
-    std::vector<Connector> connectorsA;
-    std::vector<Connector> connectorsB;
-
-    std::vector<Connector>::const_iterator connA = connectorsA.cend();
-    std::vector<Connector>::const_iterator connB = connectorsB.cend();
-
-    if(itemA)
-    {
-        itemA->getConnectors(connectorsA);
-
-        connA = std::find_if(connectorsA.cbegin(), connectorsA.cend(),
-                             [item](const Connector& c)
-        {
-            return c.direction == ~item->directionA();
-        });
-    }
-
-    if(itemB)
-    {
-        itemB->getConnectors(connectorsB);
-
-        connB = std::find_if(connectorsB.cbegin(), connectorsB.cend(),
-                             [item](const Connector& c)
-        {
-            return c.direction == ~item->directionB();
-        });
-    }
-
-    if(!nodeA || connA == connectorsA.cend())
-    {
-        // Detach side A
-        CableEnd end = cable->getNode(CableSide::A);
-        if(end.node)
-        {
-            end.node->detachCable(end.nodeContact);
-        }
-
-        nodeA = nullptr;
-    }
-
-    if(!nodeB || connB == connectorsB.cend())
-    {
-        // Detach side B
-        CableEnd end = cable->getNode(CableSide::B);
-        if(end.node)
-        {
-            end.node->detachCable(end.nodeContact);
-        }
-
-        nodeB = nullptr;
-    }
-
-    bool sideConnectedA = false;
-    if(nodeA)
-    {
-        const auto& contactA = nodeA->getContacts().at(connA->nodeContact);
-
-        if(contactA.cable == item->cable() && contactA.cableSide == CableSide::B)
-        {
-            // We have a swapped cable, detach and let it rewire later
-            CableEnd end = cable->getNode(CableSide::A);
-            if(end.node)
-            {
-                end.node->detachCable(end.nodeContact);
-            }
-
-            end = cable->getNode(CableSide::B);
-            if(end.node)
-            {
-                end.node->detachCable(end.nodeContact);
-            }
-        }
-
-        if(contactA.cable == item->cable())
-        {
-            sideConnectedA = true;
-        }
-        else if(!contactA.cable && !item->cable()->getNode(CableSide::A).node)
-        {
-            // Make the connection
-            CableItem cableItem;
-            cableItem.cable.cable = item->cable();
-            cableItem.cable.side = CableSide::A;
-            cableItem.nodeContact = connA->nodeContact;
-            cableItem.cable.pole = CircuitPole::First;
-            nodeA->attachCable(cableItem);
-
-            cableItem.cable.pole = CircuitPole::Second;
-            nodeA->attachCable(cableItem);
-
-            sideConnectedA = true;
-        }
-    }
-
-    bool sideConnectedB = false;
-    if(nodeB)
-    {
-        const auto& contactB = nodeB->getContacts().at(connB->nodeContact);
-
-        if(contactB.cable == item->cable())
-        {
-            sideConnectedB = true;
-        }
-        else if(!contactB.cable && !item->cable()->getNode(CableSide::B).node)
-        {
-            // Make the connection
-            CableItem cableItem;
-            cableItem.cable.cable = item->cable();
-            cableItem.cable.side = CableSide::B;
-            cableItem.nodeContact = connB->nodeContact;
-            cableItem.cable.pole = CircuitPole::First;
-            nodeB->attachCable(cableItem);
-
-            cableItem.cable.pole = CircuitPole::Second;
-            nodeB->attachCable(cableItem);
-
-            sideConnectedB = true;
-        }
-    }
-
-    return sideConnectedA && sideConnectedB;
-}
-
-void CircuitScene::checkItem(AbstractNodeGraphItem *item, QVector<CircuitCable *> &verifiedCables)
-{
-    const TileLocation location = item->location();
-
-    AbstractCircuitNode *node1 = item->getAbstractNode();
-    if(!node1)
-        return;
-
-    std::vector<Connector> connectors;
-    item->getConnectors(connectors);
-
-    for(const Connector& c1 : connectors)
-    {
-        const TileLocation otherLocation = location + c1.direction;
-        AbstractNodeGraphItem *other = getItemAt(otherLocation);
-        AbstractCircuitNode *node2 = other ? other->getAbstractNode() : nullptr;
-
-        auto cableA = node1->getContacts().at(c1.nodeContact).cable;
-
-        if(!node2)
-        {
-            // Detach our cable if zero length
-            if(cableA && !verifiedCables.contains(cableA))
-            {
-                auto cableGraphA = graphForCable(cableA);
-                if(!cableGraphA || !cableGraphA->validNotZero())
-                {
-                    node1->detachCable(c1.nodeContact);
-                    removeCable(cableA);
-                    cableA = nullptr;
-                }
-            }
-
-            if(cableA)
-                continue; // Already connected
-
-            // There is no other node adjacent to us
-            // And we are not connected to a cable
-            // Let's see if there is a cable in the next tile
-            CableGraphItem *cableGraph = nullptr;
-            TileCablePair pair = getCablesAt(otherLocation);
-            if(pair.first)
-            {
-                if(pair.first->sideA() == location)
-                {
-                    if(pair.first->directionA() == ~c1.direction)
-                    {
-                        cableGraph = pair.first;
-                    }
-                }
-                else if(pair.first->sideB() == location)
-                {
-                    if(pair.first->directionB() == ~c1.direction)
-                    {
-                        cableGraph = pair.first;
-                    }
-                }
-            }
-
-            if(!cableGraph && pair.second)
-            {
-                if(pair.second->sideA() == location)
-                {
-                    if(pair.second->directionA() == ~c1.direction)
-                    {
-                        cableGraph = pair.first;
-                    }
-                }
-                else if(pair.second->sideB() == location)
-                {
-                    if(pair.second->directionB() == ~c1.direction)
-                    {
-                        cableGraph = pair.first;
-                    }
-                }
-            }
-
-            // We found a suitable cable, check it
-            if(cableGraph)
-                checkCable(cableGraph);
-
-            continue;
-        }
-
-        std::vector<Connector> otherConnectors;
-        other->getConnectors(otherConnectors);
-
-        for(const Connector& c2 : otherConnectors)
-        {
-            if(c2.direction != ~c1.direction)
-                continue;
-
-            // We have a match
-
-            if(!node1 || !node2)
-                break;
-
-            connectItems(node1, node2, c1, c2, verifiedCables);
-            break;
-        }
-    }
-}
-
-bool CircuitScene::splitCableAt(CableGraphItem *item, const TileLocation& splitLoc)
-{
-    CableGraphPath::SplitPair pathResult;
-    if(!item->cablePath().splitted(splitLoc, pathResult))
-        return false;
-
-    // Set original cable path to new splitted half
-    bool firstEmpty = pathResult.first.isEmpty();
-    bool secondEmpty = pathResult.second.isEmpty();
-
-    if(firstEmpty && secondEmpty)
-    {
-        // Cable was only 1 tile long, remove it
-        removeCable(item->cable());
-        return true;
-    }
-
-    // Set original cable to non-empty half
-    item->setCablePath(firstEmpty ? pathResult.second : pathResult.first);
-    checkCable(item);
-
-    if(firstEmpty)
-        return true; // Only one half was left
-
-    // Create new cable for second half
-    CircuitCable *otherCable = new CircuitCable(circuitsModel()->modeMgr(), this);
-    CableGraphItem *otherItem = new CableGraphItem(otherCable);
-    otherItem->setPos(0, 0);
-
-    otherItem->setCablePath(pathResult.second);
-
-    // Register and check new cable
-    addCable(otherItem);
-    checkCable(otherItem);
-
-    return true;
-}
-
-void CircuitScene::addCableTiles(CableGraphItem *item)
-{
-    if(!item->validNotZero())
-        return;
-
-    for(int i = 0; i < item->cablePath().getTilesCount(); i++)
-    {
-        TileLocation tile = item->cablePath().at(i);
-
-        auto it = mCableTiles.find(tile);
-        if(it == mCableTiles.end())
-        {
-            TileCablePair pair;
-            pair.first = item;
-            pair.second = nullptr;
-            mCableTiles.insert({tile, pair});
-        }
-        else
-        {
-            TileCablePair &pair = it->second;
-            if(pair.first)
-                pair.second = item;
-            else
-                pair.first = item;
-        }
-    }
+    TileCableGraphPair result{nullptr, nullptr};
+    if(pair.first)
+        result.first = graphForCable(pair.first);
+    if(pair.second)
+        result.second = graphForCable(pair.second);
+    return result;
 }
 
-void CircuitScene::removeCableTiles(CableGraphItem *item)
+bool CircuitScene::updateItemLocation(TileLocation newLocation, AbstractNodeGraphItem *item)
 {
-    if(!item->validNotZero())
-        return;
+    // Only current moving item can pass (temporarily)
+    // on occupied locations to allow jump them
+    bool allowed = isLocationFree(newLocation);
+    if(!allowed)
+    {
+        if(mItemBeingMoved != item)
+            return false;
+
+        // Fake allowing invalid move for currently moving item.
+        // We do not update the map so it will be reverted
+        // to it's last valid position on move end.
+        return true;
+    }
 
-    for(int i = 0; i < item->cablePath().getTilesCount(); i++)
+    if(mItemBeingMoved == item)
     {
-        TileLocation tile = item->cablePath().at(i);
+        // Store location to revert future invalid moves
+        mLastMovedItemValidLocation = newLocation;
+    }
 
-        auto it = mCableTiles.find(tile);
-        Q_ASSERT_X(it != mCableTiles.end(),
-                   "removeCableTiles", "unknown tile");
+    // Update location in map
+    moveNodes({{item->getAbstractNode(), newLocation}});
 
-        TileCablePair &pair = it->second;
-        Q_ASSERT_X(pair.first == item || pair.second == item,
-                   "removeCableTiles", "cable not registered");
+    setHasUnsavedChanges(true);
 
-        if(pair.first == item)
-            pair.first = nullptr;
-        else
-            pair.second = nullptr;
+    return true;
+}
 
-        if(!pair.first && !pair.second)
-            mCableTiles.erase(it); // No more cables on this tile
-    }
+bool CircuitScene::splitCableAt(CableGraphItem *item, const TileLocation& splitLoc)
+{
+    return splitCable(item->cable(), splitLoc);
 }
 
 void CircuitScene::editCableUpdatePen()
@@ -1020,7 +287,7 @@ void CircuitScene::endMovingItem()
     if(shiftPressed && possibleNewLocation != lastValidLocation)
     {
         // If shift is pressed and node is on a cable, split the cable
-        auto otherNode = getNodeAt(possibleNewLocation);
+        auto otherNode = nodeAt(possibleNewLocation);
         TileCablePair pair;
 
         bool canSplitCables = true;
@@ -1034,18 +301,18 @@ void CircuitScene::endMovingItem()
 
         if(canSplitCables)
         {
-            pair = getCablesAt(possibleNewLocation);
+            pair = cablesAt(possibleNewLocation);
 
             if(pair.first)
             {
-                if(!splitCableAt(pair.first, possibleNewLocation))
+                if(!splitCable(pair.first, possibleNewLocation))
                     canSplitCables = false;
             }
         }
 
         if(canSplitCables && pair.second)
         {
-            if(!splitCableAt(pair.second, possibleNewLocation))
+            if(!splitCable(pair.second, possibleNewLocation))
                 canSplitCables = false;
         }
 
@@ -1133,13 +400,13 @@ void CircuitScene::endItemSelection()
 
 void CircuitScene::allowItemSelection(bool enabled)
 {
-    for(const auto& it : mCables)
+    for(const auto& it : mCableGraphs)
     {
         CableGraphItem *item = it.second;
         item->setFlag(QGraphicsItem::ItemIsSelectable, enabled);
     }
 
-    for(const auto& it : mItemMap)
+    for(const auto& it : mNodeGraphs)
     {
         AbstractNodeGraphItem *item = it.second;
         item->setFlag(QGraphicsItem::ItemIsSelectable, enabled);
@@ -1154,7 +421,7 @@ void CircuitScene::onItemSelected(AbstractNodeGraphItem *item, bool value)
     if(value)
     {
         const TileLocation tile = item->location();
-        Q_ASSERT_X(getItemAt(tile) == item, "onItemSelected",
+        Q_ASSERT_X(getNodeAt(tile) == item, "onItemSelected",
                    "Item location is not registered");
 
         mSelectedItemPositions.insert({item, tile});
@@ -1203,7 +470,7 @@ void CircuitScene::onCableSelected(CableGraphItem *item, bool value)
                 const int16_t dx = lastValidLocation.x - firstTile.x;
                 const int16_t dy = lastValidLocation.y - firstTile.y;
                 CableGraphPath translated = item->cablePath().translatedBy(dx, dy);
-                item->setCablePath(translated);
+                setCablePath(item->cable(), translated);
             }
             mSelectedCablePositions.erase(it);
         }
@@ -1230,7 +497,7 @@ void CircuitScene::moveSelectionBy(int16_t dx, int16_t dy)
 
         if(allFree)
         {
-            AbstractNodeGraphItem *otherItem = getItemAt(newTile);
+            AbstractNodeGraphItem *otherItem = getNodeAt(newTile);
             if(otherItem &&
                     mSelectedItemPositions.find(otherItem) == mSelectedItemPositions.end())
             {
@@ -1242,7 +509,7 @@ void CircuitScene::moveSelectionBy(int16_t dx, int16_t dy)
         if(allFree)
         {
             // Check if move is valid
-            TileCablePair pair = getCablesAt(newTile);
+            TileCableGraphPair pair = getCablesAt(newTile);
             if(pair.first)
             {
                 // Check if we landed on top of a cable which is not being moved
@@ -1273,7 +540,7 @@ void CircuitScene::moveSelectionBy(int16_t dx, int16_t dy)
         CableGraphPath translated = item->cablePath().translatedBy(cableDx, cableDy);
 
         // We are not sure yet this is a valid move
-        item->setPathInternal(translated.generatePath());
+        item->setPathInternal(CableGraphItem::generatePath(translated));
 
         // Store current possible first location
         it->second.second = newFirstLocation;
@@ -1283,7 +550,7 @@ void CircuitScene::moveSelectionBy(int16_t dx, int16_t dy)
             // Check if move is valid
             auto hasNode = [this](const TileLocation& tile) -> bool
             {
-                AbstractNodeGraphItem *otherItem = getItemAt(tile);
+                AbstractNodeGraphItem *otherItem = getNodeAt(tile);
                 if(otherItem &&
                         mSelectedItemPositions.find(otherItem) == mSelectedItemPositions.end())
                 {
@@ -1297,7 +564,7 @@ void CircuitScene::moveSelectionBy(int16_t dx, int16_t dy)
             auto getCablePairAt = [this, item](const TileLocation& tile) -> TileCablePathPair
             {
                 // Check if we landed on top of a cable which is not being moved
-                const TileCablePair cablePair = getCablesAt(tile);
+                const TileCableGraphPair cablePair = getCablesAt(tile);
 
                 TileCablePathPair pathPair;
 
@@ -1329,23 +596,10 @@ void CircuitScene::moveSelectionBy(int16_t dx, int16_t dy)
 
     if(allFree)
     {
-        // Unregister last valid position
-        // This is because items could move to position previously held
-        // by other moved items, so they could block each other
-        for(auto it = mSelectedItemPositions.begin();
-            it != mSelectedItemPositions.end();
-            it++)
-        {
-            AbstractNodeGraphItem *item = it->first;
-            const TileLocation oldLocation = it->second;
-
-            Q_ASSERT_X(getNodeAt(oldLocation) == item,
-                       "moveSelectionBy", "item OLD location is not in item map");
-
-            mItemMap.erase(oldLocation);
-        }
-
         // Register new valid position for all nodes
+        std::vector<std::pair<AbstractCircuitNode *, TileLocation>> moves;
+        moves.reserve(mSelectedItemPositions.size());
+
         for(auto it = mSelectedItemPositions.begin();
             it != mSelectedItemPositions.end();
             it++)
@@ -1353,24 +607,17 @@ void CircuitScene::moveSelectionBy(int16_t dx, int16_t dy)
             AbstractNodeGraphItem *item = it->first;
             const TileLocation newLocation = item->location();
 
-            Q_ASSERT_X(getNodeAt(newLocation) == nullptr,
-                       "moveSelectionBy", "item being moved to invalid position");
+            Q_ASSERT_X(getNodeAt(it->second) == item,
+                       "moveSelectionBy", "item OLD location is not in item map");
 
-            // Update location in map
-            mItemMap.insert({newLocation, item});
+            moves.push_back({item->getAbstractNode(), newLocation});
 
             // Save last valid location
             it->second = newLocation;
-
-            Q_ASSERT_X(getNodeAt(newLocation) == item,
-                       "moveSelectionBy", "item new location is not in item map");
-            Q_ASSERT_X(item->location() == newLocation,
-                       "moveSelectionBy", "error");
-
-            Q_ASSERT_X(getNodeAt(item->location()) == item,
-                       "moveSelectionBy", "item new location is not in item map");
         }
 
+        moveNodes(moves);
+
         // Unregister old tiles for all cables
         // So that during move they do not conflict with each other
         for(auto it = mSelectedCablePositions.begin();
@@ -1378,7 +625,7 @@ void CircuitScene::moveSelectionBy(int16_t dx, int16_t dy)
             it++)
         {
             CableGraphItem *item = it->first;
-            removeCableTiles(item);
+            removeCableTiles(item->cable());
         }
 
         // Register new valid position for all cables
@@ -1396,10 +643,10 @@ void CircuitScene::moveSelectionBy(int16_t dx, int16_t dy)
             const CableGraphPath translated = item->cablePath().translatedBy(cableDx, cableDy);
 
             // Now we really apply path
-            item->setCablePathInternal(translated, false);
+            setCablePath(item->cable(), translated, false);
 
             // And register new tiles
-            addCableTiles(item);
+            addCableTiles(item->cable());
 
             // Store new valid location to current first location
             it->second.first = currentFirstLocation;
@@ -1438,7 +685,7 @@ void CircuitScene::endSelectionMove()
         if(lastValidLocation != currentFirstLocation)
         {
             // Reset to last valid path
-            item->setCablePath(item->cablePath());
+            setCablePath(item->cable(), cablePath(item->cable()));
 
             // Set new first to last valid location
             it->second.second = lastValidLocation;
@@ -1481,7 +728,7 @@ void CircuitScene::copySelectedItems()
         AbstractNodeGraphItem *item = it.first;
 
         QJsonObject nodeObj;
-        item->saveToJSON(nodeObj);
+        saveNode(item->getAbstractNode(), nodeObj);
 
         QVector<ObjectProperty> objProps;
         item->getAbstractNode()->getObjectProperties(objProps);
@@ -1518,7 +765,7 @@ void CircuitScene::copySelectedItems()
             continue;
 
         QJsonObject cableObj;
-        item->saveToJSON(cableObj);
+        saveCable(item->cable(), cableObj);
         cables.append(cableObj);
     }
 
@@ -1545,7 +792,6 @@ bool CircuitScene::tryPasteItems(const TileLocation &tileHint,
     SimulationObjectCopyHelper::pasteObjects(modeMgr(), objPool);
 
     return insertFragment(tileHint, rootObj,
-                          modeMgr()->circuitFactory(),
                           outTopLeft, outBottomRight);
 }
 
@@ -1582,13 +828,13 @@ void CircuitScene::selectAll()
     if(modeMgr()->editingSubMode() != EditingSubMode::ItemSelection)
         return;
 
-    for(const auto& it : mCables)
+    for(const auto& it : mCableGraphs)
     {
         CableGraphItem *item = it.second;
         item->setSelected(true);
     }
 
-    for(const auto& it : mItemMap)
+    for(const auto& it : mNodeGraphs)
     {
         AbstractNodeGraphItem *item = it.second;
         item->setSelected(true);
@@ -1643,21 +889,10 @@ Connector::Direction CircuitScene::getTileAndDirection(const QPointF &p, TileLoc
 
 AbstractNodeGraphItem *CircuitScene::getGraphForNode(AbstractCircuitNode *node) const
 {
-    const auto vec = node->findChildren<AbstractNodeGraphItem *>(Qt::FindDirectChildrenOnly);
-    for(AbstractNodeGraphItem *item : vec)
-    {
-        if(item->getAbstractNode() == node)
-            return item; // NOTE: might not be in this scene!
-    }
-
-    // Slow way, check all items
-    for(auto it = mItemMap.begin(), end = mItemMap.end(); it != end; it++)
-    {
-        if(it->second->getAbstractNode() == node)
-            return it->second;
-    }
-
-    return nullptr;
+    auto it = mNodeGraphs.find(node);
+    if(it == mNodeGraphs.end())
+        return nullptr;
+    return it->second;
 }
 
 bool CircuitScene::areSelectedNodesSameType() const
@@ -1702,10 +937,39 @@ void CircuitScene::updateCodeStatus()
     update();
 }
 
+void CircuitScene::setShownInView(bool shown)
+{
+    mShownViewCount += shown ? 1 : -1;
+    Q_ASSERT(mShownViewCount >= 0);
+
+    if(mShownViewCount > 0)
+    {
+        mReleaseGraphicsTimer.stop();
+        if(!mGraphicsLoaded)
+            loadGraphics();
+    }
+    else if(mGraphicsLoaded)
+    {
+        mReleaseGraphicsTimer.start(ReleaseGraphicsDelayMillis, this);
+    }
+}
+
+void CircuitScene::ensureGraphicsLoaded()
+{
+    if(mGraphicsLoaded)
+        return;
+
+    loadGraphics();
+
+    // Release them if no view shows the scene
+    if(mShownViewCount == 0)
+        mReleaseGraphicsTimer.start(ReleaseGraphicsDelayMillis, this);
+}
+
 void CircuitScene::helpEvent(QGraphicsSceneHelpEvent *e)
 {
     const TileLocation tile = TileLocation::fromPointFloor(e->scenePos());
-    AbstractNodeGraphItem *item = getItemAt(tile);
+    AbstractNodeGraphItem *item = getNodeAt(tile);
     if(item)
     {
         QString tip = item->tooltipString();
@@ -1732,7 +996,6 @@ void CircuitScene::helpEvent(QGraphicsSceneHelpEvent *e)
 
 bool CircuitScene::insertFragment(const TileLocation &tileHint,
                                   const QJsonObject &fragmentRoot,
-                                  NodeEditFactory *factory,
                                   TileLocation &outTopLeft,
                                   TileLocation &outBottomRight)
 {
@@ -1763,76 +1026,39 @@ bool CircuitScene::insertFragment(const TileLocation &tileHint,
     modeMgr()->setEditingSubMode(EditingSubMode::Default);
 
     // Really paste items
-    QVector<AbstractNodeGraphItem *> pastedItems;
-    pastedItems.reserve(fragment.validNodes.size());
+    QVector<AbstractCircuitNode *> pastedNodes;
+    pastedNodes.reserve(fragment.validNodes.size());
 
-    QVector<CableGraphItem *> pastedCables;
+    QVector<CircuitCable *> pastedCables;
     pastedCables.reserve(fragment.validCables.size());
 
     for(const QJsonObject& obj : fragment.validNodes)
     {
-        const QString nodeType = obj.value("type").toString();
-        if(nodeType.isEmpty())
-            continue;
-
-        // Create new node
-        AbstractNodeGraphItem *item = factory->createItem(nodeType, this);
-        if(item)
-        {
-            if(!item->loadFromJSON(obj))
-            {
-                auto *node = item->getAbstractNode();
-                delete item;
-                delete node;
-                continue;
-            }
-
-            // Translate node
-            TileLocation tile = item->location();
-            tile = tile.adjusted(dx, dy);
-            item->setLocation(tile);
-
-            // Add node to scene
-            addNode(item);
-
-            pastedItems.append(item);
-        }
+        // Create new node, translated
+        AbstractCircuitNode *node = loadNode(obj, dx, dy);
+        if(node)
+            pastedNodes.append(node);
     }
 
     for(const QJsonObject& cableObj : fragment.validCables)
     {
-        // Create new cable
-        CircuitCable *cable = new CircuitCable(circuitsModel()->modeMgr(), this);
-        CableGraphItem *item = new CableGraphItem(cable);
-        item->setPos(0, 0);
-
-        if(!item->loadFromJSON(cableObj) || !item->validNotZero())
-        {
-            delete item;
-            delete cable;
-            continue;
-        }
-
-        // Translate cable
-        const CableGraphPath translated = item->cablePath().translatedBy(dx, dy);
-        item->setCablePath(translated);
-
-        addCable(item);
-
-        pastedCables.append(item);
+        // Create new cable, translated
+        CircuitCable *cable = loadCable(cableObj, dx, dy);
+        if(cable)
+            pastedCables.append(cable);
     }
 
     // Try to connect new nodes and cables
     QVector<CircuitCable *> verifiedCables;
-    for(AbstractNodeGraphItem *item : std::as_const(pastedItems))
+    for(AbstractCircuitNode *node : std::as_const(pastedNodes))
     {
-        checkItem(item, verifiedCables);
+        checkNode(node, verifiedCables);
     }
 
     for(auto it = pastedCables.begin(); it != pastedCables.end(); )
     {
-        CableGraphItem *item = *it;
-        if(!checkCable(item) || !item->validNotZero())
+        CircuitCable *cable = *it;
+        if(!checkCable(cable) || !cablePath(cable).validNotZero())
         {
             // We already added to scene
             // Will be deleted by calculateConnections()
@@ -1846,14 +1072,16 @@ bool CircuitScene::insertFragment(const TileLocation &tileHint,
     // Now select all pasted items so user can move them
     modeMgr()->setEditingSubMode(EditingSubMode::ItemSelection);
 
-    for(QGraphicsItem *item : std::as_const(pastedItems))
+    for(AbstractCircuitNode *node : std::as_const(pastedNodes))
     {
-        item->setSelected(true);
+        if(AbstractNodeGraphItem *item = getGraphForNode(node))
+            item->setSelected(true);
     }
 
-    for(QGraphicsItem *item : std::as_const(pastedCables))
+    for(CircuitCable *cable : std::as_const(pastedCables))
     {
-        item->setSelected(true);
+        if(CableGraphItem *item = graphForCable(cable))
+            item->setSelected(true);
     }
 
     outTopLeft = fragment.topLeftLocation.adjusted(dx, dy);;
@@ -1980,20 +1208,20 @@ bool CircuitScene::locateSpaceForFragment(const FragmentData &fragment, const Ti
 
     auto hasExistingNode = [this](const TileLocation& tile) -> bool
     {
-        return getItemAt(tile) != nullptr;
+        return nodeAt(tile) != nullptr;
     };
 
     auto getExistingCablePairAt = [this](const TileLocation& tile) -> TileCablePathPair
     {
-        const TileCablePair cablePair = getCablesAt(tile);
+        const TileCablePair cablePair = cablesAt(tile);
 
         TileCablePathPair pathPair;
 
         // Do not consider ourselves
         if(cablePair.first)
-            pathPair.first = cablePair.first->cablePath();
+            pathPair.first = cablePath(cablePair.first);
         if(cablePair.second)
-            pathPair.second = cablePair.second->cablePath();
+            pathPair.second = cablePath(cablePair.second);
 
         return pathPair;
     };
@@ -2009,10 +1237,10 @@ bool CircuitScene::locateSpaceForFragment(const FragmentData &fragment, const Ti
         for(const TileLocation& nodeTile : fragment.pastedNodeTiles)
         {
             const TileLocation destTile = nodeTile.adjusted(topLeft.x, topLeft.y);
-            if(getNodeAt(destTile))
+            if(nodeAt(destTile))
                 return false; // We overlap existing node
 
-            TileCablePair pair = getCablesAt(destTile);
+            TileCablePair pair = cablesAt(destTile);
             if(pair.first || pair.second)
                 return false; // We overlap an existing cable
         }
@@ -2098,31 +1326,24 @@ void CircuitScene::removeAllItems()
 {
     modeMgr()->setEditingSubMode(EditingSubMode::Default);
 
-    // Disable all circuits
-    for(AbstractCircuitNode *powerSource : std::as_const(mPowerSources))
+    // Node graphs must go before their nodes
+    const auto nodeGraphsCopy = mNodeGraphs;
+    mNodeGraphs.clear();
+    for(const auto& it : nodeGraphsCopy)
     {
-        powerSource->setSourceEnabled(false);
+        AbstractNodeGraphItem *item = it.second;
+        removeItem(item);
+        delete item;
     }
 
-    const auto cableCopy = mCables;
-    for(const auto& it : cableCopy)
-    {
-        CableGraphItem *item = it.second;
-        removeCable(item->cable());
-    }
-    Q_ASSERT(mCables.size() == 0);
+    // Cable graphs are removed by onCableRemoved()
+    clearLayout();
+    Q_ASSERT(mCableGraphs.empty());
 
-    const auto itemsCopy = mItemMap;
-    for(const auto& it : itemsCopy)
-    {
-        AbstractNodeGraphItem *item = it.second;
-        removeNode(item);
-    }
-    Q_ASSERT(mItemMap.size() == 0);
-    Q_ASSERT(mPowerSources.size() == 0);
+    mNodeGraphData.clear();
 }
 
-bool CircuitScene::loadFromJSON(const QJsonObject &obj, NodeEditFactory *factory)
+bool CircuitScene::loadFromJSON(const QJsonObject &obj)
 {
     removeAllItems();
 
@@ -2134,54 +1355,20 @@ bool CircuitScene::loadFromJSON(const QJsonObject &obj, NodeEditFactory *factory
 
     setCircuitSheetLongName(obj.value("long_name").toString());
 
-    const QJsonArray cables = obj.value("cables").toArray();
-
-    for(const QJsonValue& v : cables)
-    {
-        const QJsonObject cableObj = v.toObject();
-
-        // Create new cable
-        CircuitCable *cable = new CircuitCable(circuitsModel()->modeMgr(), this);
-        CableGraphItem *item = new CableGraphItem(cable);
-        item->setPos(0, 0);
-
-        if(!item->loadFromJSON(cableObj))
-        {
-            delete item;
-            delete cable;
-            continue;
-        }
-
-        addCable(item);
-    }
-
-    const QJsonArray nodes = obj.value("nodes").toArray();
-
-    for(const QJsonValue& v : nodes)
-    {
-        const QJsonObject nodeObj = v.toObject();
-        const QString nodeType = nodeObj.value("type").toString();
-        if(nodeType.isEmpty())
-            continue;
+    QElapsedTimer timer;
+    timer.start();
 
-        // Create new node
-        AbstractNodeGraphItem *item = factory->createItem(nodeType, this);
-        if(item)
-        {
-            if(!item->loadFromJSON(nodeObj))
-            {
-                auto *node = item->getAbstractNode();
-                delete item;
-                delete node;
-                continue;
-            }
+    loadLayout(obj);
 
-            addNode(item);
-        }
-    }
+    PhaseReport& report = modeMgr()->loadReport();
+    report.addTime(QLatin1String("Create items"), timer.nsecsElapsed(),
+                   qint64(cableMap().size() + nodeMap().size()));
 
     // Recalculate circuits
+    timer.start();
     calculateConnections();
+    report.addTime(QLatin1String("Connect items"), timer.nsecsElapsed(),
+                   qint64(cableMap().size()));
 
     setHasUnsavedChanges(false);
 
@@ -2193,99 +1380,7 @@ void CircuitScene::saveToJSON(QJsonObject &obj) const
     obj["name"] = circuitSheetName();
     obj["long_name"] = circuitSheetLongName();
 
-    // Sort cables by start position
-    QVector<CableGraphItem *> sortedCables;
-    sortedCables.reserve(mCables.size());
-
-    for(const auto& it : mCables)
-    {
-        CableGraphItem *item = it.second;
-
-        // Do not save zero length cables
-        // They can be automatically generated at load
-        if(item->validNotZero())
-            sortedCables.append(item);
-    }
-
-    std::sort(sortedCables.begin(),
-              sortedCables.end(),
-              [](CableGraphItem *a, CableGraphItem *b) -> bool
-    {
-        // Do not use sideA() because it adds startDirection() to TileLocation
-        TileLocation startA = a->cablePath().first();
-        TileLocation startB = b->cablePath().first();
-
-        const bool reverseA =  a->cablePath().needsReversing();
-        if(reverseA)
-            startA = a->cablePath().last();
-
-        const bool reverseB = b->cablePath().needsReversing();
-        if(reverseB)
-            startB = b->cablePath().last();
-
-        // Orded by Y, then by X, the by direction
-        if(startA.y == startB.y)
-        {
-            if(startA.x == startB.x)
-            {
-                Connector::Direction dirA = a->directionA();
-                if(reverseA)
-                    dirA = a->directionB();
-
-                Connector::Direction dirB = b->directionA();
-                if(reverseB)
-                    dirB = b->directionB();
-
-                return dirA < dirB;
-            }
-
-            return startA.x < startB.x;
-        }
-        return startA.y < startB.y;
-    });
-
-    QJsonArray cables;
-    for(CableGraphItem *item : std::as_const(sortedCables))
-    {
-        QJsonObject cableObj;
-        item->saveToJSON(cableObj);
-        cables.append(cableObj);
-    }
-
-    obj["cables"] = cables;
-
-    // Sort nodes by position
-    QVector<AbstractNodeGraphItem *> sortedNodes;
-    sortedNodes.reserve(mItemMap.size());
-
-    for(const auto& it : mItemMap)
-    {
-        AbstractNodeGraphItem *item = it.second;
-        sortedNodes.append(item);
-    }
-
-    std::sort(sortedNodes.begin(),
-              sortedNodes.end(),
-              [](AbstractNodeGraphItem *a, AbstractNodeGraphItem *b) -> bool
-    {
-        TileLocation locA = a->location();
-        TileLocation locB = b->location();
-
-        // Order by Y, then by X
-        if(locA.y == locB.y)
-            return locA.x < locB.x;
-        return locA.y < locB.y;
-    });
-
-    QJsonArray nodes;
-    for(AbstractNodeGraphItem *item : std::as_const(sortedNodes))
-    {
-        QJsonObject nodeObj;
-        item->saveToJSON(nodeObj);
-        nodes.append(nodeObj);
-    }
-
-    obj["nodes"] = nodes;
+    saveLayout(obj);
 }
 
 QPointF CircuitScene::getConnectorPoint(TileLocation l, Connector::Direction direction)
@@ -2390,21 +1485,22 @@ void CircuitScene::endEditCable(bool apply)
     if(!cablePath.validNotZero())
         return; // TODO: error message
 
+    CircuitCable *cable = nullptr;
     if(isNew)
     {
         // Create new cable
-        CircuitCable *cable = new CircuitCable(circuitsModel()->modeMgr(), this);
-        item = new CableGraphItem(cable);
-        item->setPos(0, 0);
+        cable = insertCable(cablePath);
+        if(!cable)
+            return; // TODO: error
+    }
+    else
+    {
+        cable = item->cable();
+        setCablePath(cable, cablePath);
     }
-
-    item->setCablePath(cablePath);
-
-    if(isNew)
-        addCable(item);
 
     // Try to connect it right away
-    checkCable(item);
+    checkCable(cable);
 }
 
 void CircuitScene::editCableAddPoint(const QPointF &p, bool allowEdge)
@@ -2495,13 +1591,14 @@ void CircuitScene::editCableAddPoint(const QPointF &p, bool allowEdge)
         }
     }
 
-    if(!cablePathIsValid(newCablePath, mEditingCable))
+    if(!cablePathIsValid(newCablePath,
+                         mEditingCable ? mEditingCable->cable() : nullptr))
         return;
 
     // Store new path
     *mEditNewCablePath = newCablePath;
 
-    mEditNewPath->setPath(mEditNewCablePath->generatePath());
+    mEditNewPath->setPath(CableGraphItem::generatePath(*mEditNewCablePath));
     editCableUpdatePen();
 }
 
@@ -2511,7 +1608,7 @@ void CircuitScene::editCableUndoLast()
         return;
 
     mEditNewCablePath->removeLastLine();
-    mEditNewPath->setPath(mEditNewCablePath->generatePath());
+    mEditNewPath->setPath(CableGraphItem::generatePath(*mEditNewCablePath));
     editCableUpdatePen();
 }
 
@@ -2618,36 +1715,75 @@ void CircuitScene::mousePressEvent(QGraphicsSceneMouseEvent *e)
 
 void CircuitScene::refreshItemConnections(AbstractNodeGraphItem *item, bool tryReconnect)
 {
-    // Detach all contacts, will be revaluated later
-    AbstractCircuitNode *node = item->getAbstractNode();
-    const auto& contacts = node->getContacts();
+    refreshNodeConnections(item->getAbstractNode(), tryReconnect);
+}
 
-    for(int i = 0; i < contacts.size(); i++)
-    {
-        CircuitCable *cable = contacts.at(i).cable;
-        node->detachCable(i);
+void CircuitScene::onNodeLoaded(AbstractCircuitNode *node, const QJsonObject &obj)
+{
+    if(mGraphicsLoaded)
+        createNodeGraph(node, obj);
+    else
+        mNodeGraphData.insert({node, obj}); // Shared with loaded file, cheap
 
-        if(cable)
-        {
-            // Delete zero length cables
-            // This way also opposite node becomes unconnected
-            // And can receive future connections
-            // Even before ending Editing mode
-            auto *cableGraph = graphForCable(cable);
-            if(cableGraph && !cableGraph->validNotZero())
-            {
-                removeCable(cable);
-            }
-        }
+    setHasUnsavedChanges(true);
+}
 
+void CircuitScene::saveNodeExtra(AbstractCircuitNode *node, QJsonObject &obj) const
+{
+    AbstractNodeGraphItem *item = getGraphForNode(node);
+    if(item)
+    {
+        item->saveToJSON(obj);
+        return;
     }
 
-    if(!tryReconnect)
+    auto it = mNodeGraphData.find(node);
+    if(it == mNodeGraphData.end())
         return;
 
-    // Try reconnect item
-    QVector<CircuitCable *> dummy;
-    checkItem(item, dummy);
+    // Data loaded from file also contains node properties,
+    // do not override them
+    const QJsonObject& data = it->second;
+    for(auto prop = data.constBegin(), e = data.constEnd(); prop != e; prop++)
+    {
+        if(!obj.contains(prop.key()))
+            obj.insert(prop.key(), prop.value());
+    }
+}
+
+void CircuitScene::onCableAdded(CircuitCable *cable)
+{
+    if(mGraphicsLoaded)
+        createCableGraph(cable);
+
+    if(cablePath(cable).validNotZero())
+        setHasUnsavedChanges(true);
+}
+
+void CircuitScene::onCableRemoved(CircuitCable *cable)
+{
+    auto it = mCableGraphs.find(cable);
+    if(it != mCableGraphs.end())
+    {
+        // Delete graph item
+        CableGraphItem *item = it->second;
+        mCableGraphs.erase(it);
+
+        if(item == mEditingCable)
+            endEditCable(false);
+
+        delete item;
+    }
+
+    if(!cablePath(cable).isZeroLength())
+        setHasUnsavedChanges(true);
+}
+
+void CircuitScene::onCablePathChanged(CircuitCable *cable)
+{
+    CableGraphItem *item = graphForCable(cable);
+    if(item)
+        item->setCablePath(cablePath(cable));
 }
 
 void CircuitScene::drawBackground(QPainter *painter, const QRectF &rect)
@@ -2750,6 +1886,117 @@ void CircuitScene::drawBackground(QPainter *painter, const QRectF &rect)
     }
 }
 
+void CircuitScene::timerEvent(QTimerEvent *e)
+{
+    if(e->timerId() == mReleaseGraphicsTimer.timerId())
+    {
+        mReleaseGraphicsTimer.stop();
+        if(mShownViewCount == 0)
+            releaseGraphics();
+        return;
+    }
+
+    QGraphicsScene::timerEvent(e);
+}
+
+void CircuitScene::loadGraphics()
+{
+    for(const auto& it : cableMap())
+        createCableGraph(it.first);
+
+    for(const auto& it : nodeMap())
+    {
+        AbstractCircuitNode *node = it.second;
+        auto data = mNodeGraphData.find(node);
+        createNodeGraph(node, data != mNodeGraphData.end() ? data->second : QJsonObject());
+    }
+
+    mNodeGraphData.clear();
+
+    // Build index after adding all items
+    setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+    mGraphicsLoaded = true;
+
+    // Let scene rect expand during editing
+    if(mode() != FileMode::Editing)
+        fitSceneRectToItems();
+}
+
+void CircuitScene::releaseGraphics()
+{
+    if(isEditingCable() || mItemBeingMoved
+            || !mSelectedItemPositions.empty() || !mSelectedCablePositions.empty())
+    {
+        // Items are still referenced, try later
+        mReleaseGraphicsTimer.start(ReleaseGraphicsDelayMillis, this);
+        return;
+    }
+
+    setItemIndexMethod(QGraphicsScene::NoIndex);
+
+    // Keep graph only properties to save them or recreate items
+    for(const auto& it : mNodeGraphs)
+    {
+        AbstractNodeGraphItem *item = it.second;
+
+        QJsonObject data;
+        item->saveToJSON(data);
+        mNodeGraphData.insert({it.first, data});
+
+        delete item;
+    }
+    mNodeGraphs.clear();
+
+    for(const auto& it : mCableGraphs)
+        delete it.second;
+    mCableGraphs.clear();
+
+    mGraphicsLoaded = false;
+}
+
+void CircuitScene::fitSceneRectToItems()
+{
+    // Cut scene rect to items bounding rect
+    QRectF br = itemsBoundingRect();
+
+    // Add some margin
+    br.adjust(-TileLocation::HalfSize, -TileLocation::HalfSize,
+              TileLocation::HalfSize, TileLocation::HalfSize);
+    setSceneRect(br);
+}
+
+AbstractNodeGraphItem *CircuitScene::createNodeGraph(AbstractCircuitNode *node,
+                                                     const QJsonObject &obj)
+{
+    NodeEditFactory *factory = GuiModeFrontend::get(modeMgr())->circuitFactory();
+    AbstractNodeGraphItem *item = factory->createGraph(node);
+    if(!item)
+        return nullptr;
+
+    const NodePlacement placement = nodePlacement(node);
+    item->setLocation(placement.location);
+    item->setRotate(placement.rotate);
+
+    // Graph only properties
+    item->loadFromJSON(obj);
+    item->postInit();
+
+    mNodeGraphs.insert({node, item});
+    addItem(item);
+
+    return item;
+}
+
+void CircuitScene::createCableGraph(CircuitCable *cable)
+{
+    CableGraphItem *item = new CableGraphItem(cable);
+    item->setPos(0, 0);
+    item->setCablePath(cablePath(cable));
+
+    mCableGraphs.insert({cable, item});
+    addItem(item);
+}
+
 CircuitListModel *CircuitScene::circuitsModel() const
 {
     return static_cast<CircuitListModel *>(parent());
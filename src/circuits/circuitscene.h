@@ -24,10 +24,12 @@
 #define CIRCUITSCENE_H
 
 #include <QGraphicsScene>
+#include <QBasicTimer>
+#include <QJsonObject>
 
 #include <unordered_map>
 
-#include "../utils/tilerotate.h"
+#include "circuitsheetlayout.h"
 
 #include "../enums/filemodes.h"
 
@@ -40,24 +42,18 @@ class CableGraphPath;
 
 class QGraphicsPathItem;
 
-class QJsonObject;
 class QJsonArray;
-class NodeEditFactory;
 
 class CircuitListModel;
 
 class ModeManager;
 
-class CircuitScene : public QGraphicsScene
+class CircuitScene : public QGraphicsScene, public CircuitSheetLayout
 {
     Q_OBJECT
 public:
-    // On a tile there can be 2 cables if they go in squared directions
-    // See CableGraphPath::addTile()
-    typedef std::pair<CableGraphItem *, CableGraphItem*> TileCablePair;
-    typedef std::pair<std::optional<CableGraphPath>, std::optional<CableGraphPath>> TileCablePathPair;
-    typedef std::unordered_map<TileLocation, TileCablePair, TileLocationHash> CablePairMap;
-
+    // Graph items of CircuitSheetLayout::TileCablePair
+    typedef std::pair<CableGraphItem *, CableGraphItem*> TileCableGraphPair;
 
     explicit CircuitScene(CircuitListModel *parent);
     ~CircuitScene();
@@ -68,12 +64,9 @@ class CircuitScene : public QGraphicsScene
     void addNode(AbstractNodeGraphItem *item);
     void removeNode(AbstractNodeGraphItem *item);
 
-    void addCable(CableGraphItem *item);
     void removeCable(CircuitCable *cable);
     CableGraphItem *graphForCable(CircuitCable *cable) const;
 
-    TileLocation getFreeLocationNear(TileLocation origin = TileLocation::invalid);
-
     static QPointF getConnectorPoint(TileLocation l, Connector::Direction direction);
 
     void startEditNewCable();
@@ -85,14 +78,11 @@ class CircuitScene : public QGraphicsScene
     void editCableAddPoint(const QPointF& p, bool allowEdge);
     void editCableUndoLast();
 
-    bool isLocationFree(TileLocation l) const;
     AbstractNodeGraphItem *getNodeAt(TileLocation l) const;
-    TileCablePair getCablesAt(TileLocation l) const;
-
-    bool cablePathIsValid(const CableGraphPath& cablePath, CableGraphItem *item) const;
+    TileCableGraphPair getCablesAt(TileLocation l) const;
 
     void removeAllItems();
-    bool loadFromJSON(const QJsonObject &obj, NodeEditFactory *factory);
+    bool loadFromJSON(const QJsonObject &obj);
     void saveToJSON(QJsonObject &obj) const;
 
     bool hasUnsavedChanges() const;
@@ -135,6 +125,13 @@ class CircuitScene : public QGraphicsScene
 
     void updateCodeStatus();
 
+    // Graph items are created when first shown and deleted
+    // some time after last view hides the scene.
+    // Nodes and cables are always loaded.
+    void setShownInView(bool shown);
+    void ensureGraphicsLoaded();
+    inline bool isGraphicsLoaded() const { return mGraphicsLoaded; }
+
 signals:
     void nameChanged(const QString& newName, CircuitScene *self);
     void longNameChanged(const QString& newName, CircuitScene *self);
@@ -149,7 +146,24 @@ class CircuitScene : public QGraphicsScene
 
     void drawBackground(QPainter *painter, const QRectF &rect) override;
 
+    void timerEvent(QTimerEvent *e) override;
+
+    void onNodeLoaded(AbstractCircuitNode *node, const QJsonObject& obj) override;
+    void saveNodeExtra(AbstractCircuitNode *node, QJsonObject& obj) const override;
+
+    void onCableAdded(CircuitCable *cable) override;
+    void onCableRemoved(CircuitCable *cable) override;
+    void onCablePathChanged(CircuitCable *cable) override;
+
 private:
+    void loadGraphics();
+    void releaseGraphics();
+    void fitSceneRectToItems();
+
+    AbstractNodeGraphItem *createNodeGraph(AbstractCircuitNode *node,
+                                           const QJsonObject& obj);
+    void createCableGraph(CircuitCable *cable);
+
     friend class AbstractNodeGraphItem;
 
     void refreshItemConnections(AbstractNodeGraphItem *item, bool tryReconnect);
@@ -157,26 +171,7 @@ class CircuitScene : public QGraphicsScene
     bool updateItemLocation(TileLocation newLocation,
                             AbstractNodeGraphItem *item);
 
-    void calculateConnections();
-    void connectItems(AbstractCircuitNode *node1,
-                      AbstractCircuitNode *node2,
-                      const Connector& c1, const Connector& c2,
-                      QVector<CircuitCable *>& verifiedCables);
-
-    bool checkCable(CableGraphItem *item);
-    void checkItem(AbstractNodeGraphItem *item, QVector<CircuitCable *> &verifiedCables);
-
-    inline AbstractNodeGraphItem *getItemAt(TileLocation l) const
-    {
-        auto it = mItemMap.find(l);
-        if(it != mItemMap.cend())
-            return it->second;
-        return nullptr;
-    }
-
     friend class CableGraphItem;
-    void addCableTiles(CableGraphItem *item);
-    void removeCableTiles(CableGraphItem *item);
     void editCableUpdatePen();
 
     AbstractNodeGraphItem *itemBeingMoved() const;
@@ -203,7 +198,6 @@ class CircuitScene : public QGraphicsScene
 
     bool insertFragment(const TileLocation& tileHint,
                         const QJsonObject& fragmentRoot,
-                        NodeEditFactory *factory,
                         TileLocation &outTopLeft,
                         TileLocation &outBottomRight);
 
@@ -253,13 +247,11 @@ class CircuitScene : public QGraphicsScene
     QString mCircuitSheetName;
     QString mCircuitSheetLongName;
 
-    std::unordered_map<TileLocation, AbstractNodeGraphItem *, TileLocationHash> mItemMap;
-
-    QVector<AbstractCircuitNode *> mPowerSources;
+    std::unordered_map<AbstractCircuitNode *, AbstractNodeGraphItem *> mNodeGraphs;
+    std::unordered_map<CircuitCable *, CableGraphItem *> mCableGraphs;
 
-    std::unordered_map<CircuitCable *, CableGraphItem *> mCables;
-
-    CablePairMap mCableTiles;
+    // Graph only properties of nodes without graph item
+    std::unordered_map<AbstractCircuitNode *, QJsonObject> mNodeGraphData;
 
     bool mIsEditingNewCable = false;
     CableGraphItem *mEditingCable = nullptr;
@@ -278,6 +270,10 @@ class CircuitScene : public QGraphicsScene
     TileLocation mSelectedCableMoveStart = TileLocation::invalid;
 
     FileMode mMode = FileMode::Editing;
+
+    int mShownViewCount = 0;
+    bool mGraphicsLoaded = false;
+    QBasicTimer mReleaseGraphicsTimer;
 };
 
 #endif // CIRCUITSCENE_H
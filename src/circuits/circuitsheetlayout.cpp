@@ -0,0 +1,1081 @@
+/**
+ * src/circuits/circuitsheetlayout.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "circuitsheetlayout.h"
+
+#include "nodes/circuitcable.h"
+
+#include "nodes/onoffswitchnode.h"
+#include "nodes/powersourcenode.h"
+#include "nodes/simplecircuitnode.h"
+#include "nodes/relaispowernode.h"
+#include "nodes/relaiscontactnode.h"
+#include "nodes/screenrelaispowernode.h"
+#include "nodes/screenrelaiscontactnode.h"
+#include "nodes/buttoncontactnode.h"
+#include "nodes/lightbulbnode.h"
+#include "nodes/electromagnetpowernode.h"
+#include "nodes/electromagnetcontactnode.h"
+#include "nodes/levercontactnode.h"
+#include "nodes/polarityinversionnode.h"
+#include "nodes/bifilarizatornode.h"
+#include "nodes/soundcircuitnode.h"
+#include "nodes/diodecircuitnode.h"
+#include "nodes/remotecablecircuitnode.h"
+#include "nodes/transformernode.h"
+#include "nodes/resistornode.h"
+#include "nodes/traintasticsensornode.h"
+#include "nodes/traintasticturnoutnode.h"
+#include "nodes/commandnode.h"
+#include "nodes/traintasticaxlecounternode.h"
+#include "nodes/acepanelnodes.h"
+
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QHash>
+
+template <typename Node>
+AbstractCircuitNode *createNode(ModeManager *mgr, QObject *parent)
+{
+    return new Node(mgr, parent);
+}
+
+static void attachCableSide(AbstractCircuitNode *node, int nodeContact,
+                            CircuitCable *cable, CableSide side)
+{
+    CableItem cableItem;
+    cableItem.cable.cable = cable;
+    cableItem.cable.side = side;
+    cableItem.nodeContact = nodeContact;
+    cableItem.cable.pole = CircuitPole::First;
+    node->attachCable(cableItem);
+
+    cableItem.cable.pole = CircuitPole::Second;
+    node->attachCable(cableItem);
+}
+
+static void detachCableSide(CircuitCable *cable, CableSide side)
+{
+    CableEnd cableEnd = cable->getNode(side);
+    if(!cableEnd.node)
+        return;
+
+    CableItem item;
+    item.cable.cable = cable;
+    item.cable.side = side;
+    item.nodeContact = cableEnd.nodeContact;
+
+    item.cable.pole = CircuitPole::First;
+    if(cableEnd.node->getContactType(cableEnd.nodeContact, item.cable.pole) != ContactType::NotConnected)
+    {
+        cableEnd.node->detachCable(item);
+    }
+
+    item.cable.pole = CircuitPole::Second;
+    if(cableEnd.node->getContactType(cableEnd.nodeContact, item.cable.pole) != ContactType::NotConnected)
+    {
+        cableEnd.node->detachCable(item);
+    }
+}
+
+CircuitSheetLayout::CircuitSheetLayout(ModeManager *mgr, QObject *owner)
+    : mModeMgr(mgr)
+    , mOwner(owner)
+{
+
+}
+
+CircuitSheetLayout::~CircuitSheetLayout()
+{
+    // Subclass hooks cannot be called from here, they clear before
+    clearLayout();
+}
+
+CircuitSheetLayout::CreateNodeFunc CircuitSheetLayout::nodeCreateFunc(const QString &nodeType)
+{
+    static const QHash<QString, CreateNodeFunc> types =
+    {
+        {OnOffSwitchNode::NodeType, &createNode<OnOffSwitchNode>},
+        {PowerSourceNode::NodeType, &createNode<PowerSourceNode>},
+        {SimpleCircuitNode::NodeType, &createNode<SimpleCircuitNode>},
+        {RelaisPowerNode::NodeType, &createNode<RelaisPowerNode>},
+        {RelaisContactNode::NodeType, &createNode<RelaisContactNode>},
+        {ScreenRelaisPowerNode::NodeType, &createNode<ScreenRelaisPowerNode>},
+        {ScreenRelaisContactNode::NodeType, &createNode<ScreenRelaisContactNode>},
+        {ButtonContactNode::NodeType, &createNode<ButtonContactNode>},
+        {LightBulbNode::NodeType, &createNode<LightBulbNode>},
+        {ElectroMagnetPowerNode::NodeType, &createNode<ElectroMagnetPowerNode>},
+        {ElectromagnetContactNode::NodeType, &createNode<ElectromagnetContactNode>},
+        {FakeACEIButtonNode::NodeType, &createNode<FakeACEIButtonNode>},
+        {FakeLeverNode::NodeType, &createNode<FakeLeverNode>},
+        {FakeLeverNode2::NodeType, &createNode<FakeLeverNode2>},
+        {LeverContactNode::NodeType, &createNode<LeverContactNode>},
+        {PolarityInversionNode::NodeType, &createNode<PolarityInversionNode>},
+        {BifilarizatorNode::NodeType, &createNode<BifilarizatorNode>},
+        {SoundCircuitNode::NodeType, &createNode<SoundCircuitNode>},
+        {DiodeCircuitNode::NodeType, &createNode<DiodeCircuitNode>},
+        {RemoteCableCircuitNode::NodeType, &createNode<RemoteCableCircuitNode>},
+        {TransformerNode::NodeType, &createNode<TransformerNode>},
+        {ResistorNode::NodeType, &createNode<ResistorNode>},
+        {TraintasticSensorNode::NodeType, &createNode<TraintasticSensorNode>},
+        {TraintasticTurnoutNode::NodeType, &createNode<TraintasticTurnoutNode>},
+        {CommandNode::NodeType, &createNode<CommandNode>},
+        {TraintasticAxleCounterNode::NodeType, &createNode<TraintasticAxleCounterNode>}
+    };
+
+    return types.value(nodeType, nullptr);
+}
+
+AbstractCircuitNode *CircuitSheetLayout::nodeAt(TileLocation l) const
+{
+    auto it = mNodeMap.find(l);
+    if(it == mNodeMap.cend())
+        return nullptr;
+    return it->second;
+}
+
+CircuitSheetLayout::NodePlacement CircuitSheetLayout::nodePlacement(AbstractCircuitNode *node) const
+{
+    auto it = mPlacements.find(node);
+    if(it == mPlacements.cend())
+        return NodePlacement();
+    return it->second;
+}
+
+bool CircuitSheetLayout::containsNode(AbstractCircuitNode *node) const
+{
+    return mPlacements.find(node) != mPlacements.cend();
+}
+
+CircuitSheetLayout::TileCablePair CircuitSheetLayout::cablesAt(TileLocation l) const
+{
+    auto it = mCableTiles.find(l);
+    if(it == mCableTiles.cend())
+        return {nullptr, nullptr};
+    return it->second;
+}
+
+const CableGraphPath &CircuitSheetLayout::cablePath(CircuitCable *cable) const
+{
+    static const CableGraphPath emptyPath;
+
+    auto it = mCables.find(cable);
+    if(it == mCables.cend())
+        return emptyPath;
+    return it->second;
+}
+
+bool CircuitSheetLayout::isLocationFree(TileLocation l) const
+{
+    if(nodeAt(l))
+        return false;
+
+    auto pair = cablesAt(l);
+    if(pair.first || pair.second)
+        return false;
+
+    return true;
+}
+
+TileLocation CircuitSheetLayout::getFreeLocationNear(TileLocation origin) const
+{
+    if(!origin.isValid())
+        origin = {0, 0};
+
+    TileLocation result = TileLocation::invalid;
+    bool success = spiral_helper(origin, result, [this](const TileLocation& tile)
+    {
+        return isLocationFree(tile);
+    });
+
+    if(success)
+        return result;
+
+    return TileLocation::invalid;
+}
+
+bool CircuitSheetLayout::cablePathIsValid(const CableGraphPath &cablePath, CircuitCable *ignoredCable) const
+{
+    auto hasNode = [this](const TileLocation& tile) -> bool
+    {
+        return nodeAt(tile) != nullptr;
+    };
+
+    auto getCablePairAt = [this, ignoredCable](const TileLocation& tile) -> TileCablePathPair
+    {
+        const TileCablePair cablePair = cablesAt(tile);
+
+        TileCablePathPair pathPair;
+
+        // Do not consider ourselves
+        if(cablePair.first && cablePair.first != ignoredCable)
+            pathPair.first = mCables.at(cablePair.first);
+        if(cablePair.second && cablePair.second != ignoredCable)
+            pathPair.second = mCables.at(cablePair.second);
+
+        return pathPair;
+    };
+
+    return cablePathIsValid_helper(cablePath, hasNode, getCablePairAt);
+}
+
+void CircuitSheetLayout::insertNode(AbstractCircuitNode *node, TileLocation location, TileRotate rotate)
+{
+    Q_ASSERT(!containsNode(node));
+
+    if(!isLocationFree(location))
+    {
+        // Assign a new location to node
+        location = getFreeLocationNear(location);
+    }
+
+    mNodeMap.insert({location, node});
+    mPlacements.insert({node, {location, rotate}});
+
+    if(node->isSourceNode(false))
+    {
+        node->setSourceEnabled(false);
+        mPowerSources.append(node);
+    }
+}
+
+void CircuitSheetLayout::deleteNode(AbstractCircuitNode *node)
+{
+    auto it = mPlacements.find(node);
+    if(it != mPlacements.end())
+    {
+        Q_ASSERT_X(nodeAt(it->second.location) == node,
+                   "deleteNode", "node location is not in node map");
+
+        mNodeMap.erase(it->second.location);
+        mPlacements.erase(it);
+    }
+
+    if(node->isSourceNode(false))
+    {
+        node->setSourceEnabled(false);
+        mPowerSources.removeOne(node);
+    }
+
+    delete node;
+}
+
+void CircuitSheetLayout::moveNodes(const std::vector<std::pair<AbstractCircuitNode *, TileLocation> > &moves)
+{
+    // Unregister all old locations first
+    // This is because nodes could move to locations previously held
+    // by other moved nodes, so they could block each other
+    for(const auto& move : moves)
+    {
+        const TileLocation oldLocation = mPlacements.at(move.first).location;
+
+        Q_ASSERT_X(nodeAt(oldLocation) == move.first,
+                   "moveNodes", "node OLD location is not in node map");
+
+        mNodeMap.erase(oldLocation);
+    }
+
+    for(const auto& move : moves)
+    {
+        Q_ASSERT_X(nodeAt(move.second) == nullptr,
+                   "moveNodes", "node being moved to invalid location");
+
+        mNodeMap.insert({move.second, move.first});
+        mPlacements.at(move.first).location = move.second;
+    }
+}
+
+void CircuitSheetLayout::setNodeRotate(AbstractCircuitNode *node, TileRotate rotate)
+{
+    mPlacements.at(node).rotate = rotate;
+}
+
+CircuitCable *CircuitSheetLayout::insertCable(const CableGraphPath &path)
+{
+    if(!cablePathIsValid(path, nullptr))
+        return nullptr;
+
+    CircuitCable *cable = new CircuitCable(mModeMgr, mOwner);
+    mCables.insert({cable, path});
+
+    // Add cable tiles
+    addCableTiles(cable);
+
+    onCableAdded(cable);
+
+    return cable;
+}
+
+void CircuitSheetLayout::deleteCable(CircuitCable *cable)
+{
+    auto it = mCables.find(cable);
+    if(it != mCables.end())
+    {
+        onCableRemoved(cable);
+
+        removeCableTiles(cable);
+        mCables.erase(it);
+    }
+
+    delete cable;
+}
+
+void CircuitSheetLayout::setCablePath(CircuitCable *cable, const CableGraphPath &path, bool registerTiles)
+{
+    if(registerTiles)
+        removeCableTiles(cable);
+
+    mCables.at(cable) = path;
+
+    if(registerTiles)
+        addCableTiles(cable);
+
+    // Detach nodes, they will be reattached later
+    detachCableSide(cable, CableSide::A);
+    detachCableSide(cable, CableSide::B);
+
+    onCablePathChanged(cable);
+}
+
+void CircuitSheetLayout::addCableTiles(CircuitCable *cable)
+{
+    const CableGraphPath& path = mCables.at(cable);
+    if(!path.validNotZero())
+        return;
+
+    for(const TileLocation& tile : path.tiles())
+    {
+        auto it = mCableTiles.find(tile);
+        if(it == mCableTiles.end())
+        {
+            TileCablePair pair;
+            pair.first = cable;
+            pair.second = nullptr;
+            mCableTiles.insert({tile, pair});
+        }
+        else
+        {
+            TileCablePair &pair = it->second;
+            if(pair.first)
+                pair.second = cable;
+            else
+                pair.first = cable;
+        }
+    }
+}
+
+void CircuitSheetLayout::removeCableTiles(CircuitCable *cable)
+{
+    const CableGraphPath& path = mCables.at(cable);
+    if(!path.validNotZero())
+        return;
+
+    for(const TileLocation& tile : path.tiles())
+    {
+        auto it = mCableTiles.find(tile);
+        Q_ASSERT_X(it != mCableTiles.end(),
+                   "removeCableTiles", "unknown tile");
+
+        TileCablePair &pair = it->second;
+        Q_ASSERT_X(pair.first == cable || pair.second == cable,
+                   "removeCableTiles", "cable not registered");
+
+        if(pair.first == cable)
+            pair.first = nullptr;
+        else
+            pair.second = nullptr;
+
+        if(!pair.first && !pair.second)
+            mCableTiles.erase(it); // No more cables on this tile
+    }
+}
+
+bool CircuitSheetLayout::splitCable(CircuitCable *cable, const TileLocation &splitLoc)
+{
+    CableGraphPath::SplitPair pathResult;
+    if(!cablePath(cable).splitted(splitLoc, pathResult))
+        return false;
+
+    // Set original cable path to new splitted half
+    bool firstEmpty = pathResult.first.isEmpty();
+    bool secondEmpty = pathResult.second.isEmpty();
+
+    if(firstEmpty && secondEmpty)
+    {
+        // Cable was only 1 tile long, remove it
+        deleteCable(cable);
+        return true;
+    }
+
+    // Set original cable to non-empty half
+    setCablePath(cable, firstEmpty ? pathResult.second : pathResult.first);
+    checkCable(cable);
+
+    if(firstEmpty || secondEmpty)
+        return true; // Only one half was left
+
+    // Create new cable for second half
+    CircuitCable *otherCable = insertCable(pathResult.second);
+
+    // Check new cable
+    if(otherCable)
+        checkCable(otherCable);
+
+    return true;
+}
+
+void CircuitSheetLayout::calculateConnections()
+{
+    QVector<CircuitCable *> verifiedCables;
+
+    // Copy to avoid invalidating iterators while looping
+    std::vector<CircuitCable *> cableCopy;
+    cableCopy.reserve(mCables.size());
+    for(const auto& it : mCables)
+        cableCopy.push_back(it.first);
+
+    for(CircuitCable *cable : cableCopy)
+    {
+        if(checkCable(cable))
+        {
+            verifiedCables.append(cable);
+        }
+        else
+        {
+            if(!cablePath(cable).validNotZero())
+            {
+                // Unconnected zero length cable, delete it
+                deleteCable(cable);
+            }
+        }
+    }
+
+    for(const auto& it : mNodeMap)
+    {
+        checkNode(it.second, verifiedCables);
+    }
+
+    // Delete unconnected zero length cables and empty cables
+    cableCopy.clear();
+    for(const auto& it : mCables)
+        cableCopy.push_back(it.first);
+
+    for(CircuitCable *cable : cableCopy)
+    {
+        const CableGraphPath& path = cablePath(cable);
+        if(path.isZeroLength() && verifiedCables.contains(cable))
+            continue;
+
+        if(!path.validNotZero())
+        {
+            deleteCable(cable);
+        }
+    }
+}
+
+void CircuitSheetLayout::connectNodes(AbstractCircuitNode *node1, AbstractCircuitNode *node2,
+                                      const Connector &c1, const Connector &c2,
+                                      QVector<CircuitCable *> &verifiedCables)
+{
+    const auto& contacts1 = node1->getContacts();
+    const auto& contacts2 = node2->getContacts();
+
+    CircuitCable *cableA = contacts1.at(c1.nodeContact).cable;
+
+    if(!cableA || !verifiedCables.contains(cableA))
+    {
+        CircuitCable *cableB = contacts2.at(c2.nodeContact).cable;
+        if(cableB != cableA || !cableB)
+        {
+            if(cableA)
+            {
+                node1->detachCable(c1.nodeContact);
+
+                if(!cablePath(cableA).validNotZero())
+                {
+                    deleteCable(cableA);
+                    cableA = nullptr;
+                }
+            }
+
+            if(cableB)
+            {
+                node2->detachCable(c2.nodeContact);
+
+                if(!cablePath(cableB).validNotZero())
+                {
+                    deleteCable(cableB);
+                    cableB = nullptr;
+                }
+            }
+
+            // First we set graph path
+            CircuitCable *newCable = insertCable(CableGraphPath::createZeroLength(c1.location,
+                                                                                  c2.location));
+            Q_ASSERT(newCable);
+
+            // Then we create cable connection
+            attachCableSide(node1, c1.nodeContact, newCable, CableSide::A);
+            attachCableSide(node2, c2.nodeContact, newCable, CableSide::B);
+
+            cableA = newCable;
+            verifiedCables.append(cableA);
+        }
+    }
+}
+
+void CircuitSheetLayout::getConnectors(AbstractCircuitNode *node, std::vector<Connector> &connectors) const
+{
+    const NodePlacement& placement = mPlacements.at(node);
+    node->getConnectors(connectors, placement.location, placement.rotate);
+}
+
+bool CircuitSheetLayout::checkCable(CircuitCable *cable)
+{
+    CableGraphPath path = cablePath(cable);
+
+    TileLocation nodeLocA = path.sideA();
+    TileLocation nodeLocB = path.sideB();
+
+    if(nodeLocA == TileLocation::invalid || nodeLocB == TileLocation::invalid)
+        return false;
+
+    AbstractCircuitNode *nodeA = nodeAt(nodeLocA);
+    AbstractCircuitNode *nodeB = nodeAt(nodeLocB);
+
+    if(path.validNotZero())
+    {
+        // If there is no node next to us,
+        // check if there are other cables to merge with
+        if(!nodeA)
+        {
+            const TileCablePair pair = cablesAt(nodeLocA);
+
+            CableGraphPath merged;
+            CircuitCable *other = nullptr;
+
+            if(pair.first)
+            {
+                merged = path.tryMerge(cablePath(pair.first));
+                other = pair.first;
+            }
+            if(merged.isEmpty() && pair.second)
+            {
+                merged = path.tryMerge(cablePath(pair.second));
+                other = pair.second;
+            }
+
+            if(!merged.isEmpty())
+            {
+                // We cannot delete other cable because
+                // this function is called iterating cable list
+                // so we set it to empty path and it will be garbage collected
+                setCablePath(other, CableGraphPath{});
+
+                // Set our path to merged
+                setCablePath(cable, merged);
+                path = merged;
+
+                // Retry searching nodes
+                nodeLocA = path.sideA();
+                nodeA = nodeAt(nodeLocA);
+            }
+        }
+
+        if(!nodeB)
+        {
+            const TileCablePair pair = cablesAt(nodeLocB);
+
+            CableGraphPath merged;
+            CircuitCable *other = nullptr;
+
+            if(pair.first)
+            {
+                merged = path.tryMerge(cablePath(pair.first));
+                other = pair.first;
+            }
+            if(merged.isEmpty() && pair.second)
+            {
+                merged = path.tryMerge(cablePath(pair.second));
+                other = pair.second;
+            }
+
+            if(!merged.isEmpty())
+            {
+                // We cannot delete other cable because
+                // this function is called iterating cable list
+                // so we set it to empty path and it will be garbage collected
+                setCablePath(other, CableGraphPath{});
+
+                // Set our path to merged
+                setCablePath(cable, merged);
+                path = merged;
+
+                // Retry searching nodes
+                nodeLocB = path.sideB();
+                nodeB = nodeAt(nodeLocB);
+            }
+        }
+    }
+
+    std::vector<Connector> connectorsA;
+    std::vector<Connector> connectorsB;
+
+    std::vector<Connector>::const_iterator connA = connectorsA.cend();
+    std::vector<Connector>::const_iterator connB = connectorsB.cend();
+
+    if(nodeA)
+    {
+        getConnectors(nodeA, connectorsA);
+
+        const Connector::Direction directionA = path.startDirection();
+        connA = std::find_if(connectorsA.cbegin(), connectorsA.cend(),
+                             [directionA](const Connector& c)
+        {
+            return c.direction == ~directionA;
+        });
+    }
+
+    if(nodeB)
+    {
+        getConnectors(nodeB, connectorsB);
+
+        const Connector::Direction directionB = path.endDirection();
+        connB = std::find_if(connectorsB.cbegin(), connectorsB.cend(),
+                             [directionB](const Connector& c)
+        {
+            return c.direction == ~directionB;
+        });
+    }
+
+    if(!nodeA || connA == connectorsA.cend())
+    {
+        // Detach side A
+        CableEnd end = cable->getNode(CableSide::A);
+        if(end.node)
+        {
+            end.node->detachCable(end.nodeContact);
+        }
+
+        nodeA = nullptr;
+    }
+
+    if(!nodeB || connB == connectorsB.cend())
+    {
+        // Detach side B
+        CableEnd end = cable->getNode(CableSide::B);
+        if(end.node)
+        {
+            end.node->detachCable(end.nodeContact);
+        }
+
+        nodeB = nullptr;
+    }
+
+    bool sideConnectedA = false;
+    if(nodeA)
+    {
+        const auto& contactA = nodeA->getContacts().at(connA->nodeContact);
+
+        if(contactA.cable == cable && contactA.cableSide == CableSide::B)
+        {
+            // We have a swapped cable, detach and let it rewire later
+            CableEnd end = cable->getNode(CableSide::A);
+            if(end.node)
+            {
+                end.node->detachCable(end.nodeContact);
+            }
+
+            end = cable->getNode(CableSide::B);
+            if(end.node)
+            {
+                end.node->detachCable(end.nodeContact);
+            }
+        }
+
+        if(contactA.cable == cable)
+        {
+            sideConnectedA = true;
+        }
+        else if(!contactA.cable && !cable->getNode(CableSide::A).node)
+        {
+            // Make the connection
+            attachCableSide(nodeA, connA->nodeContact, cable, CableSide::A);
+            sideConnectedA = true;
+        }
+    }
+
+    bool sideConnectedB = false;
+    if(nodeB)
+    {
+        const auto& contactB = nodeB->getContacts().at(connB->nodeContact);
+
+        if(contactB.cable == cable)
+        {
+            sideConnectedB = true;
+        }
+        else if(!contactB.cable && !cable->getNode(CableSide::B).node)
+        {
+            // Make the connection
+            attachCableSide(nodeB, connB->nodeContact, cable, CableSide::B);
+            sideConnectedB = true;
+        }
+    }
+
+    return sideConnectedA && sideConnectedB;
+}
+
+void CircuitSheetLayout::checkNode(AbstractCircuitNode *node1, QVector<CircuitCable *> &verifiedCables)
+{
+    const TileLocation location = mPlacements.at(node1).location;
+
+    std::vector<Connector> connectors;
+    getConnectors(node1, connectors);
+
+    for(const Connector& c1 : connectors)
+    {
+        const TileLocation otherLocation = location + c1.direction;
+        AbstractCircuitNode *node2 = nodeAt(otherLocation);
+
+        auto cableA = node1->getContacts().at(c1.nodeContact).cable;
+
+        if(!node2)
+        {
+            // Detach our cable if zero length
+            if(cableA && !verifiedCables.contains(cableA))
+            {
+                if(!cablePath(cableA).validNotZero())
+                {
+                    node1->detachCable(c1.nodeContact);
+                    deleteCable(cableA);
+                    cableA = nullptr;
+                }
+            }
+
+            if(cableA)
+                continue; // Already connected
+
+            // There is no other node adjacent to us
+            // And we are not connected to a cable
+            // Let's see if there is a cable in the next tile
+            CircuitCable *foundCable = nullptr;
+            const TileCablePair pair = cablesAt(otherLocation);
+            for(CircuitCable *cable : {pair.first, pair.second})
+            {
+                if(!cable)
+                    continue;
+
+                const CableGraphPath& path = cablePath(cable);
+                if(path.sideA() == location)
+                {
+                    if(path.startDirection() == ~c1.direction)
+                    {
+                        foundCable = cable;
+                        break;
+                    }
+                }
+                else if(path.sideB() == location)
+                {
+                    if(path.endDirection() == ~c1.direction)
+                    {
+                        foundCable = cable;
+                        break;
+                    }
+                }
+            }
+
+            // We found a suitable cable, check it
+            if(foundCable)
+                checkCable(foundCable);
+
+            continue;
+        }
+
+        std::vector<Connector> otherConnectors;
+        getConnectors(node2, otherConnectors);
+
+        for(const Connector& c2 : otherConnectors)
+        {
+            if(c2.direction != ~c1.direction)
+                continue;
+
+            // We have a match
+            connectNodes(node1, node2, c1, c2, verifiedCables);
+            break;
+        }
+    }
+}
+
+void CircuitSheetLayout::refreshNodeConnections(AbstractCircuitNode *node, bool tryReconnect)
+{
+    // Detach all contacts, will be revaluated later
+    const auto& contacts = node->getContacts();
+
+    for(int i = 0; i < contacts.size(); i++)
+    {
+        CircuitCable *cable = contacts.at(i).cable;
+        node->detachCable(i);
+
+        if(cable)
+        {
+            // Delete zero length cables
+            // This way also opposite node becomes unconnected
+            // And can receive future connections
+            // Even before ending Editing mode
+            auto it = mCables.find(cable);
+            if(it != mCables.end() && !it->second.validNotZero())
+            {
+                deleteCable(cable);
+            }
+        }
+    }
+
+    if(!tryReconnect)
+        return;
+
+    // Try reconnect node
+    QVector<CircuitCable *> dummy;
+    checkNode(node, dummy);
+}
+
+void CircuitSheetLayout::clearLayout()
+{
+    // Disable all circuits
+    for(AbstractCircuitNode *powerSource : std::as_const(mPowerSources))
+    {
+        powerSource->setSourceEnabled(false);
+    }
+
+    // Cables detach from nodes when deleted
+    std::vector<CircuitCable *> cableCopy;
+    cableCopy.reserve(mCables.size());
+    for(const auto& it : mCables)
+        cableCopy.push_back(it.first);
+
+    for(CircuitCable *cable : cableCopy)
+        deleteCable(cable);
+    Q_ASSERT(mCables.empty());
+
+    std::vector<AbstractCircuitNode *> nodeCopy;
+    nodeCopy.reserve(mPlacements.size());
+    for(const auto& it : mPlacements)
+        nodeCopy.push_back(it.first);
+
+    for(AbstractCircuitNode *node : nodeCopy)
+        deleteNode(node);
+    Q_ASSERT(mNodeMap.empty());
+    Q_ASSERT(mPowerSources.isEmpty());
+}
+
+void CircuitSheetLayout::loadLayout(const QJsonObject &obj)
+{
+    // Cables are added first, so nodes on occupied tiles
+    // get moved to a free location
+    const QJsonArray cables = obj.value("cables").toArray();
+    for(const QJsonValue& v : cables)
+    {
+        loadCable(v.toObject());
+    }
+
+    const QJsonArray nodes = obj.value("nodes").toArray();
+    for(const QJsonValue& v : nodes)
+    {
+        loadNode(v.toObject());
+    }
+}
+
+void CircuitSheetLayout::saveLayout(QJsonObject &obj) const
+{
+    // Sort cables by start position
+    QVector<std::pair<CircuitCable *, const CableGraphPath *>> sortedCables;
+    sortedCables.reserve(mCables.size());
+
+    for(const auto& it : mCables)
+    {
+        // Do not save zero length cables
+        // They can be automatically generated at load
+        if(it.second.validNotZero())
+            sortedCables.append({it.first, &it.second});
+    }
+
+    std::sort(sortedCables.begin(),
+              sortedCables.end(),
+              [](const auto& a, const auto& b) -> bool
+    {
+        const CableGraphPath& pathA = *a.second;
+        const CableGraphPath& pathB = *b.second;
+
+        // Do not use sideA() because it adds startDirection() to TileLocation
+        TileLocation startA = pathA.first();
+        TileLocation startB = pathB.first();
+
+        const bool reverseA = pathA.needsReversing();
+        if(reverseA)
+            startA = pathA.last();
+
+        const bool reverseB = pathB.needsReversing();
+        if(reverseB)
+            startB = pathB.last();
+
+        // Orded by Y, then by X, the by direction
+        if(startA.y == startB.y)
+        {
+            if(startA.x == startB.x)
+            {
+                Connector::Direction dirA = pathA.startDirection();
+                if(reverseA)
+                    dirA = pathA.endDirection();
+
+                Connector::Direction dirB = pathB.startDirection();
+                if(reverseB)
+                    dirB = pathB.endDirection();
+
+                return dirA < dirB;
+            }
+
+            return startA.x < startB.x;
+        }
+        return startA.y < startB.y;
+    });
+
+    QJsonArray cables;
+    for(const auto& it : std::as_const(sortedCables))
+    {
+        QJsonObject cableObj;
+        saveCable(it.first, cableObj);
+        cables.append(cableObj);
+    }
+
+    obj["cables"] = cables;
+
+    // Sort nodes by position
+    QVector<std::pair<TileLocation, AbstractCircuitNode *>> sortedNodes;
+    sortedNodes.reserve(mNodeMap.size());
+
+    for(const auto& it : mNodeMap)
+    {
+        sortedNodes.append(it);
+    }
+
+    std::sort(sortedNodes.begin(),
+              sortedNodes.end(),
+              [](const auto& a, const auto& b) -> bool
+    {
+        const TileLocation& locA = a.first;
+        const TileLocation& locB = b.first;
+
+        // Order by Y, then by X
+        if(locA.y == locB.y)
+            return locA.x < locB.x;
+        return locA.y < locB.y;
+    });
+
+    QJsonArray nodes;
+    for(const auto& it : std::as_const(sortedNodes))
+    {
+        QJsonObject nodeObj;
+        saveNode(it.second, nodeObj);
+        nodes.append(nodeObj);
+    }
+
+    obj["nodes"] = nodes;
+}
+
+AbstractCircuitNode *CircuitSheetLayout::loadNode(const QJsonObject &obj, int16_t dx, int16_t dy)
+{
+    CreateNodeFunc create = nodeCreateFunc(obj.value("type").toString());
+    if(!create)
+        return nullptr;
+
+    AbstractCircuitNode *node = create(mModeMgr, mOwner);
+    if(!node->loadFromJSON(obj))
+    {
+        delete node;
+        return nullptr;
+    }
+
+    TileLocation tile{0, 0};
+    tile.x = obj.value("x").toInt();
+    tile.y = obj.value("y").toInt();
+
+    insertNode(node, tile.adjusted(dx, dy),
+               TileRotate(obj.value("rotation").toInt()));
+
+    onNodeLoaded(node, obj);
+
+    return node;
+}
+
+CircuitCable *CircuitSheetLayout::loadCable(const QJsonObject &obj, int16_t dx, int16_t dy)
+{
+    const CableGraphPath path = CableGraphPath::loadFromJSON(obj.value("path").toObject());
+    if(!path.validNotZero())
+        return nullptr;
+
+    return insertCable(path.translatedBy(dx, dy));
+}
+
+void CircuitSheetLayout::saveNode(AbstractCircuitNode *node, QJsonObject &obj) const
+{
+    const NodePlacement& placement = mPlacements.at(node);
+    obj["x"] = placement.location.x;
+    obj["y"] = placement.location.y;
+
+    obj["rotation"] = int(placement.rotate);
+
+    node->saveToJSON(obj);
+
+    saveNodeExtra(node, obj);
+}
+
+void CircuitSheetLayout::saveCable(CircuitCable *cable, QJsonObject &obj) const
+{
+    QJsonObject pathObj;
+    CableGraphPath::saveToJSON(mCables.at(cable), pathObj);
+    obj["path"] = pathObj;
+}
+
+void CircuitSheetLayout::onNodeLoaded(AbstractCircuitNode *, const QJsonObject &)
+{
+
+}
+
+void CircuitSheetLayout::saveNodeExtra(AbstractCircuitNode *, QJsonObject &) const
+{
+
+}
+
+void CircuitSheetLayout::onCableAdded(CircuitCable *)
+{
+
+}
+
+void CircuitSheetLayout::onCableRemoved(CircuitCable *)
+{
+
+}
+
+void CircuitSheetLayout::onCablePathChanged(CircuitCable *)
+{
+
+}
@@ -0,0 +1,274 @@
+/**
+ * src/circuits/circuitsheetlayout.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef CIRCUITSHEETLAYOUT_H
+#define CIRCUITSHEETLAYOUT_H
+
+#include <QVector>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <vector>
+
+#include "cablegraphpath.h"
+
+#include "../utils/tilerotate.h"
+
+class AbstractCircuitNode;
+class CircuitCable;
+
+class ModeManager;
+
+class QObject;
+class QJsonObject;
+
+/*!
+ * \brief The CircuitSheetLayout class
+ *
+ * Tile placement of nodes and cables of a circuit sheet.
+ * Cables are connected to nodes based on tiles.
+ *
+ * Used by both CircuitScene and HeadlessCircuitList so that
+ * a sheet is wired the same way with and without graphics.
+ */
+class CircuitSheetLayout
+{
+public:
+    // On a tile there can be 2 cables if they go in squared directions
+    // See CableGraphPath::addTile()
+    typedef std::pair<CircuitCable *, CircuitCable *> TileCablePair;
+    typedef std::pair<std::optional<CableGraphPath>, std::optional<CableGraphPath>> TileCablePathPair;
+    typedef std::unordered_map<TileLocation, TileCablePair, TileLocationHash> CablePairMap;
+    typedef std::unordered_map<TileLocation, AbstractCircuitNode *, TileLocationHash> NodeMap;
+    typedef std::unordered_map<CircuitCable *, CableGraphPath> CableMap;
+
+    struct NodePlacement
+    {
+        TileLocation location = TileLocation::invalid;
+        TileRotate rotate = TileRotate::Deg0;
+    };
+
+    typedef AbstractCircuitNode *(*CreateNodeFunc)(ModeManager *mgr, QObject *parent);
+
+    CircuitSheetLayout(ModeManager *mgr, QObject *owner);
+    virtual ~CircuitSheetLayout();
+
+    static CreateNodeFunc nodeCreateFunc(const QString& nodeType);
+
+    inline const QVector<AbstractCircuitNode *>& powerSources() const
+    {
+        return mPowerSources;
+    }
+
+    inline const NodeMap& nodeMap() const { return mNodeMap; }
+    inline const CableMap& cableMap() const { return mCables; }
+
+    AbstractCircuitNode *nodeAt(TileLocation l) const;
+    NodePlacement nodePlacement(AbstractCircuitNode *node) const;
+    bool containsNode(AbstractCircuitNode *node) const;
+
+    TileCablePair cablesAt(TileLocation l) const;
+    const CableGraphPath& cablePath(CircuitCable *cable) const;
+
+    bool isLocationFree(TileLocation l) const;
+    TileLocation getFreeLocationNear(TileLocation origin = TileLocation::invalid) const;
+
+    bool cablePathIsValid(const CableGraphPath& cablePath, CircuitCable *ignoredCable) const;
+
+    // Node is moved near location if it's occupied
+    void insertNode(AbstractCircuitNode *node, TileLocation location, TileRotate rotate);
+    void deleteNode(AbstractCircuitNode *node);
+
+    // Locations are swapped all together, new locations must be free
+    void moveNodes(const std::vector<std::pair<AbstractCircuitNode *, TileLocation>>& moves);
+    void setNodeRotate(AbstractCircuitNode *node, TileRotate rotate);
+
+    CircuitCable *insertCable(const CableGraphPath& path);
+    void deleteCable(CircuitCable *cable);
+
+    void setCablePath(CircuitCable *cable, const CableGraphPath& path,
+                      bool registerTiles = true);
+
+    void addCableTiles(CircuitCable *cable);
+    void removeCableTiles(CircuitCable *cable);
+
+    bool splitCable(CircuitCable *cable, const TileLocation &splitLoc);
+
+    void calculateConnections();
+    bool checkCable(CircuitCable *cable);
+    void checkNode(AbstractCircuitNode *node, QVector<CircuitCable *> &verifiedCables);
+    void refreshNodeConnections(AbstractCircuitNode *node, bool tryReconnect);
+
+    void clearLayout();
+
+    // Nodes and cables are not connected, call calculateConnections()
+    void loadLayout(const QJsonObject& obj);
+    void saveLayout(QJsonObject& obj) const;
+
+    AbstractCircuitNode *loadNode(const QJsonObject& obj,
+                                  int16_t dx = 0, int16_t dy = 0);
+    CircuitCable *loadCable(const QJsonObject& obj,
+                            int16_t dx = 0, int16_t dy = 0);
+
+    void saveNode(AbstractCircuitNode *node, QJsonObject& obj) const;
+    void saveCable(CircuitCable *cable, QJsonObject& obj) const;
+
+protected:
+    // Graphics properties are not part of the layout
+    virtual void onNodeLoaded(AbstractCircuitNode *node, const QJsonObject& obj);
+    virtual void saveNodeExtra(AbstractCircuitNode *node, QJsonObject& obj) const;
+
+    virtual void onCableAdded(CircuitCable *cable);
+    virtual void onCableRemoved(CircuitCable *cable);
+    virtual void onCablePathChanged(CircuitCable *cable);
+
+private:
+    void connectNodes(AbstractCircuitNode *node1,
+                      AbstractCircuitNode *node2,
+                      const Connector& c1, const Connector& c2,
+                      QVector<CircuitCable *>& verifiedCables);
+
+    void getConnectors(AbstractCircuitNode *node,
+                       std::vector<Connector>& connectors) const;
+
+private:
+    ModeManager *mModeMgr;
+    QObject *mOwner;
+
+    NodeMap mNodeMap;
+    std::unordered_map<AbstractCircuitNode *, NodePlacement> mPlacements;
+
+    QVector<AbstractCircuitNode *> mPowerSources;
+
+    CableMap mCables;
+    CablePairMap mCableTiles;
+};
+
+template <typename Func>
+bool spiral_helper(const TileLocation& origin,
+                   TileLocation &outTile,
+                   Func func)
+{
+    // Loop in a square spiral around origin
+    // For each tile, func is called
+    // If func returns true, looping is stopped
+    const int N = 1000;
+    int16_t x = 0;
+    int16_t y = 0;
+    for(int i = 0; i < N; ++i)
+    {
+        const TileLocation tile = origin.adjusted(x, y);
+        if(func(tile))
+        {
+            outTile = tile;
+            return true;
+        }
+
+        if(std::abs(x) <= std::abs(y) && (x != y || x >= 0))
+            x += ((y >= 0) ? 1 : -1);
+        else
+            y += ((x >= 0) ? -1 : 1);
+    }
+
+    return false;
+}
+
+template <typename TileHasNode, typename GetCablePairAt>
+bool cablePathIsValid_helper(const CableGraphPath &cablePath,
+                             TileHasNode hasNode, GetCablePairAt getCablePairAt)
+{
+    // Check all tiles are free
+    if(cablePath.isZeroLength())
+        return true;
+
+    std::unordered_set<TileLocation, TileLocationHash> repeatedTiles;
+
+    for(int i = 0; i < cablePath.getTilesCount(); i++)
+    {
+        TileLocation tile = cablePath.at(i);
+
+        if(hasNode(tile))
+        {
+            return false;
+        }
+
+        CircuitSheetLayout::TileCablePathPair pair = getCablePairAt(tile);
+
+        if(!pair.first && !pair.second)
+        {
+            // Tile is free, check next one
+            repeatedTiles.insert(tile);
+            continue;
+        }
+
+        if(pair.first && pair.second)
+        {
+            // There are already 2 cables on this tile
+            return false;
+        }
+
+        // At this point tile has 1 cable, either first or second
+        if(repeatedTiles.find(tile) != repeatedTiles.cend())
+        {
+            // Cable passes 2 times on same tile
+            // Then this tile cannot have other cables
+            return false;
+        }
+        repeatedTiles.insert(tile);
+
+        // Check if other cable can co-exist with us in same tile
+        const CableGraphPath& otherPath = pair.first ? pair.first.value() : pair.second.value();
+        int otherIdx = otherPath.tiles().indexOf(tile);
+        Q_ASSERT_X(otherIdx >= 0,
+                   "cablePathIsValid_helper",
+                   "other cable does not contain tile");
+
+        const bool isLastTile = i == cablePath.getTilesCount() - 1;
+        const bool canCheckExit = !isLastTile || cablePath.isComplete();
+
+        // Check if first passage was straigh
+        const auto enterDir1 = cablePath.getEnterDirection(i);
+        const auto exitDir1 = cablePath.getExitDirection(i);
+        if(canCheckExit && enterDir1 != ~exitDir1)
+        {
+            // Directions are not opposite, it bends
+            return false;
+        }
+
+        const auto enterDir2 = otherPath.getEnterDirection(otherIdx);
+        const auto exitDir2 = otherPath.getExitDirection(otherIdx);
+        if(enterDir2 != ~exitDir2)
+        {
+            // Directions are not opposite, it bends
+            return false;
+        }
+
+        if(enterDir1 == enterDir2 || enterDir1 == exitDir2)
+            return false; // Both passages have same direction
+    }
+
+    return true;
+}
+
+#endif // CIRCUITSHEETLAYOUT_H
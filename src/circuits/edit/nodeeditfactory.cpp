@@ -68,6 +68,15 @@ AbstractNodeGraphItem *NodeEditFactory::createItem(const QString &nodeType,
     return item;
 }
 
+AbstractNodeGraphItem *NodeEditFactory::createGraph(AbstractCircuitNode *node) const
+{
+    const FactoryItem *factory = getItemForType(node->nodeType());
+    if(!factory || !factory->createGraph)
+        return nullptr;
+
+    return factory->createGraph(node);
+}
+
 void NodeEditFactory::editItem(QWidget *parent,
                                AbstractNodeGraphItem *item,
                                ViewManager *viewMgr,
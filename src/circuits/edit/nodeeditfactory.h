@@ -46,6 +46,7 @@ class NodeEditFactory : public QObject
     NodeEditFactory(QObject *parent);
 
     typedef AbstractNodeGraphItem *(*CreateFunc)(CircuitScene *parent, ModeManager *mgr);
+    typedef AbstractNodeGraphItem *(*CreateGraphFunc)(AbstractCircuitNode *node);
     typedef QWidget*(*EditFunc)(AbstractNodeGraphItem *item, ViewManager *mgr);
 
     enum class NeedsName
@@ -60,6 +61,7 @@ class NodeEditFactory : public QObject
         QString nodeType;
         QString prettyName;
         CreateFunc create = nullptr;
+        CreateGraphFunc createGraph = nullptr;
         EditFunc edit = nullptr;
         QChar shortcutLetter;
 
@@ -70,6 +72,7 @@ class NodeEditFactory : public QObject
 
     AbstractNodeGraphItem *createItem(const QString& nodeType,
                                       CircuitScene *scene);
+    AbstractNodeGraphItem *createGraph(AbstractCircuitNode *node) const;
     void editItem(QWidget *parent, AbstractNodeGraphItem *item,
                   ViewManager *viewMgr, bool allowDelete = true);
     void editCable(QWidget *parent, CableGraphItem *item);
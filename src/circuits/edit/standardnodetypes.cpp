@@ -158,6 +158,12 @@ AbstractNodeGraphItem* addNewNodeToScene(CircuitScene *s, ModeManager *mgr)
     return graph;
 }
 
+template <typename Graph>
+AbstractNodeGraphItem* createGraphForNode(AbstractCircuitNode *node)
+{
+    return new Graph(static_cast<typename Graph::Node *>(node));
+}
+
 QWidget *defaultDeviatorEdit(AbstractDeviatorGraphItem *item, ViewManager *viewMgr)
 {
     AbstractDeviatorNode *node = item->deviatorNode();
@@ -625,6 +631,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("On/Off switch");
         factory.shortcutLetter = 'O';
         factory.create = &addNewNodeToScene<OnOffGraphItem>;
+        factory.createGraph = &createGraphForNode<OnOffGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             OnOffSwitchNode *node = static_cast<OnOffSwitchNode *>(item->getAbstractNode());
@@ -664,6 +671,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Power Source");
         factory.shortcutLetter = 'P';
         factory.create = &addNewNodeToScene<PowerSourceGraphItem>;
+        factory.createGraph = &createGraphForNode<PowerSourceGraphItem>;
         factory.edit = nullptr;
 
         factoryReg->registerFactory(factory);
@@ -676,6 +684,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Simple Node");
         factory.shortcutLetter = 'F';
         factory.create = &addNewNodeToScene<SimpleNodeGraphItem>;
+        factory.createGraph = &createGraphForNode<SimpleNodeGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             SimpleCircuitNode *node = static_cast<SimpleCircuitNode *>(item->getAbstractNode());
@@ -717,6 +726,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Relay Power");
         factory.shortcutLetter = 'E';
         factory.create = &addNewNodeToScene<RelaisPowerGraphItem>;
+        factory.createGraph = &createGraphForNode<RelaisPowerGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             RelaisPowerNode *node = static_cast<RelaisPowerNode *>(item->getAbstractNode());
@@ -829,6 +839,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Relay Contact");
         factory.shortcutLetter = 'R';
         factory.create = &addNewNodeToScene<RelaisContactGraphItem>;
+        factory.createGraph = &createGraphForNode<RelaisContactGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             RelaisContactNode *node = static_cast<RelaisContactNode *>(item->getAbstractNode());
@@ -900,6 +911,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Screen Relay Power");
         factory.shortcutLetter = 'V';
         factory.create = &addNewNodeToScene<ScreenRelaisPowerGraphItem>;
+        factory.createGraph = &createGraphForNode<ScreenRelaisPowerGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             ScreenRelaisPowerNode *node = static_cast<ScreenRelaisPowerNode *>(item->getAbstractNode());
@@ -952,6 +964,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Screen Relay Contact");
         factory.shortcutLetter = 'X';
         factory.create = &addNewNodeToScene<ScreenRelaisContactGraphItem>;
+        factory.createGraph = &createGraphForNode<ScreenRelaisContactGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             ScreenRelaisContactNode *node = static_cast<ScreenRelaisContactNode *>(item->getAbstractNode());
@@ -1009,6 +1022,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Button Contact");
         factory.shortcutLetter = 'B';
         factory.create = &addNewNodeToScene<ButtonContactGraphItem>;
+        factory.createGraph = &createGraphForNode<ButtonContactGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             ButtonContactNode *node = static_cast<ButtonContactNode *>(item->getAbstractNode());
@@ -1103,6 +1117,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Light Bulb");
         factory.shortcutLetter = 'L';
         factory.create = &addNewNodeToScene<LightBulbGraphItem>;
+        factory.createGraph = &createGraphForNode<LightBulbGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             return defaultSimpleActivationEdit(static_cast<SimpleActivationGraphItem *>(item),
@@ -1120,6 +1135,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Electromagnet");
         factory.shortcutLetter = 'M';
         factory.create = &addNewNodeToScene<ElectroMagnetPowerGraphItem>;
+        factory.createGraph = &createGraphForNode<ElectroMagnetPowerGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             return defaultSimpleActivationEdit(static_cast<SimpleActivationGraphItem *>(item),
@@ -1137,6 +1153,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Electromagnet Contact");
         factory.shortcutLetter = QChar();
         factory.create = &addNewNodeToScene<ElectroMagnetContactGraphItem>;
+        factory.createGraph = &createGraphForNode<ElectroMagnetContactGraphItem>;
         factory.edit = &defaultMagnetContactEdit;
 
         factoryReg->registerFactory(factory);
@@ -1149,6 +1166,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.nodeType = ACEIButtonGraphItem::CustomNodeType;
         factory.prettyName = tr("ACEI Button");
         factory.create = &addNewNodeToScene<ACEIButtonGraphItem>;
+        factory.createGraph = &createGraphForNode<ACEIButtonGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             ACEIButtonGraphItem *specialItem = static_cast<ACEIButtonGraphItem *>(item);
@@ -1208,6 +1226,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.nodeType = ACEILeverGraphItem::CustomNodeType;
         factory.prettyName = tr("ACEI Lever");
         factory.create = &addNewNodeToScene<ACEILeverGraphItem>;
+        factory.createGraph = &createGraphForNode<ACEILeverGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             ACEILeverGraphItem *specialItem = static_cast<ACEILeverGraphItem *>(item);
@@ -1275,6 +1294,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.nodeType = ACESasibLeverGraphItem::CustomNodeType;
         factory.prettyName = tr("ACE Sasib Lever");
         factory.create = &addNewNodeToScene<ACESasibLeverGraphItem>;
+        factory.createGraph = &createGraphForNode<ACESasibLeverGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             ACESasibLeverGraphItem *specialItem = static_cast<ACESasibLeverGraphItem *>(item);
@@ -1316,6 +1336,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Lever Contact");
         factory.shortcutLetter = 'K';
         factory.create = &addNewNodeToScene<LeverContactGraphItem>;
+        factory.createGraph = &createGraphForNode<LeverContactGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             LeverContactNode *node = static_cast<LeverContactNode *>(item->getAbstractNode());
@@ -1408,6 +1429,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Polarity Inversion");
         factory.shortcutLetter = 'I';
         factory.create = &addNewNodeToScene<PolarityInversionGraphItem>;
+        factory.createGraph = &createGraphForNode<PolarityInversionGraphItem>;
         factory.edit = nullptr;
 
         factoryReg->registerFactory(factory);
@@ -1421,6 +1443,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("BiFiLar1zaT0R");
         factory.shortcutLetter = 'Q';
         factory.create = &addNewNodeToScene<BifilarizatorGraphItem>;
+        factory.createGraph = &createGraphForNode<BifilarizatorGraphItem>;
         factory.edit = nullptr;
 
         factoryReg->registerFactory(factory);
@@ -1434,6 +1457,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Sound Node");
         factory.shortcutLetter = 'U';
         factory.create = &addNewNodeToScene<SoundCircuitGraphItem>;
+        factory.createGraph = &createGraphForNode<SoundCircuitGraphItem>;
         factory.edit = [](AbstractNodeGraphItem *item, ViewManager *viewMgr) -> QWidget*
         {
             return defaultSimpleActivationEdit(static_cast<SimpleActivationGraphItem *>(item), viewMgr,
@@ -1451,6 +1475,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Diode");
         factory.shortcutLetter = 'D';
         factory.create = &addNewNodeToScene<DiodeGraphItem>;
+        factory.createGraph = &createGraphForNode<DiodeGraphItem>;
         factory.edit = nullptr;
 
         factoryReg->registerFactory(factory);
@@ -1464,6 +1489,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Remote Connection");
         factory.shortcutLetter = 'T';
         factory.create = &addNewNodeToScene<RemoteCableCircuitGraphItem>;
+        factory.createGraph = &createGraphForNode<RemoteCableCircuitGraphItem>;
         factory.edit = &defaultRemoteCableNodeEdit;
 
         factoryReg->registerFactory(factory);
@@ -1476,6 +1502,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.nodeType = TransformerGraphItem::Node::NodeType;
         factory.prettyName = tr("Transformer");
         factory.create = &addNewNodeToScene<TransformerGraphItem>;
+        factory.createGraph = &createGraphForNode<TransformerGraphItem>;
         factory.edit = nullptr;
 
         factoryReg->registerFactory(factory);
@@ -1488,6 +1515,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.nodeType = ResistorGraphItem::Node::NodeType;
         factory.prettyName = tr("Resistor");
         factory.create = &addNewNodeToScene<ResistorGraphItem>;
+        factory.createGraph = &createGraphForNode<ResistorGraphItem>;
         factory.edit = nullptr;
 
         factoryReg->registerFactory(factory);
@@ -1501,6 +1529,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Traintastic Sensor Contact");
         factory.shortcutLetter = 'A';
         factory.create = &addNewNodeToScene<TraintasticSensorGraphItem>;
+        factory.createGraph = &createGraphForNode<TraintasticSensorGraphItem>;
         factory.edit = &defaultTraintasticSensorContactEdit;
 
         factoryReg->registerFactory(factory);
@@ -1514,6 +1543,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Traintastic Turnout Node");
         factory.shortcutLetter = QChar();
         factory.create = &addNewNodeToScene<TraintasticTurnoutGraphItem>;
+        factory.createGraph = &createGraphForNode<TraintasticTurnoutGraphItem>;
         factory.edit = &defaultTraintasticTurnoutNodeEdit;
 
         factoryReg->registerFactory(factory);
@@ -1527,6 +1557,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Command Node");
         factory.shortcutLetter = QChar();
         factory.create = &addNewNodeToScene<CommandNodeGraphItem>;
+        factory.createGraph = &createGraphForNode<CommandNodeGraphItem>;
         factory.edit = &defaultCommandNodeEdit;
 
         factoryReg->registerFactory(factory);
@@ -1540,6 +1571,7 @@ void StandardNodeTypes::registerTypes(NodeEditFactory *factoryReg)
         factory.prettyName = tr("Axle Counter");
         factory.shortcutLetter = QChar();
         factory.create = &addNewNodeToScene<TraintasticAxleCounterGraphItem>;
+        factory.createGraph = &createGraphForNode<TraintasticAxleCounterGraphItem>;
         factory.edit = &defaultTraintasticAxleCounterEdit;
 
         factoryReg->registerFactory(factory);
@@ -21,17 +21,52 @@
  */
 
 #include "electriccircuit.h"
+#include "circuitgraph.h"
+#include "simulationprofiler.h"
 
 #include "nodes/abstractcircuitnode.h"
 #include "nodes/circuitcable.h"
 
-#include <QSet>
+#include <QHash>
 #include <QVarLengthArray>
 
+#include <algorithm>
+
 #include <QDebug>
 
 static int allCircuitsCount = 0;
 
+ElectricCircuit::Stats ElectricCircuit::mStats;
+quint64 ElectricCircuit::mConnectionsEpoch = 0;
+bool ElectricCircuit::mIncrementalRecompute = true;
+quint64 ElectricCircuit::mVisitEpoch = 0;
+bool ElectricCircuit::mShuntDetection = false;
+QHash<ElectricCircuit::ExitKey, QVector<ElectricCircuit::ExitEntry>> ElectricCircuit::mExitIndex;
+
+ElectricCircuit::FreeBlock *ElectricCircuit::mFreeBlocks = nullptr;
+int ElectricCircuit::mFreeBlocksCount = 0;
+QVector<QVector<ElectricCircuit::Item>> ElectricCircuit::mItemsPool;
+
+// Keep enough memory for big route setting bursts
+static constexpr int MaxPooledCircuits = 4096;
+static constexpr int MaxPooledItemVectors = 1024;
+static constexpr qsizetype MaxPooledItemsCapacity = 1024;
+
+// Walks can be nested, each needs its own items
+static constexpr int MaxPooledWalkItems = 16;
+static constexpr qsizetype MaxWalkItemsCapacity = 1 << 16;
+
+int ElectricCircuit::mDeleteScopeDepth = 0;
+QVector<ElectricCircuit *> ElectricCircuit::mDeadCircuits;
+
+ElectricCircuit::ItemPath *ElectricCircuit::mWalkBase = nullptr;
+
+QVector<ElectricCircuit::ItemVector> ElectricCircuit::mWalkItemsPool;
+int ElectricCircuit::mMaxWalkDepth = ElectricCircuit::DefaultMaxWalkDepth;
+
+FrameStack<ElectricCircuit::PassFrame> ElectricCircuit::mPassStack;
+FrameStack<ElectricCircuit::SearchFrame> ElectricCircuit::mSearchStack;
+
 bool containsNode(const ElectricCircuit::ItemVector &items, AbstractCircuitNode *node, int nodeContact, CircuitPole pole)
 {
     for(const ElectricCircuit::Item& item : items)
@@ -77,23 +112,259 @@ bool containsNode(Iterator beginIt, Iterator endIt, AbstractCircuitNode *node, i
 ElectricCircuit::ElectricCircuit()
 {
     allCircuitsCount++;
+    mStats.circuitsCreated++;
+    SimulationProfiler::circuitCreated();
+
+    if(!mItemsPool.isEmpty())
+    {
+        // Reuse item storage of a deleted circuit
+        mItems.adoptStorage(mItemsPool.takeLast());
+        mStats.itemsPoolHits++;
+    }
+    else
+    {
+        mStats.itemsPoolMisses++;
+    }
 }
 
 ElectricCircuit::~ElectricCircuit()
 {
     allCircuitsCount--;
+    mStats.circuitsDestroyed++;
+    SimulationProfiler::circuitDestroyed();
+
+    unregisterExits();
+
+    // Capacity is kept only if storage is not shared
+    QVector<Item> storage = mItems.takeStorage();
+
+    if(storage.capacity() > 0 &&
+            storage.capacity() <= MaxPooledItemsCapacity &&
+            mItemsPool.size() < MaxPooledItemVectors)
+    {
+        mItemsPool.append(std::move(storage));
+    }
+}
+
+void *ElectricCircuit::operator new(std::size_t size)
+{
+    Q_ASSERT(size == sizeof(ElectricCircuit));
+
+    if(mFreeBlocks)
+    {
+        FreeBlock *block = mFreeBlocks;
+        mFreeBlocks = block->next;
+        mFreeBlocksCount--;
+        mStats.poolHits++;
+        return block;
+    }
+
+    mStats.poolMisses++;
+    return ::operator new(size);
+}
+
+void ElectricCircuit::operator delete(void *ptr)
+{
+    if(!ptr)
+        return;
+
+    if(mFreeBlocksCount >= MaxPooledCircuits)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = mFreeBlocks;
+    mFreeBlocks = block;
+    mFreeBlocksCount++;
+}
+
+void ElectricCircuit::releasePool()
+{
+    while(mFreeBlocks)
+    {
+        FreeBlock *block = mFreeBlocks;
+        mFreeBlocks = block->next;
+        ::operator delete(block);
+    }
+
+    mFreeBlocksCount = 0;
+
+    mItemsPool.clear();
+    mItemsPool.squeeze();
+
+    mWalkItemsPool.clear();
+    mWalkItemsPool.squeeze();
+
+    mPassStack.squeeze();
+    mSearchStack.squeeze();
+}
+
+void ElectricCircuit::resetStats()
+{
+    mStats = Stats();
+}
+
+void ElectricCircuit::setMaxWalkDepth(int depth)
+{
+    mMaxWalkDepth = qMax(1, depth);
+}
+
+void ElectricCircuit::setShuntDetectionEnabled(bool val)
+{
+    if(mShuntDetection == val)
+        return;
+
+    mShuntDetection = val;
+
+    if(!mShuntDetection)
+    {
+        // Circuits will skip unregistering
+        mExitIndex.clear();
+        mExitIndex.squeeze();
+    }
+}
+
+void ElectricCircuit::registerExits()
+{
+    if(!mShuntDetection || mExitsRegistered)
+        return;
+
+    for(int i = 0; i < mItems.size(); i += 2)
+    {
+        const Item& item = mItems.at(i);
+        Q_ASSERT(item.isNode);
+
+        mExitIndex[{item.node.node, item.node.toContact, item.node.toPole()}]
+            .append({this, i});
+    }
+
+    mExitsRegistered = true;
+}
+
+void ElectricCircuit::unregisterExits()
+{
+    if(!mExitsRegistered)
+        return;
+
+    mExitsRegistered = false;
+
+    if(!mShuntDetection)
+        return; // Index was already cleared
+
+    // Items did not change since registration
+    for(int i = 0; i < mItems.size(); i += 2)
+    {
+        const Item& item = mItems.at(i);
+
+        auto it = mExitIndex.find({item.node.node, item.node.toContact, item.node.toPole()});
+        if(it == mExitIndex.end())
+            continue;
+
+        it->removeIf([this](const ExitEntry& entry) -> bool
+        {
+            return entry.circuit == this;
+        });
+
+        if(it->isEmpty())
+            mExitIndex.erase(it);
+    }
+}
+
+ElectricCircuit::DeleteScope::DeleteScope()
+{
+    mDeleteScopeDepth++;
+}
+
+ElectricCircuit::DeleteScope::~DeleteScope()
+{
+    Q_ASSERT(mDeleteScopeDepth > 0);
+    if(--mDeleteScopeDepth > 0)
+        return;
+
+    // Outermost scope, now really free dead circuits
+    const QVector<ElectricCircuit *> deadCircuits = std::move(mDeadCircuits);
+    mDeadCircuits.clear();
+    qDeleteAll(deadCircuits);
+}
+
+ElectricCircuit::WalkBaseScope::WalkBaseScope(ItemPath *base)
+    : mPrevBase(mWalkBase)
+{
+    mWalkBase = base;
+}
+
+ElectricCircuit::WalkBaseScope::~WalkBaseScope()
+{
+    mWalkBase = mPrevBase;
+}
+
+ElectricCircuit::WalkItems::WalkItems()
+{
+    if(!mWalkItemsPool.isEmpty())
+        items = mWalkItemsPool.takeLast();
+}
+
+ElectricCircuit::WalkItems::~WalkItems()
+{
+    // Keep capacity for next walks
+    items.clear();
+
+    if(items.capacity() <= MaxWalkItemsCapacity &&
+            mWalkItemsPool.size() < MaxPooledWalkItems)
+        mWalkItemsPool.append(std::move(items));
+}
+
+void ElectricCircuit::setItemsFromWalk(const ItemVector &items, qsizetype extraItems)
+{
+    const qsizetype baseSize = mWalkBase ? mWalkBase->size() : 0;
+
+    if(baseSize == 0 || items.size() < baseSize
+            || !(items.at(baseSize - 1) == mWalkBase->last()))
+    {
+        // Walk did not start from a known path
+        setItems(items.begin(), items.end(), extraItems);
+        return;
+    }
+
+    // Share common prefix, copy only what was found by walk
+    mItems.forkFrom(*mWalkBase, baseSize);
+    mItems.reserve(items.size() + extraItems);
+    for(qsizetype i = baseSize; i < items.size(); i++)
+        mItems.append(items.at(i));
+}
+
+void ElectricCircuit::destroy()
+{
+    Q_ASSERT(!mDead);
+
+    unregisterExits();
+
+    if(mDeleteScopeDepth == 0)
+    {
+        delete this;
+        return;
+    }
+
+    // Keep memory until scope ends
+    mDead = true;
+    mDeadCircuits.append(this);
 }
 
 /**
  * @brief ElectricCircuit::enableCircuit
  * @return false if circuit is deleted
  */
-bool ElectricCircuit::enableCircuit(QVector<ElectricCircuit *> *deletedCircuits)
+bool ElectricCircuit::enableCircuit()
 {
     Q_ASSERT(!enabled);
     Q_ASSERT(!mItems.isEmpty());
     Q_ASSERT(getSource());
 
+    // Path is final now
+    buildNodeIndex();
+
     // Check for duplicate circuits
     // TODO: this should not happen
     AbstractCircuitNode *source = getSource();
@@ -103,7 +374,7 @@ bool ElectricCircuit::enableCircuit(QVector<ElectricCircuit *> *deletedCircuits)
         {
             // We are a duplicate
             //qDebug() << "DUPLICATE CIRCUIT OF TYPE:" << (type() == CircuitType::Closed ? "closed" : "open");
-            delete this;
+            destroy();
             return false;
         }
     }
@@ -121,8 +392,8 @@ bool ElectricCircuit::enableCircuit(QVector<ElectricCircuit *> *deletedCircuits)
     //     }
     // }
 
-    //if(checkShuntedByOtherCircuit())
-    //    return false;
+    if(mShuntDetection && checkShuntedByOtherCircuit())
+        return false;
 
     recalculateFlags();
 
@@ -141,8 +412,13 @@ bool ElectricCircuit::enableCircuit(QVector<ElectricCircuit *> *deletedCircuits)
 
     enabled = true;
 
-    //if(type() == CircuitType::Closed)
-    //    checkOtherShuntedByMe(deletedCircuits);
+    // Path is valid for current node state
+    mValidEpoch = mConnectionsEpoch;
+
+    registerExits();
+
+    if(mShuntDetection && type() == CircuitType::Closed)
+        checkOtherShuntedByMe();
 
     return true;
 }
@@ -177,8 +453,17 @@ bool ElectricCircuit::tryReachOpen(AbstractCircuitNode *goalNode)
                 break;
             }
 
+            if(!isNodeChangedSinceValidation(item.node.node))
+            {
+                // Node did not change since our path was validated
+                // So our passage is still valid, skip it
+                continue;
+            }
+
+            mStats.pathNodesRechecked++;
+
             nodeSourceCable.nodeContact = item.node.fromContact;
-            const auto connections = item.node.node->getActiveConnections(nodeSourceCable);
+            const auto connections = CircuitGraph::connections(item.node.node, nodeSourceCable);
 
             bool found = false;
             for(const auto &conn : connections)
@@ -207,15 +492,24 @@ bool ElectricCircuit::tryReachOpen(AbstractCircuitNode *goalNode)
 
     Q_ASSERT(nodeIdx >= 0);
     int firstIdxToRemove = nodeIdx + 1;
-    mItems.remove(firstIdxToRemove, mItems.size() - firstIdxToRemove);
+    mItems.truncate(firstIdxToRemove);
+    truncateNodeIndex(firstIdxToRemove);
 
     // Remove last node toContact
-    mItems.last().node.toContact = NodeItem::InvalidContact;
+    mItems.mutableLast().node.toContact = NodeItem::InvalidContact;
 
     enableCircuit();
     return true;
 }
 
+bool ElectricCircuit::isNodeChangedSinceValidation(AbstractCircuitNode *node) const
+{
+    if(!mIncrementalRecompute)
+        return true; // Always walk full path
+
+    return node->connectionsEpoch() > mValidEpoch;
+}
+
 void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
 {
     Q_ASSERT(type() == CircuitType::Closed);
@@ -227,19 +521,27 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
 
     insideDisable = true;
 
+    // Path will be removed, do not let others find it
+    unregisterExits();
+
+    // Circuits may be deleted while we walk, keep them checkable
+    DeleteScope scope;
+
     // Try re-enabling shunted circuits
     if(getSource()->isSourceEnabled(mItems.first().node.toContact))
     {
         // If our source is still enabled, try following our path
-        // Skip source node
+        // Skip source node.
+        // Connections epoch cannot skip unchanged nodes here:
+        // their other branches may have been shunted by this circuit
+        // and must be checked again now that it goes away.
         bool loadPassed = false;
 
-        QVector<ElectricCircuit *> deletedCircuits;
-
         for(int i = 2;  i < mItems.size();
              i += 2)
         {
-            const Item& item = mItems.at(i);
+            // Copy, forking our path may compact storage
+            const Item item = mItems.at(i);
             Q_ASSERT(item.isNode);
 
             if(item.node.node->isElectricLoadNode())
@@ -249,7 +551,7 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
             CableItem nodeSourceCable;
             nodeSourceCable.cable = mItems.at(i - 1).cable;
             nodeSourceCable.nodeContact = item.node.fromContact;
-            const auto connections = item.node.node->getActiveConnections(nodeSourceCable);
+            const auto connections = CircuitGraph::connections(item.node.node, nodeSourceCable);
 
             bool canGoForward = false;
             for(const auto& conn : connections)
@@ -268,8 +570,8 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
                                                             conn.cable.pole) == AnyCircuitType::None)
                 {
                     // Copy until cable before node
-                    ItemVector newItems(mItems.begin(),
-                                        mItems.begin() + i);
+                    WalkItems newWalk(mItems.begin(), mItems.begin() + i);
+                    ItemVector &newItems = newWalk.items;
 
                     // Custom pass node to join with existing circuit
                     Item customNodeItem = item;
@@ -284,8 +586,7 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
                     {
                         // Register an open circuit which passes through node
                         ElectricCircuit *circuit = new ElectricCircuit();
-                        circuit->mItems = {mItems.begin(),
-                                           mItems.begin() + i};
+                        circuit->mItems.forkFrom(mItems, i);
                         circuit->mItems.append(customNodeItem);
                         circuit->setType(CircuitType::Open);
                         circuit->enableCircuit();
@@ -295,15 +596,14 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
                     }
 
                     // Get opposite side
-                    CableEnd cableEnd = conn.cable.cable->getNode(~conn.cable.side);
+                    CableEnd cableEnd = conn.otherEnd;
 
                     if(!cableEnd.node)
                     {
                         // Register an open circuit which passes through node
                         // And then go to next cable
                         ElectricCircuit *circuit = new ElectricCircuit();
-                        circuit->mItems = {mItems.begin(),
-                                           mItems.begin() + i};
+                        circuit->mItems.forkFrom(mItems, i);
                         circuit->mItems.append(customNodeItem);
                         circuit->mItems.append(nextCable);
                         circuit->setType(CircuitType::Open);
@@ -328,9 +628,13 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
                     if(loadPassed || cableEnd.node->isElectricLoad)
                         mode.setFlag(PassModes::LoadPassed, true);
 
+                    // Found circuits will share our path until node
+                    ItemPath basePath;
+                    basePath.forkFrom(mItems, i);
+                    WalkBaseScope walkScope(&basePath);
+
                     passCircuitNode(cableEnd.node, cableEnd.nodeContact,
-                                    newItems, i,
-                                    deletedCircuits);
+                                    newItems, i);
                     continue;
                 }
             }
@@ -341,12 +645,12 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
 
         // Now check for other possible closed circuits that were removed because
         // reversed and now could be re-enabled
-        QSet<AbstractCircuitNode *> checkedReverseNodes;
+        QVarLengthArray<AbstractCircuitNode *, 16> checkedReverseNodes;
 
         for(int i = 2;  i < mItems.size();
              i += 2)
         {
-            const Item& item = mItems.at(i);
+            const Item item = mItems.at(i);
             Q_ASSERT(item.isNode);
 
             if(checkedReverseNodes.contains(item.node.node))
@@ -361,7 +665,7 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
             CableItem nodeSourceCable;
             nodeSourceCable.cable = mItems.at(i - 1).cable;
             nodeSourceCable.nodeContact = item.node.fromContact;
-            const auto connections = item.node.node->getActiveConnections(nodeSourceCable, true);
+            const auto connections = CircuitGraph::connections(item.node.node, nodeSourceCable, true);
 
             for(const auto& conn : connections)
             {
@@ -376,7 +680,7 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
                     item.node.node->hasAnyEntranceCircuitOnPole(conn.nodeContact,
                                                                 conn.cable.pole) != AnyCircuitType::None)
                 {
-                    checkedReverseNodes.insert(item.node.node);
+                    checkedReverseNodes.append(item.node.node);
 
                     bool foundOppositeSource = false;
 
@@ -384,7 +688,7 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
                     const QVector<ElectricCircuit *> closedCircuitsCopy = item.node.node->getCircuits(CircuitType::Closed);
                     for(ElectricCircuit *other : closedCircuitsCopy)
                     {
-                        if(deletedCircuits.contains(other) || other->isDisabling())
+                        if(!other->isAlive() || other->isDisabling())
                             continue;
 
                         const NodeOccurences occurences = other->getNode(item.node.node);
@@ -413,30 +717,26 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
 
     // Remove only once per item
     // This way we can assert inside removeCircuit()
-    QSet<AbstractCircuitNode *> nodes;
-    QSet<CircuitCable *> cables;
+    VisitMask firstVisit;
+    markFirstVisits(firstVisit);
 
-    for(const Item& item : std::as_const(mItems))
+    for(int i = 0; i < mItems.size(); i++)
     {
+        const Item& item = mItems.at(i);
         if(item.isNode)
         {
-            if(!nodes.contains(item.node.node))
+            if(firstVisit.at(i))
             {
                 NodeOccurences items = getNode(item.node.node);
                 item.node.node->removeCircuit(this, items);
-                nodes.insert(item.node.node);
             }
 
             Q_ASSERT_X(!item.node.node->getCircuits(CircuitType::Closed).contains(this),
                        "ElectricCircuit::disableOrTerminate()", "Circuit still on node!");
         }
-        else
+        else if(firstVisit.at(i))
         {
-            if(!cables.contains(item.cable.cable))
-            {
-                item.cable.cable->removeCircuit(this);
-                cables.insert(item.cable.cable);
-            }
+            item.cable.cable->removeCircuit(this);
         }
     }
 
@@ -446,7 +746,7 @@ void ElectricCircuit::disableOrTerminate(AbstractCircuitNode *node)
     enabled = false;
 
     if(!tryReachOpen(node))
-        delete this;
+        destroy();
 }
 
 void ElectricCircuit::terminateHere(AbstractCircuitNode *goalNode,
@@ -455,30 +755,15 @@ void ElectricCircuit::terminateHere(AbstractCircuitNode *goalNode,
     Q_ASSERT(type() == CircuitType::Open);
     Q_ASSERT(enabled);
 
-    // Remove only once per item
-    // This way we can assert inside removeCircuit()
-    QSet<AbstractCircuitNode *> nodes;
-    QSet<CircuitCable *> cables;
-
-    QSet<AbstractCircuitNode *> nodesToKeep;
-    QSet<CircuitCable *> cablesToKeep;
-
     int nodeIdx = -1;
-    for(int i = 0; i < mItems.size(); i++)
+    for(int i = 0; i < mItems.size(); i += 2)
     {
         const Item& item = mItems.at(i);
-        if(item.isNode)
-        {
-            nodesToKeep.insert(item.node.node);
-            if(item.node.node == goalNode)
-            {
-                nodeIdx = i;
-                break;
-            }
-        }
-        else
+        Q_ASSERT(item.isNode);
+        if(item.node.node == goalNode)
         {
-            cablesToKeep.insert(item.cable.cable);
+            nodeIdx = i;
+            break;
         }
     }
 
@@ -487,6 +772,9 @@ void ElectricCircuit::terminateHere(AbstractCircuitNode *goalNode,
     // If node is first remove all, otherwise remove after node
     int firstIdxToRemove = nodeIdx > 0 ? nodeIdx + 1 : 0;
 
+    // Path changes, registered again below if we survive
+    unregisterExits();
+
     if(firstIdxToRemove > 0)
     {
         for(const ElectricCircuit *duplicate : std::as_const(deduplacteList))
@@ -533,11 +821,42 @@ void ElectricCircuit::terminateHere(AbstractCircuitNode *goalNode,
         }
     }
 
-    if(firstIdxToRemove == 0)
+    // Items before first removed one are kept, if any.
+    // All marks are set before removing, because removeCircuit()
+    // may start nested circuit operations which reuse marks.
+    enum ItemAction : quint8
+    {
+        Skip = 0,
+        PartialRemove,
+        Remove
+    };
+
+    const quint64 keepEpoch = nextVisitEpoch();
+    const quint64 removeEpoch = nextVisitEpoch();
+
+    for(int i = 0; i < firstIdxToRemove; i++)
+        visitMark(mItems.at(i)) = keepEpoch;
+
+    QVarLengthArray<ItemAction, 256> actions(mItems.size());
+    for(int i = firstIdxToRemove; i < mItems.size(); i++)
     {
-        // Do not keep registered on any item
-        nodesToKeep.clear();
-        cablesToKeep.clear();
+        const Item& item = mItems.at(i);
+        quint64& mark = visitMark(item);
+
+        if(mark == keepEpoch)
+        {
+            // Nodes need this passage removed, kept cables are skipped
+            actions[i] = item.isNode ? PartialRemove : Skip;
+        }
+        else if(mark != removeEpoch)
+        {
+            mark = removeEpoch;
+            actions[i] = Remove;
+        }
+        else
+        {
+            actions[i] = Skip; // Already removed
+        }
     }
 
     QMultiHash<AbstractCircuitNode *, int> nodesToUpdate;
@@ -548,7 +867,7 @@ void ElectricCircuit::terminateHere(AbstractCircuitNode *goalNode,
 
         if(item.isNode)
         {
-            if(nodesToKeep.contains(item.node.node))
+            if(actions.at(i) == PartialRemove)
             {
                 // Remove only this passage
                 item.node.node->partialRemoveCircuit(this, {item.node});
@@ -563,26 +882,21 @@ void ElectricCircuit::terminateHere(AbstractCircuitNode *goalNode,
                         nodesToUpdate.insert(item.node.node, item.node.toContact);
                 }
             }
-            else if(!nodes.contains(item.node.node))
+            else if(actions.at(i) == Remove)
             {
                 // Remove every occurrence of this circuit
-                // Then save node to avoid removing again
                 NodeOccurences items = getNode(item.node.node);
                 item.node.node->removeCircuit(this, items);
-                nodes.insert(item.node.node);
             }
         }
-        else
+        else if(actions.at(i) == Remove)
         {
-            if(!cables.contains(item.cable.cable) && !cablesToKeep.contains(item.cable.cable))
-            {
-                item.cable.cable->removeCircuit(this);
-                cables.insert(item.cable.cable);
-            }
+            item.cable.cable->removeCircuit(this);
         }
     }
 
-    mItems.remove(firstIdxToRemove, mItems.size() - firstIdxToRemove);
+    mItems.truncate(firstIdxToRemove);
+    truncateNodeIndex(firstIdxToRemove);
 
     // Update node flags after removing node
     for(auto it : nodesToUpdate.asKeyValueRange())
@@ -595,7 +909,7 @@ void ElectricCircuit::terminateHere(AbstractCircuitNode *goalNode,
     if(mItems.isEmpty())
     {
         // We are an empty circuit
-        delete this;
+        destroy();
     }
     else
     {
@@ -609,7 +923,9 @@ void ElectricCircuit::terminateHere(AbstractCircuitNode *goalNode,
         // Circuit is still registered at node
         // Remove toContact from last node
         goalNode->unregisterOpenCircuitExit(this);
-        mItems.last().node.toContact = NodeItem::InvalidContact;
+        mItems.mutableLast().node.toContact = NodeItem::InvalidContact;
+
+        registerExits();
 
         deduplacteList.append(this);
     }
@@ -617,16 +933,76 @@ void ElectricCircuit::terminateHere(AbstractCircuitNode *goalNode,
 
 QVector<NodeItem> ElectricCircuit::getNode(AbstractCircuitNode *node) const
 {
+    Q_ASSERT_X(mNodeIndex.size() == (mItems.size() + 1) / 2,
+               "ElectricCircuit::getNode()", "Node index not built");
+
     QVector<NodeItem> result;
 
-    for(const Item& item : std::as_const(mItems))
+    const auto cmp = [](const NodeIndexEntry& e, AbstractCircuitNode *n)
     {
-        if(item.isNode && item.node.node == node)
-            result.append(item.node);
-    }
+        return std::less<AbstractCircuitNode *>()(e.node, n);
+    };
+
+    auto it = std::lower_bound(mNodeIndex.cbegin(), mNodeIndex.cend(),
+                               node, cmp);
+    for(; it != mNodeIndex.cend() && it->node == node; it++)
+        result.append(mItems.at(it->itemIdx).node);
+
     return result;
 }
 
+void ElectricCircuit::buildNodeIndex()
+{
+    // Nodes are at even positions, cables in between
+    mNodeIndex.clear();
+    mNodeIndex.reserve((mItems.size() + 1) / 2);
+
+    for(int i = 0; i < mItems.size(); i += 2)
+    {
+        const Item& item = mItems.at(i);
+        Q_ASSERT(item.isNode);
+        mNodeIndex.append({item.node.node, i});
+    }
+
+    // Stable order keeps same node occurrences in path order
+    std::stable_sort(mNodeIndex.begin(), mNodeIndex.end(),
+                     [](const NodeIndexEntry& a, const NodeIndexEntry& b)
+    {
+        return std::less<AbstractCircuitNode *>()(a.node, b.node);
+    });
+}
+
+void ElectricCircuit::truncateNodeIndex(int firstIdxToRemove)
+{
+    // Sorting is preserved, no need to rebuild
+    mNodeIndex.removeIf([firstIdxToRemove](const NodeIndexEntry& e)
+    {
+        return e.itemIdx >= firstIdxToRemove;
+    });
+}
+
+quint64 &ElectricCircuit::visitMark(const Item &item)
+{
+    if(item.isNode)
+        return item.node.node->mVisitEpoch;
+    return item.cable.cable->mVisitEpoch;
+}
+
+void ElectricCircuit::markFirstVisits(VisitMask &firstVisit) const
+{
+    // Only mark here, callers act on the mask afterwards.
+    // So nested circuit operations started by callers can reuse marks
+    const quint64 epoch = nextVisitEpoch();
+
+    firstVisit.resize(mItems.size());
+    for(int i = 0; i < mItems.size(); i++)
+    {
+        quint64& mark = visitMark(mItems.at(i));
+        firstVisit[i] = mark != epoch;
+        mark = epoch;
+    }
+}
+
 bool ElectricCircuit::isLastNode(AbstractCircuitNode *node) const
 {
     if(mItems.isEmpty())
@@ -681,7 +1057,7 @@ bool ElectricCircuit::isDifferentPoleStartEnd() const
 ElectricCircuit *ElectricCircuit::cloneToOppositeType()
 {
     ElectricCircuit *other = new ElectricCircuit;
-    other->mItems = mItems;
+    other->mItems.forkFrom(mItems, mItems.size());
 
     if(type() == CircuitType::Closed)
         other->setType(CircuitType::Open);
@@ -698,6 +1074,9 @@ void ElectricCircuit::createCircuitsFromPowerNode(AbstractCircuitNode *source,
 {
     auto contact = source->getContacts().at(nodeContact);
 
+    SimulationProfiler::NodeScope profile(source);
+    DeleteScope scope;
+
     Item firstItem;
     firstItem.isNode = true;
     firstItem.node.node = source;
@@ -718,20 +1097,22 @@ void ElectricCircuit::createCircuitsFromPowerNode(AbstractCircuitNode *source,
 
         if(cableEnd.node)
         {
-            ItemVector items;
+            WalkItems walk;
+            ItemVector &items = walk.items;
             items.append(firstItem);
             items.append(nextCable);
 
             // Depth 1 because we already passed power source node
-            QVector<ElectricCircuit *> deletedCircuits;
-            passCircuitNode(cableEnd.node, cableEnd.nodeContact, items, 1, deletedCircuits);
+            WalkBaseScope walkScope(nullptr);
+            passCircuitNode(cableEnd.node, cableEnd.nodeContact, items, 1);
         }
         else
         {
             // Register an open circuit which passes through node
             // And then go to next cable
             ElectricCircuit *circuit = new ElectricCircuit();
-            circuit->mItems = {firstItem, nextCable};
+            circuit->mItems.append(firstItem);
+            circuit->mItems.append(nextCable);
             circuit->setType(CircuitType::Open);
             circuit->enableCircuit();
             return;
@@ -755,96 +1136,168 @@ void ElectricCircuit::createCircuitsFromPowerNode(AbstractCircuitNode *source,
 
 ElectricCircuit::PassNodeResult ElectricCircuit::passCircuitNode(AbstractCircuitNode *node, int nodeContact,
                                                                  ItemVector &items, int depth,
-                                                                 QVector<ElectricCircuit *>& deletedCircuits,
                                                                  PassMode mode)
 {
-    // Returns true if circuit goes to next node
-    if(depth > 1000)
-        return {}; // TODO
+    // Circuits registered while passing nodes can start nested walks
+    // Their frames are pushed above ours and popped before we resume
+    const int baseSize = mPassStack.size();
 
-    const CableContact lastCable = items.last().cable;
+    mPassStack.push()->start(node, nodeContact, depth, mode);
 
-    Item nodeItem;
-    nodeItem.isNode = true;
-    nodeItem.node.node = node;
-    nodeItem.node.fromContact = nodeContact;
-    nodeItem.node.setFromPole(lastCable.pole);
-    nodeItem.node.toContact = NodeItem::InvalidContact;
-
-    if(node == items.first().node.node)
+    PassNodeResult childResult;
+    while(mPassStack.size() > baseSize)
     {
-        if(nodeItem.node.fromPole() == ~items.first().node.toPole())
+        PassFrame *frame = mPassStack.top();
+        if(resumePassFrame(frame, items, childResult))
         {
-            // We returned to same source, on opposite pole
-            // The circuits is closed
-            if(mode.testFlag(PassModes::ReverseVoltagePassed))
-            {
-                //qWarning() << "Closed circuit with reverse voltage!";
-                return {};
-            }
+            // Pass next node, then resume this frame with its result
+            mPassStack.push()->start(frame->nextEnd.node, frame->nextEnd.nodeContact,
+                                     frame->depth + 1, frame->callMode);
+            continue;
+        }
 
-            // Register closed circuit
-            ElectricCircuit *circuit = new ElectricCircuit();
-            circuit->mItems = {items.begin(), items.end()};
-            circuit->mItems.append(nodeItem);
+        childResult = frame->result;
+        mPassStack.pop();
+    }
 
-            if(circuit->getSource()->sourceDoNotCloseCircuits())
-                circuit->setType(CircuitType::Open);
-            else
-                circuit->setType(CircuitType::Closed);
+    return childResult;
+}
 
-            circuit->enableCircuit(&deletedCircuits);
-            return {0, 1};
-        }
-        else
+void ElectricCircuit::PassFrame::start(AbstractCircuitNode *node_, int nodeContact_,
+                                       int depth_, PassMode mode_)
+{
+    node = node_;
+    nodeContact = nodeContact_;
+    depth = depth_;
+    mode = mode_;
+    stage = Stage::Enter;
+    result = {};
+}
+
+bool ElectricCircuit::resumePassFrame(PassFrame *f, ItemVector &items,
+                                      const PassNodeResult &childResult)
+{
+    switch (f->stage)
+    {
+    case PassFrame::Stage::Enter:
+    {
+        mStats.passNodeCalls++;
+        SimulationProfiler::nodeVisited(f->node);
+
+        if(f->depth > mMaxWalkDepth)
+            return false;
+
+        AbstractCircuitNode *node = f->node;
+        f->lastCable = items.last().cable;
+
+        Item &nodeItem = f->nodeItem;
+        nodeItem = Item();
+        nodeItem.isNode = true;
+        nodeItem.node.node = node;
+        nodeItem.node.fromContact = f->nodeContact;
+        nodeItem.node.setFromPole(f->lastCable.pole);
+        nodeItem.node.toContact = NodeItem::InvalidContact;
+
+        if(node == items.first().node.node)
         {
-            // We returned to same source, on same pole
-            // The circuits is open
-            if(mode.testFlag(PassModes::ReverseVoltagePassed))
+            if(nodeItem.node.fromPole() == ~items.first().node.toPole())
             {
-                //qWarning() << "Open circuit with reverse voltage!";
-                return {};
+                // We returned to same source, on opposite pole
+                // The circuits is closed
+                if(f->mode.testFlag(PassModes::ReverseVoltagePassed))
+                {
+                    //qWarning() << "Closed circuit with reverse voltage!";
+                    return false;
+                }
+
+                // Register closed circuit
+                ElectricCircuit *circuit = new ElectricCircuit();
+                circuit->setItemsFromWalk(items, 1);
+                circuit->mItems.append(nodeItem);
+
+                if(circuit->getSource()->sourceDoNotCloseCircuits())
+                    circuit->setType(CircuitType::Open);
+                else
+                    circuit->setType(CircuitType::Closed);
+
+                circuit->enableCircuit();
+                f->result = {0, 1};
+                return false;
             }
+            else
+            {
+                // We returned to same source, on same pole
+                // The circuits is open
+                if(f->mode.testFlag(PassModes::ReverseVoltagePassed))
+                {
+                    //qWarning() << "Open circuit with reverse voltage!";
+                    return false;
+                }
 
-            // Register closed circuit
-            ElectricCircuit *circuit = new ElectricCircuit();
-            circuit->mItems = {items.begin(), items.end()};
-            circuit->mItems.append(nodeItem);
-            circuit->setType(CircuitType::Open);
+                // Register closed circuit
+                ElectricCircuit *circuit = new ElectricCircuit();
+                circuit->setItemsFromWalk(items, 1);
+                circuit->mItems.append(nodeItem);
+                circuit->setType(CircuitType::Open);
 
-            circuit->enableCircuit(&deletedCircuits);
-            return {1, 0};
+                circuit->enableCircuit();
+                f->result = {1, 0};
+                return false;
+            }
         }
-    }
 
-    if(node->isSourceNode(true, nodeItem.node.fromContact))
-    {
-        // Error, different power source connected
-        return {};
-    }
+        if(node->isSourceNode(true, nodeItem.node.fromContact))
+        {
+            // Error, different power source connected
+            return false;
+        }
 
-    CableItem nodeSourceCable;
-    nodeSourceCable.cable = lastCable;
-    nodeSourceCable.cable.side = ~lastCable.side;
-    nodeSourceCable.nodeContact = nodeContact;
-    const auto connections = node->getActiveConnections(nodeSourceCable);
+        CableItem nodeSourceCable;
+        nodeSourceCable.cable = f->lastCable;
+        nodeSourceCable.cable.side = ~f->lastCable.side;
+        nodeSourceCable.nodeContact = f->nodeContact;
+        f->connections = CircuitGraph::connections(node, nodeSourceCable);
+
+        f->circuitEndsHere = true;
+        f->oldVectorSize = items.size();
+        f->connIdx = 0;
+        f->stage = PassFrame::Stage::NextConnection;
+        break;
+    }
+    case PassFrame::Stage::NextConnection:
+        break;
+    case PassFrame::Stage::AfterSkipLoads:
+    {
+        f->nextResult = childResult;
 
-    bool circuitEndsHere = true;
+        if(passAllowingLoads(f, items))
+            return true;
 
-    PassNodeResult result;
+        f->result += f->nextResult;
+        break;
+    }
+    case PassFrame::Stage::AfterAllLoads:
+    {
+        f->nextResult += childResult;
+        f->result += f->nextResult;
+        break;
+    }
+    }
 
-    const qsizetype oldVectorSize = items.size();
+    AbstractCircuitNode *node = f->node;
+    Item &nodeItem = f->nodeItem;
 
-    for(const auto& conn : connections)
+    while(f->connIdx < f->connections.size())
     {
+        const CircuitGraph::Edge &conn = f->connections.at(f->connIdx++);
+
         // Remove new items before going to next loop iteration
-        items.resize(oldVectorSize);
+        items.resize(f->oldVectorSize);
 
         nodeItem.node.toContact = conn.nodeContact;
         nodeItem.node.setToPole(conn.cable.pole);
         nodeItem.node.setFlags(conn.flags);
 
-
         Item nextCable;
         nextCable.cable = conn.cable;
 
@@ -854,24 +1307,24 @@ ElectricCircuit::PassNodeResult ElectricCircuit::passCircuitNode(AbstractCircuit
                                               conn.cable.pole) != AnyCircuitType::None)
                 continue; // Already has voltage
 
-            if(mode.testFlag(PassModes::ReverseVoltagePassed))
+            if(f->mode.testFlag(PassModes::ReverseVoltagePassed))
                 continue;
 
             // Register an open circuit which passes through node
             ElectricCircuit *circuit = new ElectricCircuit();
-            circuit->mItems = {items.begin(), items.end()};
+            circuit->setItemsFromWalk(items, 1);
             circuit->mItems.append(nodeItem);
             circuit->setType(CircuitType::Open);
-            circuit->enableCircuit(&deletedCircuits);
+            circuit->enableCircuit();
 
             // Circuit will pass to opposite node connector
-            circuitEndsHere = false;
-            result.openCircuits++;
+            f->circuitEndsHere = false;
+            f->result.openCircuits++;
             continue;
         }
 
         // Get opposite side
-        CableEnd cableEnd = conn.cable.cable->getNode(~conn.cable.side);
+        const CableEnd cableEnd = conn.otherEnd;
 
         if(!cableEnd.node)
         {
@@ -879,21 +1332,21 @@ ElectricCircuit::PassNodeResult ElectricCircuit::passCircuitNode(AbstractCircuit
                                               conn.cable.pole) != AnyCircuitType::None)
                 continue; // Already has voltage
 
-            if(mode.testFlag(PassModes::ReverseVoltagePassed))
+            if(f->mode.testFlag(PassModes::ReverseVoltagePassed))
                 continue;
 
             // Register an open circuit which passes through node
             // And then go to next cable
             ElectricCircuit *circuit = new ElectricCircuit();
-            circuit->mItems = {items.begin(), items.end()};
+            circuit->setItemsFromWalk(items, 2);
             circuit->mItems.append(nodeItem);
             circuit->mItems.append(nextCable);
             circuit->setType(CircuitType::Open);
-            circuit->enableCircuit(&deletedCircuits);
+            circuit->enableCircuit();
 
             // Circuit will pass to opposite node connector
-            circuitEndsHere = false;
-            result.openCircuits++;
+            f->circuitEndsHere = false;
+            f->result.openCircuits++;
             continue;
         }
 
@@ -905,26 +1358,26 @@ ElectricCircuit::PassNodeResult ElectricCircuit::passCircuitNode(AbstractCircuit
         // In all cases above we consider circuit as not ending here
         // So that original circuit can be freed
         // This avoid keeping around duplicate Open Circuits
-        circuitEndsHere = false;
+        f->circuitEndsHere = false;
 
-        if(cableEnd.node == node && cableEnd.nodeContact == nodeContact)
+        if(cableEnd.node == node && cableEnd.nodeContact == f->nodeContact)
         {
             continue;
         }
 
-        if(containsNode(items, node, nodeContact, lastCable.pole))
+        if(containsNode(items, node, f->nodeContact, f->lastCable.pole))
             continue;
 
         items.append(nodeItem);
         items.append(nextCable);
 
-        const qsizetype newVecSize = items.size();
+        f->newVecSize = items.size();
 
-        PassMode newMode = mode;
+        PassMode newMode = f->mode;
 
         if(cableEnd.node->isElectricLoad)
         {
-            if(mode.testFlag(PassModes::SkipLoads))
+            if(f->mode.testFlag(PassModes::SkipLoads))
                 continue; // Skip loads
 
             newMode.setFlag(PassModes::LoadPassed, true);
@@ -949,60 +1402,71 @@ ElectricCircuit::PassNodeResult ElectricCircuit::passCircuitNode(AbstractCircuit
             continue;
         }
 
-        PassNodeResult nextResult;
+        f->nextEnd = cableEnd;
+        f->newMode = newMode;
+        f->nextResult = {};
 
         if(newMode.testFlag(PassModes::LoadPassed))
         {
             // Try first to skip other loads and go directly to source
-            PassMode skipLoads = newMode;
-            skipLoads.setFlag(PassModes::SkipLoads, true);
-
-            nextResult = passCircuitNode(cableEnd.node, cableEnd.nodeContact,
-                                         items, depth + 1,
-                                         deletedCircuits, skipLoads);
+            f->callMode = newMode;
+            f->callMode.setFlag(PassModes::SkipLoads, true);
+            f->stage = PassFrame::Stage::AfterSkipLoads;
+            return true;
         }
 
-        if(nextResult.closedCircuits == 0 && !newMode.testFlag(PassModes::SkipLoads))
-        {
-            // Reset to our new items before trying again to pass node
-            items.resize(newVecSize);
-
-            // Try again allowing other loads on circuit
-            newMode.setFlag(PassModes::SkipLoads, false);
-
-            nextResult += passCircuitNode(cableEnd.node, cableEnd.nodeContact,
-                                          items, depth + 1,
-                                          deletedCircuits, newMode);
-        }
+        if(passAllowingLoads(f, items))
+            return true;
 
-        result += nextResult;
+        f->result += f->nextResult;
     }
 
     // Remove new items after last loop iteration
-    items.resize(oldVectorSize);
+    items.resize(f->oldVectorSize);
 
-    if(circuitEndsHere)
+    if(f->circuitEndsHere)
     {
-        if(depth > 0 && !mode.testFlag(PassModes::ReverseVoltagePassed))
+        if(f->depth > 0 && !f->mode.testFlag(PassModes::ReverseVoltagePassed))
         {
             // Register an open circuit which passes HALF node
             ElectricCircuit *circuit = new ElectricCircuit();
-            circuit->mItems = {items.begin(), items.end()};
+            circuit->setItemsFromWalk(items, 1);
             circuit->mItems.append(nodeItem);
             circuit->setType(CircuitType::Open);
-            circuit->enableCircuit(&deletedCircuits);
+            circuit->enableCircuit();
         }
 
         // Do not count this as result
         // It will replace parent circuit
-        return {};
+        f->result = {};
     }
 
-    return result;
+    return false;
+}
+
+bool ElectricCircuit::passAllowingLoads(PassFrame *f, ItemVector &items)
+{
+    if(f->nextResult.closedCircuits != 0 || f->newMode.testFlag(PassModes::SkipLoads))
+        return false;
+
+    // Reset to our new items before trying again to pass node
+    items.resize(f->newVecSize);
+
+    // Try again allowing other loads on circuit
+    f->newMode.setFlag(PassModes::SkipLoads, false);
+    f->callMode = f->newMode;
+    f->stage = PassFrame::Stage::AfterAllLoads;
+    return true;
 }
 
 void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
 {
+    // Node has new connections, invalidate paths passing through it
+    node->markConnectionsChanged();
+
+    SimulationProfiler::NodeScope profile(node);
+    DeleteScope scope;
+
     QVector<ElectricCircuit *> openCircuitsCopy = node->getCircuits(CircuitType::Open);
     std::sort(openCircuitsCopy.begin(), openCircuitsCopy.end(),
               [](ElectricCircuit *a, ElectricCircuit *b) -> bool
@@ -1013,13 +1477,14 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
     // Search which node contacts do not have any circuit.
     // We look for new circuits on these nodes
     // and ignore the others.
-    QVector<ElectricCircuit *> deletedCircuits;
+    // Open circuit path until node is reused without checking it,
+    // so connections epoch has nothing to skip here.
 
-    QVector<QVector<Item>> tryedPaths;
+    QVector<ItemPath> tryedPaths;
 
     for(ElectricCircuit *origCircuit : openCircuitsCopy)
     {
-        if(deletedCircuits.contains(origCircuit) || origCircuit->isDisabling())
+        if(!origCircuit->isAlive() || origCircuit->isDisabling())
             continue;
 
         // Try to continue circuit
@@ -1036,10 +1501,11 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
         bool loadPassed = false;
 
         for(int i = 0;
-             !deletedCircuits.contains(origCircuit) && i < origCircuit->mItems.size();
+             origCircuit->isAlive() && i < origCircuit->mItems.size();
              i += 2)
         {
-            const Item& otherItem = origCircuit->mItems.at(i);
+            // Copy, fork below may compact circuit storage
+            const Item otherItem = origCircuit->mItems.at(i);
             Q_ASSERT(otherItem.isNode);
 
             if(otherItem.node.node->isElectricLoad)
@@ -1076,7 +1542,14 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
                 continue; // Already tried this path
 
             // Cache this path for future comparison
-            tryedPaths.append(origCircuit->mItems.first(i + 1));
+            ItemPath triedPath;
+            triedPath.forkFrom(origCircuit->mItems, i + 1);
+            tryedPaths.append(triedPath);
+
+            // Found circuits will share original circuit path until node
+            ItemPath basePath;
+            basePath.forkFrom(origCircuit->mItems, i);
+            WalkBaseScope walkScope(&basePath);
 
             // Let's see if this circuit can diverge and go to request contact
 
@@ -1087,7 +1560,7 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
             nodeSourceCable.cable = lastCable;
             nodeSourceCable.cable.side = ~lastCable.side;
             nodeSourceCable.nodeContact = otherItem.node.fromContact;
-            const auto connections = node->getActiveConnections(nodeSourceCable);
+            const auto connections = CircuitGraph::connections(node, nodeSourceCable);
 
             bool circuitEndsHere = true;
 
@@ -1097,8 +1570,9 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
                     continue; // We should follow a different path
 
                 // Copy items until cable before node
-                ItemVector items(origCircuit->mItems.begin(),
-                                 origCircuit->mItems.begin() + i);
+                WalkItems walk(origCircuit->mItems.begin(),
+                               origCircuit->mItems.begin() + i);
+                ItemVector &items = walk.items;
 
                 Item nodeItem = otherItem;
                 nodeItem.node.toContact = conn.nodeContact;
@@ -1117,10 +1591,10 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
 
                     // Register an open circuit which passes through node
                     ElectricCircuit *circuit = new ElectricCircuit();
-                    circuit->mItems = {items.begin(), items.end()};
+                    circuit->setItemsFromWalk(items, 1);
                     circuit->mItems.append(nodeItem);
                     circuit->setType(CircuitType::Open);
-                    circuit->enableCircuit(&deletedCircuits);
+                    circuit->enableCircuit();
 
                     // Circuit will pass to opposite node connector
                     circuitEndsHere = false;
@@ -1128,7 +1602,7 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
                 }
 
                 // Get opposite side
-                CableEnd cableEnd = conn.cable.cable->getNode(~conn.cable.side);
+                CableEnd cableEnd = conn.otherEnd;
 
                 if(!cableEnd.node)
                 {
@@ -1139,11 +1613,11 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
                     // Register an open circuit which passes through node
                     // And then go to next cable
                     ElectricCircuit *circuit = new ElectricCircuit();
-                    circuit->mItems = {items.begin(), items.end()};
+                    circuit->setItemsFromWalk(items, 2);
                     circuit->mItems.append(nodeItem);
                     circuit->mItems.append(nextCable);
                     circuit->setType(CircuitType::Open);
-                    circuit->enableCircuit(&deletedCircuits);
+                    circuit->enableCircuit();
 
                     // Circuit will pass to opposite node connector
                     circuitEndsHere = false;
@@ -1176,8 +1650,7 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
                     mode.setFlag(PassModes::LoadPassed, true);
 
                 passCircuitNode(cableEnd.node, cableEnd.nodeContact,
-                                items, 1,
-                                deletedCircuits, mode);
+                                items, 1, mode);
             }
 
             if(i == origCircuit->mItems.size() - 1 && !circuitEndsHere
@@ -1190,7 +1663,7 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
             }
         }
 
-        if(removeOriginalCircuit && !deletedCircuits.contains(origCircuit))
+        if(removeOriginalCircuit && origCircuit->isAlive())
         {
             // Circuit went ahead, delete old open circuit
             QVector<ElectricCircuit *> dummy;
@@ -1201,7 +1674,7 @@ void ElectricCircuit::createCircuitsFromOtherNode(AbstractCircuitNode *node)
     const QVector<ElectricCircuit *> closedCircuitsCopy = node->getCircuits(CircuitType::Closed);
     for(ElectricCircuit *circuit : closedCircuitsCopy)
     {
-        if(deletedCircuits.contains(circuit) || circuit->isDisabling())
+        if(!circuit->isAlive() || circuit->isDisabling())
             continue;
 
         circuit->checkReverseVoltageSiblings();
@@ -1233,7 +1706,8 @@ void ElectricCircuit::tryReachNextOpenCircuit(AbstractCircuitNode *goalNode, int
     if(!cableEnd.node)
         return;
 
-    ItemVector items;
+    WalkItems walk;
+    ItemVector &items = walk.items;
     items.append(nodeItem);
     items.append(item);
 
@@ -1242,6 +1716,8 @@ void ElectricCircuit::tryReachNextOpenCircuit(AbstractCircuitNode *goalNode, int
 
 void ElectricCircuit::defaultReachNextOpenCircuit(AbstractCircuitNode *goalNode)
 {
+    SimulationProfiler::NodeScope profile(goalNode);
+
     for(int contact = 0; contact < goalNode->getContactCount(); contact++)
     {
         // TODO: skip based on pole?
@@ -1265,13 +1741,15 @@ void ElectricCircuit::defaultReachNextOpenCircuit(AbstractCircuitNode *goalNode)
 
 void ElectricCircuit::updateItemsFlags()
 {
-    QSet<AbstractCircuitNode *> updatedNodes;
-    QSet<CircuitCable *> updatedCables;
-
-    const bool hadFlags = flags() != CircuitFlags::None;
+    const CircuitFlags oldFlags = flags();
+    const bool hadFlags = oldFlags != CircuitFlags::None;
     if(!recalculateFlags())
         return; // No change
 
+    // Update counters only once per item
+    VisitMask firstVisit;
+    markFirstVisits(firstVisit);
+
     const bool removeFlags = hadFlags && flags() == CircuitFlags::None;
     const bool addFlags = !hadFlags && flags() != CircuitFlags::None;
 
@@ -1280,10 +1758,8 @@ void ElectricCircuit::updateItemsFlags()
         const Item& item = mItems[i];
         if(item.isNode)
         {
-            if(!updatedNodes.contains(item.node.node))
+            if(firstVisit.at(i))
             {
-                updatedNodes.insert(item.node.node);
-
                 // Update only once per circuit
                 // Even if circuit passes multiple times on this node
                 if(removeFlags)
@@ -1303,32 +1779,14 @@ void ElectricCircuit::updateItemsFlags()
 
             if(flagsChanged)
             {
-                emit item.node.node->circuitsChanged();
+                item.node.node->notifyCircuitsChanged();
                 item.node.node->onCircuitFlagsChanged();
             }
         }
-        else
+        else if(firstVisit.at(i))
         {
-            if(removeFlags)
-            {
-                if(!updatedCables.contains(item.cable.cable))
-                {
-                    updatedCables.insert(item.cable.cable);
-                    item.cable.cable->circuitAddedRemovedFlags(this, false);
-                }
-            }
-            else if(addFlags)
-            {
-                if(!updatedCables.contains(item.cable.cable))
-                {
-                    updatedCables.insert(item.cable.cable);
-                    item.cable.cable->circuitAddedRemovedFlags(this, true);
-                }
-            }
-            else
-            {
-                item.cable.cable->updateCircuitFlags(type(), item.cable.pole);
-            }
+            // Cable updates both poles at once
+            item.cable.cable->circuitFlagsChanged(this, oldFlags);
         }
     }
 }
@@ -1337,12 +1795,12 @@ void ElectricCircuit::applyNewFlags(AbstractCircuitNode *changedNode, CircuitFla
 {
     if(getSource() == changedNode)
     {
-        mItems[0].node.setFlags(sourceFlags);
+        mItems.mutableAt(0).node.setFlags(sourceFlags);
     }
 
     for(int i = 2; i < mItems.size(); i += 2)
     {
-        Item& item = mItems[i];
+        Item& item = mItems.mutableAt(i);
         Q_ASSERT(item.isNode);
 
         if(item.node.node != changedNode)
@@ -1351,7 +1809,7 @@ void ElectricCircuit::applyNewFlags(AbstractCircuitNode *changedNode, CircuitFla
         CableItem nodeSourceCable;
         nodeSourceCable.cable = mItems.at(i - 1).cable;
         nodeSourceCable.nodeContact = item.node.fromContact;
-        const auto connections = item.node.node->getActiveConnections(nodeSourceCable);
+        const auto connections = CircuitGraph::connections(item.node.node, nodeSourceCable);
 
         for(const auto& conn : connections)
         {
@@ -1414,44 +1872,89 @@ void ElectricCircuit::setFlags(CircuitFlags f, CircuitFlags f2)
 
 void ElectricCircuit::searchNodeWithOpenCircuits(AbstractCircuitNode *node, int nodeContact, ItemVector &items, int depth)
 {
-    if(depth > 1000)
-        return; // TODO
-
-    const CableContact lastCable = items.last().cable;
+    // Extending circuits can start nested walks above our frames
+    const int baseSize = mSearchStack.size();
 
-    Item nodeItem;
-    nodeItem.isNode = true;
-    nodeItem.node.node = node;
-    nodeItem.node.toContact = nodeContact; // Backwards
-    nodeItem.node.setToPole(lastCable.pole);
+    mSearchStack.push()->start(node, nodeContact, depth);
 
-    if(node->hasAnyEntranceCircuitOnPole(nodeItem.node.toContact,
-                                          nodeItem.node.toPole()) == AnyCircuitType::Closed)
+    while(mSearchStack.size() > baseSize)
     {
-        // We are going out were another circuits goes in
-        // This is not possible
-        return;
+        SearchFrame *frame = mSearchStack.top();
+        if(resumeSearchFrame(frame, items))
+        {
+            // Search next node, then resume this frame
+            mSearchStack.push()->start(frame->nextEnd.node, frame->nextEnd.nodeContact,
+                                       frame->depth + 1);
+            continue;
+        }
+
+        mSearchStack.pop();
     }
+}
+
+void ElectricCircuit::SearchFrame::start(AbstractCircuitNode *node_, int nodeContact_, int depth_)
+{
+    node = node_;
+    nodeContact = nodeContact_;
+    depth = depth_;
+    stage = Stage::Enter;
+}
+
+bool ElectricCircuit::resumeSearchFrame(SearchFrame *f, ItemVector &items)
+{
+    AbstractCircuitNode *node = f->node;
+    Item &nodeItem = f->nodeItem;
 
-    if(node->hasCircuits(CircuitType::Closed) || node->hasCircuits(CircuitType::Open))
+    if(f->stage == SearchFrame::Stage::Enter)
     {
-        // This node has voltage and it's connected to us
-        // Maybe we can take voltage from it, towards us
-        // TODO: avoid duplicates
-        extendExistingCircuits(node, nodeContact, items);
-        return;
-    }
+        SimulationProfiler::nodeVisited(node);
 
-    // Go backwards
-    CableItem nodeSourceCable;
-    nodeSourceCable.cable = lastCable; // Backwards
-    nodeSourceCable.nodeContact = nodeContact;
-    const auto connections = node->getActiveConnections(nodeSourceCable, true);
+        if(f->depth > mMaxWalkDepth)
+            return false;
+
+        f->lastCable = items.last().cable;
+
+        nodeItem = Item();
+        nodeItem.isNode = true;
+        nodeItem.node.node = node;
+        nodeItem.node.toContact = f->nodeContact; // Backwards
+        nodeItem.node.setToPole(f->lastCable.pole);
+
+        if(node->hasAnyEntranceCircuitOnPole(nodeItem.node.toContact,
+                                              nodeItem.node.toPole()) == AnyCircuitType::Closed)
+        {
+            // We are going out were another circuits goes in
+            // This is not possible
+            return false;
+        }
+
+        if(node->hasCircuits(CircuitType::Closed) || node->hasCircuits(CircuitType::Open))
+        {
+            // This node has voltage and it's connected to us
+            // Maybe we can take voltage from it, towards us
+            // TODO: avoid duplicates
+            extendExistingCircuits(node, f->nodeContact, items);
+            return false;
+        }
+
+        // Go backwards
+        CableItem nodeSourceCable;
+        nodeSourceCable.cable = f->lastCable; // Backwards
+        nodeSourceCable.nodeContact = f->nodeContact;
+        f->connections = CircuitGraph::connections(node, nodeSourceCable, true);
+
+        f->oldVecSize = items.size();
+        f->connIdx = 0;
+        f->stage = SearchFrame::Stage::NextConnection;
+    }
 
-    const qsizetype oldVecSize = items.size();
+    // Remove items of previous iteration
+    items.resize(f->oldVecSize);
 
-    for(const auto& conn : connections)
+    while(f->connIdx < f->connections.size())
     {
+        const CircuitGraph::Edge &conn = f->connections.at(f->connIdx++);
+
         nodeItem.node.fromContact = conn.nodeContact;
         nodeItem.node.setFromPole(conn.cable.pole);
         nodeItem.node.setFlags(conn.flags);
@@ -1459,17 +1962,17 @@ void ElectricCircuit::searchNodeWithOpenCircuits(AbstractCircuitNode *node, int
         if(!conn.cable.cable)
             continue;
 
-        auto cableEnd = conn.cable.cable->getNode(~conn.cable.side);
+        const CableEnd cableEnd = conn.otherEnd;
 
         if(!cableEnd.node)
             continue;
 
-        if(cableEnd.node == node && cableEnd.nodeContact == nodeContact)
+        if(cableEnd.node == node && cableEnd.nodeContact == f->nodeContact)
         {
             continue;
         }
 
-        if(containsNode(items, node, nodeContact, lastCable.pole))
+        if(containsNode(items, node, f->nodeContact, f->lastCable.pole))
             continue;
 
         items.append(nodeItem);
@@ -1479,11 +1982,11 @@ void ElectricCircuit::searchNodeWithOpenCircuits(AbstractCircuitNode *node, int
         item.cable.side = ~conn.cable.side; // Backwards
         items.append(item);
 
-        searchNodeWithOpenCircuits(cableEnd.node, cableEnd.nodeContact, items, depth + 1);
-
-        // Remove new items before going to next loop iteration
-        items.resize(oldVecSize);
+        f->nextEnd = cableEnd;
+        return true;
     }
+
+    return false;
 }
 
 void ElectricCircuit::extendExistingCircuits(AbstractCircuitNode *node, int nodeContact, const ItemVector &items)
@@ -1497,45 +2000,42 @@ void ElectricCircuit::extendExistingCircuits(AbstractCircuitNode *node, int node
 
     const CableContact lastCable = items.last().cable;
 
-    QVector<ElectricCircuit *> deletedCircuits;
+    DeleteScope scope;
 
     const QVector<ElectricCircuit *> closedCircuitsCopy = node->getCircuits(CircuitType::Closed);
     for(ElectricCircuit *otherCircuit : closedCircuitsCopy)
     {
-        if(deletedCircuits.contains(otherCircuit))
+        if(!otherCircuit->isAlive())
             continue;
 
         extendExistingCircuits_helper(node, nodeContact, items,
-                                      lastCable, otherCircuit,
-                                      deletedCircuits);
+                                      lastCable, otherCircuit);
     }
 
-    deletedCircuits.clear();
     const QVector<ElectricCircuit *> openCircuitsCopy = node->getCircuits(CircuitType::Open);
     for(ElectricCircuit *otherCircuit : openCircuitsCopy)
     {
-        if(deletedCircuits.contains(otherCircuit))
+        if(!otherCircuit->isAlive())
             continue;
 
         extendExistingCircuits_helper(node, nodeContact, items,
-                                      lastCable, otherCircuit,
-                                      deletedCircuits);
+                                      lastCable, otherCircuit);
     }
 }
 
 void ElectricCircuit::extendExistingCircuits_helper(AbstractCircuitNode *node, int nodeContact, const ItemVector &items,
-                                                    const CableContact& lastCable, ElectricCircuit *otherCircuit,
-                                                    QVector<ElectricCircuit *>& deletedCircuits)
+                                                    const CableContact& lastCable, ElectricCircuit *otherCircuit)
 {
     bool loadPassed = false;
 
     for(int i = 0;
-         !deletedCircuits.contains(otherCircuit) && i < otherCircuit->mItems.size();
+         otherCircuit->isAlive() && i < otherCircuit->mItems.size();
          i += 2)
     {
         // TODO: power source
 
-        const Item& otherItem = otherCircuit->mItems.at(i);
+        // Copy, fork below may compact circuit storage
+        const Item otherItem = otherCircuit->mItems.at(i);
         Q_ASSERT(otherItem.isNode);
 
         if(otherItem.node.node->isElectricLoadNode())
@@ -1550,7 +2050,7 @@ void ElectricCircuit::extendExistingCircuits_helper(AbstractCircuitNode *node, i
         CableItem nodeSourceCable;
         nodeSourceCable.cable = otherCircuit->mItems.at(i - 1).cable;
         nodeSourceCable.nodeContact = otherItem.node.fromContact;
-        const auto connections = node->getActiveConnections(nodeSourceCable);
+        const auto connections = CircuitGraph::connections(node, nodeSourceCable);
 
         for(const auto& conn : connections)
         {
@@ -1562,9 +2062,11 @@ void ElectricCircuit::extendExistingCircuits_helper(AbstractCircuitNode *node, i
 
             // This circuit can reach our node!
 
-            // Copy until cable before node
-            QVector<Item> newItems(otherCircuit->mItems.begin(),
-                                   otherCircuit->mItems.begin() + i);
+            ElectricCircuit *circuit = new ElectricCircuit();
+
+            // Share path until cable before node
+            circuit->mItems.forkFrom(otherCircuit->mItems, i);
+            circuit->mItems.reserve(i + items.size() + 1);
 
             // Custom pass node to join with existing circuit
             Item customNodeItem = otherItem;
@@ -1572,17 +2074,15 @@ void ElectricCircuit::extendExistingCircuits_helper(AbstractCircuitNode *node, i
             customNodeItem.node.setToPole(lastCable.pole);
             customNodeItem.node.setFlags(conn.flags);
 
-            newItems.append(customNodeItem);
+            circuit->mItems.append(customNodeItem);
 
             // Add previous searchd path from goal node (reversed)
             for(auto it = items.crbegin(); it != items.crend(); it++)
-                newItems.append(*it);
+                circuit->mItems.append(*it);
 
             // Register new Open circuit
-            ElectricCircuit *circuit = new ElectricCircuit();
-            circuit->mItems = newItems;
             circuit->setType(CircuitType::Open);
-            circuit->enableCircuit(&deletedCircuits);
+            circuit->enableCircuit();
         }
     }
 }
@@ -1602,6 +2102,8 @@ void ElectricCircuit::checkReverseVoltageSiblings()
 
     QVector<ElectricCircuit *> dummy;
 
+    DeleteScope scope;
+
     for(int i = 0; i < mItems.size(); i += 2)
     {
         const Item& item = mItems[i];
@@ -1631,6 +2133,9 @@ void ElectricCircuit::checkReverseVoltageSiblings()
         const QVector<ElectricCircuit *> nodeOpenCircuitsCopy = item.node.node->getCircuits(CircuitType::Open);
         for(ElectricCircuit *openCircuit : nodeOpenCircuitsCopy)
         {
+            if(!openCircuit->isAlive())
+                continue;
+
             const auto items = openCircuit->getNode(item.node.node);
             for(const NodeItem& openItem : items)
             {
@@ -1640,6 +2145,7 @@ void ElectricCircuit::checkReverseVoltageSiblings()
                     // This open circuit is going in opposite direction
                     // Remove it
                     openCircuit->terminateHere(openCircuit->getSource(), dummy);
+                    break;
                 }
             }
         }
@@ -1648,6 +2154,8 @@ void ElectricCircuit::checkReverseVoltageSiblings()
 
 bool ElectricCircuit::checkShuntedByOtherCircuit()
 {
+    mStats.shuntChecks++;
+
     for(int i = 0; i < mItems.size(); i += 2)
     {
         const Item& item = mItems[i];
@@ -1665,57 +2173,66 @@ bool ElectricCircuit::checkShuntedByOtherCircuit()
             const Item& after = mItems[afterIdx];
             Q_ASSERT(after.isNode);
 
-            if(after.node.toContact != NodeItem::InvalidContact &&
-                after.node.node->hasExitCircuitOnPole(after.node.toContact,
-                                                      after.node.toPole()))
-            {
-                const auto afterCircuits = after.node.node->getCircuits(CircuitType::Closed);
-                for(ElectricCircuit *other : afterCircuits)
-                {
-                    if(other == this || other->isDisabling() || other->getSource() != this->getSource())
-                        continue;
+            if(after.node.toContact == NodeItem::InvalidContact)
+                continue;
 
-                    const int togheterMax = qMin(other->mItems.size() - 1, afterIdx);
-                    int x = 0;
-                    for(; x <= togheterMax; x += 2)
-                    {
-                        const Item& otherItem = other->mItems[x];
-                        Q_ASSERT(otherItem.isNode);
+            // Only circuits exiting same way can shunt us here
+            auto it = mExitIndex.constFind({after.node.node, after.node.toContact, after.node.toPole()});
+            if(it == mExitIndex.constEnd())
+                continue;
 
-                        if(otherItem.node == mItems[x].node)
-                            continue;
+            for(const ExitEntry& entry : *it)
+            {
+                ElectricCircuit *other = entry.circuit;
+                if(other == this || other->type() != CircuitType::Closed)
+                    continue;
 
-                        break;
-                    }
+                if(other->isDisabling() || other->getSource() != this->getSource())
+                    continue;
+
+                mStats.shuntCandidates++;
 
-                    if(x >= togheterMax)
-                        continue; // This circuit follow same path, skip it
+                const int togheterMax = qMin(other->mItems.size() - 1, afterIdx);
+                int x = 0;
+                for(; x <= togheterMax; x += 2)
+                {
+                    const Item& otherItem = other->mItems[x];
+                    Q_ASSERT(otherItem.isNode);
 
-                    // This circuit diverges after load node, so it does not shunt us
-                    if(x > loadNodeIdx && mItems[loadNodeIdx] == other->mItems[loadNodeIdx])
+                    if(otherItem.node == mItems[x].node)
                         continue;
 
-                    for(; x < other->mItems.size(); x += 2)
-                    {
-                        const Item& otherItem = other->mItems[x];
-                        Q_ASSERT(otherItem.isNode);
+                    break;
+                }
 
-                        if(otherItem.node.node == after.node.node &&
-                            otherItem.node.toContact == after.node.toContact &&
-                            otherItem.node.toPole() == after.node.toPole())
-                        {
-                            // We get shunted by this other circuit
-                            delete this;
-                            return true;
-                        }
+                if(x >= togheterMax)
+                    continue; // This circuit follow same path, skip it
 
-                        if(otherItem.node.node->isElectricLoadNode())
-                        {
-                            // We hit a load on other circuit, it cannot shunt us
-                            break;
-                        }
+                // This circuit diverges after load node, so it does not shunt us
+                if(x > loadNodeIdx && mItems[loadNodeIdx] == other->mItems[loadNodeIdx])
+                    continue;
+
+                if(entry.itemIdx < x)
+                    continue; // It joins us before diverging
+
+                bool loadFound = false;
+                for(; x < entry.itemIdx; x += 2)
+                {
+                    if(other->mItems[x].node.node->isElectricLoadNode())
+                    {
+                        // We hit a load on other circuit, it cannot shunt us
+                        loadFound = true;
+                        break;
                     }
                 }
+
+                if(!loadFound)
+                {
+                    // We get shunted by this other circuit
+                    mStats.circuitsShunted++;
+                    destroy();
+                    return true;
+                }
             }
         }
     }
@@ -1723,8 +2240,13 @@ bool ElectricCircuit::checkShuntedByOtherCircuit()
     return false;
 }
 
-void ElectricCircuit::checkOtherShuntedByMe(QVector<ElectricCircuit *> *deletedCircuits)
+void ElectricCircuit::checkOtherShuntedByMe()
 {
+    mStats.shuntChecks++;
+
+    // Shunted circuits may be deleted, keep them checkable
+    DeleteScope scope;
+
     int prevLoadIdx = 0;
 
     int lastNodeIdx = mItems.size() - 1;
@@ -1733,6 +2255,10 @@ void ElectricCircuit::checkOtherShuntedByMe(QVector<ElectricCircuit *> *deletedC
 
     for(int i = 0; i <= lastNodeIdx; i += 2)
     {
+        // Shunting others may start nested circuit operations
+        if(!isAlive() || !enabled)
+            return;
+
         const Item& item = mItems[i];
         Q_ASSERT(item.isNode);
 
@@ -1745,18 +2271,41 @@ void ElectricCircuit::checkOtherShuntedByMe(QVector<ElectricCircuit *> *deletedC
 
         if(lastBeforeLoadIdx > prevLoadIdx + 2)
         {
-            const Item& before = mItems[lastBeforeLoadIdx];
+            const Item before = mItems[lastBeforeLoadIdx];
 
             // Check if other paths get to this node from same source but with loads
-            auto beforeCircuits = before.node.node->getCircuits(CircuitType::Closed);
-            beforeCircuits.append(before.node.node->getCircuits(CircuitType::Open));
+            // Implicitly shared copy, shunting changes the index
+            const QVector<ExitEntry> candidates =
+                mExitIndex.value({before.node.node, before.node.toContact, before.node.toPole()});
 
             QVector<ElectricCircuit *> dummyList;
+            ElectricCircuit *prevOther = nullptr;
 
-            for(ElectricCircuit *other : beforeCircuits)
+            for(const ExitEntry& entry : candidates)
             {
+                ElectricCircuit *other = entry.circuit;
+                if(other == prevOther)
+                    continue; // Already checked
+
+                prevOther = other;
+
+                if(!other->isAlive() || !other->isEnabled())
+                    continue;
+
                 if(other == this || other->isDisabling() || other->getSource() != this->getSource())
-                    break;
+                    continue;
+
+                // Path could have changed after we copied candidates
+                if(entry.itemIdx >= other->mItems.size())
+                    continue;
+
+                const NodeItem& joinItem = other->mItems.at(entry.itemIdx).node;
+                if(joinItem.node != before.node.node ||
+                        joinItem.toContact != before.node.toContact ||
+                        joinItem.toPole() != before.node.toPole())
+                    continue;
+
+                mStats.shuntCandidates++;
 
                 const int togheterMax = qMin(other->mItems.size() - 1, lastBeforeLoadIdx);
                 if(togheterMax <= prevLoadIdx)
@@ -1781,20 +2330,9 @@ void ElectricCircuit::checkOtherShuntedByMe(QVector<ElectricCircuit *> *deletedC
                     continue;
 
                 bool loadFound = false;
-                for(; x < other->mItems.size(); x += 2)
+                for(; x < entry.itemIdx; x += 2)
                 {
-                    const Item& otherItem = other->mItems[x];
-                    Q_ASSERT(otherItem.isNode);
-
-                    if(otherItem.node.node == before.node.node &&
-                        otherItem.node.toContact == before.node.toContact &&
-                        otherItem.node.toPole() == before.node.toPole())
-                    {
-                        // We reached joining point
-                        break;
-                    }
-
-                    if(otherItem.node.node->isElectricLoadNode())
+                    if(other->mItems[x].node.node->isElectricLoadNode())
                     {
                         // We hit a load on other circuit, it will be shunted by us
                         loadFound = true;
@@ -1805,13 +2343,12 @@ void ElectricCircuit::checkOtherShuntedByMe(QVector<ElectricCircuit *> *deletedC
                 if(loadFound)
                 {
                     // Shunt other circuit (it also deletes circuit)
+                    mStats.circuitsShunted++;
+
                     if(other->type() == CircuitType::Closed)
                         other->disableOrTerminate(other->getSource());
                     else
                         other->terminateHere(other->getSource(), dummyList);
-
-                    if(deletedCircuits)
-                        deletedCircuits->append(other);
                 }
             }
         }
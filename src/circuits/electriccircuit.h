@@ -26,8 +26,17 @@
 #include "../enums/cabletypes.h"
 #include "../enums/circuittypes.h"
 
+#include "circuitgraph.h"
+
+#include "../utils/framestack.h"
+#include "../utils/sharedprefixvector.h"
+
 #include <QFlags>
+#include <QHash>
 #include <QVarLengthArray>
+#include <QVector>
+
+#include <iterator>
 
 class AbstractCircuitNode;
 class PowerSourceNode;
@@ -69,12 +78,86 @@ class ElectricCircuit
         }
     };
 
-    typedef QVarLengthArray<Item, 256> ItemVector;
+    // Path being walked, storage is recycled between walks
+    typedef QVector<Item> ItemVector;
+
+    // Circuits from same source share their common path prefix
+    typedef SharedPrefixVector<Item> ItemPath;
+
+    // Engine counters, used for benchmarks
+    struct Stats
+    {
+        qint64 circuitsCreated = 0;
+        qint64 circuitsDestroyed = 0;
+        qint64 passNodeCalls = 0;
+        qint64 pathNodesRechecked = 0;
+
+        // Allocation pool
+        qint64 poolHits = 0;
+        qint64 poolMisses = 0;
+        qint64 itemsPoolHits = 0;
+        qint64 itemsPoolMisses = 0;
+
+        // Shunt detection
+        qint64 shuntChecks = 0;
+        qint64 shuntCandidates = 0;
+        qint64 circuitsShunted = 0;
+    };
+
+    static inline const Stats& stats() { return mStats; }
+    static void resetStats();
+
+    // Incremental recomputation
+    // Every node records the epoch of its last connection change.
+    // Circuits record the epoch at which their path was validated,
+    // so unchanged path prefixes do not need to be walked again.
+    // Only used by tryReachOpen(), see disableOrTerminate()
+    // and createCircuitsFromOtherNode() for why.
+    static inline quint64 connectionsEpoch() { return mConnectionsEpoch; }
+    static inline quint64 advanceConnectionsEpoch() { return ++mConnectionsEpoch; }
+
+    static inline bool isIncrementalRecompute() { return mIncrementalRecompute; }
+    static inline void setIncrementalRecompute(bool val) { mIncrementalRecompute = val; }
+
+    // Shunt detection, disabled by default
+    // While enabled circuits register their exits in an index
+    // keyed by (node, contact, pole) so only circuits joining
+    // our path are compared. Set it before creating circuits.
+    static inline bool isShuntDetectionEnabled() { return mShuntDetection; }
+    static void setShuntDetectionEnabled(bool val);
+
+    // Walks use an explicit stack, so only this limits path length
+    static constexpr int DefaultMaxWalkDepth = 10000;
+    static inline int maxWalkDepth() { return mMaxWalkDepth; }
+    static void setMaxWalkDepth(int depth);
 
     explicit ElectricCircuit();
     ~ElectricCircuit();
 
-    bool enableCircuit(QVector<ElectricCircuit *> *deletedCircuits = nullptr);
+    // Circuits are created and destroyed in bursts
+    // So recycle their memory instead of going through heap allocator
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr);
+    static void releasePool();
+
+    /*!
+     * \brief The DeleteScope class
+     *
+     * While a scope is alive, deleted circuits are only marked as dead
+     * and kept in memory. So pointers stored in circuit lists copies
+     * can still be checked with isAlive() in constant time.
+     * Dead circuits are freed when outermost scope ends.
+     */
+    class DeleteScope
+    {
+    public:
+        DeleteScope();
+        ~DeleteScope();
+
+        Q_DISABLE_COPY_MOVE(DeleteScope)
+    };
+
+    bool enableCircuit();
     void disableOrTerminate(AbstractCircuitNode *node);
     void terminateHere(AbstractCircuitNode *goalNode, QVector<ElectricCircuit *>& deduplacteList);
 
@@ -83,7 +166,9 @@ class ElectricCircuit
     inline CircuitType type() const { return toType_(mFlagsAndType); }
 
     inline bool isEnabled() const { return enabled; }
+    inline bool isAlive() const { return !mDead; }
 
+    // Uses node index built when circuit is enabled
     NodeOccurences getNode(AbstractCircuitNode *node) const;
 
     bool isLastNode(AbstractCircuitNode *node) const;
@@ -121,30 +206,226 @@ class ElectricCircuit
 
     bool tryReachOpen(AbstractCircuitNode *goalNode);
 
+    bool isNodeChangedSinceValidation(AbstractCircuitNode *node) const;
+
+    void buildNodeIndex();
+    void truncateNodeIndex(int firstIdxToRemove);
+
+    // Visited marks, replace temporary sets of nodes and cables
+    typedef QVarLengthArray<bool, 256> VisitMask;
+
+    static inline quint64 nextVisitEpoch() { return ++mVisitEpoch; }
+    static quint64& visitMark(const Item& item);
+    void markFirstVisits(VisitMask& firstVisit) const;
+
+    void setItemsFromWalk(const ItemVector &items, qsizetype extraItems);
+
+    template <typename Iterator>
+    inline void setItems(Iterator beginIt, Iterator endIt, qsizetype extraItems = 0)
+    {
+        // Keep recycled capacity
+        mItems.clear();
+        mItems.reserve(qsizetype(std::distance(beginIt, endIt)) + extraItems);
+        for(auto it = beginIt; it != endIt; it++)
+            mItems.append(*it);
+    }
+
     static PassNodeResult passCircuitNode(AbstractCircuitNode *node, int nodeContact,
                                           ItemVector& items, int depth,
-                                          QVector<ElectricCircuit *>& deletedCircuits,
                                           PassMode mode = PassModes::None);
 
     static void searchNodeWithOpenCircuits(AbstractCircuitNode *node, int nodeContact, ItemVector &items, int depth);
 
+    // State of a node being passed, kept on explicit stack
+    struct PassFrame
+    {
+        enum class Stage
+        {
+            Enter = 0,
+            NextConnection,
+            AfterSkipLoads,
+            AfterAllLoads
+        };
+
+        void start(AbstractCircuitNode *node_, int nodeContact_,
+                   int depth_, PassMode mode_);
+
+        AbstractCircuitNode *node = nullptr;
+        int nodeContact = 0;
+        int depth = 0;
+        PassMode mode = PassModes::None;
+        Stage stage = Stage::Enter;
+
+        Item nodeItem;
+        CableContact lastCable;
+        CircuitGraph::Edges connections;
+        int connIdx = 0;
+        qsizetype oldVectorSize = 0;
+        qsizetype newVecSize = 0;
+        bool circuitEndsHere = true;
+        PassNodeResult result;
+        PassNodeResult nextResult;
+
+        // Next node to pass
+        CableEnd nextEnd;
+        PassMode newMode = PassModes::None;
+        PassMode callMode = PassModes::None;
+    };
+
+    // Returns true if frame needs to pass next node first
+    static bool resumePassFrame(PassFrame *f, ItemVector& items,
+                                const PassNodeResult& childResult);
+    static bool passAllowingLoads(PassFrame *f, ItemVector& items);
+
+    struct SearchFrame
+    {
+        enum class Stage
+        {
+            Enter = 0,
+            NextConnection
+        };
+
+        void start(AbstractCircuitNode *node_, int nodeContact_, int depth_);
+
+        AbstractCircuitNode *node = nullptr;
+        int nodeContact = 0;
+        int depth = 0;
+        Stage stage = Stage::Enter;
+
+        Item nodeItem;
+        CableContact lastCable;
+        CircuitGraph::Edges connections;
+        int connIdx = 0;
+        qsizetype oldVecSize = 0;
+
+        // Next node to search
+        CableEnd nextEnd;
+    };
+
+    // Returns true if frame needs to search next node first
+    static bool resumeSearchFrame(SearchFrame *f, ItemVector& items);
+
     static void extendExistingCircuits(AbstractCircuitNode *node, int nodeContact, const ItemVector &items);
 
     static void extendExistingCircuits_helper(AbstractCircuitNode *node, int nodeContact, const ItemVector &items,
-                                              const CableContact& lastCable, ElectricCircuit *otherCircuit, QVector<ElectricCircuit *> &deletedCircuits);
+                                              const CableContact& lastCable, ElectricCircuit *otherCircuit);
 
     void checkReverseVoltageSiblings();
 
     bool checkShuntedByOtherCircuit();
-    void checkOtherShuntedByMe(QVector<ElectricCircuit *> *deletedCircuits);
+    void checkOtherShuntedByMe();
 
     inline bool isDisabling() const { return insideDisable || aboutToDisable; }
 
+    void registerExits();
+    void unregisterExits();
+
+    void destroy();
+
 private:
-    QVector<Item> mItems;
+    static Stats mStats;
+    static quint64 mConnectionsEpoch;
+    static bool mIncrementalRecompute;
+    static quint64 mVisitEpoch;
+    static bool mShuntDetection;
+
+    struct ExitKey
+    {
+        AbstractCircuitNode *node;
+        int contact;
+        CircuitPole pole;
+
+        inline bool operator==(const ExitKey& other) const
+        {
+            return node == other.node && contact == other.contact && pole == other.pole;
+        }
+
+        friend inline size_t qHash(const ExitKey& key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.node, key.contact, int(key.pole));
+        }
+    };
+
+    struct ExitEntry
+    {
+        ElectricCircuit *circuit;
+        int itemIdx;
+    };
+
+    // Node items of enabled circuits by exit
+    static QHash<ExitKey, QVector<ExitEntry>> mExitIndex;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    static FreeBlock *mFreeBlocks;
+    static int mFreeBlocksCount;
+    static QVector<QVector<Item>> mItemsPool;
+
+    static int mDeleteScopeDepth;
+    static QVector<ElectricCircuit *> mDeadCircuits;
+
+    // Walks started from an existing path register it here
+    // so that circuits found share it instead of copying
+    class WalkBaseScope
+    {
+    public:
+        WalkBaseScope(ItemPath *base);
+        ~WalkBaseScope();
+
+        Q_DISABLE_COPY_MOVE(WalkBaseScope)
+
+    private:
+        ItemPath *mPrevBase;
+    };
+
+    static ItemPath *mWalkBase;
+
+    // Lease of a recycled item vector for walks
+    class WalkItems
+    {
+    public:
+        WalkItems();
+        ~WalkItems();
+
+        template <typename Iterator>
+        WalkItems(Iterator beginIt, Iterator endIt)
+            : WalkItems()
+        {
+            for(auto it = beginIt; it != endIt; it++)
+                items.append(*it);
+        }
+
+        Q_DISABLE_COPY_MOVE(WalkItems)
+
+        ItemVector items;
+    };
+
+    static QVector<ItemVector> mWalkItemsPool;
+    static int mMaxWalkDepth;
+
+    // Nested walks push their frames above current ones
+    static FrameStack<PassFrame> mPassStack;
+    static FrameStack<SearchFrame> mSearchStack;
+
+    // Node item indexes sorted by node, then by path position
+    struct NodeIndexEntry
+    {
+        AbstractCircuitNode *node;
+        int itemIdx;
+    };
+
+    ItemPath mItems;
+    quint64 mValidEpoch = 0;
+
+    QVector<NodeIndexEntry> mNodeIndex;
     bool enabled = false;
     bool insideDisable = false;
     bool aboutToDisable = false;
+    bool mDead = false;
+    bool mExitsRegistered = false;
     CircuitFlags mFlagsAndType = CircuitFlags::None;
     CircuitFlags mNonSourceFlags = CircuitFlags::None;
 };
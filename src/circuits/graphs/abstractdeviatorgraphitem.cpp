@@ -151,18 +151,6 @@ QRectF AbstractDeviatorGraphItem::boundingRect() const
         .united(itemPreviewRect());
 }
 
-void AbstractDeviatorGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    TileRotate centralConnectorRotate = TileRotate::Deg90;
-    if(deviatorNode()->flipContact())
-        centralConnectorRotate = TileRotate::Deg270;
-
-    connectors.emplace_back(location(), rotate(), 0); // Common
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg180, 2); // Down
-    if(deviatorNode()->hasCentralConnector())
-        connectors.emplace_back(location(), rotate() + centralConnectorRotate, 1);  // Up
-}
-
 double AbstractDeviatorGraphItem::textDisplayFontSize() const
 {
     return 20.0; // pt, a bit smaller than relay power nodes
@@ -44,8 +44,6 @@ class AbstractDeviatorGraphItem : public AbstractNodeGraphItem
 
     QRectF boundingRect() const override;
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     double textDisplayFontSize() const override;
 
     QRectF textDisplayRect() const override;
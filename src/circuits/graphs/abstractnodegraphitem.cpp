@@ -74,6 +74,11 @@ QPainterPath AbstractNodeGraphItem::shape() const
     return p;
 }
 
+void AbstractNodeGraphItem::getConnectors(std::vector<Connector> &connectors) const
+{
+    mAbstractNode->getConnectors(connectors, location(), rotate());
+}
+
 void AbstractNodeGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
     CircuitScene *s = circuitScene();
@@ -691,12 +696,15 @@ void AbstractNodeGraphItem::setRotate(TileRotate newRotate)
         return;
     mRotate = newRotate;
 
+    CircuitScene *s = circuitScene();
+    if(s)
+        s->setNodeRotate(mAbstractNode, mRotate);
+
     // Detach all contacts, try reconnect immediately
     invalidateConnections();
 
     recalculateTextPosition();
 
-    CircuitScene *s = circuitScene();
     if(s)
         s->setHasUnsavedChanges(true);
 
@@ -732,16 +740,7 @@ CircuitScene *AbstractNodeGraphItem::circuitScene() const
 
 bool AbstractNodeGraphItem::loadFromJSON(const QJsonObject &obj)
 {
-    if(!getAbstractNode()->loadFromJSON(obj))
-        return false;
-
-    TileLocation tile{0, 0};
-    tile.x = obj.value("x").toInt();
-    tile.y = obj.value("y").toInt();
-    setLocation(tile);
-
-    setRotate(TileRotate(obj.value("rotation").toInt()));
-
+    // Node, location and rotation are loaded by CircuitSheetLayout
     setTextRotate(Connector::Direction(obj.value("text_rotation").toInt(1)));
 
     return true;
@@ -749,15 +748,7 @@ bool AbstractNodeGraphItem::loadFromJSON(const QJsonObject &obj)
 
 void AbstractNodeGraphItem::saveToJSON(QJsonObject &obj) const
 {
-    TileLocation tile = location();
-    obj["x"] = tile.x;
-    obj["y"] = tile.y;
-
-    obj["rotation"] = int(mRotate);
-
     obj["text_rotation"] = int(mTextDirection);
-
-    getAbstractNode()->saveToJSON(obj);
 }
 
 QColor AbstractNodeGraphItem::getContactColor(const AnyCircuitType targetType,
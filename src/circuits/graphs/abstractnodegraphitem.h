@@ -47,7 +47,7 @@ class AbstractNodeGraphItem : public QGraphicsObject
     QRectF boundingRect() const override;
     QPainterPath shape() const override;
 
-    virtual void getConnectors(std::vector<Connector>& /*connectors*/) const {}
+    void getConnectors(std::vector<Connector>& connectors) const;
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,QWidget *widget = nullptr) override;
 
@@ -89,31 +89,6 @@ void BifilarizatorGraphItem::paint(QPainter *painter, const QStyleOptionGraphics
     painter->drawLine(lines[toRotateInt(rotate() + TileRotate::Deg90)]);
 }
 
-void BifilarizatorGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    /* Do not invert unifilar polarity for case when 2 Bifilarizator nodes
-     * are placed in opposite direction and connected like this:
-     *              ___+__+__+___
-     *              |           |
-     * Uni A -----Bifi 1       Bifi 2 ------ Uni B
-     *              |           |
-     *              |__-__-__-__|
-     *
-     * Current in Uni A must have same polarity in Uni B
-     * So positive must go on upper half and negative on lower half
-     * So Bifi 1 is normal and Bifi 2 is reversed
-     */
-
-    const bool invertPolarity =
-            (rotate() == TileRotate::Deg180 || rotate() == TileRotate::Deg270);
-
-    connectors.emplace_back(location(), rotate() - TileRotate::Deg90,
-                            invertPolarity ? 2 : 0);
-    connectors.emplace_back(location(), rotate(), 1);
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg90,
-                            invertPolarity ? 0 : 2);
-}
-
 BifilarizatorNode *BifilarizatorGraphItem::node() const
 {
     return static_cast<BifilarizatorNode *>(getAbstractNode());
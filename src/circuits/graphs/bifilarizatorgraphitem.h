@@ -37,8 +37,6 @@ class BifilarizatorGraphItem : public AbstractNodeGraphItem
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     BifilarizatorNode *node() const;
 };
 
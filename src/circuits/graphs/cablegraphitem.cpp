@@ -34,9 +34,6 @@
 #include <QPainterPathStroker>
 #include <QPainter>
 
-#include <QJsonObject>
-#include <QJsonArray>
-
 #include <QGraphicsSceneMouseEvent>
 
 static QPainterPath _qt_graphicsItem_shapeFromPath(const QPainterPath &path, const QPen &pen, const qreal widthF)
@@ -126,7 +123,7 @@ QPainterPath CableGraphItem::shape() const
 {
     // Return a bigger shape to get mouse clicks in around cable drawing.
     // Otherwise it's too difficult to select it.
-    return _qt_graphicsItem_shapeFromPath(mPath, pen, pen.widthF() * 4.0);
+    return _qt_graphicsItem_shapeFromPath(ensurePath(), pen, pen.widthF() * 4.0);
 }
 
 void CableGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -179,7 +176,7 @@ void CableGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *op
     // Draw cable path
     painter->setPen(pen);
     painter->setBrush(Qt::NoBrush);
-    painter->drawPath(mPath);
+    painter->drawPath(ensurePath());
 }
 
 void CableGraphItem::mouseMoveEvent(QGraphicsSceneMouseEvent *ev)
@@ -288,6 +285,7 @@ void CableGraphItem::setPathInternal(const QPainterPath &newPath)
 {
     prepareGeometryChange();
     mPath = newPath;
+    mPathDirty = false;
     mBoundingRect = QRectF();
     update();
 }
@@ -299,6 +297,22 @@ CircuitScene *CableGraphItem::circuitScene() const
 
 QPainterPath CableGraphItem::path() const
 {
+    return ensurePath();
+}
+
+void CableGraphItem::releasePath()
+{
+    mPath = QPainterPath();
+    mPathDirty = true;
+}
+
+const QPainterPath &CableGraphItem::ensurePath() const
+{
+    if(mPathDirty)
+    {
+        mPath = generatePath(mCablePath);
+        mPathDirty = false;
+    }
     return mPath;
 }
 
@@ -307,68 +321,18 @@ const CableGraphPath &CableGraphItem::cablePath() const
     return mCablePath;
 }
 
-void CableGraphItem::setCablePathInternal(const CableGraphPath &newCablePath, bool registerTiles)
+void CableGraphItem::setCablePath(const CableGraphPath &newCablePath)
 {
     prepareGeometryChange();
 
-    // Update scene
-    auto *s = circuitScene();
-    if(s && registerTiles)
-        s->removeCableTiles(this);
-
     mCablePath = newCablePath;
 
-    if(s && registerTiles)
-        s->addCableTiles(this);
-
-    mPath = mCablePath.generatePath();
+    // Not needed until scene is shown
+    releasePath();
     mBoundingRect = QRectF();
 
     setVisible(!mCablePath.isZeroLength());
 
-    // Detach nodes, they will be reattached later
-    CableEnd cableEnd = cable()->getNode(CableSide::A);
-    if(cableEnd.node)
-    {
-        CableItem item;
-        item.cable.cable = cable();
-        item.cable.side = CableSide::A;
-        item.nodeContact = cableEnd.nodeContact;
-
-        item.cable.pole = CircuitPole::First;
-        if(cableEnd.node->getContactType(cableEnd.nodeContact, item.cable.pole) != ContactType::NotConnected)
-        {
-            cableEnd.node->detachCable(item);
-        }
-
-        item.cable.pole = CircuitPole::Second;
-        if(cableEnd.node->getContactType(cableEnd.nodeContact, item.cable.pole) != ContactType::NotConnected)
-        {
-            cableEnd.node->detachCable(item);
-        }
-    }
-
-    cableEnd = cable()->getNode(CableSide::B);
-    if(cableEnd.node)
-    {
-        CableItem item;
-        item.cable.cable = cable();
-        item.cable.side = CableSide::B;
-        item.nodeContact = cableEnd.nodeContact;
-
-        item.cable.pole = CircuitPole::First;
-        if(cableEnd.node->getContactType(cableEnd.nodeContact, item.cable.pole) != ContactType::NotConnected)
-        {
-            cableEnd.node->detachCable(item);
-        }
-
-        item.cable.pole = CircuitPole::Second;
-        if(cableEnd.node->getContactType(cableEnd.nodeContact, item.cable.pole) != ContactType::NotConnected)
-        {
-            cableEnd.node->detachCable(item);
-        }
-    }
-
     update();
 }
 
@@ -404,7 +368,7 @@ bool CableGraphItem::isMouseInsideShapePluseExtra(const QPointF &p) const
         return true;
     }
 
-    CircuitScene::TileCablePair pair = s->getCablesAt(tile);
+    CircuitScene::TileCableGraphPair pair = s->getCablesAt(tile);
 
     CableGraphItem *otherCrossCable = nullptr;
     if(pair.first == this)
@@ -473,47 +437,14 @@ Connector::Direction CableGraphItem::directionB() const
     return mCablePath.endDirection();
 }
 
-bool CableGraphItem::loadFromJSON(const QJsonObject &obj)
-{
-    if(!obj.contains("path"))
-        return false;
-
-    const QJsonObject pathObj = obj.value("path").toObject();
-    CableGraphPath newPath = CableGraphPath::loadFromJSON(pathObj);
-    if(newPath.isEmpty() || !newPath.isComplete())
-        return false;
-
-    setCablePath(newPath);
-    return true;
-}
-
-void CableGraphItem::saveToJSON(QJsonObject &obj) const
-{
-    QJsonObject pathObj;
-    CableGraphPath::saveToJSON(mCablePath, pathObj);
-    obj["path"] = pathObj;
-}
-
 TileLocation CableGraphItem::sideA() const
 {
-    if(mCablePath.isEmpty())
-        return TileLocation::invalid;
-
-    if(mCablePath.isZeroLength())
-        return mCablePath.first();
-
-    return mCablePath.first() + mCablePath.startDirection();
+    return mCablePath.sideA();
 }
 
 TileLocation CableGraphItem::sideB() const
 {
-    if(mCablePath.isEmpty())
-        return TileLocation::invalid;
-
-    if(mCablePath.isZeroLength())
-        return mCablePath.last();
-
-    return mCablePath.last() + mCablePath.endDirection();
+    return mCablePath.sideB();
 }
 
 CircuitCable *CableGraphItem::cable() const
@@ -521,209 +452,31 @@ CircuitCable *CableGraphItem::cable() const
     return mCable;
 }
 
-Connector::Direction CableGraphPath::getEnterDirection(int tileIdx) const
-{
-    if(tileIdx == 0)
-        return mStartDirection;
-
-    if(tileIdx >= mTiles.size())
-        return Connector::Direction::South; // Error
-
-    const TileLocation& tile = mTiles.at(tileIdx);
-    const TileLocation& prevTile = mTiles.at(tileIdx - 1);
-    return getDirection(tile, prevTile);
-}
-
-Connector::Direction CableGraphPath::getExitDirection(int tileIdx) const
-{
-    if(tileIdx == mTiles.size() - 1)
-        return mEndDirection;
-
-    if(tileIdx >= mTiles.size())
-        return Connector::Direction::South; // Error
-
-    const TileLocation& tile = mTiles.at(tileIdx);
-    const TileLocation& nextTile = mTiles.at(tileIdx + 1);
-    return getDirection(tile, nextTile);
-}
-
-bool CableGraphPath::addTile(const TileLocation &l)
-{
-    if(mPathIsComplete)
-        return false;
-
-    if(!mTiles.isEmpty())
-    {
-        if(mTiles.last() == l)
-            return false; // Cannot add same tile twice
-
-        const TileLocation& prevTile = mTiles.last();
-        if(prevTile.x != l.x && prevTile.y != l.y)
-        {
-            // Adjacent tiles must have one coordinate in common
-            return false;
-        }
-
-        const auto newPrevTileExitDir = getDirection(mTiles.last(), l);
-        const auto newTileStartDir = ~newPrevTileExitDir; // Opposite
-        if(!mExitDirectionIsFree)
-        {
-            // We didn't respect last exit direction
-            if(newPrevTileExitDir != mWantedExitDirection)
-                return false;
-        }
-
-        // Check we are not going back
-        const auto prevTileStartDir = getEnterDirection(mTiles.size() - 1);
-        if(newPrevTileExitDir == prevTileStartDir)
-            return false;
-
-        // Cable can pass on same tile twice if:
-        // - it's not same as previous tile
-        // - Both times it passes it does not bend, but goes straight
-        // - Direction is different in the 2 passages
-
-        int idx = mTiles.indexOf(l);
-        if(idx >= 0)
-        {
-            // Check if first passage was straigh
-            const auto enterDir1 = getEnterDirection(idx);
-            const auto exitDir1 = getExitDirection(idx);
-            if(enterDir1 != ~exitDir1)
-                return false; // Directions are not opposite, it bends
-
-            if(newTileStartDir == enterDir1 || newTileStartDir == exitDir1)
-                return false; // Both passages have same direction
-
-            // We do not want to bend second passage
-            mExitDirectionIsFree = false;
-            mWantedExitDirection = ~newTileStartDir; // Opposite
-        }
-        else
-        {
-            // Reset
-            mExitDirectionIsFree = true;
-        }
-    }
-
-    mTiles.append(l);
-    return true;
-}
-
-Connector::Direction CableGraphPath::startDirection() const
-{
-    return mStartDirection;
-}
-
-bool CableGraphPath::setStartDirection(Connector::Direction newStartDirection)
-{
-    if(!mTiles.isEmpty())
-        return false; // Must be set before adding tiles
-
-    mStartDirection = newStartDirection;
-    return true;
-}
-
-Connector::Direction CableGraphPath::endDirection() const
-{
-    return mEndDirection;
-}
-
-bool CableGraphPath::setEndDirection(Connector::Direction newEndDirection)
-{
-    if(mTiles.isEmpty())
-        return false; // Must add tiles first
-
-    if(!mExitDirectionIsFree && newEndDirection != mWantedExitDirection)
-    {
-        // We didn't respect last exit direction
-        return false;
-    }
-
-    if(getEnterDirection(mTiles.size() - 1) == newEndDirection)
-        return false; // Cannot enter and exit on same direction
-
-    mEndDirection = newEndDirection;
-
-    mPathIsComplete = true;
-
-    return true;
-}
-
-bool CableGraphPath::removeLastLine()
-{
-    if(mTiles.isEmpty() || isZeroLength())
-        return false;
-
-    if(mPathIsComplete)
-    {
-        // Remove end connector direction
-        mPathIsComplete = false;
-        return true;
-    }
-
-    if(mTiles.size() == 1)
-    {
-        // Remove first
-        mTiles.removeLast();
-        return true;
-    }
-
-    // Remove last straight line
-    const auto startDir = getEnterDirection(mTiles.size() - 1);
-    while(mTiles.size() > 1) // Do not remove first
-    {
-        const auto otherStartDir = getEnterDirection(mTiles.size() - 1);
-        if(otherStartDir != startDir)
-            break; // We reached a bend
-
-        mTiles.removeLast();
-    }
-
-    return true;
-}
-
-bool CableGraphPath::isPointInsideCableTiles(const QPointF &pos) const
-{
-    // This is smaller than total bounding rects (Think L-shaped cables)
-    // But it's more than shape (Which has just pen width)
-    for(const TileLocation& tile : mTiles)
-    {
-        const QRectF tileRect(tile.toPoint(),
-                              QSizeF(TileLocation::Size,
-                                     TileLocation::Size));
-        if(tileRect.contains(pos))
-            return true;
-    }
-
-    return false;
-}
-
-QPainterPath CableGraphPath::generatePath() const
+QPainterPath CableGraphItem::generatePath(const CableGraphPath &cablePath)
 {
     QPainterPath path;
-    if(mTiles.isEmpty() || isZeroLength())
+    if(cablePath.isEmpty() || cablePath.isZeroLength())
         return path; // Empty
 
     // Move to start connector
-    path.moveTo(CircuitScene::getConnectorPoint(mTiles.first(), mStartDirection));
+    path.moveTo(CircuitScene::getConnectorPoint(cablePath.first(), cablePath.startDirection()));
 
     // Draw start connector line
-    QPointF center = mTiles.first().toPoint();
+    QPointF center = cablePath.first().toPoint();
     center.rx() += TileLocation::HalfSize;
     center.ry() += TileLocation::HalfSize;
     path.lineTo(center);
 
-    Connector::Direction exitDir = getExitDirection(0);
-    for(int i = 1; i < mTiles.size() - 1; i++)
+    Connector::Direction exitDir = cablePath.getExitDirection(0);
+    for(int i = 1; i < cablePath.getTilesCount() - 1; i++)
     {
         // Go from second to just before last tile
-        Connector::Direction exitDir2 = getExitDirection(i);
+        Connector::Direction exitDir2 = cablePath.getExitDirection(i);
         if(exitDir2 == exitDir)
             continue; // Line is straigh, go to next tile
 
         // We reached a bend
-        center = mTiles.at(i).toPoint();
+        center = cablePath.at(i).toPoint();
         center.rx() += TileLocation::HalfSize;
         center.ry() += TileLocation::HalfSize;
         path.lineTo(center);
@@ -731,341 +484,20 @@ QPainterPath CableGraphPath::generatePath() const
         exitDir = exitDir2;
     }
 
-    if(mTiles.size() > 1)
+    if(cablePath.getTilesCount() > 1)
     {
         // Go to last tile
-        center = mTiles.last().toPoint();
+        center = cablePath.last().toPoint();
         center.rx() += TileLocation::HalfSize;
         center.ry() += TileLocation::HalfSize;
         path.lineTo(center);
     }
 
-    if(mPathIsComplete)
+    if(cablePath.isComplete())
     {
         // Draw end connector line
-        path.lineTo(CircuitScene::getConnectorPoint(mTiles.last(), mEndDirection));
+        path.lineTo(CircuitScene::getConnectorPoint(cablePath.last(), cablePath.endDirection()));
     }
 
     return path;
 }
-
-CableGraphPath CableGraphPath::tryMerge(const CableGraphPath &other) const
-{
-    // No point in merging zero length cables
-    if(isZeroLength() || other.isZeroLength())
-        return {}; // Return empty
-
-    CableGraphPath totalPath;
-
-    TileLocation ourNextFirst = this->first() + this->startDirection();
-    if(ourNextFirst == other.first()
-            && other.startDirection() == ~this->startDirection())
-    {
-        // Pass other cable reversed and then ourselves
-        totalPath.setStartDirection(other.endDirection());
-        for(int i = other.getTilesCount() - 1; i >= 0; i--)
-        {
-            if(!totalPath.addTile(other.at(i)))
-            {
-                return {};
-            }
-        }
-
-        for(int i = 0; i < this->getTilesCount(); i++)
-        {
-            if(!totalPath.addTile(this->at(i)))
-            {
-                return {};
-            }
-        }
-
-        if(!totalPath.setEndDirection(this->endDirection()))
-            return {};
-
-        return totalPath;
-    }
-
-    if(ourNextFirst == other.last()
-            && other.endDirection() == ~this->startDirection())
-    {
-        // Pass other cable and then ourselves
-        totalPath.setStartDirection(other.startDirection());
-        for(int i = 0; i < other.getTilesCount(); i++)
-        {
-            if(!totalPath.addTile(other.at(i)))
-            {
-                return {};
-            }
-        }
-
-        for(int i = 0; i < this->getTilesCount(); i++)
-        {
-            if(!totalPath.addTile(this->at(i)))
-            {
-                return {};
-            }
-        }
-
-        if(!totalPath.setEndDirection(this->endDirection()))
-            return {};
-
-        return totalPath;
-    }
-
-    TileLocation ourNextLast = this->last() + this->endDirection();
-    if(ourNextLast == other.first()
-            && other.startDirection() == ~this->endDirection())
-    {
-        // Pass ourselves and then other cable
-        totalPath.setStartDirection(this->startDirection());
-
-        for(int i = 0; i < this->getTilesCount(); i++)
-        {
-            if(!totalPath.addTile(this->at(i)))
-            {
-                return {};
-            }
-        }
-
-        for(int i = 0; i < other.getTilesCount(); i++)
-        {
-            if(!totalPath.addTile(other.at(i)))
-            {
-                return {};
-            }
-        }
-
-        if(!totalPath.setEndDirection(other.endDirection()))
-            return {};
-
-        return totalPath;
-    }
-
-    if(ourNextLast == other.last()
-            && other.endDirection() == ~this->endDirection())
-    {
-        // Pass ourselves and then other cable reversed
-        totalPath.setStartDirection(this->startDirection());
-
-        for(int i = 0; i < this->getTilesCount(); i++)
-        {
-            if(!totalPath.addTile(this->at(i)))
-            {
-                return {};
-            }
-        }
-
-        for(int i = other.getTilesCount() - 1; i >= 0; i--)
-        {
-            if(!totalPath.addTile(other.at(i)))
-            {
-                return {};
-            }
-        }
-
-        if(!totalPath.setEndDirection(other.startDirection()))
-            return {};
-
-        return totalPath;
-    }
-
-    // Return empty
-    return {};
-}
-
-bool CableGraphPath::splitted(const TileLocation splitLoc, SplitPair& result) const
-{
-    if(isZeroLength() || !mTiles.contains(splitLoc))
-        return false; // Nothing to split
-
-    CableGraphPath a, b;
-
-    // Set a start
-    a.setStartDirection(this->startDirection());
-
-    int tileIdx = 0;
-    for(; tileIdx < mTiles.size(); tileIdx++)
-    {
-        const TileLocation& tile = mTiles.at(tileIdx);
-
-        if(tile == splitLoc)
-        {
-            // We reached node tile
-            if(a.isEmpty())
-                break; // No path before tile
-
-            // Set end direction
-            a.setEndDirection(getDirection(a.last(), splitLoc));
-            break;
-        }
-
-        // Copy first half to a
-        a.addTile(tile);
-    }
-
-    // Skip splitLoc tile
-    tileIdx++;
-
-    for(; tileIdx < mTiles.size(); tileIdx++)
-    {
-        const TileLocation& tile = mTiles.at(tileIdx);
-
-        if(b.isEmpty())
-        {
-            // Set b start direction
-            b.setStartDirection(getDirection(tile, splitLoc));
-        }
-
-        // Copy second half to b
-        b.addTile(tile);
-    }
-
-    b.setEndDirection(this->endDirection());
-
-    result.first = a;
-    result.second = b;
-    return true;
-}
-
-CableGraphPath CableGraphPath::translatedBy(int16_t dx, int16_t dy) const
-{
-    if(isZeroLength() || isEmpty())
-        return {};
-
-    CableGraphPath translated;
-    translated.setStartDirection(startDirection());
-
-    for(const TileLocation tile : mTiles)
-    {
-        translated.addTile(tile.adjusted(dx, dy));
-    }
-
-    translated.setEndDirection(endDirection());
-
-    return translated;
-}
-
-CableGraphPath CableGraphPath::createZeroLength(const TileLocation &a, const TileLocation &b)
-{
-    CableGraphPath path;
-    path.mIsZeroLength = true;
-
-    if(a.x == b.x)
-    {
-        Q_ASSERT_X(std::abs(a.y - b.y) == 1,
-                   "CableGraphPath::createZeroLength",
-                   "horizontal not adjacent");
-        path.mStartDirection = getDirection(b, a); // Opposite
-    }
-    else if(a.y == b.y)
-    {
-        Q_ASSERT_X(std::abs(a.x - b.x) == 1,
-                   "CableGraphPath::createZeroLength",
-                   "vertical not adjacent");
-        path.mStartDirection = getDirection(b, a); // Opposite
-    }
-    else
-    {
-        // Tiles are not adjacent
-        Q_ASSERT_X(false, "CableGraphPath::createZeroLength", "tiles not adjacent");
-    }
-
-    path.mTiles.append(a);
-    path.mTiles.append(b);
-    path.mEndDirection = ~path.mStartDirection;
-
-    return path;
-}
-
-CableGraphPath CableGraphPath::loadFromJSON(const QJsonObject &obj)
-{
-    const QJsonArray tiles = obj.value("tiles").toArray();
-
-
-    CableGraphPath result;
-
-    int startDir = obj.value("start_dir").toInt();
-    int endDir = obj.value("end_dir").toInt();
-
-    result.setStartDirection(Connector::Direction(startDir));
-
-    for(const QJsonValue& v : tiles)
-    {
-        const QJsonObject tileObj = v.toObject();
-        TileLocation tile;
-        tile.x = int16_t(tileObj.value("x").toInt());
-        tile.y = int16_t(tileObj.value("y").toInt());
-        result.addTile(tile);
-    }
-
-    result.setEndDirection(Connector::Direction(endDir));
-
-    if(!result.isComplete())
-        return {};
-
-    return result;
-}
-
-void CableGraphPath::saveToJSON(const CableGraphPath &path, QJsonObject &obj)
-{
-    assert(!path.isZeroLength());
-
-    const bool needsReverse = path.needsReversing();
-
-    QJsonArray tiles;
-    for(const TileLocation tile : path.tiles())
-    {
-        QJsonObject tileObj;
-        tileObj["x"] = tile.x;
-        tileObj["y"] = tile.y;
-
-        if(needsReverse)
-            tiles.prepend(tileObj);
-        else
-            tiles.append(tileObj);
-    }
-    obj["tiles"] = tiles;
-
-    if(needsReverse)
-    {
-        obj["start_dir"] = int(path.endDirection());
-        obj["end_dir"] = int(path.startDirection());
-    }
-    else
-    {
-        obj["start_dir"] = int(path.startDirection());
-        obj["end_dir"] = int(path.endDirection());
-    }
-}
-
-bool CableGraphPath::needsReversing() const
-{
-    if(tiles().size() == 1)
-    {
-        return startDirection() < endDirection();
-    }
-    else if(tiles().size() > 1)
-    {
-        if(first().x == last().x)
-            return first().y > last().y;
-
-        return first().x > last().x;
-    }
-
-    return false;
-}
-
-Connector::Direction CableGraphPath::getDirection(const TileLocation &a, const TileLocation &b)
-{
-    if(a.x == b.x)
-    {
-        if(a.y > b.y)
-            return Connector::Direction::North;
-        return Connector::Direction::South;
-    }
-
-    // Tiles have same y
-    if(a.x > b.x)
-        return Connector::Direction::West;
-    return Connector::Direction::East;
-}
@@ -28,100 +28,11 @@
 #include <QPen>
 #include <QVector>
 
-#include "../../utils/tilerotate.h"
+#include "../cablegraphpath.h"
 
 class CircuitCable;
 class CircuitScene;
 
-class QJsonObject;
-
-class CableGraphPath
-{
-public:
-    CableGraphPath() = default;
-
-    inline const QVector<TileLocation>& tiles() const
-    {
-        return mTiles;
-    }
-
-    inline int getTilesCount() const
-    {
-        return mTiles.size();
-    }
-
-    inline bool isEmpty() const
-    {
-        return mTiles.isEmpty();
-    }
-
-    inline bool validNotZero() const
-    {
-        return !isEmpty() && !isZeroLength() && isComplete();
-    }
-
-    inline TileLocation first() const { return mTiles.first(); }
-    inline TileLocation last() const { return mTiles.last(); }
-    inline TileLocation at(int i) const { return mTiles.at(i); }
-
-    Connector::Direction getEnterDirection(int tileIdx) const;
-    Connector::Direction getExitDirection(int tileIdx) const;
-
-    bool addTile(const TileLocation& l);
-
-    Connector::Direction startDirection() const;
-    bool setStartDirection(Connector::Direction newStartDirection);
-
-    Connector::Direction endDirection() const;
-    bool setEndDirection(Connector::Direction newEndDirection);
-
-    bool removeLastLine();
-
-    bool isPointInsideCableTiles(const QPointF& pos) const;
-
-    QPainterPath generatePath() const;
-
-    inline bool isZeroLength() const
-    {
-        return mIsZeroLength;
-    }
-
-    inline bool isComplete() const
-    {
-        return mPathIsComplete;
-    }
-
-    CableGraphPath tryMerge(const CableGraphPath& other) const;
-
-    typedef std::pair<CableGraphPath, CableGraphPath> SplitPair;
-    bool splitted(const TileLocation splitLoc, SplitPair& result) const;
-
-    CableGraphPath translatedBy(int16_t dx, int16_t dy) const;
-
-    static CableGraphPath createZeroLength(const TileLocation& a,
-                                           const TileLocation& b);
-
-    static CableGraphPath loadFromJSON(const QJsonObject& obj);
-    static void saveToJSON(const CableGraphPath& path, QJsonObject& obj);
-
-    bool needsReversing() const;
-
-private:
-    static Connector::Direction getDirection(const TileLocation& a,
-                                             const TileLocation& b);
-
-private:
-    QVector<TileLocation> mTiles;
-    Connector::Direction mStartDirection;
-    Connector::Direction mEndDirection;
-
-    bool mExitDirectionIsFree = true;
-    Connector::Direction mWantedExitDirection = Connector::Direction::South;
-
-    bool mPathIsComplete = false;
-    bool mIsZeroLength = false;
-};
-
 class CableGraphItem : public QGraphicsObject
 {
     Q_OBJECT
@@ -134,10 +45,8 @@ class CableGraphItem : public QGraphicsObject
 
     const CableGraphPath& cablePath() const;
 
-    void setCablePath(const CableGraphPath &newCablePath)
-    {
-        setCablePathInternal(newCablePath, true);
-    }
+    // Graphics only, cable path is owned by CircuitSheetLayout
+    void setCablePath(const CableGraphPath &newCablePath);
 
     QRectF boundingRect() const override;
     QPainterPath shape() const override;
@@ -163,8 +72,10 @@ class CableGraphItem : public QGraphicsObject
 
     Connector::Direction directionB() const;
 
-    bool loadFromJSON(const QJsonObject& obj);
-    void saveToJSON(QJsonObject& obj) const;
+    // Drop painter path, regenerated on next paint
+    void releasePath();
+
+    static QPainterPath generatePath(const CableGraphPath& cablePath);
 
 protected:
     void mouseMoveEvent(QGraphicsSceneMouseEvent *ev) override;
@@ -177,11 +88,11 @@ class CableGraphItem : public QGraphicsObject
     friend class CircuitScene;
     void setPathInternal(const QPainterPath& newPath);
 
-    void setCablePathInternal(const CableGraphPath &newCablePath,
-                              bool registerTiles);
-
     bool isMouseInsideShapePluseExtra(const QPointF& p) const;
 
+    // Painter path is generated lazily from cable path
+    const QPainterPath& ensurePath() const;
+
 private slots:
     void updatePen();
     void triggerUpdate();
@@ -189,7 +100,8 @@ private slots:
 private:
     CircuitCable *mCable;
     QPen pen;
-    QPainterPath mPath;
+    mutable QPainterPath mPath;
+    mutable bool mPathDirty = false;
     QRectF mBoundingRect;
     CableGraphPath mCablePath;
 };
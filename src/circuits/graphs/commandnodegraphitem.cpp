@@ -128,11 +128,6 @@ void CommandNodeGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsIt
     drawName(painter);
 }
 
-void CommandNodeGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-}
-
 QString CommandNodeGraphItem::displayString() const
 {
     if(node()->object())
@@ -147,12 +147,6 @@ void DiodeGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *op
     painter->drawLine(diodeLine);
 }
 
-void DiodeGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg180, 1);
-}
-
 DiodeCircuitNode *DiodeGraphItem::node() const
 {
     return static_cast<DiodeCircuitNode *>(getAbstractNode());
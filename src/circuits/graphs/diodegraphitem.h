@@ -37,8 +37,6 @@ class DiodeGraphItem : public AbstractNodeGraphItem
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     DiodeCircuitNode *node() const;
 };
 
@@ -168,12 +168,6 @@ void OnOffGraphItem::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *ev)
     }
 }
 
-void OnOffGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg180, 1);
-}
-
 OnOffSwitchNode *OnOffGraphItem::node() const
 {
     return static_cast<OnOffSwitchNode *>(getAbstractNode());
@@ -38,8 +38,6 @@ class OnOffGraphItem : public AbstractNodeGraphItem
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,QWidget *widget = nullptr) override;
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     OnOffSwitchNode *node() const;
 
 protected:
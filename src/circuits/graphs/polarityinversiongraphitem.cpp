@@ -141,12 +141,6 @@ void PolarityInversionGraphItem::paint(QPainter *painter, const QStyleOptionGrap
     painter->drawPolyline(arr, 3);
 }
 
-void PolarityInversionGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg180, 1);
-}
-
 PolarityInversionNode *PolarityInversionGraphItem::node() const
 {
     return static_cast<PolarityInversionNode *>(getAbstractNode());
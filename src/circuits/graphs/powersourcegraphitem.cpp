@@ -93,11 +93,6 @@ void PowerSourceGraphItem::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *ev)
     }
 }
 
-void PowerSourceGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-}
-
 PowerSourceNode *PowerSourceGraphItem::node() const
 {
     return static_cast<PowerSourceNode *>(getAbstractNode());
@@ -38,8 +38,6 @@ class PowerSourceGraphItem : public AbstractNodeGraphItem
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,QWidget *widget = nullptr) override;
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     PowerSourceNode *node() const;
 
 protected:
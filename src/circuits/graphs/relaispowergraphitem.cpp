@@ -457,27 +457,6 @@ void RelaisPowerGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsIt
     drawName(painter);
 }
 
-void RelaisPowerGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    if(mRelay && mRelay->relaisType() == AbstractRelais::RelaisType::Combinator)
-    {
-        TileRotate firstConnector = TileRotate::Deg90;
-        if(node()->combinatorSecondCoil())
-            firstConnector = TileRotate::Deg270;
-
-        const TileRotate secondConnector = twoConnectorsRotate() + TileRotate::Deg180;
-
-        connectors.emplace_back(location(), firstConnector, 0);
-        connectors.emplace_back(location(), secondConnector, 1);
-    }
-    else
-    {
-        connectors.emplace_back(location(), rotate(), 0);
-        if(node()->hasSecondConnector())
-            connectors.emplace_back(location(), rotate() + TileRotate::Deg180, 1);
-    }
-}
-
 QString RelaisPowerGraphItem::displayString() const
 {
     if(mRelay)
@@ -883,3 +862,8 @@ RelaisPowerNode *RelaisPowerGraphItem::node() const
 {
     return static_cast<RelaisPowerNode *>(getAbstractNode());
 }
+
+TileRotate RelaisPowerGraphItem::twoConnectorsRotate() const
+{
+    return RelaisPowerNode::twoConnectorsRotate(rotate());
+}
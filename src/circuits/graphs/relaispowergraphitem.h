@@ -41,8 +41,6 @@ class RelaisPowerGraphItem : public AbstractNodeGraphItem
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,QWidget *widget = nullptr) override;
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     QString displayString() const override;
 
     QString tooltipString() const override;
@@ -54,17 +52,7 @@ class RelaisPowerGraphItem : public AbstractNodeGraphItem
 
     RelaisPowerNode *node() const;
 
-    inline TileRotate twoConnectorsRotate() const
-    {
-        // Always put connectors horizontal
-        // We ignore other rotations otherwise we cannot draw name :(
-        TileRotate r = rotate();
-        if(r == TileRotate::Deg90)
-            r = TileRotate::Deg0;
-        else if(r == TileRotate::Deg270)
-            r = TileRotate::Deg180;
-        return r;
-    }
+    TileRotate twoConnectorsRotate() const;
 
     void setArrowDirection(Connector::Direction newArrowDirection);
 
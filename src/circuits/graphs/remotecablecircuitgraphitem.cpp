@@ -97,11 +97,6 @@ void RemoteCableCircuitGraphItem::paint(QPainter *painter, const QStyleOptionGra
     drawName(painter);
 }
 
-void RemoteCableCircuitGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-}
-
 QString RemoteCableCircuitGraphItem::displayString() const
 {
     return node()->getDescription();
@@ -162,15 +157,14 @@ QString RemoteCableCircuitGraphItem::tooltipString() const
 
     QString sceneDescr;
 
-    AbstractNodeGraphItem *otherGraph = nullptr;
+    CircuitScene *otherScene = nullptr;
     if(circuitScene())
     {
-        otherGraph = circuitScene()->circuitsModel()->getGraphForNode(otherNode);
+        otherScene = circuitScene()->circuitsModel()->sceneForNode(otherNode);
     }
 
-    if(otherGraph && otherGraph->circuitScene())
+    if(otherScene)
     {
-        CircuitScene *otherScene = otherGraph->circuitScene();
         if(otherScene == circuitScene())
         {
             sceneDescr = tr("To other node in this sheet");
@@ -37,8 +37,6 @@ class RemoteCableCircuitGraphItem : public AbstractNodeGraphItem
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,QWidget *widget = nullptr) override;
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     QString displayString() const override;
 
     QString tooltipString() const override;
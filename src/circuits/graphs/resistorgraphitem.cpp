@@ -99,12 +99,6 @@ void ResistorGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsItem
     painter->drawLine(contact1Line);
 }
 
-void ResistorGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg180, 1);
-}
-
 ResistorNode *ResistorGraphItem::node() const
 {
     return static_cast<ResistorNode *>(getAbstractNode());
@@ -168,11 +168,6 @@ void ScreenRelaisPowerGraphItem::paint(QPainter *painter, const QStyleOptionGrap
     drawName(painter);
 }
 
-void ScreenRelaisPowerGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-}
-
 QString ScreenRelaisPowerGraphItem::displayString() const
 {
     if(node()->screenRelais())
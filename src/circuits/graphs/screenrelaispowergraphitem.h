@@ -38,8 +38,6 @@ class ScreenRelaisPowerGraphItem : public AbstractNodeGraphItem
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,QWidget *widget = nullptr) override;
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     QString displayString() const override;
 
     QString tooltipString() const override;
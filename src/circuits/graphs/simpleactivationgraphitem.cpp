@@ -36,11 +36,6 @@ SimpleActivationGraphItem::SimpleActivationGraphItem(SimpleActivationNode *node_
             this, &SimpleActivationGraphItem::setObject);
 }
 
-void SimpleActivationGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-}
-
 QString SimpleActivationGraphItem::displayString() const
 {
     if(activationNode()->object())
@@ -34,8 +34,6 @@ class SimpleActivationGraphItem : public AbstractNodeGraphItem
 public:
     explicit SimpleActivationGraphItem(SimpleActivationNode *node_);
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     QString displayString() const override;
 
     QString tooltipString() const override;
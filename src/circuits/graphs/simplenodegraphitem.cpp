@@ -215,24 +215,6 @@ void SimpleNodeGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsIte
     }
 }
 
-void SimpleNodeGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    bool hasDeg90  = node()->disabledContact() != 1;
-    bool hasDeg180 = node()->disabledContact() != 2;
-    bool hasDeg270 = node()->disabledContact() != 3;
-
-    connectors.emplace_back(location(), rotate(), 0); // Common
-
-    if(hasDeg90)
-        connectors.emplace_back(location(), rotate() + TileRotate::Deg90, 1);
-
-    if(hasDeg180)
-        connectors.emplace_back(location(), rotate() + TileRotate::Deg180, 2);
-
-    if(hasDeg270)
-        connectors.emplace_back(location(), rotate() + TileRotate::Deg270, 3);
-}
-
 SimpleCircuitNode *SimpleNodeGraphItem::node() const
 {
     return static_cast<SimpleCircuitNode *>(getAbstractNode());
@@ -37,8 +37,6 @@ class SimpleNodeGraphItem : public AbstractNodeGraphItem
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,QWidget *widget = nullptr) override;
 
-    void getConnectors(std::vector<Connector>& connectors) const final;
-
     SimpleCircuitNode *node() const;
 };
 
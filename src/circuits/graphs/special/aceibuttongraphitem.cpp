@@ -22,12 +22,7 @@
 
 #include "aceibuttongraphitem.h"
 
-//TODO: fake
-#include "../../nodes/onoffswitchnode.h"
-#include <QJsonObject>
-
 #include "../../../objects/abstractsimulationobject.h"
-#include "../../../objects/abstractsimulationobjectmodel.h"
 
 #include "../../../objects/interfaces/buttoninterface.h"
 
@@ -43,7 +38,10 @@
 ACEIButtonGraphItem::ACEIButtonGraphItem(OnOffSwitchNode *node_)
     : AbstractNodeGraphItem(node_)
 {
-
+    // Graph can be created after node was loaded
+    Node *fakeNode = static_cast<Node *>(node_);
+    attachButton(fakeNode->button());
+    attachCentralLight(fakeNode->centralLight());
 }
 
 void ACEIButtonGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -197,6 +195,16 @@ void ACEIButtonGraphItem::setCentralLight(LightBulbObject *newCentralLight)
     if(mCentralLight == newCentralLight)
         return;
 
+    static_cast<Node *>(getAbstractNode())->setCentralLight(newCentralLight);
+    attachCentralLight(newCentralLight);
+
+    getAbstractNode()->modeMgr()->setFileEdited();
+    update();
+    emit lightsChanged();
+}
+
+void ACEIButtonGraphItem::attachCentralLight(LightBulbObject *newCentralLight)
+{
     if(mCentralLight)
     {
         disconnect(mCentralLight, &LightBulbObject::stateChanged,
@@ -214,10 +222,6 @@ void ACEIButtonGraphItem::setCentralLight(LightBulbObject *newCentralLight)
         connect(mCentralLight, &LightBulbObject::destroyed,
                 this, &ACEIButtonGraphItem::onLightDestroyed);
     }
-
-    getAbstractNode()->modeMgr()->setFileEdited();
-    update();
-    emit lightsChanged();
 }
 
 AbstractSimulationObject *ACEIButtonGraphItem::button() const
@@ -227,9 +231,14 @@ AbstractSimulationObject *ACEIButtonGraphItem::button() const
 
 void ACEIButtonGraphItem::setButton(AbstractSimulationObject *newButton)
 {
-    if(newButton && !newButton->getInterface<ButtonInterface>())
+    if(!static_cast<Node *>(getAbstractNode())->setButton(newButton))
         return;
 
+    attachButton(newButton);
+}
+
+void ACEIButtonGraphItem::attachButton(AbstractSimulationObject *newButton)
+{
     if(mButton)
     {
         disconnect(mButton, &AbstractSimulationObject::destroyed,
@@ -262,49 +271,6 @@ void ACEIButtonGraphItem::setButton(AbstractSimulationObject *newButton)
     emit buttonChanged(mButton);
 }
 
-bool ACEIButtonGraphItem::loadFromJSON(const QJsonObject &obj)
-{
-    QJsonObject objCopy = obj;
-
-    // Restore fake node type
-    objCopy["type"] = Node::NodeType;
-
-    const QString buttonName = obj.value("button").toString();
-    const QString buttonType = obj.value("button_type").toString();
-    auto model = getAbstractNode()->modeMgr()->modelForType(buttonType);
-
-    if(model)
-        setButton(model->getObjectByName(buttonName));
-    else
-        setButton(nullptr);
-
-    auto lightModel = getAbstractNode()->modeMgr()->modelForType(LightBulbObject::Type);
-    if(lightModel)
-    {
-        const QString centralLightName = obj.value("light_central").toString();
-        setCentralLight(static_cast<LightBulbObject *>(lightModel->getObjectByName(centralLightName)));
-    }
-    else
-    {
-        setCentralLight(nullptr);
-    }
-
-    return AbstractNodeGraphItem::loadFromJSON(objCopy);
-}
-
-void ACEIButtonGraphItem::saveToJSON(QJsonObject &obj) const
-{
-    AbstractNodeGraphItem::saveToJSON(obj);
-
-    // Replace fake node type with ours
-    obj["type"] = CustomNodeType;
-
-    obj["button"] = mButton ? mButton->name() : QString();
-    obj["button_type"] = mButton ? mButton->getType() : QString();
-
-    obj["light_central"] = mCentralLight ? mCentralLight->name() : QString();
-}
-
 void ACEIButtonGraphItem::onButtonDestroyed()
 {
     mButton = nullptr;
@@ -331,8 +297,3 @@ void ACEIButtonGraphItem::onInterfacePropertyChanged(const QString &ifaceName, c
     }
 }
 
-QString FakeACEIButtonNode::nodeType() const
-{
-    return FakeACEIButtonNode::NodeType;
-}
-
@@ -25,27 +25,13 @@
 
 #include "../abstractnodegraphitem.h"
 
-#include "../../nodes/onoffswitchnode.h"
+#include "../../nodes/acepanelnodes.h"
 
 class AbstractSimulationObject;
 class ButtonInterface;
 
 class LightBulbObject;
 
-// TODO: this is a fake node
-class FakeACEIButtonNode : public OnOffSwitchNode
-{
-public:
-    explicit FakeACEIButtonNode(ModeManager *mgr, QObject *parent = nullptr)
-        : OnOffSwitchNode(mgr, parent)
-    {
-
-    }
-
-    static constexpr QLatin1String NodeType = QLatin1String("acei_button");
-    QString nodeType() const override;
-};
-
 class ACEIButtonGraphItem : public AbstractNodeGraphItem
 {
     Q_OBJECT
@@ -57,9 +43,6 @@ class ACEIButtonGraphItem : public AbstractNodeGraphItem
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,QWidget *widget = nullptr) override;
 
-    bool loadFromJSON(const QJsonObject& obj) override;
-    void saveToJSON(QJsonObject& obj) const override;
-
     AbstractSimulationObject *button() const;
     void setButton(AbstractSimulationObject *newButton);
 
@@ -82,6 +65,10 @@ private slots:
     void mousePressEvent(QGraphicsSceneMouseEvent *ev) override;
     void mouseReleaseEvent(QGraphicsSceneMouseEvent *ev) override;
 
+private:
+    void attachButton(AbstractSimulationObject *newButton);
+    void attachCentralLight(LightBulbObject *newCentralLight);
+
 private:
     AbstractSimulationObject *mButton = nullptr;
     ButtonInterface *mButtonIface = nullptr;
@@ -22,20 +22,10 @@
 
 #include "aceilevergraphitem.h"
 
-//TODO: fake
-#include "../../nodes/onoffswitchnode.h"
-#include <QJsonObject>
-
 #include "../../../objects/abstractsimulationobject.h"
-#include "../../../objects/abstractsimulationobjectmodel.h"
 
 #include "../../../objects/interfaces/leverinterface.h"
 
-#include "../../../objects/lever/acei/aceileverobject.h"
-
-//TODO: remove BEM
-#include "../../../objects/lever/bem/bemleverobject.h"
-
 #include "../../../objects/simple_activable/lightbulbobject.h"
 
 #include "../../../views/modemanager.h"
@@ -50,7 +40,11 @@
 ACEILeverGraphItem::ACEILeverGraphItem(OnOffSwitchNode *node_)
     : AbstractNodeGraphItem(node_)
 {
-    updateLeverTooltip();
+    // Graph can be created after node was loaded
+    Node *fakeNode = static_cast<Node *>(node_);
+    attachLever(fakeNode->lever());
+    attachLight(mLeftLight, fakeNode->leftLight());
+    attachLight(mRightLight, fakeNode->rightLight());
 }
 
 void ACEILeverGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -312,23 +306,8 @@ void ACEILeverGraphItem::setLeftLight(LightBulbObject *newLeftLight)
     if(mLeftLight == newLeftLight)
         return;
 
-    if(mLeftLight)
-    {
-        disconnect(mLeftLight, &LightBulbObject::stateChanged,
-                   this, &ACEILeverGraphItem::triggerUpdate);
-        disconnect(mLeftLight, &LightBulbObject::destroyed,
-                   this, &ACEILeverGraphItem::onLightDestroyed);
-    }
-
-    mLeftLight = newLeftLight;
-
-    if(mLeftLight)
-    {
-        connect(mLeftLight, &LightBulbObject::stateChanged,
-                this, &ACEILeverGraphItem::triggerUpdate);
-        connect(mLeftLight, &LightBulbObject::destroyed,
-                this, &ACEILeverGraphItem::onLightDestroyed);
-    }
+    static_cast<Node *>(getAbstractNode())->setLeftLight(newLeftLight);
+    attachLight(mLeftLight, newLeftLight);
 
     getAbstractNode()->modeMgr()->setFileEdited();
     update();
@@ -345,23 +324,8 @@ void ACEILeverGraphItem::setRightLight(LightBulbObject *newRightLight)
     if(mRightLight == newRightLight)
         return;
 
-    if(mRightLight)
-    {
-        disconnect(mRightLight, &LightBulbObject::stateChanged,
-                   this, &ACEILeverGraphItem::triggerUpdate);
-        disconnect(mRightLight, &LightBulbObject::destroyed,
-                   this, &ACEILeverGraphItem::onLightDestroyed);
-    }
-
-    mRightLight = newRightLight;
-
-    if(mRightLight)
-    {
-        connect(mRightLight, &LightBulbObject::stateChanged,
-                this, &ACEILeverGraphItem::triggerUpdate);
-        connect(mRightLight, &LightBulbObject::destroyed,
-                this, &ACEILeverGraphItem::onLightDestroyed);
-    }
+    static_cast<Node *>(getAbstractNode())->setRightLight(newRightLight);
+    attachLight(mRightLight, newRightLight);
 
     getAbstractNode()->modeMgr()->setFileEdited();
     update();
@@ -375,10 +339,14 @@ AbstractSimulationObject *ACEILeverGraphItem::lever() const
 
 void ACEILeverGraphItem::setLever(AbstractSimulationObject *newLever)
 {
-    // TODO: remove BEM
-    if(newLever && newLever->getType() != ACEILeverObject::Type && newLever->getType() != BEMLeverObject::Type)
+    if(!static_cast<Node *>(getAbstractNode())->setLever(newLever))
         return;
 
+    attachLever(newLever);
+}
+
+void ACEILeverGraphItem::attachLever(AbstractSimulationObject *newLever)
+{
     if(mLever)
     {
         disconnect(mLever, &AbstractSimulationObject::destroyed,
@@ -413,52 +381,25 @@ void ACEILeverGraphItem::setLever(AbstractSimulationObject *newLever)
     emit leverChanged(mLever);
 }
 
-bool ACEILeverGraphItem::loadFromJSON(const QJsonObject &obj)
+void ACEILeverGraphItem::attachLight(LightBulbObject *&light, LightBulbObject *newLight)
 {
-    QJsonObject objCopy = obj;
-
-    // Restore fake node type
-    objCopy["type"] = Node::NodeType;
-
-    const QString leverName = obj.value("lever").toString();
-    const QString leverType = obj.value("lever_type").toString();
-    auto model = getAbstractNode()->modeMgr()->modelForType(leverType);
-
-    if(model)
-        setLever(model->getObjectByName(leverName));
-    else
-        setLever(nullptr);
-
-    auto lightModel = getAbstractNode()->modeMgr()->modelForType(LightBulbObject::Type);
-    if(lightModel)
+    if(light)
     {
-        const QString leftLightName = obj.value("light_left").toString();
-        setLeftLight(static_cast<LightBulbObject *>(lightModel->getObjectByName(leftLightName)));
-
-        const QString rightLightName = obj.value("light_right").toString();
-        setRightLight(static_cast<LightBulbObject *>(lightModel->getObjectByName(rightLightName)));
-    }
-    else
-    {
-        setLeftLight(nullptr);
-        setRightLight(nullptr);
+        disconnect(light, &LightBulbObject::stateChanged,
+                   this, &ACEILeverGraphItem::triggerUpdate);
+        disconnect(light, &LightBulbObject::destroyed,
+                   this, &ACEILeverGraphItem::onLightDestroyed);
     }
 
-    return AbstractNodeGraphItem::loadFromJSON(objCopy);
-}
-
-void ACEILeverGraphItem::saveToJSON(QJsonObject &obj) const
-{
-    AbstractNodeGraphItem::saveToJSON(obj);
-
-    // Replace fake node type with ours
-    obj["type"] = CustomNodeType;
-
-    obj["lever"] = mLever ? mLever->name() : QString();
-    obj["lever_type"] = mLever ? mLever->getType() : QString();
+    light = newLight;
 
-    obj["light_left"] = mLeftLight ? mLeftLight->name() : QString();
-    obj["light_right"] = mRightLight ? mRightLight->name() : QString();
+    if(light)
+    {
+        connect(light, &LightBulbObject::stateChanged,
+                this, &ACEILeverGraphItem::triggerUpdate);
+        connect(light, &LightBulbObject::destroyed,
+                this, &ACEILeverGraphItem::onLightDestroyed);
+    }
 }
 
 void ACEILeverGraphItem::onLeverDestroyed()
@@ -490,8 +431,3 @@ void ACEILeverGraphItem::onInterfacePropertyChanged(const QString &ifaceName, co
         }
     }
 }
-
-QString FakeLeverNode::nodeType() const
-{
-    return FakeLeverNode::NodeType;
-}
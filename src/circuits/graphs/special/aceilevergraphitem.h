@@ -25,27 +25,13 @@
 
 #include "../abstractnodegraphitem.h"
 
-#include "../../nodes/onoffswitchnode.h"
+#include "../../nodes/acepanelnodes.h"
 
 class AbstractSimulationObject;
 class LeverInterface;
 
 class LightBulbObject;
 
-// TODO: this is a fake node
-class FakeLeverNode : public OnOffSwitchNode
-{
-public:
-    explicit FakeLeverNode(ModeManager *mgr, QObject *parent = nullptr)
-        : OnOffSwitchNode(mgr, parent)
-    {
-
-    }
-
-    static constexpr QLatin1String NodeType = QLatin1String("acei_lever");
-    QString nodeType() const override;
-};
-
 class ACEILeverGraphItem : public AbstractNodeGraphItem
 {
     Q_OBJECT
@@ -60,9 +46,6 @@ class ACEILeverGraphItem : public AbstractNodeGraphItem
     AbstractSimulationObject *lever() const;
     void setLever(AbstractSimulationObject *newLever);
 
-    bool loadFromJSON(const QJsonObject& obj) override;
-    void saveToJSON(QJsonObject& obj) const override;
-
     LightBulbObject *leftLight() const;
     void setLeftLight(LightBulbObject *newLeftLight);
 
@@ -89,6 +72,9 @@ private slots:
 private:
     void updateLeverTooltip();
 
+    void attachLever(AbstractSimulationObject *newLever);
+    void attachLight(LightBulbObject *&light, LightBulbObject *newLight);
+
 private:
     AbstractSimulationObject *mLever = nullptr;
     LeverInterface *mLeverIface = nullptr;
@@ -22,15 +22,9 @@
 
 #include "acesasiblevergraphitem.h"
 
-//TODO: fake
-#include "../../nodes/onoffswitchnode.h"
-#include <QJsonObject>
-
 #include "../../../objects/abstractsimulationobject.h"
-#include "../../../objects/abstractsimulationobjectmodel.h"
 
 #include "../../../objects/interfaces/leverinterface.h"
-#include "../../../objects/interfaces/sasibaceleverextrainterface.h"
 
 #include "../../../views/modemanager.h"
 
@@ -44,7 +38,8 @@
 ACESasibLeverGraphItem::ACESasibLeverGraphItem(OnOffSwitchNode *node_)
     : AbstractNodeGraphItem(node_)
 {
-    updateLeverTooltip();
+    // Graph can be created after node was loaded
+    attachLever(static_cast<Node *>(node_)->lever());
 }
 
 void ACESasibLeverGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -234,9 +229,14 @@ AbstractSimulationObject *ACESasibLeverGraphItem::lever() const
 
 void ACESasibLeverGraphItem::setLever(AbstractSimulationObject *newLever)
 {
-    if(newLever && !newLever->getInterface<SasibACELeverExtraInterface>())
+    if(!static_cast<Node *>(getAbstractNode())->setLever(newLever))
         return;
 
+    attachLever(newLever);
+}
+
+void ACESasibLeverGraphItem::attachLever(AbstractSimulationObject *newLever)
+{
     if(mLever)
     {
         disconnect(mLever, &AbstractSimulationObject::destroyed,
@@ -271,36 +271,6 @@ void ACESasibLeverGraphItem::setLever(AbstractSimulationObject *newLever)
     emit leverChanged(mLever);
 }
 
-bool ACESasibLeverGraphItem::loadFromJSON(const QJsonObject &obj)
-{
-    QJsonObject objCopy = obj;
-
-    // Restore fake node type
-    objCopy["type"] = Node::NodeType;
-
-    const QString leverName = obj.value("lever").toString();
-    const QString leverType = obj.value("lever_type").toString();
-    auto model = getAbstractNode()->modeMgr()->modelForType(leverType);
-
-    if(model)
-        setLever(model->getObjectByName(leverName));
-    else
-        setLever(nullptr);
-
-    return AbstractNodeGraphItem::loadFromJSON(objCopy);
-}
-
-void ACESasibLeverGraphItem::saveToJSON(QJsonObject &obj) const
-{
-    AbstractNodeGraphItem::saveToJSON(obj);
-
-    // Replace fake node type with ours
-    obj["type"] = CustomNodeType;
-
-    obj["lever"] = mLever ? mLever->name() : QString();
-    obj["lever_type"] = mLever ? mLever->getType() : QString();
-}
-
 void ACESasibLeverGraphItem::onLeverDestroyed()
 {
     mLever = nullptr;
@@ -322,8 +292,3 @@ void ACESasibLeverGraphItem::onInterfacePropertyChanged(const QString &ifaceName
         }
     }
 }
-
-QString FakeLeverNode2::nodeType() const
-{
-    return FakeLeverNode2::NodeType;
-}
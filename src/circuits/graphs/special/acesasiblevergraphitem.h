@@ -25,25 +25,11 @@
 
 #include "../abstractnodegraphitem.h"
 
-#include "../../nodes/onoffswitchnode.h"
+#include "../../nodes/acepanelnodes.h"
 
 class AbstractSimulationObject;
 class LeverInterface;
 
-// TODO: this is a fake node
-class FakeLeverNode2 : public OnOffSwitchNode
-{
-public:
-    explicit FakeLeverNode2(ModeManager *mgr, QObject *parent = nullptr)
-        : OnOffSwitchNode(mgr, parent)
-    {
-
-    }
-
-    static constexpr QLatin1String NodeType = QLatin1String("ace_sasib_lever");
-    QString nodeType() const override;
-};
-
 class ACESasibLeverGraphItem : public AbstractNodeGraphItem
 {
     Q_OBJECT
@@ -58,9 +44,6 @@ class ACESasibLeverGraphItem : public AbstractNodeGraphItem
     AbstractSimulationObject *lever() const;
     void setLever(AbstractSimulationObject *newLever);
 
-    bool loadFromJSON(const QJsonObject& obj) override;
-    void saveToJSON(QJsonObject& obj) const override;
-
 signals:
     void leverChanged(AbstractSimulationObject *newLever);
 
@@ -79,6 +62,8 @@ private slots:
 private:
     void updateLeverTooltip();
 
+    void attachLever(AbstractSimulationObject *newLever);
+
 private:
     AbstractSimulationObject *mLever = nullptr;
     LeverInterface *mLeverIface = nullptr;
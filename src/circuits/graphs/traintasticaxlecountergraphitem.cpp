@@ -110,14 +110,6 @@ void TraintasticAxleCounterGraphItem::paint(QPainter *painter, const QStyleOptio
         painter->drawText(r, Qt::AlignCenter, QString::number(node()->axleCounter()->axleCount()));
 }
 
-void TraintasticAxleCounterGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), TraintasticAxleCounterNode::Contacts::PowerIn);
-    connectors.emplace_back(location(), rotate() - TileRotate::Deg90, TraintasticAxleCounterNode::Contacts::FreeTrackOut);
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg180, TraintasticAxleCounterNode::Contacts::ResetIn);
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg90, TraintasticAxleCounterNode::Contacts::OccupiedTrackOut);
-}
-
 QString TraintasticAxleCounterGraphItem::displayString() const
 {
     if(node()->axleCounter())
@@ -107,14 +107,6 @@ void TraintasticTurnoutGraphItem::paint(QPainter *painter, const QStyleOptionGra
     drawName(painter);
 }
 
-void TraintasticTurnoutGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    if(!node()->spawn())
-        connectors.emplace_back(location(), rotate(), 1);
-
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg180, 0);
-}
-
 QString TraintasticTurnoutGraphItem::displayString() const
 {
     if(node()->turnout())
@@ -121,12 +121,6 @@ void TransformerGraphItem::paint(QPainter *painter, const QStyleOptionGraphicsIt
     painter->drawEllipse(coilCenters[0], CoilRadius, CoilRadius);
 }
 
-void TransformerGraphItem::getConnectors(std::vector<Connector> &connectors) const
-{
-    connectors.emplace_back(location(), rotate(), 0);
-    connectors.emplace_back(location(), rotate() + TileRotate::Deg180, 1);
-}
-
 TransformerNode *TransformerGraphItem::node() const
 {
     return static_cast<TransformerNode *>(getAbstractNode());
@@ -0,0 +1,180 @@
+/**
+ * src/circuits/headlesscircuitlist.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "headlesscircuitlist.h"
+
+#include "circuitislands.h"
+#include "circuitsheetlayout.h"
+
+#include "nodes/abstractcircuitnode.h"
+
+#include "../utils/phasereport.h"
+
+#include <QJsonArray>
+#include <QSet>
+
+HeadlessCircuitList::HeadlessCircuitList(ModeManager *mgr)
+    : mModeMgr(mgr)
+{
+
+}
+
+HeadlessCircuitList::~HeadlessCircuitList()
+{
+    shutdown();
+}
+
+void HeadlessCircuitList::shutdown()
+{
+    clear();
+}
+
+void HeadlessCircuitList::onModeChanged(FileMode newMode, FileMode oldMode)
+{
+    if(oldMode == FileMode::Editing || oldMode == FileMode::LoadingFile)
+    {
+        // Recalculate circuits like CircuitScene::setMode()
+        for(CircuitSheetLayout *sheet : std::as_const(mSheets))
+        {
+            sheet->calculateConnections();
+        }
+    }
+
+    if(newMode == FileMode::Simulation)
+    {
+        // Islands of all sheets are prepared together
+        CircuitIslands::NodeList sources;
+        for(CircuitSheetLayout *sheet : std::as_const(mSheets))
+        {
+            sources.append(sheet->powerSources());
+        }
+
+        CircuitIslands::setSourcesEnabled(sources, true);
+        return;
+    }
+
+    for(CircuitSheetLayout *sheet : std::as_const(mSheets))
+    {
+        for(AbstractCircuitNode *powerSource : sheet->powerSources())
+        {
+            powerSource->setSourceEnabled(false);
+        }
+    }
+}
+
+void HeadlessCircuitList::onCodePhaseChanged()
+{
+    // Nothing to repaint
+}
+
+void HeadlessCircuitList::resetHasUnsavedChanges()
+{
+    // Circuits cannot be edited
+}
+
+void HeadlessCircuitList::clear()
+{
+    // Sheets disable circuits when deleted
+    qDeleteAll(mSheets);
+    mSheets.clear();
+
+    CircuitIslands::clearCache();
+
+    mCircuitsObj = QJsonObject();
+    mPanelsObj = QJsonObject();
+    mRemoteMgrObj = QJsonObject();
+    mSessionName.clear();
+}
+
+void HeadlessCircuitList::loadFromJSON(const QJsonObject &rootObj, PhaseReport *report)
+{
+    clear();
+
+    mSessionName = rootObj.value("session_name").toString();
+    mCircuitsObj = rootObj.value("circuits").toObject();
+    mPanelsObj = rootObj.value("panels").toObject();
+    mRemoteMgrObj = rootObj.value("remote_mgr").toObject();
+
+    PhaseScope phase(report, QLatin1String("Load circuits"));
+
+    // Sheets with duplicate names are skipped like in CircuitListModel
+    QSet<QString> sheetNames;
+
+    const QJsonArray arr = mCircuitsObj.value("scenes").toArray();
+    for(const QJsonValue& v : arr)
+    {
+        const QJsonObject obj = v.toObject();
+        if(!obj.contains("cables") || !obj.contains("nodes"))
+            continue;
+
+        const QString name = obj.value("name").toString().trimmed();
+        if(sheetNames.contains(name))
+            continue;
+        sheetNames.insert(name);
+
+        CircuitSheetLayout *sheet = new CircuitSheetLayout(mModeMgr, nullptr);
+        sheet->loadLayout(obj);
+        sheet->calculateConnections();
+        mSheets.append(sheet);
+    }
+
+    phase.setCount(mSheets.size());
+}
+
+void HeadlessCircuitList::saveToJSON(QJsonObject &rootObj, PhaseReport *report) const
+{
+    PhaseScope phase(report, QLatin1String("Save circuits"));
+
+    rootObj["session_name"] = mSessionName;
+
+    rootObj["circuits"] = mCircuitsObj;
+    rootObj["panels"] = mPanelsObj;
+
+    rootObj["remote_mgr"] = mRemoteMgrObj;
+
+    phase.setCount(mSheets.size());
+}
+
+AbstractRemoteSession *HeadlessCircuitList::addRemoteSession(const QString &)
+{
+    return nullptr;
+}
+
+AbstractSerialDevice *HeadlessCircuitList::addSerialDevice(const QString &)
+{
+    return nullptr;
+}
+
+AbstractTraintasticSimManager *HeadlessCircuitList::traintasticSim() const
+{
+    return nullptr;
+}
+
+void HeadlessCircuitList::disconnectAll()
+{
+    // No external inputs
+}
+
+AbstractSoundPlayer *HeadlessCircuitList::createSoundPlayer()
+{
+    return nullptr;
+}
@@ -0,0 +1,85 @@
+/**
+ * src/circuits/headlesscircuitlist.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef HEADLESSCIRCUITLIST_H
+#define HEADLESSCIRCUITLIST_H
+
+#include "../views/modemanagerfrontend.h"
+
+#include <QVector>
+#include <QJsonObject>
+#include <QString>
+
+class ModeManager;
+class CircuitSheetLayout;
+
+/*!
+ * \brief The HeadlessCircuitList class
+ *
+ * Loads circuit nodes and cables without graphics scenes,
+ * so simulation can run with only QtCore.
+ * Sheets are wired by CircuitSheetLayout, same as CircuitScene.
+ * Panels, remote and sheet layout are not parsed,
+ * they are saved back unchanged.
+ */
+class HeadlessCircuitList : public AbstractModeManagerFrontend
+{
+public:
+    explicit HeadlessCircuitList(ModeManager *mgr);
+    ~HeadlessCircuitList();
+
+    void shutdown() override;
+
+    void onModeChanged(FileMode newMode, FileMode oldMode) override;
+    void onCodePhaseChanged() override;
+
+    void resetHasUnsavedChanges() override;
+    void clear() override;
+
+    void loadFromJSON(const QJsonObject& rootObj, PhaseReport *report) override;
+    void saveToJSON(QJsonObject& rootObj, PhaseReport *report) const override;
+
+    AbstractRemoteSession *addRemoteSession(const QString& sessionName) override;
+    AbstractSerialDevice *addSerialDevice(const QString& devName) override;
+    AbstractTraintasticSimManager *traintasticSim() const override;
+
+    void disconnectAll() override;
+
+    AbstractSoundPlayer *createSoundPlayer() override;
+
+    inline int sheetCount() const
+    {
+        return mSheets.size();
+    }
+
+private:
+    ModeManager *mModeMgr;
+
+    QVector<CircuitSheetLayout *> mSheets;
+
+    QJsonObject mCircuitsObj;
+    QJsonObject mPanelsObj;
+    QJsonObject mRemoteMgrObj;
+    QString mSessionName;
+};
+
+#endif // HEADLESSCIRCUITLIST_H
@@ -23,8 +23,13 @@
 #include "abstractcircuitnode.h"
 
 #include "../electriccircuit.h"
+#include "../circuitgraph.h"
+#include "../simulationprofiler.h"
+#include "../circuitchangenotifier.h"
 #include "circuitcable.h"
 
+#include "../../views/modemanager.h"
+
 #include <QJsonObject>
 
 AbstractCircuitNode::AbstractCircuitNode(ModeManager *mgr, bool isLoad, QObject *parent)
@@ -46,6 +51,10 @@ AbstractCircuitNode::~AbstractCircuitNode()
     {
         detachCable(i);
     }
+
+    CircuitGraph::removeNode(this);
+    SimulationProfiler::removeNode(this);
+    mModeMgr->changeNotifier()->removeNode(this);
 }
 
 void AbstractCircuitNode::addCircuit(ElectricCircuit *circuit)
@@ -97,7 +106,7 @@ void AbstractCircuitNode::addCircuit(ElectricCircuit *circuit)
     }
 
     if(circuitList.size() == 1 || updateNeeded || flagsChanged)
-        emit circuitsChanged();
+        notifyCircuitsChanged();
 
     if(flagsChanged)
         onCircuitFlagsChanged();
@@ -132,7 +141,7 @@ void AbstractCircuitNode::removeCircuit(ElectricCircuit *circuit, const NodeOccu
 
         if(flagsChanged)
         {
-            emit circuitsChanged();
+            notifyCircuitsChanged();
             onCircuitFlagsChanged();
         }
     }
@@ -178,7 +187,7 @@ void AbstractCircuitNode::partialRemoveCircuit(ElectricCircuit *circuit, const N
     }
 
     if(updateNeeded)
-        emit circuitsChanged();
+        notifyCircuitsChanged();
 }
 
 void AbstractCircuitNode::attachCable(const CableItem& item)
@@ -209,6 +218,8 @@ void AbstractCircuitNode::attachCable(const CableItem& item)
         // Add a pole
         contact.setType(item.cable.pole, ContactType::Connected);
     }
+
+    markConnectionsChanged();
 }
 
 void AbstractCircuitNode::detachCable(const CableItem &item)
@@ -235,10 +246,15 @@ void AbstractCircuitNode::detachCable(const CableItem &item)
         // Keep other pole
         contact.setType(item.cable.pole, ContactType::NotConnected);
     }
+
+    markConnectionsChanged();
 }
 
 void AbstractCircuitNode::applyNewFlags(CircuitFlags sourceFlags, int nodeContact)
 {
+    // Flags of our connections might have changed
+    markConnectionsChanged();
+
     for(ElectricCircuit *circuit : getCircuits(CircuitType::Open))
     {
         if(nodeContact != NodeItem::InvalidContact)
@@ -338,6 +354,8 @@ void AbstractCircuitNode::detachCable(int contactIdx)
         contact.cable->setNode(contact.cableSide, {});
         contact.type1 = contact.type2 = ContactType::NotConnected;
         contact.cable = nullptr;
+
+        markConnectionsChanged();
     }
 }
 
@@ -394,6 +412,14 @@ void AbstractCircuitNode::onCircuitFlagsChanged()
 void AbstractCircuitNode::disableCircuits(const CircuitList &listCopy,
                                           AbstractCircuitNode *node)
 {
+    // Before DeleteScope, so circuits deleted at its end are counted
+    SimulationProfiler::NodeScope profile(this);
+
+    markConnectionsChanged();
+
+    // Keep circuits in list copy valid until we are done
+    ElectricCircuit::DeleteScope scope;
+
     for(ElectricCircuit *circuit : listCopy)
     {
         Q_ASSERT(circuit->type() == CircuitType::Closed);
@@ -402,7 +428,8 @@ void AbstractCircuitNode::disableCircuits(const CircuitList &listCopy,
 
     for(ElectricCircuit *circuit : listCopy)
     {
-        circuit->disableOrTerminate(node);
+        if(circuit->isAlive())
+            circuit->disableOrTerminate(node);
     }
 }
 
@@ -410,6 +437,13 @@ void AbstractCircuitNode::disableCircuits(const CircuitList &listCopy,
                                           AbstractCircuitNode *node,
                                           const int contact)
 {
+    SimulationProfiler::NodeScope profile(this);
+
+    markConnectionsChanged();
+
+    // Keep circuits in list copy valid until we are done
+    ElectricCircuit::DeleteScope scope;
+
     for(ElectricCircuit *circuit : listCopy)
     {
         Q_ASSERT(circuit->type() == CircuitType::Closed);
@@ -437,13 +471,21 @@ void AbstractCircuitNode::disableCircuits(const CircuitList &listCopy,
 
     for(ElectricCircuit *circuit : std::as_const(toDisable))
     {
-        circuit->disableOrTerminate(node);
+        if(circuit->isAlive())
+            circuit->disableOrTerminate(node);
     }
 }
 
 void AbstractCircuitNode::truncateCircuits(const CircuitList &listCopy,
                                            AbstractCircuitNode *node)
 {
+    SimulationProfiler::NodeScope profile(this);
+
+    markConnectionsChanged();
+
+    // Keep circuits in list copy valid until we are done
+    ElectricCircuit::DeleteScope scope;
+
     CircuitList duplicateList;
 
     for(ElectricCircuit *circuit : listCopy)
@@ -454,7 +496,8 @@ void AbstractCircuitNode::truncateCircuits(const CircuitList &listCopy,
 
     for(ElectricCircuit *circuit : listCopy)
     {
-        circuit->terminateHere(node, duplicateList);
+        if(circuit->isAlive())
+            circuit->terminateHere(node, duplicateList);
     }
 }
 
@@ -462,6 +505,13 @@ void AbstractCircuitNode::truncateCircuits(const CircuitList &listCopy,
                                            AbstractCircuitNode *node,
                                            const int contact)
 {
+    SimulationProfiler::NodeScope profile(this);
+
+    markConnectionsChanged();
+
+    // Keep circuits in list copy valid until we are done
+    ElectricCircuit::DeleteScope scope;
+
     CircuitList toDisable;
     toDisable.reserve(listCopy.size());
 
@@ -485,7 +535,8 @@ void AbstractCircuitNode::truncateCircuits(const CircuitList &listCopy,
     CircuitList duplicateList;
     for(ElectricCircuit *circuit : std::as_const(toDisable))
     {
-        circuit->terminateHere(node, duplicateList);
+        if(circuit->isAlive())
+            circuit->terminateHere(node, duplicateList);
     }
 }
 
@@ -507,6 +558,54 @@ void AbstractCircuitNode::unregisterOpenCircuitExit(ElectricCircuit *circuit)
 
         toCount--;
         if(toCount == 0)
-            emit circuitsChanged();
+            notifyCircuitsChanged();
     }
 }
+
+void AbstractCircuitNode::markConnectionsChanged()
+{
+    // Circuits validated before this epoch must re-check this node
+    mConnectionsEpoch = ElectricCircuit::advanceConnectionsEpoch();
+}
+
+void AbstractCircuitNode::notifyCircuitsChanged()
+{
+    mModeMgr->changeNotifier()->nodeCircuitsChanged(this);
+}
+
+AbstractCircuitNode::CircuitsState AbstractCircuitNode::circuitsState() const
+{
+    CircuitsState state;
+    state.append((mClosedCircuits.isEmpty() ? 0 : 1) | (mOpenCircuits.isEmpty() ? 0 : 2));
+
+    for(const NodeContact& contact : mContacts)
+    {
+        quint32 bits = 0;
+        int bit = 0;
+
+        for(CircuitType type : {CircuitType::Closed, CircuitType::Open})
+        {
+            for(CircuitPole pole : {CircuitPole::First, CircuitPole::Second})
+            {
+                if(contact.entranceCount(type, pole))
+                    bits |= 1 << bit;
+                bit++;
+
+                if(contact.exitCount(type, pole))
+                    bits |= 1 << bit;
+                bit++;
+            }
+        }
+
+        bits |= quint32(contact.getFlags(CircuitType::Closed)) << 8;
+        bits |= quint32(contact.getFlags(CircuitType::Open)) << 16;
+        state.append(bits);
+    }
+
+    return state;
+}
+
+SimulationScheduler *AbstractCircuitNode::scheduler() const
+{
+    return mModeMgr->scheduler();
+}
@@ -27,13 +27,18 @@
 #include <QVarLengthArray>
 #include <QVector>
 
+#include <vector>
+
 #include "../../enums/circuittypes.h"
 #include "../../enums/cabletypes.h"
 #include "../../utils/objectproperty.h"
+#include "../../utils/tilerotate.h"
 
 class ElectricCircuit;
+class CircuitGraph;
 
 class ModeManager;
+class SimulationScheduler;
 class QJsonObject;
 
 class AbstractCircuitNode : public QObject
@@ -128,6 +133,11 @@ class AbstractCircuitNode : public QObject
 
     virtual ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) = 0;
 
+    // Connectors of node when placed on a tile with given rotation
+    virtual void getConnectors(std::vector<Connector>& /*connectors*/,
+                               const TileLocation& /*location*/,
+                               TileRotate /*r*/) const {}
+
     virtual void addCircuit(ElectricCircuit *circuit);
     virtual void removeCircuit(ElectricCircuit *circuit, const NodeOccurences &items);
     virtual void partialRemoveCircuit(ElectricCircuit *circuit,
@@ -273,9 +283,16 @@ class AbstractCircuitNode : public QObject
         return mModeMgr;
     }
 
+    SimulationScheduler *scheduler() const;
+
     void applyNewFlags(CircuitFlags sourceFlags = CircuitFlags::None,
                        int nodeContact = NodeItem::InvalidContact);
 
+    inline quint64 connectionsEpoch() const
+    {
+        return mConnectionsEpoch;
+    }
+
 protected:
     friend class CircuitScene;
     friend class AbstractNodeGraphItem;
@@ -308,6 +325,9 @@ class AbstractCircuitNode : public QObject
                           const int contact);
 
     friend class ElectricCircuit;
+    friend class CircuitGraph;
+    friend class SimulationProfiler;
+    friend class CircuitChangeNotifier;
     inline CircuitList& getCircuits(CircuitType type)
     {
         return type == CircuitType::Closed ? mClosedCircuits : mOpenCircuits;
@@ -320,9 +340,36 @@ class AbstractCircuitNode : public QObject
 
     void unregisterOpenCircuitExit(ElectricCircuit *circuit);
 
+    void markConnectionsChanged();
+
+    // Coalesced circuitsChanged(), see CircuitChangeNotifier
+    void notifyCircuitsChanged();
+
+private:
+    // Compact drawn circuit state: presence of circuits,
+    // then entrances, exits and flags of each contact
+    typedef QVarLengthArray<quint32, 8> CircuitsState;
+    CircuitsState circuitsState() const;
+
 private:
     ModeManager *mModeMgr;
 
+    // Epoch of last active connections change
+    quint64 mConnectionsEpoch = 0;
+
+    // Last circuit operation which visited this node
+    quint64 mVisitEpoch = 0;
+
+    // Slot in compiled CircuitGraph, -1 if not compiled
+    int mGraphId = -1;
+
+    // Slot in SimulationProfiler, -1 if never profiled
+    int mProfileId = -1;
+
+    // State of last emitted circuitsChanged()
+    CircuitsState mNotifiedCircuitsState;
+    bool mCircuitsChangePending = false;
+
     CircuitList mClosedCircuits;
     CircuitList mOpenCircuits;
     const bool isElectricLoad;
@@ -28,6 +28,13 @@
 
 #include <QJsonObject>
 
+#include <QVarLengthArray>
+
+#include <utility>
+
+int AbstractDeviatorNode::mBatchDepth = 0;
+QVector<AbstractDeviatorNode *> AbstractDeviatorNode::mBatchNodes;
+
 AbstractDeviatorNode::AbstractDeviatorNode(ModeManager *mgr, QObject *parent)
     : AbstractCircuitNode{mgr, false, parent}
 {
@@ -37,6 +44,27 @@ AbstractDeviatorNode::AbstractDeviatorNode(ModeManager *mgr, QObject *parent)
     mContacts.append(NodeContact("31", "32")); // Down
 }
 
+AbstractDeviatorNode::~AbstractDeviatorNode()
+{
+    if(mBatchPending)
+        mBatchNodes.removeOne(this);
+}
+
+AbstractDeviatorNode::ContactBatch::ContactBatch()
+{
+    mBatchDepth++;
+}
+
+AbstractDeviatorNode::ContactBatch::~ContactBatch()
+{
+    // Keep depth while committing, so that
+    // nested changes are queued for next round
+    if(mBatchDepth == 1)
+        commitBatch();
+
+    mBatchDepth--;
+}
+
 AbstractDeviatorNode::ConnectionsRes AbstractDeviatorNode::getActiveConnections(CableItem source, bool invertDir)
 {
     Q_UNUSED(invertDir);
@@ -113,6 +141,20 @@ AbstractDeviatorNode::ConnectionsRes AbstractDeviatorNode::getActiveConnections(
     return result;
 }
 
+void AbstractDeviatorNode::getConnectors(std::vector<Connector> &connectors,
+                                         const TileLocation &location,
+                                         TileRotate r) const
+{
+    TileRotate centralConnectorRotate = TileRotate::Deg90;
+    if(flipContact())
+        centralConnectorRotate = TileRotate::Deg270;
+
+    connectors.emplace_back(location, r, 0); // Common
+    connectors.emplace_back(location, r + TileRotate::Deg180, 2); // Down
+    if(hasCentralConnector())
+        connectors.emplace_back(location, r + centralConnectorRotate, 1);  // Up
+}
+
 bool AbstractDeviatorNode::loadFromJSON(const QJsonObject &obj)
 {
     if(!AbstractCircuitNode::loadFromJSON(obj))
@@ -224,6 +266,21 @@ void AbstractDeviatorNode::setContactState(bool valUp, bool valDown, bool specia
         std::swap(valUp, valDown);
     }
 
+    if(mBatchDepth > 0)
+    {
+        // Last queued state wins
+        if(!mBatchPending)
+        {
+            mBatchPending = true;
+            mBatchNodes.append(this);
+        }
+
+        mBatchContactOn[0] = valUp;
+        mBatchContactOn[1] = valDown;
+        mBatchSpecialContact = mBatchSpecialContact || specialContact;
+        return;
+    }
+
     const bool hadCircuits = hasCircuits(CircuitType::Closed) || hasCircuits(CircuitType::Open);
 
     bool hasNewConnections = false;
@@ -232,6 +289,11 @@ void AbstractDeviatorNode::setContactState(bool valUp, bool valDown, bool specia
     if(valDown && !isContactOn(DownIdx))
         hasNewConnections = true;
 
+    // Connection table depends only on contact state,
+    // also removed connections must invalidate it
+    if(mContactOnArr[0] != valUp || mContactOnArr[1] != valDown)
+        markConnectionsChanged();
+
     // Set new state
     mContactOnArr[0] = valUp;
     mContactOnArr[1] = valDown;
@@ -242,6 +304,27 @@ void AbstractDeviatorNode::setContactState(bool valUp, bool valDown, bool specia
         ElectricCircuit::createCircuitsFromOtherNode(this);
     }
 
+    removeDisconnectedCircuits();
+
+    if(hasNewConnections && !specialContact)
+    {
+        // Scan for new circuits after removing existing ones
+        ElectricCircuit::createCircuitsFromOtherNode(this);
+    }
+
+    if(hadCircuits)
+    {
+        ElectricCircuit::defaultReachNextOpenCircuit(this);
+    }
+
+    emit deviatorStateChanged();
+}
+
+void AbstractDeviatorNode::removeDisconnectedCircuits()
+{
+    const bool valUp = mContactOnArr[0];
+    const bool valDown = mContactOnArr[1];
+
     // Remove existing circuits if no more connected
     // regardless of previous contact state
     if(!valUp)
@@ -290,19 +373,75 @@ void AbstractDeviatorNode::setContactState(bool valUp, bool valDown, bool specia
             Q_ASSERT(circuit->isEnabled());
         }
     }
+}
 
-    if(hasNewConnections && !specialContact)
+void AbstractDeviatorNode::commitBatch()
+{
+    struct Change
     {
-        // Scan for new circuits after removing existing ones
-        ElectricCircuit::createCircuitsFromOtherNode(this);
-    }
+        AbstractDeviatorNode *node;
+        bool hadCircuits;
+        bool hasNewConnections;
+        bool specialContact;
+    };
 
-    if(hadCircuits)
+    while(!mBatchNodes.isEmpty())
     {
-        ElectricCircuit::defaultReachNextOpenCircuit(this);
-    }
+        const QVector<AbstractDeviatorNode *> nodes = std::exchange(mBatchNodes, {});
 
-    emit deviatorStateChanged();
+        QVarLengthArray<Change, 32> changes;
+        changes.reserve(nodes.size());
+
+        // Switch all contacts together
+        for(AbstractDeviatorNode *node : nodes)
+        {
+            Change c;
+            c.node = node;
+            c.hadCircuits = node->hasCircuits(CircuitType::Closed) ||
+                    node->hasCircuits(CircuitType::Open);
+            c.hasNewConnections = (node->mBatchContactOn[0] && !node->mContactOnArr[0]) ||
+                    (node->mBatchContactOn[1] && !node->mContactOnArr[1]);
+            c.specialContact = node->mBatchSpecialContact;
+            changes.append(c);
+
+            if(node->mContactOnArr[0] != node->mBatchContactOn[0] ||
+                    node->mContactOnArr[1] != node->mBatchContactOn[1])
+                node->markConnectionsChanged();
+
+            node->mContactOnArr[0] = node->mBatchContactOn[0];
+            node->mContactOnArr[1] = node->mBatchContactOn[1];
+            node->mBatchSpecialContact = false;
+            node->mBatchPending = false;
+        }
+
+        // Same order of single contact change, but each step
+        // is done for all contacts before going to next one
+        for(const Change& c : std::as_const(changes))
+        {
+            // Scan for new circuits before removing existing ones
+            if(c.hasNewConnections && c.specialContact)
+                ElectricCircuit::createCircuitsFromOtherNode(c.node);
+        }
+
+        for(const Change& c : std::as_const(changes))
+            c.node->removeDisconnectedCircuits();
+
+        for(const Change& c : std::as_const(changes))
+        {
+            // Scan for new circuits after removing existing ones
+            if(c.hasNewConnections && !c.specialContact)
+                ElectricCircuit::createCircuitsFromOtherNode(c.node);
+        }
+
+        for(const Change& c : std::as_const(changes))
+        {
+            if(c.hadCircuits)
+                ElectricCircuit::defaultReachNextOpenCircuit(c.node);
+        }
+
+        for(const Change& c : std::as_const(changes))
+            emit c.node->deviatorStateChanged();
+    }
 }
 
 bool AbstractDeviatorNode::allowSwap() const
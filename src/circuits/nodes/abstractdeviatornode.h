@@ -38,9 +38,31 @@ class AbstractDeviatorNode : public AbstractCircuitNode
     };
 
     AbstractDeviatorNode(ModeManager *mgr, QObject *parent = nullptr);
+    ~AbstractDeviatorNode();
+
+    /*!
+     * \brief The ContactBatch class
+     *
+     * While a batch is open, contact state changes are queued.
+     * When outermost batch ends, all queued contacts switch together
+     * and circuits are updated once. So no circuit is searched
+     * through a contact which is about to switch too.
+     */
+    class ContactBatch
+    {
+    public:
+        ContactBatch();
+        ~ContactBatch();
+
+        Q_DISABLE_COPY_MOVE(ContactBatch)
+    };
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     bool loadFromJSON(const QJsonObject& obj) override;
     void saveToJSON(QJsonObject& obj) const override;
 
@@ -83,6 +105,14 @@ class AbstractDeviatorNode : public AbstractCircuitNode
     void setBothCanBeActive(bool value);
 
 private:
+    void removeDisconnectedCircuits();
+
+    static void commitBatch();
+
+private:
+    static int mBatchDepth;
+    static QVector<AbstractDeviatorNode *> mBatchNodes;
+
     bool mFlipContact = false;
     bool mSwapContactState = false;
     bool mHasCentralConnector = false; // Up connector
@@ -92,6 +122,11 @@ class AbstractDeviatorNode : public AbstractCircuitNode
 
     // UpIdx, DownIdx reflecting actual state
     bool mContactOnArr[2] = {false, false};
+
+    // Queued state, applied when batch ends
+    bool mBatchContactOn[2] = {false, false};
+    bool mBatchSpecialContact = false;
+    bool mBatchPending = false;
 };
 
 #endif // ABSTRACTDEVIATORNODE_H
@@ -0,0 +1,214 @@
+/**
+ * src/circuits/nodes/acepanelnodes.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "acepanelnodes.h"
+
+#include "../../objects/abstractsimulationobject.h"
+#include "../../objects/abstractsimulationobjectmodel.h"
+
+#include "../../objects/interfaces/buttoninterface.h"
+#include "../../objects/interfaces/sasibaceleverextrainterface.h"
+
+#include "../../objects/lever/acei/aceileverobject.h"
+
+//TODO: remove BEM
+#include "../../objects/lever/bem/bemleverobject.h"
+
+#include "../../objects/simple_activable/lightbulbobject.h"
+
+#include "../../views/modemanager.h"
+
+#include <QJsonObject>
+
+static AbstractSimulationObject *loadObjectRef(ModeManager *mgr,
+                                               const QJsonObject& obj,
+                                               const QString& nameKey,
+                                               const QString& type)
+{
+    auto model = mgr->modelForType(type);
+    if(!model)
+        return nullptr;
+
+    return model->getObjectByName(obj.value(nameKey).toString());
+}
+
+QString FakeACEIButtonNode::nodeType() const
+{
+    return FakeACEIButtonNode::NodeType;
+}
+
+bool FakeACEIButtonNode::loadFromJSON(const QJsonObject &obj)
+{
+    if(!OnOffSwitchNode::loadFromJSON(obj))
+        return false;
+
+    setButton(loadObjectRef(modeMgr(), obj, "button",
+                            obj.value("button_type").toString()));
+
+    setCentralLight(static_cast<LightBulbObject *>(
+                        loadObjectRef(modeMgr(), obj, "light_central",
+                                      LightBulbObject::Type)));
+
+    return true;
+}
+
+void FakeACEIButtonNode::saveToJSON(QJsonObject &obj) const
+{
+    OnOffSwitchNode::saveToJSON(obj);
+
+    obj["button"] = mButton ? mButton->name() : QString();
+    obj["button_type"] = mButton ? mButton->getType() : QString();
+
+    obj["light_central"] = mCentralLight ? mCentralLight->name() : QString();
+}
+
+AbstractSimulationObject *FakeACEIButtonNode::button() const
+{
+    return mButton;
+}
+
+bool FakeACEIButtonNode::setButton(AbstractSimulationObject *newButton)
+{
+    if(newButton && !newButton->getInterface<ButtonInterface>())
+        return false;
+
+    mButton = newButton;
+    return true;
+}
+
+LightBulbObject *FakeACEIButtonNode::centralLight() const
+{
+    return mCentralLight;
+}
+
+void FakeACEIButtonNode::setCentralLight(LightBulbObject *newCentralLight)
+{
+    mCentralLight = newCentralLight;
+}
+
+QString FakeLeverNode::nodeType() const
+{
+    return FakeLeverNode::NodeType;
+}
+
+bool FakeLeverNode::loadFromJSON(const QJsonObject &obj)
+{
+    if(!OnOffSwitchNode::loadFromJSON(obj))
+        return false;
+
+    setLever(loadObjectRef(modeMgr(), obj, "lever",
+                           obj.value("lever_type").toString()));
+
+    setLeftLight(static_cast<LightBulbObject *>(
+                     loadObjectRef(modeMgr(), obj, "light_left",
+                                   LightBulbObject::Type)));
+    setRightLight(static_cast<LightBulbObject *>(
+                      loadObjectRef(modeMgr(), obj, "light_right",
+                                    LightBulbObject::Type)));
+
+    return true;
+}
+
+void FakeLeverNode::saveToJSON(QJsonObject &obj) const
+{
+    OnOffSwitchNode::saveToJSON(obj);
+
+    obj["lever"] = mLever ? mLever->name() : QString();
+    obj["lever_type"] = mLever ? mLever->getType() : QString();
+
+    obj["light_left"] = mLeftLight ? mLeftLight->name() : QString();
+    obj["light_right"] = mRightLight ? mRightLight->name() : QString();
+}
+
+AbstractSimulationObject *FakeLeverNode::lever() const
+{
+    return mLever;
+}
+
+bool FakeLeverNode::setLever(AbstractSimulationObject *newLever)
+{
+    // TODO: remove BEM
+    if(newLever && newLever->getType() != ACEILeverObject::Type && newLever->getType() != BEMLeverObject::Type)
+        return false;
+
+    mLever = newLever;
+    return true;
+}
+
+LightBulbObject *FakeLeverNode::leftLight() const
+{
+    return mLeftLight;
+}
+
+void FakeLeverNode::setLeftLight(LightBulbObject *newLeftLight)
+{
+    mLeftLight = newLeftLight;
+}
+
+LightBulbObject *FakeLeverNode::rightLight() const
+{
+    return mRightLight;
+}
+
+void FakeLeverNode::setRightLight(LightBulbObject *newRightLight)
+{
+    mRightLight = newRightLight;
+}
+
+QString FakeLeverNode2::nodeType() const
+{
+    return FakeLeverNode2::NodeType;
+}
+
+bool FakeLeverNode2::loadFromJSON(const QJsonObject &obj)
+{
+    if(!OnOffSwitchNode::loadFromJSON(obj))
+        return false;
+
+    setLever(loadObjectRef(modeMgr(), obj, "lever",
+                           obj.value("lever_type").toString()));
+
+    return true;
+}
+
+void FakeLeverNode2::saveToJSON(QJsonObject &obj) const
+{
+    OnOffSwitchNode::saveToJSON(obj);
+
+    obj["lever"] = mLever ? mLever->name() : QString();
+    obj["lever_type"] = mLever ? mLever->getType() : QString();
+}
+
+AbstractSimulationObject *FakeLeverNode2::lever() const
+{
+    return mLever;
+}
+
+bool FakeLeverNode2::setLever(AbstractSimulationObject *newLever)
+{
+    if(newLever && !newLever->getInterface<SasibACELeverExtraInterface>())
+        return false;
+
+    mLever = newLever;
+    return true;
+}
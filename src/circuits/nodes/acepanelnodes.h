@@ -0,0 +1,136 @@
+/**
+ * src/circuits/nodes/acepanelnodes.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef ACEPANELNODES_H
+#define ACEPANELNODES_H
+
+#include "onoffswitchnode.h"
+
+#include <QPointer>
+
+class AbstractSimulationObject;
+class LightBulbObject;
+
+// ACEI and ACE Sasib panel items are drawings on circuit sheets.
+// Their nodes only occupy a tile and have no connectors,
+// so they are loaded also without graphics.
+// Linked objects are stored in nodes so graph items
+// can be created and released at any time.
+
+// TODO: this is a fake node
+class FakeACEIButtonNode : public OnOffSwitchNode
+{
+public:
+    explicit FakeACEIButtonNode(ModeManager *mgr, QObject *parent = nullptr)
+        : OnOffSwitchNode(mgr, parent)
+    {
+
+    }
+
+    static constexpr QLatin1String NodeType = QLatin1String("acei_button");
+    QString nodeType() const override;
+
+    // Not a real circuit node, no connectors
+    void getConnectors(std::vector<Connector>& /*connectors*/,
+                       const TileLocation& /*location*/,
+                       TileRotate /*r*/) const override {}
+
+    bool loadFromJSON(const QJsonObject& obj) override;
+    void saveToJSON(QJsonObject& obj) const override;
+
+    AbstractSimulationObject *button() const;
+    bool setButton(AbstractSimulationObject *newButton);
+
+    LightBulbObject *centralLight() const;
+    void setCentralLight(LightBulbObject *newCentralLight);
+
+private:
+    QPointer<AbstractSimulationObject> mButton;
+    QPointer<LightBulbObject> mCentralLight;
+};
+
+// TODO: this is a fake node
+class FakeLeverNode : public OnOffSwitchNode
+{
+public:
+    explicit FakeLeverNode(ModeManager *mgr, QObject *parent = nullptr)
+        : OnOffSwitchNode(mgr, parent)
+    {
+
+    }
+
+    static constexpr QLatin1String NodeType = QLatin1String("acei_lever");
+    QString nodeType() const override;
+
+    // Not a real circuit node, no connectors
+    void getConnectors(std::vector<Connector>& /*connectors*/,
+                       const TileLocation& /*location*/,
+                       TileRotate /*r*/) const override {}
+
+    bool loadFromJSON(const QJsonObject& obj) override;
+    void saveToJSON(QJsonObject& obj) const override;
+
+    AbstractSimulationObject *lever() const;
+    bool setLever(AbstractSimulationObject *newLever);
+
+    LightBulbObject *leftLight() const;
+    void setLeftLight(LightBulbObject *newLeftLight);
+
+    LightBulbObject *rightLight() const;
+    void setRightLight(LightBulbObject *newRightLight);
+
+private:
+    QPointer<AbstractSimulationObject> mLever;
+    QPointer<LightBulbObject> mLeftLight;
+    QPointer<LightBulbObject> mRightLight;
+};
+
+// TODO: this is a fake node
+class FakeLeverNode2 : public OnOffSwitchNode
+{
+public:
+    explicit FakeLeverNode2(ModeManager *mgr, QObject *parent = nullptr)
+        : OnOffSwitchNode(mgr, parent)
+    {
+
+    }
+
+    static constexpr QLatin1String NodeType = QLatin1String("ace_sasib_lever");
+    QString nodeType() const override;
+
+    // Not a real circuit node, no connectors
+    void getConnectors(std::vector<Connector>& /*connectors*/,
+                       const TileLocation& /*location*/,
+                       TileRotate /*r*/) const override {}
+
+    bool loadFromJSON(const QJsonObject& obj) override;
+    void saveToJSON(QJsonObject& obj) const override;
+
+    AbstractSimulationObject *lever() const;
+    bool setLever(AbstractSimulationObject *newLever);
+
+private:
+    QPointer<AbstractSimulationObject> mLever;
+};
+
+#endif // ACEPANELNODES_H
@@ -85,6 +85,33 @@ AbstractCircuitNode::ConnectionsRes BifilarizatorNode::getActiveConnections(Cabl
     return {};
 }
 
+void BifilarizatorNode::getConnectors(std::vector<Connector> &connectors,
+                                      const TileLocation &location,
+                                      TileRotate r) const
+{
+    /* Do not invert unifilar polarity for case when 2 Bifilarizator nodes
+     * are placed in opposite direction and connected like this:
+     *              ___+__+__+___
+     *              |           |
+     * Uni A -----Bifi 1       Bifi 2 ------ Uni B
+     *              |           |
+     *              |__-__-__-__|
+     *
+     * Current in Uni A must have same polarity in Uni B
+     * So positive must go on upper half and negative on lower half
+     * So Bifi 1 is normal and Bifi 2 is reversed
+     */
+
+    const bool invertPolarity =
+            (r == TileRotate::Deg180 || r == TileRotate::Deg270);
+
+    connectors.emplace_back(location, r - TileRotate::Deg90,
+                            invertPolarity ? 2 : 0);
+    connectors.emplace_back(location, r, 1);
+    connectors.emplace_back(location, r + TileRotate::Deg90,
+                            invertPolarity ? 0 : 2);
+}
+
 QString BifilarizatorNode::nodeType() const
 {
     return NodeType;
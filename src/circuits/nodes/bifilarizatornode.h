@@ -33,6 +33,10 @@ class BifilarizatorNode : public AbstractCircuitNode
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     static constexpr QLatin1String NodeType = QLatin1String("bifilarizator_node");
     QString nodeType() const override;
 
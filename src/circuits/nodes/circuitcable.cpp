@@ -25,28 +25,36 @@
 #include "abstractcircuitnode.h"
 
 #include "../electriccircuit.h"
+#include "../circuitgraph.h"
+#include "../circuitchangenotifier.h"
 
 #include "../../views/modemanager.h"
 
+// Smaller sets are scanned, avoids hashing for most cables
+static constexpr int MinIndexedCircuits = 16;
+
 CircuitCable::CircuitCable(ModeManager *mgr, QObject *parent)
     : QObject{parent}
     , mModeMgr(mgr)
 {
-
+    mNotifiedPower = powered();
+    mNotifiedFlags = getFlags();
 }
 
 CircuitCable::~CircuitCable()
 {
     Q_ASSERT(getCircuits(CircuitType::Closed,
-                         CircuitPole::First).isEmpty());
+                         CircuitPole::First).circuits.isEmpty());
     Q_ASSERT(getCircuits(CircuitType::Closed,
-                         CircuitPole::Second).isEmpty());
+                         CircuitPole::Second).circuits.isEmpty());
     Q_ASSERT(getCircuits(CircuitType::Open,
-                         CircuitPole::First).isEmpty());
+                         CircuitPole::First).circuits.isEmpty());
     Q_ASSERT(getCircuits(CircuitType::Open,
-                         CircuitPole::Second).isEmpty());
+                         CircuitPole::Second).circuits.isEmpty());
     Q_ASSERT(mCircuitsWithFlags == 0);
 
+    modeMgr()->changeNotifier()->removeCable(this);
+
     // Detach all nodes
     if(mNodeA.node)
     {
@@ -108,48 +116,42 @@ void CircuitCable::addCircuit(ElectricCircuit *circuit, CircuitPole pole)
 {
     const CablePower oldPower = powered();
 
-    CircuitList& circuitList = getCircuits(circuit->type(),
-                                           pole);
+    CircuitSet& circuitSet = getCircuits(circuit->type(), pole);
 
     // Since pole lists are different
     // a circuit may pass only once per list
-    if(circuitList.contains(circuit))
+    if(circuitSet.contains(circuit))
         return;
-    circuitList.append(circuit);
-
-    if(circuit->flags() != getFlags(circuit->type(), pole))
-        updateCircuitFlags(circuit->type(), pole);
+    circuitSet.append(circuit);
 
     if(circuit->flags() != CircuitFlags::None)
         mCircuitsWithFlags++;
 
-    const CablePower newPower = powered();
-    if(oldPower != newPower)
-        emit powerChanged(newPower);
+    const bool flagsChanged = circuitSet.updateFlags();
+
+    if(flagsChanged || oldPower != powered())
+        notifyPowerChanged();
 }
 
 void CircuitCable::removeCircuit(ElectricCircuit *circuit)
 {
     const CablePower oldPower = powered();
 
-    CircuitList& circuitList1 = getCircuits(circuit->type(),
-                                            CircuitPole::First);
-    CircuitList& circuitList2 = getCircuits(circuit->type(),
-                                            CircuitPole::Second);
+    CircuitSet& circuitSet1 = getCircuits(circuit->type(),
+                                          CircuitPole::First);
+    CircuitSet& circuitSet2 = getCircuits(circuit->type(),
+                                          CircuitPole::Second);
 
-    Q_ASSERT(circuitList1.contains(circuit) ||
-             circuitList2.contains(circuit));
+    const bool isFirst = circuitSet1.remove(circuit);
+    const bool isSecond = circuitSet2.remove(circuit);
 
-    bool isFirst = circuitList1.removeOne(circuit);
-    bool isSecond = circuitList2.removeOne(circuit);
+    Q_ASSERT(isFirst || isSecond);
 
-    if(mCircuitsWithFlags > 0)
-    {
-        if(isFirst)
-            updateCircuitFlags(circuit->type(), CircuitPole::First);
-        if(isSecond)
-            updateCircuitFlags(circuit->type(), CircuitPole::Second);
-    }
+    bool flagsChanged = false;
+    if(isFirst)
+        flagsChanged |= circuitSet1.updateFlags();
+    if(isSecond)
+        flagsChanged |= circuitSet2.updateFlags();
 
     if(circuit->flags() != CircuitFlags::None)
     {
@@ -159,72 +161,42 @@ void CircuitCable::removeCircuit(ElectricCircuit *circuit)
     }
     Q_ASSERT(mCircuitsWithFlags >= 0);
 
-    const CablePower newPower = powered();
-    if(oldPower != newPower)
-        emit powerChanged(newPower);
+    if(flagsChanged || oldPower != powered())
+        notifyPowerChanged();
 }
 
-void CircuitCable::circuitAddedRemovedFlags(ElectricCircuit *circuit, bool add)
+void CircuitCable::circuitFlagsChanged(ElectricCircuit *circuit, CircuitFlags oldFlags)
 {
-    CircuitList& circuitList1 = getCircuits(circuit->type(),
-                                            CircuitPole::First);
-    CircuitList& circuitList2 = getCircuits(circuit->type(),
-                                            CircuitPole::Second);
-
-    bool isFirst = circuitList1.contains(circuit);
-    bool isSecond = circuitList2.contains(circuit);
+    const CircuitFlags newFlags = circuit->flags();
+    if(newFlags == oldFlags)
+        return;
 
-    Q_ASSERT(isFirst || isSecond);
+    // Counters were added with old flags, move them to new flags
+    bool flagsChanged = false;
+    int count = 0;
 
-    if(mCircuitsWithFlags > 0 || add)
+    for(CircuitPole pole : {CircuitPole::First, CircuitPole::Second})
     {
-        if(isFirst)
-            updateCircuitFlags(circuit->type(), CircuitPole::First);
-        if(isSecond)
-            updateCircuitFlags(circuit->type(), CircuitPole::Second);
+        CircuitSet& circuitSet = getCircuits(circuit->type(), pole);
+        if(!circuitSet.contains(circuit))
+            continue;
+
+        circuitSet.countFlags(oldFlags, -1);
+        circuitSet.countFlags(newFlags, +1);
+        flagsChanged |= circuitSet.updateFlags();
+        count++;
     }
 
-    if(add)
-    {
-        mCircuitsWithFlags++;
-        if(isFirst && isSecond)
-            mCircuitsWithFlags++;
-    }
-    else
-    {
-        mCircuitsWithFlags--;
-        if(isFirst && isSecond)
-            mCircuitsWithFlags--;
-    }
-    Q_ASSERT(mCircuitsWithFlags >= 0);
-}
+    Q_ASSERT(count > 0);
 
-void CircuitCable::updateCircuitFlags(CircuitType type, CircuitPole pole)
-{
-    CircuitFlags newFlags = CircuitFlags::None;
-
-    const CircuitList& circuitList = getCircuits(type, pole);
-    if(!circuitList.isEmpty())
-        newFlags = circuitList.first()->flags();
-
-    for(ElectricCircuit *circuit : circuitList)
-    {
-        const CircuitFlags flags2 = circuit->flags();
-        const CircuitFlags code1 = getCode(newFlags);
-        const CircuitFlags code2 = getCode(flags2);
-
-        newFlags = newFlags & flags2;
-
-        if(code1 != code2 && code1 != CircuitFlags::None && code2 != CircuitFlags::None)
-            newFlags = withCode(newFlags, CircuitFlags::CodeInvalid);
-    }
+    if(oldFlags == CircuitFlags::None)
+        mCircuitsWithFlags += count;
+    else if(newFlags == CircuitFlags::None)
+        mCircuitsWithFlags -= count;
+    Q_ASSERT(mCircuitsWithFlags >= 0);
 
-    CircuitFlags &curFlags = getFlags(type, pole);
-    if(newFlags != curFlags)
-    {
-        curFlags = newFlags;
-        emit powerChanged(powered());
-    }
+    if(flagsChanged)
+        notifyPowerChanged();
 }
 
 void CircuitCable::setNode(CableSide s, CableEnd node)
@@ -242,18 +214,26 @@ void CircuitCable::setNode(CableSide s, CableEnd node)
         break;
     }
 
+    // Opposite node must see new end
+    CircuitGraph::cableEndChanged(this, s);
+
     emit nodesChanged();
 }
 
+void CircuitCable::notifyPowerChanged()
+{
+    modeMgr()->changeNotifier()->cablePowerChanged(this);
+}
+
 CablePower CircuitCable::powered() const
 {
     // Cable is powered if there are
     // closed circuits passing on it
 
     const bool firstOn = !getCircuits(CircuitType::Closed,
-                                      CircuitPole::First).isEmpty();
+                                      CircuitPole::First).circuits.isEmpty();
     const bool secondOn = !getCircuits(CircuitType::Closed,
-                                       CircuitPole::Second).isEmpty();
+                                       CircuitPole::Second).circuits.isEmpty();
 
     if(firstOn)
     {
@@ -267,9 +247,9 @@ CablePower CircuitCable::powered() const
     }
 
     const bool firstOpenOn = !getCircuits(CircuitType::Open,
-                                          CircuitPole::First).isEmpty();
+                                          CircuitPole::First).circuits.isEmpty();
     const bool secondOpenOn = !getCircuits(CircuitType::Open,
-                                           CircuitPole::Second).isEmpty();
+                                           CircuitPole::Second).circuits.isEmpty();
 
     if(firstOpenOn)
     {
@@ -288,36 +268,147 @@ CablePower CircuitCable::powered() const
 CircuitFlags CircuitCable::getFlags() const
 {
     const bool firstOn = !getCircuits(CircuitType::Closed,
-                                      CircuitPole::First).isEmpty();
+                                      CircuitPole::First).circuits.isEmpty();
     const bool secondOn = !getCircuits(CircuitType::Closed,
-                                       CircuitPole::Second).isEmpty();
+                                       CircuitPole::Second).circuits.isEmpty();
 
     if(firstOn)
     {
         if(secondOn)
-            return mFlagsFirstClosed & mFlagsSecondClosed;
-        return mFlagsFirstClosed;
+            return mFirstPoleCirctuitsClosed.flags & mSecondPoleCirctuitsClosed.flags;
+        return mFirstPoleCirctuitsClosed.flags;
     }
     else if(secondOn)
     {
-        return mFlagsSecondClosed;
+        return mSecondPoleCirctuitsClosed.flags;
     }
 
     const bool firstOpenOn = !getCircuits(CircuitType::Open,
-                                          CircuitPole::First).isEmpty();
+                                          CircuitPole::First).circuits.isEmpty();
     const bool secondOpenOn = !getCircuits(CircuitType::Open,
-                                           CircuitPole::Second).isEmpty();
+                                           CircuitPole::Second).circuits.isEmpty();
 
     if(firstOpenOn)
     {
         if(secondOpenOn)
-            return mFlagsFirstOpen & mFlagsSecondOpen;
-        return mFlagsFirstOpen;
+            return mFirstPoleCirctuitsOpen.flags & mSecondPoleCirctuitsOpen.flags;
+        return mFirstPoleCirctuitsOpen.flags;
     }
     else if(secondOpenOn)
     {
-        return mFlagsSecondOpen;
+        return mSecondPoleCirctuitsOpen.flags;
     }
 
     return CircuitFlags::None;
 }
+
+int CircuitCable::CircuitSet::indexOf(ElectricCircuit *circuit) const
+{
+    if(index.isEmpty())
+        return circuits.indexOf(circuit);
+    return index.value(circuit, -1);
+}
+
+void CircuitCable::CircuitSet::append(ElectricCircuit *circuit)
+{
+    circuits.append(circuit);
+    countFlags(circuit->flags(), +1);
+
+    if(!index.isEmpty())
+    {
+        index.insert(circuit, circuits.size() - 1);
+    }
+    else if(circuits.size() > MinIndexedCircuits)
+    {
+        // Set became big, start indexing
+        index.reserve(circuits.size());
+        for(int i = 0; i < circuits.size(); i++)
+            index.insert(circuits.at(i), i);
+    }
+}
+
+bool CircuitCable::CircuitSet::remove(ElectricCircuit *circuit)
+{
+    const int idx = indexOf(circuit);
+    if(idx < 0)
+        return false;
+
+    countFlags(circuit->flags(), -1);
+
+    // Move last circuit in place of removed one
+    ElectricCircuit *last = circuits.takeLast();
+    if(last != circuit)
+        circuits[idx] = last;
+
+    if(!index.isEmpty())
+    {
+        if(circuits.size() < MinIndexedCircuits / 2)
+        {
+            // Small enough to be scanned again
+            index.clear();
+        }
+        else
+        {
+            index.remove(circuit);
+            if(last != circuit)
+                index[last] = idx;
+        }
+    }
+
+    return true;
+}
+
+void CircuitCable::CircuitSet::countFlags(CircuitFlags f, int delta)
+{
+    const quint8 bits = quint8(onlyFlags(f));
+    for(int bit = 0; bit < FlagBitCount; bit++)
+    {
+        if(bits & (1 << bit))
+            flagCounts[bit] += delta;
+    }
+
+    const CircuitFlags code = getCode(f);
+    if(code != CircuitFlags::None)
+    {
+        codeCounts[qCountTrailingZeroBits(quint8(code))] += delta;
+        codedCount += delta;
+    }
+}
+
+bool CircuitCable::CircuitSet::updateFlags()
+{
+    // Keep only flags shared by all circuits
+    const int total = circuits.size();
+
+    quint8 bits = 0;
+    for(int bit = 0; total > 0 && bit < FlagBitCount; bit++)
+    {
+        if(flagCounts[bit] == total)
+            bits |= quint8(1 << bit);
+    }
+
+    CircuitFlags newFlags = CircuitFlags(bits);
+
+    if(total > 0 && codedCount == total)
+    {
+        // All circuits have a code, if they differ it's invalid
+        bool sameCode = false;
+        for(int bit = 0; bit < FlagBitCount; bit++)
+        {
+            if(codeCounts[bit] == total)
+            {
+                sameCode = true;
+                break;
+            }
+        }
+
+        if(!sameCode)
+            newFlags = withCode(newFlags, CircuitFlags::CodeInvalid);
+    }
+
+    if(newFlags == flags)
+        return false;
+
+    flags = newFlags;
+    return true;
+}
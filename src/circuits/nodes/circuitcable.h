@@ -25,6 +25,7 @@
 
 #include <QObject>
 #include <QVector>
+#include <QHash>
 
 #include "../../enums/circuittypes.h"
 #include "../../enums/cabletypes.h"
@@ -85,8 +86,8 @@ class CircuitCable : public QObject
         return mCircuitsWithFlags > 0;
     }
 
-    void circuitAddedRemovedFlags(ElectricCircuit *circuit, bool add);
-    void updateCircuitFlags(CircuitType type, CircuitPole pole);
+    // Circuit flags changed while passing on this cable
+    void circuitFlagsChanged(ElectricCircuit *circuit, CircuitFlags oldFlags);
 
 signals:
     void modeChanged(Mode m);
@@ -95,16 +96,58 @@ class CircuitCable : public QObject
 
 private:
     friend class AbstractCircuitNode;
+    friend class ElectricCircuit;
     void setNode(CableSide s, CableEnd node);
 
+    // Coalesced powerChanged(), see CircuitChangeNotifier
+    friend class CircuitChangeNotifier;
+    void notifyPowerChanged();
+
 private:
     ModeManager *mModeMgr;
 
     Mode mMode = Mode::Unifilar;
 
-    typedef QVector<ElectricCircuit *> CircuitList;
+    // Bits of CircuitFlags::FlagsMask
+    static constexpr int FlagBitCount = 6;
+
+    /*!
+     * Circuits of one type passing on one pole.
+     * Big sets index circuit positions for constant time lookup,
+     * small sets are just scanned.
+     * Flags are aggregated from per flag counters,
+     * so adding or removing a circuit does not iterate the set.
+     */
+    struct CircuitSet
+    {
+        QVector<ElectricCircuit *> circuits;
+        QHash<ElectricCircuit *, int> index;
+
+        // Circuits having each flag bit
+        int flagCounts[FlagBitCount] = {};
+
+        // Circuits having each code, and having any code
+        int codeCounts[FlagBitCount] = {};
+        int codedCount = 0;
 
-    inline CircuitList& getCircuits(CircuitType type, CircuitPole pole)
+        CircuitFlags flags = CircuitFlags::None;
+
+        int indexOf(ElectricCircuit *circuit) const;
+        inline bool contains(ElectricCircuit *circuit) const
+        {
+            return indexOf(circuit) >= 0;
+        }
+
+        void append(ElectricCircuit *circuit);
+        bool remove(ElectricCircuit *circuit);
+
+        void countFlags(CircuitFlags f, int delta);
+
+        // Returns true if aggregated flags changed
+        bool updateFlags();
+    };
+
+    inline CircuitSet& getCircuits(CircuitType type, CircuitPole pole)
     {
         if(pole == CircuitPole::First)
             return type == CircuitType::Closed ?
@@ -116,7 +159,7 @@ class CircuitCable : public QObject
                     mSecondPoleCirctuitsOpen;
     }
 
-    inline const CircuitList& getCircuits(CircuitType type, CircuitPole pole) const
+    inline const CircuitSet& getCircuits(CircuitType type, CircuitPole pole) const
     {
         if(pole == CircuitPole::First)
             return type == CircuitType::Closed ?
@@ -128,41 +171,26 @@ class CircuitCable : public QObject
                     mSecondPoleCirctuitsOpen;
     }
 
-    inline CircuitFlags& getFlags(CircuitType type, CircuitPole pole)
-    {
-        if(pole == CircuitPole::First)
-            return type == CircuitType::Closed ?
-                        mFlagsFirstClosed :
-                        mFlagsFirstOpen;
-
-        return type == CircuitType::Closed ?
-                    mFlagsSecondClosed :
-                    mFlagsSecondOpen;
-    }
-
     inline CircuitFlags getFlags(CircuitType type, CircuitPole pole) const
     {
-        if(pole == CircuitPole::First)
-            return type == CircuitType::Closed ?
-                        mFlagsFirstClosed :
-                        mFlagsFirstOpen;
-
-        return type == CircuitType::Closed ?
-                    mFlagsSecondClosed :
-                    mFlagsSecondOpen;
+        return getCircuits(type, pole).flags;
     }
 
-    CircuitList mFirstPoleCirctuitsClosed;
-    CircuitList mSecondPoleCirctuitsClosed;
-    CircuitList mFirstPoleCirctuitsOpen;
-    CircuitList mSecondPoleCirctuitsOpen;
+    CircuitSet mFirstPoleCirctuitsClosed;
+    CircuitSet mSecondPoleCirctuitsClosed;
+    CircuitSet mFirstPoleCirctuitsOpen;
+    CircuitSet mSecondPoleCirctuitsOpen;
 
-    CircuitFlags mFlagsFirstClosed = CircuitFlags::None;
-    CircuitFlags mFlagsSecondClosed = CircuitFlags::None;
-    CircuitFlags mFlagsFirstOpen = CircuitFlags::None;
-    CircuitFlags mFlagsSecondOpen = CircuitFlags::None;
     int mCircuitsWithFlags = 0;
 
+    // Last circuit operation which visited this cable
+    quint64 mVisitEpoch = 0;
+
+    // State of last emitted powerChanged()
+    CablePower mNotifiedPower = CablePower::None;
+    CircuitFlags mNotifiedFlags = CircuitFlags::None;
+    bool mPowerChangePending = false;
+
     CableEnd mNodeA;
     CableEnd mNodeB;
 };
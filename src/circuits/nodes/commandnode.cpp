@@ -69,6 +69,13 @@ AbstractCircuitNode::ConnectionsRes CommandNode::getActiveConnections(CableItem
     return {dest};
 }
 
+void CommandNode::getConnectors(std::vector<Connector> &connectors,
+                                const TileLocation &location,
+                                TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+}
+
 void CommandNode::addCircuit(ElectricCircuit *circuit)
 {
     const bool wasActive = hasCircuits();
@@ -80,8 +87,8 @@ void CommandNode::addCircuit(ElectricCircuit *circuit)
     if(!wasActive && isActive && mObject)
     {
         setPhase(Phase::Waiting);
-        mTimer.start(std::chrono::milliseconds(mDelayMillis),
-                     Qt::CoarseTimer, this);
+        mTimer.start(scheduler(), std::chrono::milliseconds(mDelayMillis),
+                     this);
     }
 }
 
@@ -166,7 +173,7 @@ void CommandNode::timerEvent(QTimerEvent *ev)
         if(!performAction())
         {
             // Action failed, retry in 1 second
-            mTimer.start(std::chrono::seconds(1), Qt::CoarseTimer, this);
+            mTimer.start(scheduler(), std::chrono::seconds(1), this);
         }
         return;
     }
@@ -254,7 +261,7 @@ bool CommandNode::performAction()
             if(leverIface->angle() == stepAngle)
             {
                 // Success, schedule next step
-                mTimer.start(std::chrono::milliseconds(100), Qt::CoarseTimer, this);
+                mTimer.start(scheduler(), std::chrono::milliseconds(100), this);
                 return true;
             }
         }
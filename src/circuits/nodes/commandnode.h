@@ -24,7 +24,7 @@
 #define COMMANDNODE_H
 
 #include "abstractcircuitnode.h"
-#include <QBasicTimer>
+#include "../../utils/simulationscheduler.h"
 
 class AbstractSimulationObject;
 
@@ -51,6 +51,10 @@ class CommandNode : public AbstractCircuitNode
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     void addCircuit(ElectricCircuit *circuit) override;
     void removeCircuit(ElectricCircuit *circuit, const NodeOccurences& items) override;
 
@@ -85,7 +89,7 @@ class CommandNode : public AbstractCircuitNode
 
 private:
     AbstractSimulationObject *mObject = nullptr;
-    QBasicTimer mTimer;
+    SimulationTimer mTimer;
     int mDelayMillis = 500;
 
     int mTargetPosition = 0;
@@ -63,6 +63,14 @@ AbstractCircuitNode::ConnectionsRes DiodeCircuitNode::getActiveConnections(Cable
     return {};
 }
 
+void DiodeCircuitNode::getConnectors(std::vector<Connector> &connectors,
+                                     const TileLocation &location,
+                                     TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+    connectors.emplace_back(location, r + TileRotate::Deg180, 1);
+}
+
 void DiodeCircuitNode::addCircuit(ElectricCircuit *circuit)
 {
     CircuitList& circuitList = getCircuits(circuit->type());
@@ -33,6 +33,10 @@ class DiodeCircuitNode : public AbstractCircuitNode
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     virtual void addCircuit(ElectricCircuit *circuit) override;
     void partialRemoveCircuit(ElectricCircuit *circuit, const NodeOccurences &items) override;
 
@@ -71,6 +71,14 @@ AbstractCircuitNode::ConnectionsRes OnOffSwitchNode::getActiveConnections(CableI
     return {};
 }
 
+void OnOffSwitchNode::getConnectors(std::vector<Connector> &connectors,
+                                    const TileLocation &location,
+                                    TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+    connectors.emplace_back(location, r + TileRotate::Deg180, 1);
+}
+
 bool OnOffSwitchNode::loadFromJSON(const QJsonObject &obj)
 {
     if(!AbstractCircuitNode::loadFromJSON(obj))
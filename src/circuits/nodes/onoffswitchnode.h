@@ -33,6 +33,10 @@ class OnOffSwitchNode : public AbstractCircuitNode
 
     virtual ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     bool loadFromJSON(const QJsonObject& obj) override;
     void saveToJSON(QJsonObject& obj) const override;
 
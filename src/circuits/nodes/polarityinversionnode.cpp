@@ -46,6 +46,14 @@ AbstractCircuitNode::ConnectionsRes PolarityInversionNode::getActiveConnections(
     return {dest};
 }
 
+void PolarityInversionNode::getConnectors(std::vector<Connector> &connectors,
+                                          const TileLocation &location,
+                                          TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+    connectors.emplace_back(location, r + TileRotate::Deg180, 1);
+}
+
 QString PolarityInversionNode::nodeType() const
 {
     return NodeType;
@@ -33,6 +33,10 @@ class PolarityInversionNode : public AbstractCircuitNode
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     static constexpr QLatin1String NodeType = QLatin1String("polarity_inversion");
     QString nodeType() const override;
 };
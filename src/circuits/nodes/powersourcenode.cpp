@@ -39,6 +39,13 @@ AbstractCircuitNode::ConnectionsRes PowerSourceNode::getActiveConnections(CableI
     return {};
 }
 
+void PowerSourceNode::getConnectors(std::vector<Connector> &connectors,
+                                    const TileLocation &location,
+                                    TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+}
+
 QString PowerSourceNode::nodeType() const
 {
     return NodeType;
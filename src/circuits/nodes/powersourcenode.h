@@ -33,6 +33,10 @@ class PowerSourceNode : public AbstractCircuitNode
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     static constexpr QLatin1String NodeType = QLatin1String("power_source");
     QString nodeType() const override;
 
@@ -208,6 +208,9 @@ void RelaisContactNode::setState(State newState)
         return;
     mState = newState;
 
+    // Code flags of connections depend on relay state too
+    markConnectionsChanged();
+
     const bool canMiddle = (mState == State::Middle && activeWhileMiddle());
 
     setContactState(mState == State::Up || canMiddle,
@@ -92,6 +92,29 @@ AbstractCircuitNode::ConnectionsRes RelaisPowerNode::getActiveConnections(CableI
     return {dest};
 }
 
+void RelaisPowerNode::getConnectors(std::vector<Connector> &connectors,
+                                    const TileLocation &location,
+                                    TileRotate r) const
+{
+    if(relais() && relais()->relaisType() == AbstractRelais::RelaisType::Combinator)
+    {
+        TileRotate firstConnector = TileRotate::Deg90;
+        if(combinatorSecondCoil())
+            firstConnector = TileRotate::Deg270;
+
+        const TileRotate secondConnector = twoConnectorsRotate(r) + TileRotate::Deg180;
+
+        connectors.emplace_back(location, firstConnector, 0);
+        connectors.emplace_back(location, secondConnector, 1);
+    }
+    else
+    {
+        connectors.emplace_back(location, r, 0);
+        if(hasSecondConnector())
+            connectors.emplace_back(location, r + TileRotate::Deg180, 1);
+    }
+}
+
 void RelaisPowerNode::addCircuit(ElectricCircuit *circuit)
 {
     const bool wasActiveFirst = hasCircuit(0, CircuitType::Closed);
@@ -370,10 +393,10 @@ void RelaisPowerNode::setDelayDownMillis(int newDelayDownMillis)
 
 void RelaisPowerNode::timerEvent(QTimerEvent *e)
 {
-    if(e->timerId() == mTimerIds[0] || e->timerId() == mTimerIds[1])
+    if(e->timerId() == mTimers[0].timerId() || e->timerId() == mTimers[1].timerId())
     {
         Q_ASSERT_X(mRelais, "RelaisPowerNode::timerEvent", "no relay");
-        const int contact = (e->timerId() == mTimerIds[0]) ? 0 : 1;
+        const int contact = (e->timerId() == mTimers[0].timerId()) ? 0 : 1;
 
         const bool decoder = (relais() && relais()->relaisType() == AbstractRelais::RelaisType::Decoder);
         const bool repeater = (relais() && relais()->relaisType() == AbstractRelais::RelaisType::CodeRepeater);
@@ -395,7 +418,7 @@ void RelaisPowerNode::timerEvent(QTimerEvent *e)
         stopTimer(contact);
         return;
     }
-    else if(e->timerId() == mPercentTimerId)
+    else if(e->timerId() == mPercentTimer.timerId())
     {
         Q_ASSERT_X(mRelais, "RelaisPowerNode::timerEvent", "no relay");
 
@@ -403,9 +426,9 @@ void RelaisPowerNode::timerEvent(QTimerEvent *e)
         const double upIncrement = 250.0 / qMax(0.1, double(mDelayUpMillis));
         const double downIncrement = -250.0 / qMax(0.1, double(mDelayDownMillis));
 
-        if(mTimerIds[0])
+        if(mTimers[0].isActive())
             mTimeoutPercentStatus[0] += wasGoingUp[0] ? upIncrement : downIncrement;
-        if(mTimerIds[1])
+        if(mTimers[1].isActive())
             mTimeoutPercentStatus[1] += wasGoingUp[1] ? upIncrement : downIncrement;
 
         // Update visual drawing
@@ -435,7 +458,7 @@ void RelaisPowerNode::activateRelay(int contact)
 {
     Q_ASSERT(contact == 0 || contact == 1);
 
-    if(mTimerIds[contact] && wasGoingUp[contact])
+    if(mTimers[contact].isActive() && wasGoingUp[contact])
         return; // Already scheduled
 
     stopTimer(contact);
@@ -466,8 +489,7 @@ void RelaisPowerNode::activateRelay(int contact)
     else
     {
         wasGoingUp[contact] = true;
-        mTimerIds[contact] = startTimer(mDelayUpMillis,
-                                        Qt::PreciseTimer);
+        mTimers[contact].start(scheduler(), mDelayUpMillis, this);
         mTimeoutPercentStatus[contact] = 0.0; // We start from bottom
         ensureTimeoutPercentTimer();
     }
@@ -477,7 +499,7 @@ void RelaisPowerNode::deactivateRelay(int contact)
 {
     Q_ASSERT(contact == 0 || contact == 1);
 
-    if(mTimerIds[contact] && !wasGoingUp[contact])
+    if(mTimers[contact].isActive() && !wasGoingUp[contact])
         return; // Already scheduled
 
     stopTimer(contact);
@@ -505,8 +527,7 @@ void RelaisPowerNode::deactivateRelay(int contact)
     else
     {
         wasGoingUp[contact] = false;
-        mTimerIds[contact] = startTimer(mDelayDownMillis,
-                                        Qt::PreciseTimer);
+        mTimers[contact].start(scheduler(), mDelayDownMillis, this);
         mTimeoutPercentStatus[contact] = 1.0; // We start from top
         ensureTimeoutPercentTimer();
     }
@@ -516,13 +537,12 @@ void RelaisPowerNode::stopTimer(int contact)
 {
     Q_ASSERT(contact == 0 || contact == 1);
 
-    if(!mTimerIds[contact])
+    if(!mTimers[contact].isActive())
         return;
 
-    killTimer(mTimerIds[contact]);
-    mTimerIds[contact] = 0;
+    mTimers[contact].stop();
 
-    if(!mTimerIds[0] && !mTimerIds[1])
+    if(!mTimers[0].isActive() && !mTimers[1].isActive())
     {
         stopTimeoutPercentTimer();
     }
@@ -530,21 +550,20 @@ void RelaisPowerNode::stopTimer(int contact)
 
 void RelaisPowerNode::ensureTimeoutPercentTimer()
 {
-    if(mPercentTimerId)
+    if(mPercentTimer.isActive())
         return;
 
     // Start an auxiliary timer which increases
     // percent of elapsed time since delay started
-    mPercentTimerId = startTimer(250, Qt::CoarseTimer);
+    mPercentTimer.start(scheduler(), 250, this);
 }
 
 void RelaisPowerNode::stopTimeoutPercentTimer()
 {
-    if(!mPercentTimerId)
+    if(!mPercentTimer.isActive())
         return;
 
-    killTimer(mPercentTimerId);
-    mPercentTimerId = 0;
+    mPercentTimer.stop();
 
     // Reset percent status
     mTimeoutPercentStatus[0] = 0.0;
@@ -27,6 +27,8 @@
 
 #include "../../enums/signalaspectcodes.h"
 
+#include "../../utils/simulationscheduler.h"
+
 class AbstractRelais;
 
 class RelaisPowerNode : public AbstractCircuitNode
@@ -38,6 +40,10 @@ class RelaisPowerNode : public AbstractCircuitNode
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     void addCircuit(ElectricCircuit *circuit) override;
     void removeCircuit(ElectricCircuit *circuit, const NodeOccurences& items) override;
 
@@ -65,7 +71,7 @@ class RelaisPowerNode : public AbstractCircuitNode
 
     inline bool isTimeoutActive() const
     {
-        return mPercentTimerId > 0;
+        return mPercentTimer.isActive();
     }
 
     inline double getTimeoutPercent() const
@@ -78,6 +84,17 @@ class RelaisPowerNode : public AbstractCircuitNode
     bool combinatorSecondCoil() const;
     void setCombinatorSecondCoil(bool newCombinatorSecondCoil);
 
+    static inline TileRotate twoConnectorsRotate(TileRotate r)
+    {
+        // Always put connectors horizontal
+        // We ignore other rotations otherwise we cannot draw name :(
+        if(r == TileRotate::Deg90)
+            r = TileRotate::Deg0;
+        else if(r == TileRotate::Deg270)
+            r = TileRotate::Deg180;
+        return r;
+    }
+
 signals:
     void relayChanged(AbstractRelais *r);
     void delaysChanged();
@@ -110,8 +127,8 @@ private slots:
     bool mCombinatorSecondCoil = false;
 
     // State
-    int mTimerIds[2] = {0, 0};
-    int mPercentTimerId = 0;
+    SimulationTimer mTimers[2];
+    SimulationTimer mPercentTimer;
 
     double mTimeoutPercentStatus[2] = {0, 0};
     bool wasGoingUp[2] = {true, true};
@@ -23,6 +23,7 @@
 #include "remotecablecircuitnode.h"
 
 #include "../electriccircuit.h"
+#include "../simulationprofiler.h"
 
 #include "../../objects/abstractsimulationobjectmodel.h"
 #include "../../objects/circuit_bridge/remotecircuitbridge.h"
@@ -127,6 +128,13 @@ AbstractCircuitNode::ConnectionsRes RemoteCableCircuitNode::getActiveConnections
     return {dest};
 }
 
+void RemoteCableCircuitNode::getConnectors(std::vector<Connector> &connectors,
+                                           const TileLocation &location,
+                                           TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+}
+
 void RemoteCableCircuitNode::addCircuit(ElectricCircuit *circuit)
 {
     mStateDirty = false;
@@ -395,6 +403,8 @@ void RemoteCableCircuitNode::setMode(Mode newMode, bool flagsChanged)
     const Mode oldMode = mMode;
     mMode = newMode;
 
+    markConnectionsChanged();
+
     if(mMode == Mode::None || (mMode == Mode::SendCurrentOpen && oldMode != Mode::None))
     {
         if(insideRemoveCircuit)
@@ -515,6 +525,9 @@ void RemoteCableCircuitNode::setMode(Mode newMode, bool flagsChanged)
 void RemoteCableCircuitNode::onPeerModeChanged(Mode peerMode, CircuitPole peerSendPole,
                                                CircuitFlags peerFlags)
 {
+    SimulationProfiler::EventScope profileEvent(SimulationProfiler::EventType::RemoteUpdate);
+    SimulationProfiler::NodeScope profileNode(this);
+
     const CircuitFlags oldFlags = mRecvFlags;
 
     mRecvPole = peerSendPole;
@@ -61,6 +61,10 @@ class RemoteCableCircuitNode : public AbstractCircuitNode
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     void addCircuit(ElectricCircuit *circuit) override;
     void removeCircuit(ElectricCircuit *circuit, const NodeOccurences &items) override;
     void partialRemoveCircuit(ElectricCircuit *circuit, const NodeOccurences &items) override;
@@ -48,6 +48,14 @@ AbstractCircuitNode::ConnectionsRes ResistorNode::getActiveConnections(CableItem
     return {other};
 }
 
+void ResistorNode::getConnectors(std::vector<Connector> &connectors,
+                                 const TileLocation &location,
+                                 TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+    connectors.emplace_back(location, r + TileRotate::Deg180, 1);
+}
+
 QString ResistorNode::nodeType() const
 {
     return NodeType;
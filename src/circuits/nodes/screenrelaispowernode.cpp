@@ -58,6 +58,13 @@ AbstractCircuitNode::ConnectionsRes ScreenRelaisPowerNode::getActiveConnections(
     return {dest};
 }
 
+void ScreenRelaisPowerNode::getConnectors(std::vector<Connector> &connectors,
+                                          const TileLocation &location,
+                                          TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+}
+
 void ScreenRelaisPowerNode::addCircuit(ElectricCircuit *circuit)
 {
     AbstractCircuitNode::addCircuit(circuit);
@@ -36,6 +36,10 @@ class ScreenRelaisPowerNode : public AbstractCircuitNode
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     void addCircuit(ElectricCircuit *circuit) override;
     void removeCircuit(ElectricCircuit *circuit, const NodeOccurences& items) override;
 
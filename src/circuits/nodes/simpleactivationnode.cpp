@@ -55,6 +55,13 @@ AbstractCircuitNode::ConnectionsRes SimpleActivationNode::getActiveConnections(C
     return {dest};
 }
 
+void SimpleActivationNode::getConnectors(std::vector<Connector> &connectors,
+                                         const TileLocation &location,
+                                         TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+}
+
 void SimpleActivationNode::addCircuit(ElectricCircuit *circuit)
 {
     const bool wasActive = hasCircuits();
@@ -69,6 +69,26 @@ AbstractCircuitNode::ConnectionsRes SimpleCircuitNode::getActiveConnections(Cabl
     return result;
 }
 
+void SimpleCircuitNode::getConnectors(std::vector<Connector> &connectors,
+                                      const TileLocation &location,
+                                      TileRotate r) const
+{
+    bool hasDeg90  = disabledContact() != 1;
+    bool hasDeg180 = disabledContact() != 2;
+    bool hasDeg270 = disabledContact() != 3;
+
+    connectors.emplace_back(location, r, 0); // Common
+
+    if(hasDeg90)
+        connectors.emplace_back(location, r + TileRotate::Deg90, 1);
+
+    if(hasDeg180)
+        connectors.emplace_back(location, r + TileRotate::Deg180, 2);
+
+    if(hasDeg270)
+        connectors.emplace_back(location, r + TileRotate::Deg270, 3);
+}
+
 void SimpleCircuitNode::setDisabledContact(int val)
 {
     Q_ASSERT(val >= 0 && val < 4);
@@ -112,6 +112,16 @@ AbstractCircuitNode::ConnectionsRes TraintasticAxleCounterNode::getActiveConnect
     return {};
 }
 
+void TraintasticAxleCounterNode::getConnectors(std::vector<Connector> &connectors,
+                                               const TileLocation &location,
+                                               TileRotate r) const
+{
+    connectors.emplace_back(location, r, Contacts::PowerIn);
+    connectors.emplace_back(location, r - TileRotate::Deg90, Contacts::FreeTrackOut);
+    connectors.emplace_back(location, r + TileRotate::Deg180, Contacts::ResetIn);
+    connectors.emplace_back(location, r + TileRotate::Deg90, Contacts::OccupiedTrackOut);
+}
+
 QString TraintasticAxleCounterNode::nodeType() const
 {
     return NodeType;
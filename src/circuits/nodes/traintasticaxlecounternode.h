@@ -44,6 +44,10 @@ class TraintasticAxleCounterNode : public AbstractCircuitNode
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     static constexpr QLatin1String NodeType = QLatin1String("traintastic_axle_counter_node");
     QString nodeType() const override;
 
@@ -75,6 +75,16 @@ AbstractCircuitNode::ConnectionsRes TraintasticTurnoutNode::getActiveConnections
     return {dest};
 }
 
+void TraintasticTurnoutNode::getConnectors(std::vector<Connector> &connectors,
+                                           const TileLocation &location,
+                                           TileRotate r) const
+{
+    if(!spawn())
+        connectors.emplace_back(location, r, 1);
+
+    connectors.emplace_back(location, r + TileRotate::Deg180, 0);
+}
+
 bool TraintasticTurnoutNode::loadFromJSON(const QJsonObject &obj)
 {
     if(!AbstractCircuitNode::loadFromJSON(obj))
@@ -37,6 +37,10 @@ class TraintasticTurnoutNode : public AbstractCircuitNode
     ~TraintasticTurnoutNode();
 
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir) override;
+
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
     void addCircuit(ElectricCircuit *circuit) override;
     void removeCircuit(ElectricCircuit *circuit, const NodeOccurences &items) override;
 
@@ -26,26 +26,7 @@
 
 #include "../../views/modemanager.h"
 
-#include <QCoreApplication>
-#include <QEvent>
-
-class TransformerNodeEnableEvent : public QEvent
-{
-public:
-    static const QEvent::Type _Type = QEvent::Type(QEvent::User + 3);
-
-    TransformerNodeEnableEvent(bool flagChange_ = false) :
-        QEvent(_Type),
-        mFlagChange(flagChange_)
-    {
-    }
-
-    inline bool isFlagChange() const { return mFlagChange; }
-
-private:
-    bool mFlagChange = false;
-};
-
+#include <QTimerEvent>
 
 TransformerNode::TransformerNode(ModeManager *mgr, QObject *parent)
     : AbstractCircuitNode{mgr, true, parent}
@@ -55,17 +36,16 @@ TransformerNode::TransformerNode(ModeManager *mgr, QObject *parent)
     mContacts.append(NodeContact("3", "4"));
 }
 
-bool TransformerNode::event(QEvent *e)
+void TransformerNode::timerEvent(QTimerEvent *e)
 {
-    if(e->type() == TransformerNodeEnableEvent::_Type)
+    if(e->timerId() == mUpdateTimer.timerId())
     {
-        TransformerNodeEnableEvent *ev = static_cast<TransformerNodeEnableEvent *>(e);
-        ev->accept();
+        mUpdateTimer.stop();
         updateSourceState();
-        return true;
+        return;
     }
 
-    return AbstractCircuitNode::event(e);
+    AbstractCircuitNode::timerEvent(e);
 }
 
 void TransformerNode::addCircuit(ElectricCircuit *circuit)
@@ -160,6 +140,14 @@ AbstractCircuitNode::ConnectionsRes TransformerNode::getActiveConnections(CableI
     return {dest};
 }
 
+void TransformerNode::getConnectors(std::vector<Connector> &connectors,
+                                    const TileLocation &location,
+                                    TileRotate r) const
+{
+    connectors.emplace_back(location, r, 0);
+    connectors.emplace_back(location, r + TileRotate::Deg180, 1);
+}
+
 QString TransformerNode::nodeType() const
 {
     return NodeType;
@@ -204,16 +192,16 @@ void TransformerNode::onCircuitFlagsChanged()
 
 void TransformerNode::scheduleUpdate()
 {
-    if(updateScheduled)
+    if(mUpdateTimer.isActive())
         return;
 
-    updateScheduled = true;
-    QCoreApplication::postEvent(this, new TransformerNodeEnableEvent);
+    // Update on next simulation event
+    mUpdateTimer.start(scheduler(), 0, this);
 }
 
 void TransformerNode::updateSourceState()
 {
-    updateScheduled = false;
+    mUpdateTimer.stop();
 
     const bool shouldEnable = enabled && hasCircuit(0, CircuitType::Closed)
             && modeMgr()->mode() != FileMode::Editing;
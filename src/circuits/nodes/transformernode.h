@@ -24,6 +24,7 @@
 #define TRANSFORMERNODE_H
 
 #include "abstractcircuitnode.h"
+#include "../../utils/simulationscheduler.h"
 
 class TransformerNode : public AbstractCircuitNode
 {
@@ -31,10 +32,12 @@ class TransformerNode : public AbstractCircuitNode
 public:
     explicit TransformerNode(ModeManager *mgr, QObject *parent = nullptr);
 
-    bool event(QEvent *e) override;
-
     ConnectionsRes getActiveConnections(CableItem source, bool invertDir = false) override;
 
+    void getConnectors(std::vector<Connector>& connectors,
+                       const TileLocation& location,
+                       TileRotate r) const override;
+
     void addCircuit(ElectricCircuit *circuit) override;
     void removeCircuit(ElectricCircuit *circuit, const NodeOccurences &items) override;
     void partialRemoveCircuit(ElectricCircuit *circuit,
@@ -50,6 +53,9 @@ class TransformerNode : public AbstractCircuitNode
 
     void onCircuitFlagsChanged() override;
 
+protected:
+    void timerEvent(QTimerEvent *e) override;
+
 private:
     void scheduleUpdate();
     void updateSourceState();
@@ -58,7 +64,9 @@ class TransformerNode : public AbstractCircuitNode
     bool enabled = false;
     bool reallyEnabled = false;
     bool flagsNeedUpdate = false;
-    bool updateScheduled = false;
+
+    // Deferred source state update
+    SimulationTimer mUpdateTimer;
 };
 
 #endif // TRANSFORMERNODE_H
@@ -0,0 +1,246 @@
+/**
+ * src/circuits/simulationprofiler.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "simulationprofiler.h"
+
+#include "nodes/abstractcircuitnode.h"
+
+#include <QCoreApplication>
+
+QVector<SimulationProfiler::NodeCounters> SimulationProfiler::mNodes;
+QVector<int> SimulationProfiler::mFreeIds;
+SimulationProfiler::Counters SimulationProfiler::mEvents[int(EventType::NTypes)];
+
+AbstractCircuitNode *SimulationProfiler::mCurrentNode = nullptr;
+int SimulationProfiler::mCurrentEvent = -1;
+
+QElapsedTimer SimulationProfiler::mClock;
+int SimulationProfiler::mSampleInterval = 1;
+int SimulationProfiler::mSampleCounter = 0;
+bool SimulationProfiler::mEnabled = false;
+
+static constexpr int MaxSampleInterval = 1024;
+
+SimulationProfiler::Counters &SimulationProfiler::Counters::operator+=(const Counters &other)
+{
+    visits += other.visits;
+    circuitsCreated += other.circuitsCreated;
+    circuitsDestroyed += other.circuitsDestroyed;
+    calls += other.calls;
+    samples += other.samples;
+    sampledNs += other.sampledNs;
+    return *this;
+}
+
+SimulationProfiler::NodeScope::NodeScope(AbstractCircuitNode *node)
+{
+    if(!mEnabled)
+        return;
+
+    mNode = node;
+    mPrevNode = mCurrentNode;
+    mCurrentNode = node;
+
+    countersFor(node).calls++;
+    mStartNs = startSample();
+}
+
+SimulationProfiler::NodeScope::~NodeScope()
+{
+    if(!mNode)
+        return;
+
+    mCurrentNode = mPrevNode;
+
+    if(mStartNs < 0 || !mEnabled)
+        return;
+
+    // Look up again, storage might have grown
+    Counters &c = countersFor(mNode);
+    c.samples++;
+    c.sampledNs += mClock.nsecsElapsed() - mStartNs;
+}
+
+SimulationProfiler::EventScope::EventScope(EventType type)
+{
+    if(!mEnabled)
+        return;
+
+    mType = int(type);
+    mPrevType = mCurrentEvent;
+    mCurrentEvent = mType;
+
+    mEvents[mType].calls++;
+    mStartNs = startSample();
+}
+
+SimulationProfiler::EventScope::~EventScope()
+{
+    if(mType < 0)
+        return;
+
+    mCurrentEvent = mPrevType;
+
+    if(mStartNs < 0 || !mEnabled)
+        return;
+
+    Counters &c = mEvents[mType];
+    c.samples++;
+    c.sampledNs += mClock.nsecsElapsed() - mStartNs;
+}
+
+void SimulationProfiler::setEnabled(bool val)
+{
+    if(val && !mClock.isValid())
+        mClock.start();
+
+    mEnabled = val;
+}
+
+void SimulationProfiler::setSampleInterval(int interval)
+{
+    mSampleInterval = qBound(1, interval, MaxSampleInterval);
+    mSampleCounter = 0;
+}
+
+void SimulationProfiler::removeNode(AbstractCircuitNode *node)
+{
+    if(node->mProfileId < 0)
+        return;
+
+    mNodes[node->mProfileId] = NodeCounters();
+    mFreeIds.append(node->mProfileId);
+    node->mProfileId = -1;
+
+    if(mCurrentNode == node)
+        mCurrentNode = nullptr;
+
+    if(mFreeIds.size() == mNodes.size())
+    {
+        mNodes.clear();
+        mNodes.squeeze();
+        mFreeIds.clear();
+        mFreeIds.squeeze();
+    }
+}
+
+void SimulationProfiler::reset()
+{
+    // Keep node ids, they are still referenced by nodes
+    for(NodeCounters &entry : mNodes)
+        entry.counters = Counters();
+
+    for(Counters &c : mEvents)
+        c = Counters();
+
+    mSampleCounter = 0;
+}
+
+QVector<SimulationProfiler::NodeCounters> SimulationProfiler::nodeCounters()
+{
+    QVector<NodeCounters> result;
+    result.reserve(mNodes.size() - mFreeIds.size());
+
+    for(const NodeCounters &entry : std::as_const(mNodes))
+    {
+        if(entry.node)
+            result.append(entry);
+    }
+
+    return result;
+}
+
+QString SimulationProfiler::eventTypeName(EventType type)
+{
+    switch (type)
+    {
+    case EventType::RelayMove:
+        return QCoreApplication::translate("SimulationProfiler", "Relay move");
+    case EventType::LeverMove:
+        return QCoreApplication::translate("SimulationProfiler", "Lever move");
+    case EventType::RemoteUpdate:
+        return QCoreApplication::translate("SimulationProfiler", "Remote update");
+    default:
+        break;
+    }
+
+    return QString();
+}
+
+SimulationProfiler::Counters &SimulationProfiler::countersFor(AbstractCircuitNode *node)
+{
+    if(node->mProfileId < 0)
+    {
+        if(!mFreeIds.isEmpty())
+        {
+            node->mProfileId = mFreeIds.takeLast();
+        }
+        else
+        {
+            node->mProfileId = mNodes.size();
+            mNodes.append(NodeCounters());
+        }
+
+        mNodes[node->mProfileId].node = node;
+    }
+
+    return mNodes[node->mProfileId].counters;
+}
+
+void SimulationProfiler::addVisit(AbstractCircuitNode *node)
+{
+    countersFor(node).visits++;
+
+    if(mCurrentEvent >= 0)
+        mEvents[mCurrentEvent].visits++;
+}
+
+void SimulationProfiler::addCircuitChange(bool created)
+{
+    if(mCurrentNode)
+    {
+        Counters &c = countersFor(mCurrentNode);
+        if(created)
+            c.circuitsCreated++;
+        else
+            c.circuitsDestroyed++;
+    }
+
+    if(mCurrentEvent >= 0)
+    {
+        Counters &c = mEvents[mCurrentEvent];
+        if(created)
+            c.circuitsCreated++;
+        else
+            c.circuitsDestroyed++;
+    }
+}
+
+qint64 SimulationProfiler::startSample()
+{
+    if(++mSampleCounter < mSampleInterval)
+        return -1;
+
+    mSampleCounter = 0;
+    return mClock.nsecsElapsed();
+}
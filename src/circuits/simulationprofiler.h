@@ -0,0 +1,167 @@
+/**
+ * src/circuits/simulationprofiler.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef SIMULATIONPROFILER_H
+#define SIMULATIONPROFILER_H
+
+#include <QVector>
+#include <QElapsedTimer>
+
+class AbstractCircuitNode;
+
+/*!
+ * \brief The SimulationProfiler class
+ *
+ * Instrumentation of circuit engine.
+ * Counts node visits during path search and circuits created and destroyed.
+ * Circuits are attributed to the node whose change caused them,
+ * that is the innermost NodeScope, and to the current EventScope.
+ *
+ * Scopes also measure inclusive time. To keep cost low only one scope
+ * every sampleInterval() is timed, total time is then estimated.
+ * When disabled each instrumentation point only checks a flag.
+ */
+class SimulationProfiler
+{
+public:
+    enum class EventType
+    {
+        RelayMove = 0,
+        LeverMove,
+        RemoteUpdate,
+        NTypes
+    };
+
+    struct Counters
+    {
+        qint64 visits = 0;
+        qint64 circuitsCreated = 0;
+        qint64 circuitsDestroyed = 0;
+        qint64 calls = 0;
+        qint64 samples = 0;
+        qint64 sampledNs = 0;
+
+        inline qint64 estimatedNs() const
+        {
+            if(samples == 0)
+                return 0;
+            return sampledNs * calls / samples;
+        }
+
+        Counters& operator+=(const Counters& other);
+    };
+
+    struct NodeCounters
+    {
+        AbstractCircuitNode *node = nullptr;
+        Counters counters;
+    };
+
+    class NodeScope
+    {
+    public:
+        NodeScope(AbstractCircuitNode *node);
+        ~NodeScope();
+
+        Q_DISABLE_COPY_MOVE(NodeScope)
+
+    private:
+        AbstractCircuitNode *mNode = nullptr;
+        AbstractCircuitNode *mPrevNode = nullptr;
+        qint64 mStartNs = -1;
+    };
+
+    class EventScope
+    {
+    public:
+        EventScope(EventType type);
+        ~EventScope();
+
+        Q_DISABLE_COPY_MOVE(EventScope)
+
+    private:
+        int mType = -1;
+        int mPrevType = -1;
+        qint64 mStartNs = -1;
+    };
+
+    static inline bool isEnabled() { return mEnabled; }
+    static void setEnabled(bool val);
+
+    // 1 means every scope is timed
+    static inline int sampleInterval() { return mSampleInterval; }
+    static void setSampleInterval(int interval);
+
+    static inline void nodeVisited(AbstractCircuitNode *node)
+    {
+        if(mEnabled)
+            addVisit(node);
+    }
+
+    static inline void circuitCreated()
+    {
+        if(mEnabled)
+            addCircuitChange(true);
+    }
+
+    static inline void circuitDestroyed()
+    {
+        if(mEnabled)
+            addCircuitChange(false);
+    }
+
+    static void removeNode(AbstractCircuitNode *node);
+
+    static void reset();
+
+    // Only nodes which were instrumented
+    static QVector<NodeCounters> nodeCounters();
+
+    static inline const Counters& eventCounters(EventType type)
+    {
+        return mEvents[int(type)];
+    }
+
+    static QString eventTypeName(EventType type);
+
+private:
+    static Counters& countersFor(AbstractCircuitNode *node);
+    static void addVisit(AbstractCircuitNode *node);
+    static void addCircuitChange(bool created);
+    static qint64 startSample();
+
+private:
+    static QVector<NodeCounters> mNodes;
+    static QVector<int> mFreeIds;
+    static Counters mEvents[int(EventType::NTypes)];
+
+    static AbstractCircuitNode *mCurrentNode;
+    static int mCurrentEvent;
+
+    static QElapsedTimer mClock;
+    static int mSampleInterval;
+    static int mSampleCounter;
+    static bool mEnabled;
+};
+
+#endif // SIMULATIONPROFILER_H
@@ -23,6 +23,7 @@
 #include "circuitlistmodel.h"
 
 #include "../circuitscene.h"
+#include "../circuitislands.h"
 
 #include "../../views/modemanager.h"
 
@@ -243,7 +244,7 @@ bool CircuitListModel::loadFromJSON(const QJsonObject &obj)
     for(const QJsonValue& v : arr)
     {
         CircuitScene *scene = new CircuitScene(this);
-        if(!scene->loadFromJSON(v.toObject(), modeMgr()->circuitFactory()))
+        if(!scene->loadFromJSON(v.toObject()))
         {
             delete scene;
             continue;
@@ -281,13 +282,12 @@ void CircuitListModel::saveToJSON(QJsonObject &obj) const
     obj["scenes"] = arr;
 }
 
-AbstractNodeGraphItem *CircuitListModel::getGraphForNode(AbstractCircuitNode *node) const
+CircuitScene *CircuitListModel::sceneForNode(AbstractCircuitNode *node) const
 {
     for(CircuitScene *scene : std::as_const(mCircuitScenes))
     {
-        AbstractNodeGraphItem *item = scene->getGraphForNode(node);
-        if(item)
-            return item;
+        if(scene->containsNode(node))
+            return scene;
     }
 
     return nullptr;
@@ -317,6 +317,18 @@ void CircuitListModel::setMode(FileMode newMode, FileMode oldMode)
     {
         scene->setMode(newMode, oldMode);
     }
+
+    if(newMode == FileMode::Simulation)
+    {
+        // Islands of all scenes are prepared together
+        CircuitIslands::NodeList sources;
+        for(CircuitScene *scene : std::as_const(mCircuitScenes))
+        {
+            sources.append(scene->powerSources());
+        }
+
+        CircuitIslands::setSourcesEnabled(sources, true);
+    }
 }
 
 void CircuitListModel::setEditingSubMode(EditingSubMode oldMode, EditingSubMode newMode)
@@ -340,4 +352,6 @@ void CircuitListModel::clearInternal()
 {
     qDeleteAll(mCircuitScenes);
     mCircuitScenes.clear();
+
+    CircuitIslands::clearCache();
 }
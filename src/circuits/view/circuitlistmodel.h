@@ -97,7 +97,7 @@ class CircuitListModel : public QAbstractTableModel
     bool loadFromJSON(const QJsonObject &obj);
     void saveToJSON(QJsonObject &obj) const;
 
-    AbstractNodeGraphItem *getGraphForNode(AbstractCircuitNode *node) const;
+    CircuitScene *sceneForNode(AbstractCircuitNode *node) const;
 
     void updateCodeStatus();
 
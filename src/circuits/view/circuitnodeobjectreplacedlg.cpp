@@ -28,6 +28,7 @@
 #include "../nodes/abstractcircuitnode.h"
 
 #include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
 #include "../../views/viewmanager.h"
 
 #include "../edit/nodeeditfactory.h"
@@ -64,18 +65,18 @@ void CircuitNodeTraits::saveToJSON(Node *node, QJsonObject &obj)
 
 void CircuitNodeTraits::editItem(Node *node, ViewManager *viewMgr, QWidget *parent)
 {
-    auto editFactory = viewMgr->modeMgr()->circuitFactory();
+    auto editFactory = GuiModeFrontend::get(viewMgr->modeMgr())->circuitFactory();
     editFactory->editItem(parent, node, viewMgr, false);
 }
 
 QStringList CircuitNodeTraits::getRegisteredTypes(ModeManager *modeMgr)
 {
-    auto editFactory = modeMgr->circuitFactory();
+    auto editFactory = GuiModeFrontend::get(modeMgr)->circuitFactory();
     return editFactory->getRegisteredTypes();
 }
 
 QString CircuitNodeTraits::prettyTypeName(ModeManager *modeMgr, const QString &typeName)
 {
-    auto editFactory = modeMgr->circuitFactory();
+    auto editFactory = GuiModeFrontend::get(modeMgr)->circuitFactory();
     return editFactory->prettyName(typeName);
 }
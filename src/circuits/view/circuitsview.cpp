@@ -33,6 +33,7 @@
 #include "../../utils/itemobjectreplacedlg_impl.hpp"
 
 #include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
 
 #include <QKeyEvent>
 
@@ -196,13 +197,13 @@ void CircuitsView::keyPressEvent(QKeyEvent *ev)
             {
                 // It's a letter
                 const QChar letter = ev->text().at(0);
-                const QString nodeType = circuitScene()->modeMgr()->circuitFactory()->typeForShortcutLetter(letter);
+                const QString nodeType = GuiModeFrontend::get(circuitScene()->modeMgr())->circuitFactory()->typeForShortcutLetter(letter);
 
                 if(!nodeType.isEmpty())
                 {
                     // Add node to cursor pos
                     const TileLocation tileHint = TileLocation::fromPointFloor(getTargetScenePos());
-                    addNodeAtLocation(circuitScene()->modeMgr()->circuitFactory(),
+                    addNodeAtLocation(GuiModeFrontend::get(circuitScene()->modeMgr())->circuitFactory(),
                                       nodeType,
                                       tileHint);
                     return;
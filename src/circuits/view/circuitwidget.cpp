@@ -87,7 +87,8 @@ CircuitWidget::CircuitWidget(ViewManager *mgr, QWidget *parent)
 
 CircuitWidget::~CircuitWidget()
 {
-
+    if(mScene && mSceneShown)
+        mScene->setShownInView(false);
 }
 
 CircuitScene *CircuitWidget::scene() const
@@ -102,6 +103,10 @@ void CircuitWidget::setScene(CircuitScene *newScene, bool updateName)
 
     if(mScene)
     {
+        if(mSceneShown)
+            mScene->setShownInView(false);
+        mSceneShown = false;
+
         disconnect(mScene, &CircuitScene::nameChanged,
                    this, &CircuitWidget::onSceneNameChanged);
         disconnect(mScene, &CircuitScene::destroyed,
@@ -119,6 +124,8 @@ void CircuitWidget::setScene(CircuitScene *newScene, bool updateName)
                 this, &CircuitWidget::onSceneDestroyed);
     }
 
+    updateSceneShown();
+
     setUniqueNum(mCircuitView->viewMgr()->getUniqueNum(mScene, this));
 
     if(updateName)
@@ -156,6 +163,8 @@ void CircuitWidget::onSceneNameChanged()
 
 void CircuitWidget::onSceneDestroyed()
 {
+    // Scene is already partially destroyed
+    mSceneShown = false;
     setScene(nullptr);
 }
 
@@ -206,6 +215,18 @@ void CircuitWidget::keyPressEvent(QKeyEvent *ev)
     QWidget::keyPressEvent(ev);
 }
 
+void CircuitWidget::showEvent(QShowEvent *ev)
+{
+    QWidget::showEvent(ev);
+    updateSceneShown();
+}
+
+void CircuitWidget::hideEvent(QHideEvent *ev)
+{
+    QWidget::hideEvent(ev);
+    updateSceneShown();
+}
+
 void CircuitWidget::addNodeToCenter(NodeEditFactory *editFactory,
                                     const QString &nodeType)
 {
@@ -221,6 +242,16 @@ void CircuitWidget::toggleStatusBar()
     setStatusBarVisible(!isStatusBarVisible());
 }
 
+void CircuitWidget::updateSceneShown()
+{
+    const bool shown = mScene && isVisible();
+    if(mSceneShown == shown)
+        return;
+
+    mSceneShown = shown;
+    mScene->setShownInView(mSceneShown);
+}
+
 int CircuitWidget::uniqueNum() const
 {
     return mUniqueNum;
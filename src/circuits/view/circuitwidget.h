@@ -66,6 +66,8 @@ private slots:
     bool eventFilter(QObject *watched, QEvent *e) override;
     void focusInEvent(QFocusEvent *ev) override;
     void keyPressEvent(QKeyEvent *ev) override;
+    void showEvent(QShowEvent *ev) override;
+    void hideEvent(QHideEvent *ev) override;
 
 private:
     friend class ViewManager;
@@ -75,8 +77,12 @@ private slots:
 
     void toggleStatusBar();
 
+    // Tell scene when it becomes visible or hidden
+    void updateSceneShown();
+
 private:
     CircuitScene *mScene = nullptr;
+    bool mSceneShown = false;
 
     CircuitsView *mCircuitView = nullptr;
     DoubleClickSlider *mZoomSlider = nullptr;
@@ -0,0 +1,315 @@
+/**
+ * src/circuits/view/simulationprofilermodel.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "simulationprofilermodel.h"
+
+#include "circuitlistmodel.h"
+#include "../circuitscene.h"
+#include "../graphs/abstractnodegraphitem.h"
+#include "../nodes/abstractcircuitnode.h"
+
+#include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
+
+#include <QHash>
+#include <QTextStream>
+
+SimulationProfilerModel::SimulationProfilerModel(ModeManager *mgr, QObject *parent)
+    : QAbstractTableModel(parent)
+    , mModeMgr(mgr)
+{
+
+}
+
+QVariant SimulationProfilerModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(orientation == Qt::Horizontal && role == Qt::DisplayRole)
+    {
+        switch (section)
+        {
+        case NameCol:
+            return tr("Name");
+        case SceneCol:
+            return tr("Circuit");
+        case VisitsCol:
+            return tr("Visits");
+        case CircuitsCreatedCol:
+            return tr("Circuits Created");
+        case CircuitsDestroyedCol:
+            return tr("Circuits Destroyed");
+        case CallsCol:
+            return tr("Calls");
+        case SamplesCol:
+            return tr("Samples");
+        case TimeCol:
+            return tr("Time (ms)");
+        default:
+            break;
+        }
+    }
+    else if(orientation == Qt::Horizontal && role == Qt::ToolTipRole)
+    {
+        switch (section)
+        {
+        case CallsCol:
+            return tr("Number of changes started by this item");
+        case SamplesCol:
+            return tr("Number of timed calls");
+        case TimeCol:
+            return tr("Estimated total time, including nested changes");
+        default:
+            break;
+        }
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+int SimulationProfilerModel::rowCount(const QModelIndex &p) const
+{
+    return p.isValid() ? 0 : mRows.size();
+}
+
+int SimulationProfilerModel::columnCount(const QModelIndex &p) const
+{
+    return p.isValid() ? 0 : NCols;
+}
+
+QVariant SimulationProfilerModel::data(const QModelIndex &idx, int role) const
+{
+    if (!idx.isValid() || idx.row() >= mRows.size())
+        return QVariant();
+
+    const Row& row = mRows.at(idx.row());
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+    {
+        if(idx.column() == TimeCol)
+            return QString::number(double(row.counters.estimatedNs()) / 1e6, 'f', 3);
+        return rowValue(row, idx.column());
+    }
+    case SortRole:
+        return rowValue(row, idx.column());
+    case Qt::TextAlignmentRole:
+    {
+        if(idx.column() >= VisitsCol)
+            return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+        break;
+    }
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+void SimulationProfilerModel::setGrouping(Grouping g)
+{
+    if(mGrouping == g)
+        return;
+
+    mGrouping = g;
+    refresh();
+}
+
+bool SimulationProfilerModel::getNodeLocation(int row, QString &sceneName, TileLocation &location) const
+{
+    if(mGrouping != Grouping::Nodes || row < 0 || row >= mRows.size())
+        return false;
+
+    const Row& r = mRows.at(row);
+    if(r.sceneName.isEmpty() || !r.location.isValid())
+        return false;
+
+    sceneName = r.sceneName;
+    location = r.location;
+    return true;
+}
+
+bool SimulationProfilerModel::exportCSV(QIODevice *dev) const
+{
+    QTextStream stream(dev);
+
+    for(int col = 0; col < NCols; col++)
+    {
+        if(col > 0)
+            stream << ',';
+        stream << headerData(col, Qt::Horizontal, Qt::DisplayRole).toString();
+    }
+    stream << '\n';
+
+    auto escaped = [](QString str) -> QString
+    {
+        if(!str.contains(',') && !str.contains('"') && !str.contains('\n'))
+            return str;
+
+        str.replace('"', QLatin1String("\"\""));
+        return QLatin1Char('"') + str + QLatin1Char('"');
+    };
+
+    for(const Row& row : mRows)
+    {
+        stream << escaped(row.name) << ','
+               << escaped(row.sceneName) << ','
+               << row.counters.visits << ','
+               << row.counters.circuitsCreated << ','
+               << row.counters.circuitsDestroyed << ','
+               << row.counters.calls << ','
+               << row.counters.samples << ','
+               << QString::number(double(row.counters.estimatedNs()) / 1e6, 'f', 3) << '\n';
+    }
+
+    stream.flush();
+    return stream.status() == QTextStream::Ok;
+}
+
+void SimulationProfilerModel::refresh()
+{
+    beginResetModel();
+
+    mRows.clear();
+
+    switch (mGrouping)
+    {
+    case Grouping::Nodes:
+        buildNodeRows(false);
+        break;
+    case Grouping::Scenes:
+        buildNodeRows(true);
+        break;
+    case Grouping::Events:
+        buildEventRows();
+        break;
+    }
+
+    endResetModel();
+}
+
+void SimulationProfilerModel::buildNodeRows(bool groupByScene)
+{
+    // Find scenes of profiled nodes
+    struct NodeInfo
+    {
+        CircuitScene *scene = nullptr;
+        TileLocation location = TileLocation::invalid;
+    };
+
+    QHash<AbstractCircuitNode *, NodeInfo> nodeInfo;
+
+    const auto scenes = GuiModeFrontend::get(mModeMgr)->circuitList()->getScenes();
+    for(CircuitScene *scene : scenes)
+    {
+        for(const auto& it : scene->nodeMap())
+            nodeInfo.insert(it.second, {scene, it.first});
+    }
+
+    QHash<CircuitScene *, int> sceneRows;
+
+    const auto counters = SimulationProfiler::nodeCounters();
+    for(const SimulationProfiler::NodeCounters& entry : counters)
+    {
+        const NodeInfo info = nodeInfo.value(entry.node);
+
+        if(groupByScene)
+        {
+            auto it = sceneRows.constFind(info.scene);
+            if(it == sceneRows.constEnd())
+            {
+                Row row;
+                row.name = info.scene ? info.scene->circuitSheetName() : tr("Other");
+                it = sceneRows.insert(info.scene, mRows.size());
+                mRows.append(row);
+            }
+
+            mRows[it.value()].counters += entry.counters;
+            continue;
+        }
+
+        Row row;
+        row.counters = entry.counters;
+
+        if(info.scene)
+        {
+            // Graph items exist only if scene was recently shown
+            AbstractNodeGraphItem *item = info.scene->getGraphForNode(entry.node);
+            if(item)
+                row.name = item->displayString();
+
+            row.sceneName = info.scene->circuitSheetName();
+            row.location = info.location;
+        }
+
+        if(row.name.isEmpty())
+            row.name = entry.node->nodeType();
+
+        if(row.location.isValid())
+        {
+            row.name = tr("%1 (%2, %3)").arg(row.name)
+                    .arg(row.location.x).arg(row.location.y);
+        }
+
+        mRows.append(row);
+    }
+}
+
+void SimulationProfilerModel::buildEventRows()
+{
+    for(int i = 0; i < int(SimulationProfiler::EventType::NTypes); i++)
+    {
+        const auto type = SimulationProfiler::EventType(i);
+
+        Row row;
+        row.name = SimulationProfiler::eventTypeName(type);
+        row.counters = SimulationProfiler::eventCounters(type);
+        mRows.append(row);
+    }
+}
+
+QVariant SimulationProfilerModel::rowValue(const Row &row, int col) const
+{
+    switch (col)
+    {
+    case NameCol:
+        return row.name;
+    case SceneCol:
+        return row.sceneName;
+    case VisitsCol:
+        return row.counters.visits;
+    case CircuitsCreatedCol:
+        return row.counters.circuitsCreated;
+    case CircuitsDestroyedCol:
+        return row.counters.circuitsDestroyed;
+    case CallsCol:
+        return row.counters.calls;
+    case SamplesCol:
+        return row.counters.samples;
+    case TimeCol:
+        return row.counters.estimatedNs();
+    default:
+        break;
+    }
+
+    return QVariant();
+}
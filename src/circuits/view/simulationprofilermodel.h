@@ -0,0 +1,107 @@
+/**
+ * src/circuits/view/simulationprofilermodel.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef SIMULATIONPROFILERMODEL_H
+#define SIMULATIONPROFILERMODEL_H
+
+#include <QAbstractTableModel>
+
+#include "../simulationprofiler.h"
+#include "../../utils/tilerotate.h"
+
+class ModeManager;
+
+class QIODevice;
+
+class SimulationProfilerModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Columns
+    {
+        NameCol = 0,
+        SceneCol,
+        VisitsCol,
+        CircuitsCreatedCol,
+        CircuitsDestroyedCol,
+        CallsCol,
+        SamplesCol,
+        TimeCol,
+        NCols
+    };
+
+    enum class Grouping
+    {
+        Nodes = 0,
+        Scenes,
+        Events
+    };
+
+    // Raw value for sorting
+    static constexpr int SortRole = Qt::UserRole;
+
+    explicit SimulationProfilerModel(ModeManager *mgr, QObject *parent = nullptr);
+
+    // Header:
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Basic functionality:
+    int rowCount(const QModelIndex &p = QModelIndex()) const override;
+    int columnCount(const QModelIndex &p = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex &idx, int role = Qt::DisplayRole) const override;
+
+    inline Grouping grouping() const { return mGrouping; }
+    void setGrouping(Grouping g);
+
+    // Scene and location of node rows, to show them in circuit view
+    bool getNodeLocation(int row, QString &sceneName, TileLocation &location) const;
+
+    bool exportCSV(QIODevice *dev) const;
+
+public slots:
+    void refresh();
+
+private:
+    struct Row
+    {
+        QString name;
+        QString sceneName;
+        TileLocation location = TileLocation::invalid;
+        SimulationProfiler::Counters counters;
+    };
+
+    void buildNodeRows(bool groupByScene);
+    void buildEventRows();
+
+    QVariant rowValue(const Row& row, int col) const;
+
+private:
+    ModeManager *mModeMgr;
+
+    QVector<Row> mRows;
+    Grouping mGrouping = Grouping::Nodes;
+};
+
+#endif // SIMULATIONPROFILERMODEL_H
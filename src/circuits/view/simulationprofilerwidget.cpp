@@ -0,0 +1,203 @@
+/**
+ * src/circuits/view/simulationprofilerwidget.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "simulationprofilerwidget.h"
+
+#include "simulationprofilermodel.h"
+#include "circuitlistmodel.h"
+
+#include "../circuitscene.h"
+#include "../simulationprofiler.h"
+
+#include "../../views/viewmanager.h"
+#include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
+
+#include <QTableView>
+#include <QHeaderView>
+#include <QSortFilterProxyModel>
+
+#include <QCheckBox>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QPushButton>
+
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QFile>
+
+#include <QBoxLayout>
+
+#include <QTimerEvent>
+
+// Profiler counters are not signaled, poll them
+static constexpr int RefreshIntervalMillis = 1000;
+
+SimulationProfilerWidget::SimulationProfilerWidget(ViewManager *viewMgr, QWidget *parent)
+    : QWidget{parent}
+    , mViewMgr(viewMgr)
+{
+    QVBoxLayout *lay = new QVBoxLayout(this);
+
+    QHBoxLayout *butLay = new QHBoxLayout;
+    lay->addLayout(butLay);
+
+    mEnabledCheck = new QCheckBox(tr("Enabled"));
+    mEnabledCheck->setChecked(SimulationProfiler::isEnabled());
+    butLay->addWidget(mEnabledCheck);
+
+    mSampleSpin = new QSpinBox;
+    mSampleSpin->setRange(1, 1024);
+    mSampleSpin->setValue(SimulationProfiler::sampleInterval());
+    mSampleSpin->setPrefix(tr("Time 1 every "));
+    mSampleSpin->setToolTip(tr("Timing only some changes reduces profiler overhead.\n"
+                               "Total time is estimated from timed changes."));
+    butLay->addWidget(mSampleSpin);
+
+    mGroupingCombo = new QComboBox;
+    mGroupingCombo->addItem(tr("Nodes"));
+    mGroupingCombo->addItem(tr("Circuits"));
+    mGroupingCombo->addItem(tr("Events"));
+    butLay->addWidget(mGroupingCombo);
+
+    butLay->addStretch();
+
+    resetBut = new QPushButton(tr("Reset"));
+    butLay->addWidget(resetBut);
+
+    exportBut = new QPushButton(tr("Export CSV"));
+    butLay->addWidget(exportBut);
+
+    mModel = new SimulationProfilerModel(mViewMgr->modeMgr(), this);
+
+    mProxyModel = new QSortFilterProxyModel(this);
+    mProxyModel->setSourceModel(mModel);
+    mProxyModel->setSortRole(SimulationProfilerModel::SortRole);
+
+    mView = new QTableView;
+    mView->setModel(mProxyModel);
+    mView->setSortingEnabled(true);
+    mView->sortByColumn(SimulationProfilerModel::TimeCol, Qt::DescendingOrder);
+    mView->setEditTriggers(QTableView::NoEditTriggers);
+    mView->setSelectionBehavior(QTableView::SelectRows);
+    lay->addWidget(mView);
+
+    connect(mEnabledCheck, &QCheckBox::toggled,
+            this, &SimulationProfilerWidget::setProfilerEnabled);
+    connect(mSampleSpin, &QSpinBox::valueChanged,
+            this, [](int val)
+    {
+        SimulationProfiler::setSampleInterval(val);
+    });
+    connect(mGroupingCombo, &QComboBox::currentIndexChanged,
+            this, &SimulationProfilerWidget::onGroupingChanged);
+    connect(resetBut, &QPushButton::clicked,
+            this, &SimulationProfilerWidget::resetCounters);
+    connect(exportBut, &QPushButton::clicked,
+            this, &SimulationProfilerWidget::exportCSV);
+    connect(mView, &QTableView::doubleClicked,
+            this, &SimulationProfilerWidget::onRowDoubleClicked);
+
+    mModel->refresh();
+    mView->resizeColumnsToContents();
+
+    if(SimulationProfiler::isEnabled())
+        mRefreshTimer.start(RefreshIntervalMillis, this);
+}
+
+void SimulationProfilerWidget::timerEvent(QTimerEvent *e)
+{
+    if(e->timerId() == mRefreshTimer.timerId())
+    {
+        mModel->refresh();
+        return;
+    }
+
+    QWidget::timerEvent(e);
+}
+
+void SimulationProfilerWidget::setProfilerEnabled(bool val)
+{
+    SimulationProfiler::setEnabled(val);
+
+    if(val)
+    {
+        mRefreshTimer.start(RefreshIntervalMillis, this);
+    }
+    else
+    {
+        mRefreshTimer.stop();
+
+        // Show last values
+        mModel->refresh();
+    }
+}
+
+void SimulationProfilerWidget::onGroupingChanged(int idx)
+{
+    mModel->setGrouping(SimulationProfilerModel::Grouping(idx));
+    mView->resizeColumnsToContents();
+}
+
+void SimulationProfilerWidget::resetCounters()
+{
+    SimulationProfiler::reset();
+    mModel->refresh();
+}
+
+void SimulationProfilerWidget::exportCSV()
+{
+    // Export what is currently shown
+    mModel->refresh();
+
+    const QString fileName = QFileDialog::getSaveFileName(this,
+                                                          tr("Export Profiler Data"),
+                                                          QLatin1String("profiler.csv"),
+                                                          tr("CSV Files (*.csv)"));
+    if(fileName.isEmpty())
+        return;
+
+    QFile f(fileName);
+    if(!f.open(QFile::WriteOnly | QFile::Truncate | QFile::Text) || !mModel->exportCSV(&f))
+    {
+        QMessageBox::warning(this, tr("Export Error"),
+                             tr("Could not write <b>%1</b>:<br>%2")
+                             .arg(fileName.toHtmlEscaped(), f.errorString().toHtmlEscaped()));
+    }
+}
+
+void SimulationProfilerWidget::onRowDoubleClicked(const QModelIndex &idx)
+{
+    const QModelIndex sourceIdx = mProxyModel->mapToSource(idx);
+
+    QString sceneName;
+    TileLocation location = TileLocation::invalid;
+    if(!mModel->getNodeLocation(sourceIdx.row(), sceneName, location))
+        return;
+
+    CircuitScene *scene = GuiModeFrontend::get(mViewMgr->modeMgr())->circuitList()->sceneByName(sceneName);
+    if(!scene)
+        return;
+
+    mViewMgr->ensureCircuitNodeIsVisible(scene, scene->nodeAt(location), false, true);
+}
@@ -0,0 +1,73 @@
+/**
+ * src/circuits/view/simulationprofilerwidget.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef SIMULATIONPROFILERWIDGET_H
+#define SIMULATIONPROFILERWIDGET_H
+
+#include <QWidget>
+#include <QBasicTimer>
+
+class QCheckBox;
+class QSpinBox;
+class QComboBox;
+class QPushButton;
+class QTableView;
+class QSortFilterProxyModel;
+
+class ViewManager;
+class SimulationProfilerModel;
+
+class SimulationProfilerWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit SimulationProfilerWidget(ViewManager *viewMgr,
+                                      QWidget *parent = nullptr);
+
+protected:
+    void timerEvent(QTimerEvent *e) override;
+
+private slots:
+    void setProfilerEnabled(bool val);
+    void onGroupingChanged(int idx);
+    void resetCounters();
+    void exportCSV();
+    void onRowDoubleClicked(const QModelIndex &idx);
+
+private:
+    ViewManager *mViewMgr;
+
+    QCheckBox *mEnabledCheck;
+    QSpinBox *mSampleSpin;
+    QComboBox *mGroupingCombo;
+    QPushButton *resetBut;
+    QPushButton *exportBut;
+
+    QTableView *mView;
+    QSortFilterProxyModel *mProxyModel;
+    SimulationProfilerModel *mModel;
+
+    QBasicTimer mRefreshTimer;
+};
+
+#endif // SIMULATIONPROFILERWIDGET_H
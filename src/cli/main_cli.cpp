@@ -0,0 +1,247 @@
+/**
+ * src/cli/main_cli.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <QTextStream>
+#include <QEventLoop>
+#include <QElapsedTimer>
+
+#include "info.h"
+
+#include "../views/modemanager.h"
+#include "../objects/simulationrecorder.h"
+
+#include "../utils/projectfile.h"
+#include "../utils/phasereport.h"
+
+#include "simulationscriptrunner.h"
+
+static bool readJsonFile(const QString& fileName, QJsonObject& result)
+{
+    QFile f(fileName);
+    if(!f.open(QFile::ReadOnly))
+        return false;
+
+    QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
+    if(doc.isNull())
+        return false;
+
+    result = doc.object();
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setOrganizationName(AppCompany);
+    QCoreApplication::setApplicationName(AppProduct);
+    QCoreApplication::setApplicationVersion(AppVersion);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QLatin1String("Headless simulation runner"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument(QLatin1String("file"),
+                                 QLatin1String("Project file to load."));
+
+    QCommandLineOption scriptOption({QLatin1String("s"), QLatin1String("script")},
+                                    QLatin1String("JSON script of actions to apply."),
+                                    QLatin1String("script"));
+    parser.addOption(scriptOption);
+
+    QCommandLineOption outputOption({QLatin1String("o"), QLatin1String("output")},
+                                    QLatin1String("Write final state to file instead of standard output."),
+                                    QLatin1String("output"));
+    parser.addOption(outputOption);
+
+    QCommandLineOption fastForwardOption({QLatin1String("f"), QLatin1String("fast-forward")},
+                                         QLatin1String("Advance simulation clock on wait actions without sleeping."));
+    parser.addOption(fastForwardOption);
+
+    QCommandLineOption seedOption(QLatin1String("seed"),
+                                  QLatin1String("Seed of random relay timings, for reproducible runs."),
+                                  QLatin1String("seed"));
+    parser.addOption(seedOption);
+
+    QCommandLineOption replayOption(QLatin1String("replay"),
+                                    QLatin1String("Replay recorded inputs after script."),
+                                    QLatin1String("recording"));
+    parser.addOption(replayOption);
+
+    QCommandLineOption convertOption(QLatin1String("convert"),
+                                     QLatin1String("Convert project to JSON or binary format, chosen by output extension, then exit."),
+                                     QLatin1String("output"));
+    parser.addOption(convertOption);
+
+    QCommandLineOption loadReportOption(QLatin1String("load-report"),
+                                        QLatin1String("Print time, object count and peak memory of each load phase to standard error."));
+    parser.addOption(loadReportOption);
+
+    parser.process(app);
+
+    QTextStream err(stderr);
+
+    const QStringList args = parser.positionalArguments();
+    if(args.size() != 1)
+    {
+        parser.showHelp(1);
+    }
+
+    if(parser.isSet(convertOption))
+    {
+        // No need to load objects
+        if(!ProjectFile::convert(args.first(), parser.value(convertOption)))
+        {
+            err << "Cannot convert project file: " << args.first() << Qt::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    QElapsedTimer readTimer;
+    readTimer.start();
+
+    QJsonObject projectObj;
+    if(!ProjectFile::read(args.first(), projectObj))
+    {
+        err << "Cannot read project file: " << args.first() << Qt::endl;
+        return 1;
+    }
+
+    const qint64 readNs = readTimer.nsecsElapsed();
+
+    ModeManager modeMgr;
+    modeMgr.setFilePath(args.first(), true);
+
+    if(parser.isSet(seedOption))
+    {
+        bool ok = false;
+        const quint32 seed = parser.value(seedOption).toUInt(&ok);
+        if(!ok)
+        {
+            err << "Invalid seed: " << parser.value(seedOption) << Qt::endl;
+            return 1;
+        }
+
+        modeMgr.scheduler()->setRandomSeed(seed);
+    }
+
+    // Pause clock before loading so that no timer runs on wall clock
+    if(parser.isSet(fastForwardOption))
+        modeMgr.scheduler()->setPaused(true);
+
+    const bool loaded = modeMgr.loadFromJSON(projectObj, true);
+
+    // Report is reset by loading
+    modeMgr.loadReport().addPhase(QLatin1String("Read file"), readNs, -1, 0);
+
+    if(parser.isSet(loadReportOption))
+        err << modeMgr.loadReport().toText() << Qt::flush;
+
+    if(!loaded)
+    {
+        err << "File could not be loaded, check file version is not too new." << Qt::endl;
+        return 1;
+    }
+
+    SimulationScriptRunner runner(&modeMgr);
+    runner.setFastForward(parser.isSet(fastForwardOption));
+
+    if(parser.isSet(scriptOption))
+    {
+        QJsonObject scriptObj;
+        if(!readJsonFile(parser.value(scriptOption), scriptObj))
+        {
+            err << "Cannot read script file: " << parser.value(scriptOption) << Qt::endl;
+            return 1;
+        }
+
+        if(!runner.loadScript(scriptObj))
+        {
+            err << runner.errorString() << Qt::endl;
+            return 1;
+        }
+    }
+
+    if(!runner.run())
+    {
+        err << runner.errorString() << Qt::endl;
+        return 2;
+    }
+
+    if(parser.isSet(replayOption))
+    {
+        SimulationRecorder *recorder = modeMgr.recorder();
+        if(!recorder->startReplay(parser.value(replayOption)))
+        {
+            err << recorder->errorString() << Qt::endl;
+            return 2;
+        }
+
+        if(parser.isSet(fastForwardOption))
+        {
+            // Jump from one event to next
+            while(recorder->isReplaying())
+                modeMgr.scheduler()->advanceBy(recorder->timeToNextEvent());
+        }
+        else
+        {
+            QEventLoop loop;
+            QObject::connect(recorder, &SimulationRecorder::replayChanged,
+                             &loop, &QEventLoop::quit);
+            if(recorder->isReplaying())
+                loop.exec();
+        }
+    }
+
+    QJsonObject stateObj;
+    runner.saveStateToJSON(stateObj);
+
+    const QByteArray data = QJsonDocument(stateObj).toJson(QJsonDocument::Indented);
+
+    if(parser.isSet(outputOption))
+    {
+        QFile f(parser.value(outputOption));
+        if(!f.open(QFile::WriteOnly | QFile::Truncate))
+        {
+            err << "Cannot write output file: " << parser.value(outputOption) << Qt::endl;
+            return 1;
+        }
+        f.write(data);
+    }
+    else
+    {
+        QTextStream out(stdout);
+        out << data;
+    }
+
+    // Stop simulation before destroying objects
+    modeMgr.setMode(FileMode::Editing);
+
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * src/cli/simulationscriptrunner.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "simulationscriptrunner.h"
+
+#include "../views/modemanager.h"
+
+#include "../objects/simulationobjectfactory.h"
+#include "../objects/abstractsimulationobjectmodel.h"
+#include "../objects/abstractsimulationobject.h"
+
+#include "../objects/interfaces/leverinterface.h"
+#include "../objects/interfaces/buttoninterface.h"
+
+#include "../objects/relais/model/abstractrelais.h"
+
+#include "../utils/simulationscheduler.h"
+
+#include <QJsonObject>
+#include <QCborMap>
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+
+SimulationScriptRunner::SimulationScriptRunner(ModeManager *mgr, QObject *parent)
+    : QObject{parent}
+    , mModeMgr(mgr)
+{
+
+}
+
+bool SimulationScriptRunner::loadScript(const QJsonObject &obj)
+{
+    if(!obj.value("actions").isArray())
+    {
+        mErrorString = tr("Script has no \"actions\" array");
+        return false;
+    }
+
+    mActions = obj.value("actions").toArray();
+    return true;
+}
+
+void SimulationScriptRunner::setFastForward(bool val)
+{
+    mFastForward = val;
+
+    // Clock only advances on wait actions
+    mModeMgr->scheduler()->setPaused(mFastForward);
+}
+
+bool SimulationScriptRunner::run()
+{
+    // Let objects react to initial power on
+    waitMillis(0);
+
+    for(int i = 0; i < mActions.size(); i++)
+    {
+        if(!applyAction(mActions.at(i).toObject()))
+        {
+            mErrorString = tr("Action %1: %2").arg(i).arg(mErrorString);
+            return false;
+        }
+
+        // Deliver posted events before next action
+        waitMillis(0);
+    }
+
+    return true;
+}
+
+void SimulationScriptRunner::saveStateToJSON(QJsonObject &obj) const
+{
+    QJsonObject objects;
+
+    const QStringList types = mModeMgr->objectFactory()->getRegisteredTypes();
+    for(const QString& objType : types)
+    {
+        AbstractSimulationObjectModel *model = mModeMgr->modelForType(objType);
+        if(!model || model->rowCount() == 0)
+            continue;
+
+        QJsonObject modelObj;
+        for(int row = 0; row < model->rowCount(); row++)
+        {
+            AbstractSimulationObject *item = model->objectAt(row);
+
+            QCborMap replicaState;
+            item->getReplicaState(replicaState);
+            modelObj[item->name()] = replicaState.toJsonObject();
+        }
+
+        objects[objType] = modelObj;
+    }
+
+    obj["objects"] = objects;
+}
+
+bool SimulationScriptRunner::applyAction(const QJsonObject &action)
+{
+    const QString actionType = action.value("action").toString();
+
+    if(actionType == QLatin1String("wait"))
+    {
+        waitMillis(action.value("ms").toInt());
+        return true;
+    }
+    else if(actionType == QLatin1String("snapshot"))
+    {
+        mModeMgr->saveSnapshot();
+        return true;
+    }
+    else if(actionType == QLatin1String("restore"))
+    {
+        if(!mModeMgr->restoreSnapshot())
+        {
+            mErrorString = tr("No snapshot to restore");
+            return false;
+        }
+        return true;
+    }
+
+    const QString name = action.value("object").toString();
+    AbstractSimulationObject *item = findObject(name,
+                                                action.value("type").toString());
+    if(!item)
+    {
+        mErrorString = tr("Object \"%1\" not found").arg(name);
+        return false;
+    }
+
+    if(actionType == QLatin1String("lever"))
+    {
+        LeverInterface *leverIface = item->getInterface<LeverInterface>();
+        if(!leverIface)
+        {
+            mErrorString = tr("Object \"%1\" is not a lever").arg(name);
+            return false;
+        }
+
+        const int pos = action.value("position").toInt(LeverAngleDesc::InvalidPosition);
+        if(pos < leverIface->absoluteMin() || pos > leverIface->absoluteMax())
+        {
+            mErrorString = tr("Invalid position %1 for lever \"%2\"").arg(pos).arg(name);
+            return false;
+        }
+
+        // Move like a user would do, locks still apply
+        leverIface->setAngle(leverIface->angleForPosition(pos));
+        leverIface->setPosition(pos);
+        return true;
+    }
+    else if(actionType == QLatin1String("button"))
+    {
+        ButtonInterface *butIface = item->getInterface<ButtonInterface>();
+        if(!butIface)
+        {
+            mErrorString = tr("Object \"%1\" is not a button").arg(name);
+            return false;
+        }
+
+        const QJsonValue stateVal = action.value("state");
+        ButtonInterface::State state = ButtonInterface::State::Normal;
+        if(stateVal.isString())
+        {
+            const QString stateStr = stateVal.toString();
+            if(stateStr == QLatin1String("pressed"))
+                state = ButtonInterface::State::Pressed;
+            else if(stateStr == QLatin1String("extracted"))
+                state = ButtonInterface::State::Extracted;
+        }
+        else
+        {
+            state = ButtonInterface::State(qBound(int(ButtonInterface::State::Pressed),
+                                                  stateVal.toInt(int(ButtonInterface::State::Normal)),
+                                                  int(ButtonInterface::State::Extracted)));
+        }
+
+        butIface->setState(state);
+        return true;
+    }
+    else if(actionType == QLatin1String("relay"))
+    {
+        AbstractRelais *relay = qobject_cast<AbstractRelais *>(item);
+        if(!relay)
+        {
+            mErrorString = tr("Object \"%1\" is not a relay").arg(name);
+            return false;
+        }
+
+        const bool up = action.value("state").toString() == QLatin1String("up");
+        relay->setState(up ? AbstractRelais::State::Up : AbstractRelais::State::Down);
+        return true;
+    }
+    else if(actionType == QLatin1String("state"))
+    {
+        const QCborMap replicaState = QCborMap::fromJsonObject(action.value("state").toObject());
+        if(!item->setReplicaState(replicaState))
+        {
+            mErrorString = tr("Object \"%1\" does not accept state").arg(name);
+            return false;
+        }
+        return true;
+    }
+
+    mErrorString = tr("Unknown action \"%1\"").arg(actionType);
+    return false;
+}
+
+AbstractSimulationObject *SimulationScriptRunner::findObject(const QString &name,
+                                                             const QString &objType) const
+{
+    if(!objType.isEmpty())
+        return mModeMgr->objectByUniqueId(objType + QLatin1Char('.') + name);
+
+    const QStringList types = mModeMgr->objectFactory()->getRegisteredTypes();
+    for(const QString& type : types)
+    {
+        AbstractSimulationObjectModel *model = mModeMgr->modelForType(type);
+        if(!model)
+            continue;
+
+        AbstractSimulationObject *item = model->getObjectByName(name);
+        if(item)
+            return item;
+    }
+
+    return nullptr;
+}
+
+void SimulationScriptRunner::waitMillis(int millis)
+{
+    if(mFastForward)
+    {
+        SimulationScheduler *scheduler = mModeMgr->scheduler();
+
+        QCoreApplication::sendPostedEvents();
+        scheduler->advanceBy(qMax(0, millis));
+
+        // Timers started by last posted events
+        QCoreApplication::sendPostedEvents();
+        scheduler->advanceBy(0);
+        return;
+    }
+
+    // Timers of relays, levers and buttons
+    // need a running event loop
+    QEventLoop loop;
+    QTimer::singleShot(qMax(0, millis), Qt::PreciseTimer,
+                       &loop, &QEventLoop::quit);
+    loop.exec();
+}
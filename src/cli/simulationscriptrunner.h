@@ -0,0 +1,103 @@
+/**
+ * src/cli/simulationscriptrunner.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIMULATIONSCRIPTRUNNER_H
+#define SIMULATIONSCRIPTRUNNER_H
+
+#include <QObject>
+#include <QJsonArray>
+
+class ModeManager;
+class AbstractSimulationObject;
+
+class QJsonObject;
+
+/*!
+ * \brief The SimulationScriptRunner class
+ *
+ * Applies a scripted list of actions to a loaded project
+ * and dumps resulting object state.
+ *
+ * Script format:
+ * {
+ *   "actions": [
+ *     { "action": "lever",  "object": "L1", "position": 2 },
+ *     { "action": "button", "object": "B1", "state": "pressed" },
+ *     { "action": "relay",  "object": "R1", "state": "up" },
+ *     { "action": "state",  "object": "S1", "type": "screen_relais", "state": { ... } },
+ *     { "action": "wait",   "ms": 1500 },
+ *     { "action": "snapshot" },
+ *     { "action": "restore" }
+ *   ]
+ * }
+ *
+ * Optional "type" key restricts object lookup to a single object type.
+ * "state" action uses same keys of replica state.
+ * "restore" goes back to state of last "snapshot".
+ *
+ * In fast forward mode simulation clock is paused
+ * and "wait" advances it without sleeping.
+ */
+class SimulationScriptRunner : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SimulationScriptRunner(ModeManager *mgr, QObject *parent = nullptr);
+
+    bool loadScript(const QJsonObject& obj);
+
+    // Blocks until all actions are applied, event loop keeps running
+    bool run();
+
+    inline bool fastForward() const
+    {
+        return mFastForward;
+    }
+
+    void setFastForward(bool val);
+
+    void saveStateToJSON(QJsonObject& obj) const;
+
+    inline QString errorString() const
+    {
+        return mErrorString;
+    }
+
+private:
+    bool applyAction(const QJsonObject& action);
+
+    AbstractSimulationObject *findObject(const QString& name,
+                                         const QString& objType) const;
+
+    void waitMillis(int millis);
+
+private:
+    ModeManager *mModeMgr;
+
+    QJsonArray mActions;
+
+    QString mErrorString;
+
+    bool mFastForward = false;
+};
+
+#endif // SIMULATIONSCRIPTRUNNER_H
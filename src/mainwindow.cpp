@@ -23,14 +23,21 @@
 #include "mainwindow.h"
 
 #include <QAction>
+#include <QActionGroup>
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QInputDialog>
 
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QPlainTextEdit>
+#include <QVBoxLayout>
+#include <QFontDatabase>
+#include <QElapsedTimer>
+
 #include <QStandardPaths>
 #include <QSettings>
 
-#include <QJsonDocument>
 #include <QJsonObject>
 
 #include <QCloseEvent>
@@ -38,14 +45,23 @@
 #include <QMenuBar>
 #include <QToolBar>
 
+#include <QGuiApplication>
+#include <QScreen>
+
 
 #include "views/viewmanager.h"
 #include "views/modemanager.h"
+#include "views/guimodefrontend.h"
 #include "network/remotemanager.h"
+#include "circuits/circuitchangenotifier.h"
 
 #include "circuits/edit/nodeeditfactory.h"
 #include "panels/edit/panelitemfactory.h"
 #include "objects/simulationobjectfactory.h"
+#include "objects/simulationrecorder.h"
+
+#include "utils/projectfile.h"
+#include "utils/phasereport.h"
 
 #include "views/layoutloader.h"
 #include "views/uilayoutdialog.h"
@@ -58,6 +74,8 @@ static constexpr const char *jsonFiles =
         QT_TRANSLATE_NOOP("MainWindow", "JSON Files (*.json)");
 static constexpr const char *simraFormat =
         QT_TRANSLATE_NOOP("MainWindow", "Simulatore Relais Circuits (*.simrelaisc)");
+static constexpr const char *simraBinaryFormat =
+        QT_TRANSLATE_NOOP("MainWindow", "Simulatore Relais Circuits Binary (*.simrelaisb)");
 static constexpr const char *simraLayoutFormat =
         QT_TRANSLATE_NOOP("MainWindow", "Simulatore Relais Circuits Layout (*.simrelayout)");
 
@@ -66,6 +84,15 @@ MainWindow::MainWindow(const QString& uniqueName_, const QString& settingsFile_,
     , settingsFile(settingsFile_)
 {
     mModeMgr = new ModeManager(this);
+    mModeMgr->setFrontend(new GuiModeFrontend(mModeMgr));
+
+    // Deliver circuit changes once per display frame
+    const QScreen *primaryScreen = QGuiApplication::primaryScreen();
+    if(primaryScreen && primaryScreen->refreshRate() > 0)
+    {
+        const int frameInterval = qRound(1000.0 / primaryScreen->refreshRate());
+        mModeMgr->changeNotifier()->setFrameInterval(frameInterval);
+    }
 
     mViewMgr = new ViewManager(this);
 
@@ -133,6 +160,10 @@ void MainWindow::buildMenuBar()
     menuFile->addAction(tr("Load Layout"), this, &MainWindow::loadLayout);
     menuFile->addAction(tr("Save Layout"), this, &MainWindow::saveLayout);
 
+    menuFile->addSeparator();
+
+    menuFile->addAction(tr("Load/Save Report"), this, &MainWindow::showPhaseReport);
+
     connect(actionNew, &QAction::triggered,
             this, &MainWindow::onNew);
     connect(actionOpen, &QAction::triggered,
@@ -215,10 +246,173 @@ void MainWindow::buildMenuBar()
                                                  &MainWindow::showLayoutDialog);
     actionLayouts->setShortcut(QKeyCombination(Qt::ControlModifier, Qt::Key_L));
 
+    // Menu Simulation
+    QMenu *menuSimulation = menuBar()->addMenu(tr("Simulation"));
+
+    SimulationScheduler *scheduler = mModeMgr->scheduler();
+
+    QAction *actionPause = menuSimulation->addAction(tr("Pause"));
+    actionPause->setCheckable(true);
+    actionPause->setChecked(scheduler->isPaused());
+    connect(actionPause, &QAction::toggled,
+            scheduler, &SimulationScheduler::setPaused);
+    connect(scheduler, &SimulationScheduler::pausedChanged,
+            actionPause, &QAction::setChecked);
+
+    QAction *actionStep = menuSimulation->addAction(tr("Step"));
+    actionStep->setToolTip(tr("Advance paused simulation by one step"));
+    actionStep->setEnabled(scheduler->isPaused());
+    connect(actionStep, &QAction::triggered,
+            scheduler, &SimulationScheduler::step);
+    connect(scheduler, &SimulationScheduler::pausedChanged,
+            actionStep, &QAction::setEnabled);
+
+    menuSimulation->addSeparator();
+
+    QMenu *menuSpeed = menuSimulation->addMenu(tr("Speed"));
+    QActionGroup *speedGroup = new QActionGroup(menuSpeed);
+
+    const double speedFactors[] = {0.1, 0.25, 0.5, 1.0, 2.0, 5.0, 10.0};
+    for(const double factor : speedFactors)
+    {
+        QAction *act = menuSpeed->addAction(tr("%1x").arg(factor));
+        act->setCheckable(true);
+        act->setChecked(qFuzzyCompare(factor, scheduler->speedFactor()));
+        speedGroup->addAction(act);
+
+        connect(act, &QAction::triggered,
+                scheduler, [scheduler, factor]()
+        {
+            scheduler->setSpeedFactor(factor);
+        });
+    }
+
+    QMenu *menuClockMode = menuSimulation->addMenu(tr("Clock Mode"));
+    QActionGroup *clockModeGroup = new QActionGroup(menuClockMode);
+
+    const std::pair<SimulationScheduler::RunMode, QString> clockModes[] =
+    {
+        {SimulationScheduler::RunMode::RealTime, tr("Real Time")},
+        {SimulationScheduler::RunMode::FixedStep, tr("Fixed Step")},
+        {SimulationScheduler::RunMode::AsFastAsPossible, tr("As Fast As Possible")}
+    };
+
+    for(const auto& clockMode : clockModes)
+    {
+        QAction *act = menuClockMode->addAction(clockMode.second);
+        act->setCheckable(true);
+        act->setChecked(clockMode.first == scheduler->runMode());
+        clockModeGroup->addAction(act);
+
+        const SimulationScheduler::RunMode mode = clockMode.first;
+        connect(act, &QAction::triggered,
+                scheduler, [scheduler, mode]()
+        {
+            scheduler->setRunMode(mode);
+        });
+    }
+
+    menuSimulation->addSeparator();
+
+    QAction *actionSaveSnapshot = menuSimulation->addAction(tr("Save Snapshot"));
+    connect(actionSaveSnapshot, &QAction::triggered,
+            mModeMgr, &ModeManager::saveSnapshot);
+
+    QAction *actionRestoreSnapshot = menuSimulation->addAction(tr("Restore Snapshot"));
+    connect(actionRestoreSnapshot, &QAction::triggered,
+            mModeMgr, &ModeManager::restoreSnapshot);
+
+    QAction *actionRewind = menuSimulation->addAction(tr("Rewind 30 seconds"));
+    connect(actionRewind, &QAction::triggered,
+            mModeMgr, [this]()
+    {
+        mModeMgr->rewindBy(30000);
+    });
+
+    auto updateSnapshotActions = [actionSaveSnapshot, actionRestoreSnapshot, actionRewind](FileMode mode)
+    {
+        const bool isSim = mode == FileMode::Simulation;
+        actionSaveSnapshot->setEnabled(isSim);
+        actionRestoreSnapshot->setEnabled(isSim);
+        actionRewind->setEnabled(isSim);
+    };
+    connect(mModeMgr, &ModeManager::modeChanged, this, updateSnapshotActions);
+    updateSnapshotActions(mModeMgr->mode());
+
+    menuSimulation->addSeparator();
+
+    SimulationRecorder *recorder = mModeMgr->recorder();
+    const QString recordingFilter = tr("Input Recordings (*.srrec)");
+
+    QAction *actionRecord = menuSimulation->addAction(tr("Record Inputs"));
+    actionRecord->setCheckable(true);
+    connect(actionRecord, &QAction::triggered,
+            this, [this, recorder, recordingFilter, actionRecord](bool on)
+    {
+        if(!on)
+        {
+            recorder->stopRecording();
+            return;
+        }
+
+        const QString fileName = QFileDialog::getSaveFileName(this,
+                                                              tr("Record Inputs"),
+                                                              QString(),
+                                                              recordingFilter);
+        if(fileName.isEmpty() || !recorder->startRecording(fileName))
+        {
+            if(!fileName.isEmpty())
+                QMessageBox::warning(this, tr("Record Inputs"), recorder->errorString());
+            actionRecord->setChecked(false);
+        }
+    });
+    connect(recorder, &SimulationRecorder::recordingChanged,
+            actionRecord, &QAction::setChecked);
+
+    QAction *actionReplay = menuSimulation->addAction(tr("Replay Inputs"));
+    actionReplay->setCheckable(true);
+    connect(actionReplay, &QAction::triggered,
+            this, [this, recorder, recordingFilter, actionReplay](bool on)
+    {
+        if(!on)
+        {
+            recorder->stopReplay();
+            return;
+        }
+
+        const QString fileName = QFileDialog::getOpenFileName(this,
+                                                              tr("Replay Inputs"),
+                                                              QString(),
+                                                              recordingFilter);
+        if(fileName.isEmpty() || !recorder->startReplay(fileName))
+        {
+            if(!fileName.isEmpty())
+                QMessageBox::warning(this, tr("Replay Inputs"), recorder->errorString());
+            actionReplay->setChecked(false);
+        }
+    });
+    connect(recorder, &SimulationRecorder::replayChanged,
+            actionReplay, &QAction::setChecked);
+
+    auto updateRecorderActions = [actionRecord, actionReplay](FileMode mode)
+    {
+        const bool isSim = mode == FileMode::Simulation;
+        actionRecord->setEnabled(isSim);
+        actionReplay->setEnabled(isSim);
+    };
+    connect(mModeMgr, &ModeManager::modeChanged, this, updateRecorderActions);
+    updateRecorderActions(mModeMgr->mode());
+
+    menuSimulation->addSeparator();
+
+    QAction *showProfiler = menuSimulation->addAction(tr("Profiler"));
+    connect(showProfiler, &QAction::triggered,
+            mViewMgr, &ViewManager::showSimulationProfilerView);
+
     // Menu Network
     QMenu *menuNetwork = menuBar()->addMenu(tr("Network"));
 
-    RemoteManager *remoteMgr = mModeMgr->getRemoteManager();
+    RemoteManager *remoteMgr = GuiModeFrontend::get(mModeMgr)->getRemoteManager();
 
     actionSessionName = menuNetwork->addAction(tr("Change Session Name"));
     actionSessionName->setEnabled(mModeMgr->mode() == FileMode::Editing);
@@ -370,7 +564,7 @@ void MainWindow::buildEditToolBar()
 
     QVector<QAction *> addCircuitItemActions;
 
-    auto circuitEditFactory = mModeMgr->circuitFactory();
+    auto circuitEditFactory = GuiModeFrontend::get(mModeMgr)->circuitFactory();
     for(const QString& nodeType : circuitEditFactory->getRegisteredTypes())
     {
         QString prettyName = circuitEditFactory->prettyName(nodeType);
@@ -451,7 +645,7 @@ void MainWindow::buildEditToolBar()
 
     QVector<QAction *> addPanelItemActions;
 
-    auto panelEditFactory = mModeMgr->panelFactory();
+    auto panelEditFactory = GuiModeFrontend::get(mModeMgr)->panelFactory();
     for(const QString& nodeType : panelEditFactory->getRegisteredTypes())
     {
         QString title = tr("%1").arg(panelEditFactory->prettyName(nodeType));
@@ -581,7 +775,7 @@ void MainWindow::onOpen()
     if(!maybeSave())
         return;
 
-    QStringList filters = {simraFormat, jsonFiles, allFiles};
+    QStringList filters = {simraFormat, simraBinaryFormat, jsonFiles, allFiles};
     for(auto &s : filters)
         s = tr(s.toLatin1());
     QString fileName = QFileDialog::getOpenFileName(this,
@@ -610,8 +804,7 @@ void MainWindow::onOpenRecent()
 
 void MainWindow::loadFile(const QString& fileName, bool startSim)
 {
-    QFile f(fileName);
-    if(!f.open(QFile::ReadOnly))
+    if(!QFile::exists(fileName))
         return;
 
     mViewMgr->closeAllFileSpecificDocks();
@@ -622,13 +815,22 @@ void MainWindow::loadFile(const QString& fileName, bool startSim)
 
     addFileToRecents(fileName);
 
-    QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
-    if(doc.isNull())
+    QElapsedTimer readTimer;
+    readTimer.start();
+
+    // Either JSON or binary, detected from content
+    QJsonObject rootObj;
+    if(!ProjectFile::read(fileName, rootObj))
         return;
 
-    const QJsonObject rootObj = doc.object();
+    const qint64 readNs = readTimer.nsecsElapsed();
+
+    const bool loaded = mModeMgr->loadFromJSON(rootObj, startSim);
+
+    // Report is reset by loading
+    mModeMgr->loadReport().addPhase(QLatin1String("Read file"), readNs, -1, 0);
 
-    if(!mModeMgr->loadFromJSON(rootObj, startSim))
+    if(!loaded)
     {
         // Loading error, show error to user and start new session
         onNew();
@@ -679,19 +881,22 @@ bool MainWindow::saveFile(const QString& fileName)
     const QString oldFilePath = mModeMgr->filePath();
     mModeMgr->setFilePath(fileName);
 
+    mSaveReport.clear();
+
     QJsonObject rootObj;
-    mModeMgr->saveToJSON(rootObj);
+    mModeMgr->saveToJSON(rootObj, &mSaveReport);
 
     // Reset
     mModeMgr->setFilePath(oldFilePath, true);
 
-    QJsonDocument doc(rootObj);
+    QElapsedTimer writeTimer;
+    writeTimer.start();
 
-    QFile f(fileName);
-    if(!f.open(QFile::WriteOnly))
+    if(!ProjectFile::write(fileName, rootObj,
+                           ProjectFile::formatForFileName(fileName)))
         return false;
 
-    f.write(doc.toJson());
+    mSaveReport.addPhase(QLatin1String("Write file"), writeTimer.nsecsElapsed(), -1);
 
     mViewMgr->saveLayoutFile();
 
@@ -716,7 +921,7 @@ bool MainWindow::onSave()
 
 bool MainWindow::onSaveAs()
 {
-    QStringList filters = {simraFormat, jsonFiles, allFiles};
+    QStringList filters = {simraFormat, simraBinaryFormat, jsonFiles, allFiles};
     for(auto &s : filters)
         s = tr(s.toLatin1());
     QString fileName = QFileDialog::getSaveFileName(this,
@@ -783,6 +988,43 @@ void MainWindow::saveLayout()
     f.close();
 }
 
+void MainWindow::showPhaseReport()
+{
+    QString text;
+
+    if(!mModeMgr->loadReport().isEmpty())
+        text += mModeMgr->loadReport().toText();
+
+    if(!mSaveReport.isEmpty())
+    {
+        if(!text.isEmpty())
+            text += QLatin1Char('\n');
+        text += mSaveReport.toText();
+    }
+
+    if(text.isEmpty())
+        text = tr("No file was loaded or saved yet.");
+
+    QDialog dlg(this);
+    dlg.setWindowTitle(tr("Load/Save Report"));
+
+    QVBoxLayout *lay = new QVBoxLayout(&dlg);
+
+    QPlainTextEdit *edit = new QPlainTextEdit;
+    edit->setReadOnly(true);
+    edit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    edit->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    edit->setPlainText(text);
+    lay->addWidget(edit);
+
+    QDialogButtonBox *box = new QDialogButtonBox(QDialogButtonBox::Close);
+    connect(box, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
+    lay->addWidget(box);
+
+    dlg.resize(700, 450);
+    dlg.exec();
+}
+
 void MainWindow::updateWindowModified()
 {
     // Do not set modified state for new files
@@ -28,6 +28,8 @@
 
 #include "enums/filemodes.h"
 
+#include "utils/phasereport.h"
+
 class ModeManager;
 class ViewManager;
 
@@ -74,6 +76,8 @@ private slots:
     void loadLayout();
     void saveLayout();
 
+    void showPhaseReport();
+
     void updateWindowModified();
 
     void onFileModeChanged(FileMode mode, FileMode oldMode);
@@ -109,6 +113,9 @@ private slots:
     // Views
     ViewManager *mViewMgr = nullptr;
 
+    // Phases of last save
+    PhaseReport mSaveReport;
+
     enum
     {
         MaxRecentFiles = 10
@@ -30,6 +30,7 @@
 #include "peermanager.h"
 
 #include "../views/modemanager.h"
+#include "../views/guimodefrontend.h"
 
 #include "traintastic-simulator/traintasticsimmanager.h"
 
@@ -256,7 +257,7 @@ void PeerManager::readTraintasticBroadcastDatagram()
         quint16 traintasticServerPort = *reinterpret_cast<const quint16 *>(datagram.constData() + 4);
         traintasticServerPort = qFromBigEndian(traintasticServerPort);
 
-        modeMgr()->getTraitasticSimMgr()->tryConnectToServer(senderIp, traintasticServerPort);
+        GuiModeFrontend::get(modeMgr())->getTraitasticSimMgr()->tryConnectToServer(senderIp, traintasticServerPort);
     }
 }
 
@@ -29,6 +29,10 @@
 
 #include "../views/modemanager.h"
 
+#include "../circuits/simulationprofiler.h"
+
+#include "../objects/simulationrecorder.h"
+
 #include "../objects/circuit_bridge/remotecircuitbridge.h"
 #include "../objects/circuit_bridge/remotecircuitbridgesmodel.h"
 
@@ -391,9 +395,15 @@ void RemoteSession::onSourceObjectStateReceived(quint64 replicaId, const QCborMa
     if(replicaId >= quint64(mReplicas.size()))
         return;
 
+    SimulationProfiler::EventScope profile(SimulationProfiler::EventType::RemoteUpdate);
+
+    SimulationRecorder *recorder = remoteMgr()->modeMgr()->recorder();
+
     const ReplicaData& repData = mReplicas.at(replicaId);
     for(AbstractSimulationObject *replica : repData.objects)
     {
+        recorder->record(SimulationRecorder::EventType::ReplicaState,
+                         replica, objState);
         replica->setReplicaState(objState);
     }
 }
@@ -26,6 +26,8 @@
 #include <QObject>
 #include <QHash>
 
+#include "../objects/circuit_bridge/abstractremotesession.h"
+
 class PeerConnection;
 
 class AbstractSimulationObject;
@@ -37,7 +39,7 @@ class QCborMap;
 
 class QHostAddress;
 
-class RemoteSession : public QObject
+class RemoteSession : public QObject, public AbstractRemoteSession
 {
     Q_OBJECT
 public:
@@ -59,10 +61,10 @@ class RemoteSession : public QObject
     RemoteManager *remoteMgr() const;
 
     bool setSessionName(const QString& newName);
-    inline QString getSessionName() const { return mSessionName; }
+    inline QString getSessionName() const override { return mSessionName; }
 
-    void addRemoteBridge(RemoteCircuitBridge *bridge);
-    void removeRemoteBridge(RemoteCircuitBridge *bridge);
+    void addRemoteBridge(RemoteCircuitBridge *bridge) override;
+    void removeRemoteBridge(RemoteCircuitBridge *bridge) override;
 
     inline RemoteCircuitBridge *getBridgeAt(int bridgeId) const
     {
@@ -79,6 +81,11 @@ class RemoteSession : public QObject
         return mPeerConn;
     }
 
+    inline bool isConnected() const override
+    {
+        return mPeerConn != nullptr;
+    }
+
     QHostAddress getPeerAddress() const;
 
     void onConnected(PeerConnection *conn);
@@ -88,7 +95,7 @@ class RemoteSession : public QObject
     void sendBridgesToPeer();
 
     bool isRemoteBridgeNameAvailable(const QString& name,
-                                     RemoteCircuitBridge *excluded = nullptr) const;
+                                     RemoteCircuitBridge *excluded = nullptr) const override;
 
 public:
     void onRemoteBridgeResponseReceived(const BridgeResponse &msg);
@@ -100,7 +107,7 @@ class RemoteSession : public QObject
 
     void onLocalBridgeModeChanged(quint64 peerNodeId,
                                   qint8 mode, qint8 pole,
-                                  qint8 replyToMode, quint8 circuitFlags);
+                                  qint8 replyToMode, quint8 circuitFlags) override;
 
     void sendReplicaList();
     void onReplicaListReceived(const QCborArray &msg);
@@ -23,6 +23,7 @@
 #include "traintasticsimmanager.h"
 
 #include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
 #include "../remotemanager.h"
 #include "../peermanager.h"
 
@@ -34,10 +35,12 @@
 #include "../../objects/traintastic/traintasticaxlecounterobj.h"
 
 #include "../../objects/abstractsimulationobjectmodel.h"
+#include "../../objects/simulationrecorder.h"
 
 #include "protocol.hpp"
 
 #include <QTcpSocket>
+#include <QCborArray>
 #include <QTimerEvent>
 #include <QTime>
 
@@ -119,7 +122,7 @@ void TraintasticSimManager::onSocketError()
     disconnectSimulator();
 
     // Try to reconnect
-    mModeMgr->getRemoteManager()->setTraintasticDiscoveryEnabled(true);
+    GuiModeFrontend::get(mModeMgr)->getRemoteManager()->setTraintasticDiscoveryEnabled(true);
 }
 
 void TraintasticSimManager::onReadyRead()
@@ -228,7 +231,7 @@ void TraintasticSimManager::onConnected()
         send(msg);
     }
 
-    mModeMgr->getRemoteManager()->setTraintasticDiscoveryEnabled(false);
+    GuiModeFrontend::get(mModeMgr)->getRemoteManager()->setTraintasticDiscoveryEnabled(false);
 
     send(SimulatorProtocol::HandShake(true));
     mHandShakeTimer.start(HandShakeRate, Qt::PreciseTimer, this);
@@ -243,7 +246,7 @@ void TraintasticSimManager::timerEvent(QTimerEvent *ev)
         disconnectSimulator();
 
         // Try to reconnect
-        mModeMgr->getRemoteManager()->setTraintasticDiscoveryEnabled(true);
+        GuiModeFrontend::get(mModeMgr)->getRemoteManager()->setTraintasticDiscoveryEnabled(true);
         return;
     }
 
@@ -282,6 +285,8 @@ void TraintasticSimManager::receive(const SimulatorProtocol::Message &message)
         if(it == chan->constEnd())
             return;
 
+        mModeMgr->recorder()->record(SimulationRecorder::EventType::SensorState,
+                                     it.value(), m.state);
         it.value()->setState(m.state);
 
         break;
@@ -299,10 +304,14 @@ void TraintasticSimManager::receive(const SimulatorProtocol::Message &message)
                 TraintasticAxleCounterObj *axleCounterObj = static_cast<TraintasticAxleCounterObj *>(axleCountersModel->objectAt(i));
                 if(axleCounterObj->address(true) == m.address && axleCounterObj->channel(true) == m.channel)
                 {
+                    mModeMgr->recorder()->record(SimulationRecorder::EventType::AxleCounter,
+                                                 axleCounterObj, QCborArray{m.axleCount, true});
                     axleCounterObj->axleCounterEvent(m.axleCount, true);
                 }
                 else if(axleCounterObj->address(false) == m.address && axleCounterObj->channel(false) == m.channel)
                 {
+                    mModeMgr->recorder()->record(SimulationRecorder::EventType::AxleCounter,
+                                                 axleCounterObj, QCborArray{m.axleCount, false});
                     axleCounterObj->axleCounterEvent(m.axleCount, false);
                 }
             }
@@ -318,6 +327,8 @@ void TraintasticSimManager::receive(const SimulatorProtocol::Message &message)
             if(it == chan->constEnd())
                 return;
 
+            mModeMgr->recorder()->record(SimulationRecorder::EventType::SensorState,
+                                         it.value(), m.value);
             it.value()->setState(m.value);
         }
 
@@ -333,6 +344,8 @@ void TraintasticSimManager::receive(const SimulatorProtocol::Message &message)
         if(it == mSpawnSensors.constEnd())
             return;
 
+        mModeMgr->recorder()->record(SimulationRecorder::EventType::SensorState,
+                                     it.value(), m.state);
         it.value()->setState(m.state);
 
         break;
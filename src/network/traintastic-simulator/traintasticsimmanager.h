@@ -27,7 +27,7 @@
 #include <QHash>
 #include <QBasicTimer>
 
-#include "protocol.hpp"
+#include "../../objects/traintastic/abstracttraintasticsimmanager.h"
 
 class QTcpSocket;
 class QHostAddress;
@@ -38,23 +38,23 @@ class TraintasticSpawnObj;
 
 class ModeManager;
 
-class TraintasticSimManager : public QObject
+class TraintasticSimManager : public QObject, public AbstractTraintasticSimManager
 {
     Q_OBJECT
 public:
     explicit TraintasticSimManager(ModeManager *mgr);
     ~TraintasticSimManager();
 
-    bool isConnected() const;
+    bool isConnected() const override;
 
     void enableConnection(bool val);
 
-    void setTurnoutState(int channel, int address, int state);
-    void setSpawnState(int address, bool active);
+    void setTurnoutState(int channel, int address, int state) override;
+    void setSpawnState(int address, bool active) override;
 
     void tryConnectToServer(const QHostAddress &addr, quint16 port);
 
-    void send(const SimulatorProtocol::Message &message);
+    void send(const SimulatorProtocol::Message &message) override;
 
 signals:
     void stateChanged();
@@ -72,17 +72,14 @@ private slots:
 private:
     void receive(const SimulatorProtocol::Message &message);
 
-    friend class TraintasticSensorObj;
-    bool setSensorChannel(TraintasticSensorObj *obj, int newChannel);
-    bool setSensorAddress(TraintasticSensorObj *obj, int newAddress);
+    bool setSensorChannel(TraintasticSensorObj *obj, int newChannel) override;
+    bool setSensorAddress(TraintasticSensorObj *obj, int newAddress) override;
 
-    friend class TraintasticTurnoutObj;
-    void addTurnout(TraintasticTurnoutObj *obj);
-    void removeTurnout(TraintasticTurnoutObj *obj);
+    void addTurnout(TraintasticTurnoutObj *obj) override;
+    void removeTurnout(TraintasticTurnoutObj *obj) override;
 
-    friend class TraintasticSpawnObj;
-    void addSpawn(TraintasticSpawnObj *obj);
-    void removeSpawn(TraintasticSpawnObj *obj);
+    void addSpawn(TraintasticSpawnObj *obj) override;
+    void removeSpawn(TraintasticSpawnObj *obj) override;
 
     void setSensorsOff();
     void disconnectSimulator();
@@ -24,6 +24,7 @@
 
 #include "../../views/viewmanager.h"
 #include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
 
 #include "../remotemanager.h"
 #include "../remotesessionsmodel.h"
@@ -40,7 +41,7 @@ RemoteSessionListWidget::RemoteSessionListWidget(ViewManager *viewMgr, QWidget *
     : QWidget{parent}
     , mViewMgr(viewMgr)
 {
-    RemoteManager *remoteMgr = mViewMgr->modeMgr()->getRemoteManager();
+    RemoteManager *remoteMgr = GuiModeFrontend::get(mViewMgr->modeMgr())->getRemoteManager();
     mModel = remoteMgr->remoteSessionsModel();
 
     QVBoxLayout *lay = new QVBoxLayout(this);
@@ -91,7 +92,7 @@ void RemoteSessionListWidget::addRemoteSession()
     if(mViewMgr->modeMgr()->mode() != FileMode::Editing)
         return;
 
-    RemoteManager *remoteMgr = mViewMgr->modeMgr()->getRemoteManager();
+    RemoteManager *remoteMgr = GuiModeFrontend::get(mViewMgr->modeMgr())->getRemoteManager();
     QString name;
 
     bool first = true;
@@ -139,7 +140,7 @@ void RemoteSessionListWidget::removeRemoteSession()
                                        "This will reset all remote objects set to this session.").arg(name));
     if(ret == QMessageBox::Yes)
     {
-        RemoteManager *remoteMgr = mViewMgr->modeMgr()->getRemoteManager();
+        RemoteManager *remoteMgr = GuiModeFrontend::get(mViewMgr->modeMgr())->getRemoteManager();
         remoteMgr->removeRemoteSession(remoteSession);
     }
 }
@@ -24,6 +24,7 @@
 
 #include "../../views/viewmanager.h"
 #include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
 
 #include "../remotemanager.h"
 #include "../remotesessionsmodel.h"
@@ -52,7 +53,7 @@ ReplicasListWidget::ReplicasListWidget(ViewManager *viewMgr, QWidget *parent)
     : QWidget{parent}
     , mViewMgr(viewMgr)
 {
-    RemoteManager *remoteMgr = mViewMgr->modeMgr()->getRemoteManager();
+    RemoteManager *remoteMgr = GuiModeFrontend::get(mViewMgr->modeMgr())->getRemoteManager();
     connect(remoteMgr, &RemoteManager::remoteSessionRemoved,
             this, &ReplicasListWidget::onRemoteSessionRemoved);
 
@@ -108,7 +109,7 @@ void ReplicasListWidget::addReplica()
     if(mViewMgr->modeMgr()->mode() != FileMode::Editing)
         return;
 
-    ReplicaObjectManager *replicaMgr = mViewMgr->modeMgr()->getRemoteManager()->replicaMgr();
+    ReplicaObjectManager *replicaMgr = GuiModeFrontend::get(mViewMgr->modeMgr())->getRemoteManager()->replicaMgr();
     AbstractSimulationObject *replicaObj = nullptr;
 
     const auto replicaTypes = mViewMgr->modeMgr()->objectFactory()->replicaTypes();
@@ -126,7 +127,7 @@ void ReplicasListWidget::addReplica()
     QCheckBox *sessionCheck = new QCheckBox(tr("Use Remote Session"));
     sessionCheck->setChecked(mUseRemoteSession);
 
-    RemoteSessionsModel *sessionsModel = mViewMgr->modeMgr()->getRemoteManager()->remoteSessionsModel();
+    RemoteSessionsModel *sessionsModel = GuiModeFrontend::get(mViewMgr->modeMgr())->getRemoteManager()->remoteSessionsModel();
     QComboBox *sessionCombo = new QComboBox;
     sessionCombo->setModel(sessionsModel);
     lay->addRow(sessionCheck, sessionCombo);
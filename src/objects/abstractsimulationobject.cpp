@@ -27,6 +27,8 @@
 
 #include "../circuits/nodes/abstractcircuitnode.h"
 
+#include "../views/modemanager.h"
+
 #include <QTimerEvent>
 
 #include <QJsonObject>
@@ -131,6 +133,21 @@ void AbstractSimulationObject::getReplicaState(QCborMap &replicaState) const
     Q_UNUSED(replicaState);
 }
 
+bool AbstractSimulationObject::setSnapshotState(const QCborMap &state)
+{
+    return setReplicaState(state);
+}
+
+void AbstractSimulationObject::getSnapshotState(QCborMap &state) const
+{
+    getReplicaState(state);
+}
+
+SimulationScheduler *AbstractSimulationObject::scheduler() const
+{
+    return mModel->modeMgr()->scheduler();
+}
+
 QString AbstractSimulationObject::name() const
 {
     return mName;
@@ -33,6 +33,8 @@ class AbstractSimulationObjectModel;
 
 class AbstractObjectInterface;
 
+class SimulationScheduler;
+
 class AbstractCircuitNode;
 class QJsonObject;
 
@@ -69,6 +71,11 @@ class AbstractSimulationObject : public QObject
     virtual bool setReplicaState(const QCborMap& replicaState);
     virtual void getReplicaState(QCborMap& replicaState) const;
 
+    // See SimulationSnapshot, by default same as replica state.
+    // Objects whose state only follows circuits leave it empty
+    virtual bool setSnapshotState(const QCborMap& state);
+    virtual void getSnapshotState(QCborMap& state) const;
+
     QString name() const;
     bool setName(const QString &newName);
 
@@ -85,6 +92,8 @@ class AbstractSimulationObject : public QObject
         return mModel;
     }
 
+    SimulationScheduler *scheduler() const;
+
     // Nodes in which this object is referenced
     // If result is nullptr, it just returns number of referencing getReferencingNodes
     virtual int getReferencingNodes(QVector<AbstractCircuitNode *> *result) const;
@@ -31,9 +31,7 @@
 
 #include <QJsonObject>
 #include <QJsonArray>
-
-#include <QFont>
-#include <QColor>
+#include <QSet>
 
 
 AbstractSimulationObjectModel::AbstractSimulationObjectModel(ModeManager *mgr,
@@ -157,14 +155,14 @@ AbstractSimulationObject *AbstractSimulationObjectModel::objectAt(int row) const
     return mObjects.value(row, nullptr);
 }
 
-AbstractSimulationObject *AbstractSimulationObjectModel::getObjectByName(const QString &name) const
+AbstractSimulationObject *AbstractSimulationObjectModel::getObjectByUniqueId(const QString &uniqueId) const
 {
-    for(int i = 0; i < mObjects.size(); i++)
-    {
-        if(mObjects.at(i)->name() == name)
-            return mObjects.at(i);
-    }
-    return nullptr;
+    if(uniqueId.size() <= mObjectType.size()
+            || !uniqueId.startsWith(mObjectType)
+            || uniqueId.at(mObjectType.size()) != QLatin1Char('.'))
+        return nullptr;
+
+    return getObjectByName(uniqueId.mid(mObjectType.size() + 1));
 }
 
 QString AbstractSimulationObjectModel::getObjectPrettyName() const
@@ -181,25 +179,69 @@ void AbstractSimulationObjectModel::clear()
     endResetModel();
 }
 
-bool AbstractSimulationObjectModel::loadFromJSON(const QJsonObject &modelObj, LoadPhase phase)
+bool AbstractSimulationObjectModel::parseObjects(const QJsonObject &modelObj,
+                                                 const QString &objType,
+                                                 ParsedObjects &result)
 {
-    if(modelObj.value("model_type") != mObjectType)
+    if(modelObj.value("model_type") != objType)
         return false;
 
+    const QJsonArray arr = modelObj.value("objects").toArray();
+    result.objects.reserve(arr.size());
+
+    QSet<QString> names;
+    names.reserve(arr.size());
+
+    for(const QJsonValue& v : arr)
+    {
+        if(!v.isObject())
+            continue;
+
+        QJsonObject obj = v.toObject();
+
+        // Object would reject it at creation anyway
+        if(obj.value("type") != objType)
+            continue;
+
+        const QString name = obj.value("name").toString();
+        if(names.contains(name))
+            continue; // Skip duplicates
+
+        names.insert(name);
+        result.objects.append(obj);
+    }
+
+    return true;
+}
+
+bool AbstractSimulationObjectModel::loadParsed(ParsedObjects &parsed, LoadPhase phase)
+{
     if(phase == LoadPhase::Creation)
     {
         beginResetModel();
 
         clearInternal();
-    }
 
-    const QJsonArray arr = modelObj.value("objects").toArray();
+        // Create all objects
+        SimulationObjectFactory *factory = modeMgr()->objectFactory();
 
-    QJsonArray result;
-    addObjectsFromArray_internal(arr, result, phase);
+        parsed.items.fill(nullptr, parsed.objects.size());
+        mObjects.reserve(parsed.objects.size());
+
+        for(int i = 0; i < parsed.objects.size(); i++)
+        {
+            AbstractSimulationObject *item = factory->createItem(this);
+            if(!item || !item->loadFromJSON(parsed.objects.at(i), LoadPhase::Creation))
+            {
+                delete item;
+                continue;
+            }
+
+            addObjectInternal(item);
+            mObjects.append(item);
+            parsed.items[i] = item;
+        }
 
-    if(phase == LoadPhase::Creation)
-    {
         std::sort(mObjects.begin(),
                   mObjects.end(),
                   [](const AbstractSimulationObject *a,
@@ -210,6 +252,22 @@ bool AbstractSimulationObjectModel::loadFromJSON(const QJsonObject &modelObj, Lo
 
         endResetModel();
     }
+    else
+    {
+        // Now that all objects are created,
+        // let objects connect to each other
+        Q_ASSERT(parsed.items.size() == parsed.objects.size());
+
+        for(int i = 0; i < parsed.items.size(); i++)
+        {
+            AbstractSimulationObject *item = parsed.items.at(i);
+            if(!item)
+                continue;
+
+            // In this second phase we ignore the result
+            item->loadFromJSON(parsed.objects.at(i), LoadPhase::AllCreated);
+        }
+    }
 
     return true;
 }
@@ -289,11 +347,6 @@ void AbstractSimulationObjectModel::addObjectsFromArray(const QJsonArray &arr,
     }
 }
 
-bool AbstractSimulationObjectModel::isNameAvailable(const QString &name) const
-{
-    return getObjectByName(name) == nullptr;
-}
-
 void AbstractSimulationObjectModel::resetHasUnsavedChanges()
 {
     if(!mHasUnsavedChanges)
@@ -321,6 +374,16 @@ void AbstractSimulationObjectModel::onObjectDestroyed(QObject *obj)
     int row = mObjects.indexOf(item);
     Q_ASSERT(row >= 0);
 
+    // Name cannot be read anymore, search it
+    for(auto it = mNameIndex.cbegin(); it != mNameIndex.cend(); it++)
+    {
+        if(it.value() == item)
+        {
+            unindexObject(item, it.key());
+            break;
+        }
+    }
+
     beginRemoveRows(QModelIndex(), row, row);
     mObjects.removeAt(row);
     endRemoveRows();
@@ -328,6 +391,14 @@ void AbstractSimulationObjectModel::onObjectDestroyed(QObject *obj)
     setModelEdited();
 }
 
+void AbstractSimulationObjectModel::onObjectNameChanged(AbstractSimulationObject *item,
+                                                        const QString &name,
+                                                        const QString &oldName)
+{
+    unindexObject(item, oldName);
+    indexObject(item, name);
+}
+
 void AbstractSimulationObjectModel::updateObjectRow(AbstractSimulationObject *item)
 {
     int row = mObjects.indexOf(item);
@@ -357,6 +428,25 @@ void AbstractSimulationObjectModel::clearInternal()
     mObjects.clear();
 }
 
+void AbstractSimulationObjectModel::indexObject(AbstractSimulationObject *item,
+                                                const QString &name)
+{
+    mNameIndex.insert(name, item);
+    mModeMgr->mObjectIndex.insert(uniqueIdForName(name), item);
+}
+
+void AbstractSimulationObjectModel::unindexObject(AbstractSimulationObject *item,
+                                                  const QString &name)
+{
+    // Another object might have taken the name
+    auto it = mNameIndex.find(name);
+    if(it == mNameIndex.end() || it.value() != item)
+        return;
+
+    mNameIndex.erase(it);
+    mModeMgr->mObjectIndex.remove(uniqueIdForName(name));
+}
+
 void AbstractSimulationObjectModel::addObjectsFromArray_internal(const QJsonArray &arr,
                                                                  QJsonArray &result,
                                                                  LoadPhase phase)
@@ -410,8 +500,12 @@ void AbstractSimulationObjectModel::addObjectsFromArray_internal(const QJsonArra
 
 void AbstractSimulationObjectModel::addObjectInternal(AbstractSimulationObject *item)
 {
+    indexObject(item, item->name());
+
     connect(item, &QObject::destroyed,
             this, &AbstractSimulationObjectModel::onObjectDestroyed);
+    connect(item, &AbstractSimulationObject::nameChanged,
+            this, &AbstractSimulationObjectModel::onObjectNameChanged);
     connect(item, &AbstractSimulationObject::settingsChanged,
             this, &AbstractSimulationObjectModel::onObjectChanged);
     connect(item, &AbstractSimulationObject::stateChanged,
@@ -422,8 +516,12 @@ void AbstractSimulationObjectModel::addObjectInternal(AbstractSimulationObject *
 
 void AbstractSimulationObjectModel::removeObjectInternal(AbstractSimulationObject *item)
 {
+    unindexObject(item, item->name());
+
     disconnect(item, &QObject::destroyed,
                this, &AbstractSimulationObjectModel::onObjectDestroyed);
+    disconnect(item, &AbstractSimulationObject::nameChanged,
+               this, &AbstractSimulationObjectModel::onObjectNameChanged);
     disconnect(item, &AbstractSimulationObject::settingsChanged,
                this, &AbstractSimulationObjectModel::onObjectChanged);
     disconnect(item, &AbstractSimulationObject::stateChanged,
@@ -444,30 +542,9 @@ QVariant AbstractSimulationObjectModel::nodesCountData(const AbstractSimulationO
         return nodesCount;
     case Qt::TextAlignmentRole:
         return int(Qt::AlignRight | Qt::AlignVCenter);
-    case Qt::FontRole:
-    {
-        if(highlight)
-        {
-            // Highlight objects not referenced by nodes
-            // Bold font
-            QFont f;
-            f.setBold(true);
-            return f;
-        }
-
-        break;
-    }
-    case Qt::BackgroundRole:
-    {
-        if(highlight)
-        {
-            // Highlight objects not referenced by nodes
-            // Light red background
-            return QColor(qRgb(255, 140, 140));
-        }
-
-        break;
-    }
+    case HighlightRole:
+        // Highlight objects not referenced by nodes
+        return highlight;
     case Qt::ToolTipRole:
     {
         if(!tip.isNull())
@@ -26,6 +26,8 @@
 #include <QAbstractTableModel>
 
 #include <QVector>
+#include <QHash>
+#include <QJsonObject>
 
 enum class LoadPhase;
 
@@ -33,7 +35,6 @@ class AbstractSimulationObject;
 
 class ModeManager;
 
-class QJsonObject;
 class QJsonArray;
 
 class AbstractSimulationObjectModel : public QAbstractTableModel
@@ -48,6 +49,24 @@ class AbstractSimulationObjectModel : public QAbstractTableModel
         NCols
     };
 
+    // Custom roles, views map them to colors and fonts
+    enum Roles
+    {
+        HighlightRole = Qt::UserRole + 1, // bool, e.g. object not used by nodes
+        StatusRole // ObjectStatus of NameCol
+    };
+
+    enum class ObjectStatus
+    {
+        Normal = 0,
+        Active,
+        Transition,
+        Encoder,
+        Blinker,
+        Timer,
+        Remote
+    };
+
     AbstractSimulationObjectModel(ModeManager *mgr,
                                   const QString& objTypeName,
                                   QObject *parent = nullptr);
@@ -70,7 +89,18 @@ class AbstractSimulationObjectModel : public QAbstractTableModel
 
     AbstractSimulationObject *objectAt(int row) const;
 
-    AbstractSimulationObject *getObjectByName(const QString& name) const;
+    inline AbstractSimulationObject *getObjectByName(const QString& name) const
+    {
+        return mNameIndex.value(name, nullptr);
+    }
+
+    AbstractSimulationObject *getObjectByUniqueId(const QString& uniqueId) const;
+
+    // Same as AbstractSimulationObject::uniqueId()
+    inline QString uniqueIdForName(const QString& name) const
+    {
+        return mObjectType + QLatin1Char('.') + name;
+    }
 
     inline int rowForObject(AbstractSimulationObject *item) const
     {
@@ -89,11 +119,28 @@ class AbstractSimulationObjectModel : public QAbstractTableModel
 
     QString getObjectPrettyName() const;
 
+    // Object JSON of a model, kept between load phases.
+    // Objects of other types and duplicate names are already discarded.
+    struct ParsedObjects
+    {
+        QVector<QJsonObject> objects;
+
+        // Set by Creation phase, nullptr if object failed to load
+        QVector<AbstractSimulationObject *> items;
+    };
+
+    static bool parseObjects(const QJsonObject& modelObj,
+                             const QString& objType,
+                             ParsedObjects& result);
+
     void clear();
-    bool loadFromJSON(const QJsonObject& modelObj, LoadPhase phase);
+    bool loadParsed(ParsedObjects& parsed, LoadPhase phase);
     void saveToJSON(QJsonObject& modelObj) const;
 
-    bool isNameAvailable(const QString& name) const;
+    inline bool isNameAvailable(const QString& name) const
+    {
+        return !mNameIndex.contains(name);
+    }
 
     inline bool hasUnsavedChanges() const
     {
@@ -116,12 +163,18 @@ private slots:
     void onObjectChanged(AbstractSimulationObject *item);
     void onObjectStateChanged(AbstractSimulationObject *item);
     void onObjectDestroyed(QObject *obj);
+    void onObjectNameChanged(AbstractSimulationObject *item,
+                             const QString& name, const QString& oldName);
 
 private:
     void updateObjectRow(AbstractSimulationObject *item);
     void setModelEdited();
     void clearInternal();
 
+    // Keep name index and ModeManager global index in sync
+    void indexObject(AbstractSimulationObject *item, const QString& name);
+    void unindexObject(AbstractSimulationObject *item, const QString& name);
+
     void addObjectsFromArray_internal(const QJsonArray& arr,
                                       QJsonArray &result,
                                       LoadPhase phase);
@@ -140,6 +193,7 @@ private slots:
     ModeManager *mModeMgr;
 
     QVector<AbstractSimulationObject *> mObjects;
+    QHash<QString, AbstractSimulationObject *> mNameIndex;
 
     const QString mObjectType;
 
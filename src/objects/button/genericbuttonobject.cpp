@@ -174,8 +174,8 @@ void GenericButtonObject::onReplicaModeChanged(bool on)
 
 void GenericButtonObject::startReturnTimer()
 {
-    mReturnTimeout.start(buttonIface->timeoutMillis(),
-                         Qt::PreciseTimer, this);
+    mReturnTimeout.start(scheduler(), buttonIface->timeoutMillis(),
+                         this);
 }
 
 void GenericButtonObject::setNewLockRange()
@@ -25,7 +25,7 @@
 
 #include "../abstractsimulationobject.h"
 
-#include <QBasicTimer>
+#include "../../utils/simulationscheduler.h"
 
 class ButtonInterface;
 class MechanicalInterface;
@@ -61,7 +61,7 @@ class GenericButtonObject : public AbstractSimulationObject
     ButtonInterface *buttonIface = nullptr;
     MechanicalInterface *mechanicalIface = nullptr;
 
-    QBasicTimer mReturnTimeout;
+    SimulationTimer mReturnTimeout;
     int mReturnTimerId = 0;
 };
 
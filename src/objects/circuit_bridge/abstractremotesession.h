@@ -0,0 +1,51 @@
+/**
+ * src/objects/circuit_bridge/abstractremotesession.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef ABSTRACTREMOTESESSION_H
+#define ABSTRACTREMOTESESSION_H
+
+#include <QString>
+
+class RemoteCircuitBridge;
+
+// Peer session which RemoteCircuitBridge sends its modes to
+class AbstractRemoteSession
+{
+public:
+    virtual ~AbstractRemoteSession() {}
+
+    virtual QString getSessionName() const = 0;
+
+    virtual bool isConnected() const = 0;
+
+    virtual void addRemoteBridge(RemoteCircuitBridge *bridge) = 0;
+    virtual void removeRemoteBridge(RemoteCircuitBridge *bridge) = 0;
+
+    virtual bool isRemoteBridgeNameAvailable(const QString& name,
+                                             RemoteCircuitBridge *excluded = nullptr) const = 0;
+
+    virtual void onLocalBridgeModeChanged(quint64 peerNodeId,
+                                          qint8 mode, qint8 pole,
+                                          qint8 replyToMode, quint8 circuitFlags) = 0;
+};
+
+#endif // ABSTRACTREMOTESESSION_H
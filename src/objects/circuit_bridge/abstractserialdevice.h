@@ -0,0 +1,53 @@
+/**
+ * src/objects/circuit_bridge/abstractserialdevice.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef ABSTRACTSERIALDEVICE_H
+#define ABSTRACTSERIALDEVICE_H
+
+#include <QString>
+
+class RemoteCircuitBridge;
+
+// Serial device which RemoteCircuitBridge inputs and outputs are mapped to
+class AbstractSerialDevice
+{
+public:
+    virtual ~AbstractSerialDevice() {}
+
+    virtual QString getName() const = 0;
+
+    virtual bool isInputFree(int inputId) const = 0;
+    virtual bool isOutputFree(int outputId) const = 0;
+
+    virtual void onOutputChanged(int outputId, int mode) = 0;
+
+    virtual void addRemoteBridge(RemoteCircuitBridge *bridge) = 0;
+    virtual void removeRemoteBridge(RemoteCircuitBridge *bridge) = 0;
+
+    virtual bool changeRemoteBridgeInput(RemoteCircuitBridge *bridge,
+                                         int oldValue, int newValue) = 0;
+
+    virtual bool changeRemoteBridgeOutput(RemoteCircuitBridge *bridge,
+                                          int oldValue, int newValue) = 0;
+};
+
+#endif // ABSTRACTSERIALDEVICE_H
@@ -27,16 +27,16 @@
 #include "../../circuits/nodes/remotecablecircuitnode.h"
 
 #include "../../views/modemanager.h"
+#include "../../views/modemanagerfrontend.h"
+#include "../simulationrecorder.h"
 
-#include "../../network/remotemanager.h"
-#include "../../network/remotesession.h"
-
-#include "../../serial/serialmanager.h"
-#include "../../serial/serialdevice.h"
+#include "abstractremotesession.h"
+#include "abstractserialdevice.h"
 
 #include <QTimer>
 
 #include <QJsonObject>
+#include <QCborArray>
 
 RemoteCircuitBridge::RemoteCircuitBridge(AbstractSimulationObjectModel *m)
     : AbstractSimulationObject{m}
@@ -90,9 +90,8 @@ bool RemoteCircuitBridge::loadFromJSON(const QJsonObject &obj, LoadPhase phase)
     const QString peerSessionName = obj.value("remote_session").toString().trimmed();
     if(!peerSessionName.isEmpty())
     {
-        RemoteManager *remoteMgr = model()->modeMgr()->getRemoteManager();
-        RemoteSession *remoteSession = remoteMgr->addRemoteSession(peerSessionName);
-        setRemoteSession(remoteSession);
+        AbstractModeManagerFrontend *frontend = model()->modeMgr()->frontend();
+        setRemoteSession(frontend->addRemoteSession(peerSessionName));
     }
 
     mSerialInputId = obj.value("device_input_id").toInt();
@@ -101,9 +100,8 @@ bool RemoteCircuitBridge::loadFromJSON(const QJsonObject &obj, LoadPhase phase)
     const QString devName = obj.value("device_name").toString().simplified();
     if(!devName.isEmpty())
     {
-        SerialManager *serialMgr = model()->modeMgr()->getSerialManager();
-        SerialDevice *dev = serialMgr->addDevice(devName);
-        setSerialDevice(dev);
+        AbstractModeManagerFrontend *frontend = model()->modeMgr()->frontend();
+        setSerialDevice(frontend->addSerialDevice(devName));
     }
 
     return true;
@@ -181,7 +179,7 @@ QString RemoteCircuitBridge::remoteSessionName() const
     return QString();
 }
 
-bool RemoteCircuitBridge::setRemoteSession(RemoteSession *remoteSession)
+bool RemoteCircuitBridge::setRemoteSession(AbstractRemoteSession *remoteSession)
 {
     if(mRemoteSession == remoteSession)
         return true;
@@ -368,6 +366,9 @@ void RemoteCircuitBridge::onLocalNodeModeChanged(RemoteCableCircuitNode *node)
 
 void RemoteCircuitBridge::onSerialInputMode(int mode)
 {
+    model()->modeMgr()->recorder()->record(SimulationRecorder::EventType::BridgeSerialInput,
+                                           this, mode);
+
     if(!mNodeA)
         return;
 
@@ -483,11 +484,11 @@ QString RemoteCircuitBridge::getSerialDeviceName() const
 
 bool RemoteCircuitBridge::isRemoteSessionConnected() const
 {
-    return mRemoteSession && mRemoteSession->getConnection()
+    return mRemoteSession && mRemoteSession->isConnected()
             && mPeerNodeId != 0;
 }
 
-bool RemoteCircuitBridge::setSerialDevice(SerialDevice *serialDevice)
+bool RemoteCircuitBridge::setSerialDevice(AbstractSerialDevice *serialDevice)
 {
     if(mSerialDevice == serialDevice)
         return true;
@@ -530,6 +531,9 @@ void RemoteCircuitBridge::onRemoteNodeModeChanged(qint8 mode, qint8 pole,
     const RemoteCableCircuitNode::Mode replyMode = RemoteCableCircuitNode::Mode(replyToMode);
     const CircuitFlags recvFlags = CircuitFlags(circuitFlags);
 
+    model()->modeMgr()->recorder()->record(SimulationRecorder::EventType::BridgeRemoteMode,
+                                           this, QCborArray{mode, pole, replyToMode, circuitFlags});
+
     if(!mNodeA)
         return;
 
@@ -560,6 +564,9 @@ void RemoteCircuitBridge::onRemoteNodeModeChanged(qint8 mode, qint8 pole,
 
 void RemoteCircuitBridge::onRemoteDisconnected()
 {
+    model()->modeMgr()->recorder()->record(SimulationRecorder::EventType::BridgeRemoteDisconnected,
+                                           this);
+
     if(mNodeA)
         mNodeA->onPeerModeChanged(RemoteCableCircuitNode::Mode::None,
                                   CircuitPole::First,
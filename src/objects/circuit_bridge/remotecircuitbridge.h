@@ -27,8 +27,8 @@
 
 class RemoteCableCircuitNode;
 
-class RemoteSession;
-class SerialDevice;
+class AbstractRemoteSession;
+class AbstractSerialDevice;
 
 class RemoteCircuitBridge : public AbstractSimulationObject
 {
@@ -60,12 +60,12 @@ class RemoteCircuitBridge : public AbstractSimulationObject
     // Remote Session
     QString remoteSessionName() const;
 
-    inline RemoteSession *getRemoteSession() const
+    inline AbstractRemoteSession *getRemoteSession() const
     {
         return mRemoteSession;
     }
 
-    bool setRemoteSession(RemoteSession *remoteSession);
+    bool setRemoteSession(AbstractRemoteSession *remoteSession);
 
     // TODO: make private
     void onRemoteNodeModeChanged(qint8 mode, qint8 pole,
@@ -86,7 +86,7 @@ class RemoteCircuitBridge : public AbstractSimulationObject
     // Serial Device
     QString getSerialDeviceName() const;
 
-    inline SerialDevice *getSerialDevice() const
+    inline AbstractSerialDevice *getSerialDevice() const
     {
         return mSerialDevice;
     }
@@ -98,7 +98,7 @@ class RemoteCircuitBridge : public AbstractSimulationObject
 
     bool isRemoteSessionConnected() const;
 
-    bool setSerialDevice(SerialDevice *serialDevice);
+    bool setSerialDevice(AbstractSerialDevice *serialDevice);
 
     int serialInputId() const;
     void setSerialInputId(int newSerialInputId);
@@ -120,6 +120,7 @@ private slots:
 
     friend class SerialManager;
     friend class SerialDevice;
+    friend class SimulationRecorder;
     void onSerialInputMode(int mode);
 
 private:
@@ -133,12 +134,12 @@ private slots:
     // Remote Session
     friend class RemoteManager;
     friend class RemoteSession;
-    RemoteSession *mRemoteSession = nullptr;
+    AbstractRemoteSession *mRemoteSession = nullptr;
     QString mPeerNodeCustomName;
     size_t mPeerNodeId = 0;
 
     // Serial Device
-    SerialDevice *mSerialDevice = nullptr;
+    AbstractSerialDevice *mSerialDevice = nullptr;
     qint64 mSerialNameId = 0;
     int mSerialInputId = 0;
     int mSerialOutputId = 0;
@@ -24,8 +24,6 @@
 
 #include "remotecircuitbridge.h"
 
-#include <QColor>
-
 RemoteCircuitBridgesModel::RemoteCircuitBridgesModel(ModeManager *mgr, QObject *parent)
     : AbstractSimulationObjectModel(mgr, RemoteCircuitBridge::Type, parent)
 {
@@ -88,11 +86,11 @@ QVariant RemoteCircuitBridgesModel::data(const QModelIndex &idx, int role) const
     if(!bridge)
         return QVariant();
 
-    if(idx.column() == NameCol && role == Qt::DecorationRole)
+    if(idx.column() == NameCol && role == StatusRole)
     {
         // If bridge is remote, show red decoration
         if(bridge->isRemote())
-            return QColor(Qt::red);
+            return int(ObjectStatus::Remote);
 
         return QVariant(); // Not decorated
     }
@@ -24,6 +24,7 @@
 #include "../abstractsimulationobject.h"
 
 #include "../../circuits/nodes/levercontactnode.h"
+#include "../../circuits/simulationprofiler.h"
 
 #include <QJsonObject>
 
@@ -286,7 +287,14 @@ void LeverInterface::setPosition(int newPosition)
 
         mPosition = p;
 
-        emitChanged(PositionPropName, mPosition);
+        {
+            // Contacts switch together, circuits are updated once.
+            // Commit at every step, locked range may change
+            SimulationProfiler::EventScope profile(SimulationProfiler::EventType::LeverMove);
+            AbstractDeviatorNode::ContactBatch batch;
+            emitChanged(PositionPropName, mPosition);
+        }
+
         emit mObject->stateChanged(mObject);
     }
 }
@@ -588,7 +596,7 @@ void LeverInterface::startSpringTimer()
     stopSpringTimer();
 
     // Update every 100ms for a semi-smooth animation
-    springTimer.start(std::chrono::milliseconds(100), mObject);
+    springTimer.start(mObject->scheduler(), std::chrono::milliseconds(100), mObject);
 }
 
 int LeverInterface::absoluteMin() const
@@ -26,8 +26,7 @@
 #include "abstractobjectinterface.h"
 
 #include "../../utils/enum_desc.h"
-
-#include <QBasicTimer>
+#include "../../utils/simulationscheduler.h"
 
 class LeverContactNode;
 
@@ -241,7 +240,7 @@ class LeverInterface : public AbstractObjectInterface
     // After last position we go to a "middle" and the first again
     bool mCanWarpAroundZero = false;
 
-    QBasicTimer springTimer;
+    SimulationTimer springTimer;
 
     bool mHasSpringReturnMin = false;
     bool mHasSpringReturnMax = false;
@@ -25,13 +25,13 @@
 #include "../../../circuits/nodes/relaiscontactnode.h"
 #include "../../../circuits/nodes/relaispowernode.h"
 
+#include "../../../circuits/simulationprofiler.h"
+
 #include <QTimerEvent>
 
 #include <QJsonObject>
 #include <QCborMap>
 
-#include <QRandomGenerator>
-
 #include <QCoreApplication>
 
 class AbstractRelaisUpdateFlagsEvent : public QEvent
@@ -316,8 +316,9 @@ void AbstractRelais::timerEvent(QTimerEvent *e)
             if(relaisType() == RelaisType::Blinker && mCustomDownMS > 0)
             {
                 // Asymmetric blink
-                mPositionTimer.start(state() == State::Down ? mCustomDownMS : mCustomUpMS,
-                                     Qt::PreciseTimer, this);
+                mPositionTimer.start(scheduler(),
+                                     state() == State::Down ? mCustomDownMS : mCustomUpMS,
+                                     this);
             }
 
             return;
@@ -391,8 +392,9 @@ void AbstractRelais::powerNodeActivated(RelaisPowerNode *p, bool secondContact)
             mPositionTimer.stop();
 
             // Timer will switch state
-            mPositionTimer.start(mCustomDownMS > 0 ? mCustomDownMS : mCustomUpMS,
-                                 Qt::PreciseTimer, this);
+            mPositionTimer.start(scheduler(),
+                                 mCustomDownMS > 0 ? mCustomDownMS : mCustomUpMS,
+                                 this);
         }
         else
         {
@@ -548,7 +550,7 @@ void AbstractRelais::startMove(bool up)
     // Relay can be up to 5% faster/slower
     const double MaxTimeOscillationRel = 0.05;
     const double factor =
-            QRandomGenerator::global()->bounded(MaxTimeOscillationRel * 2) - MaxTimeOscillationRel;
+            scheduler()->random()->bounded(MaxTimeOscillationRel * 2) - MaxTimeOscillationRel;
     const int timeOscillation = qRound(double(totalTime) * factor);
 
     totalTime += timeOscillation;
@@ -559,7 +561,7 @@ void AbstractRelais::startMove(bool up)
     // How much to change position at each tick
     mTickPositionDelta = double(tickDurationMS) / double(totalTime);
 
-    mPositionTimer.start(tickDurationMS, Qt::PreciseTimer, this);
+    mPositionTimer.start(scheduler(), tickDurationMS, this);
 }
 
 void AbstractRelais::setDecodedResult(SignalAspectCode code)
@@ -828,6 +830,9 @@ void AbstractRelais::setState(State newState)
         }
     }
 
+    // Contacts switch together, circuits are updated once
+    SimulationProfiler::EventScope profile(SimulationProfiler::EventType::RelayMove);
+    AbstractDeviatorNode::ContactBatch batch;
     emit stateChanged(this);
 }
 
@@ -27,7 +27,8 @@
 #include "../../../enums/signalaspectcodes.h"
 
 #include <QElapsedTimer>
-#include <QBasicTimer>
+
+#include "../../../utils/simulationscheduler.h"
 
 class RelaisPowerNode;
 class RelaisContactNode;
@@ -217,7 +218,7 @@ class AbstractRelais : public AbstractSimulationObject
     quint32 mCustomDownMS = 0;
     double mTickPositionDelta = 0;
     double mPosition = 0.0;
-    QBasicTimer mPositionTimer;
+    SimulationTimer mPositionTimer;
 
     QVector<RelaisPowerNode *> mPowerNodes;
     int mActivePowerNodesUp = 0;
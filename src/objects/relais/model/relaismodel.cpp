@@ -26,15 +26,9 @@
 
 #include "../../../views/modemanager.h"
 
-#include "../../../circuits/graphs/circuitcolors.h"
-
-#include <QColor>
-
 #include <QJsonObject>
 #include <QJsonArray>
 
-#include <QFont>
-
 RelaisModel::RelaisModel(ModeManager *mgr, QObject *parent)
     : AbstractSimulationObjectModel(mgr, AbstractRelais::Type, parent)
 {
@@ -71,18 +65,18 @@ QVariant RelaisModel::data(const QModelIndex &idx, int role) const
     if(!relay)
         return QVariant();
 
-    if(idx.column() == NameCol && role == Qt::DecorationRole)
+    if(idx.column() == NameCol && role == StatusRole)
     {
         // Show a little colored square based on relay state
-        QColor color = Qt::black;
+        ObjectStatus status = ObjectStatus::Normal;
         switch (relay->state())
         {
         case AbstractRelais::State::Up:
-            color = CircuitColors::Closed; // Red
+            status = ObjectStatus::Active; // Red
             break;
         case AbstractRelais::State::GoingUp:
         case AbstractRelais::State::GoingDown:
-            color = CircuitColors::Open; // Light blue
+            status = ObjectStatus::Transition; // Light blue
             break;
         case AbstractRelais::State::Down:
         default:
@@ -96,27 +90,27 @@ QVariant RelaisModel::data(const QModelIndex &idx, int role) const
             {
             case AbstractRelais::RelaisType::Encoder:
             case AbstractRelais::RelaisType::CodeRepeater:
-                color = Qt::darkCyan;
+                status = ObjectStatus::Encoder;
                 break;
             case AbstractRelais::RelaisType::Blinker:
-                color = Qt::darkGreen;
+                status = ObjectStatus::Blinker;
                 break;
             case AbstractRelais::RelaisType::Timer:
-                color = Qt::darkMagenta;
+                status = ObjectStatus::Timer;
                 break;
             default:
             {
                 // For other types, show default state
                 if(relay->normallyUp())
-                    color = CircuitColors::Closed; // Red
+                    status = ObjectStatus::Active; // Red
                 else
-                    color = Qt::black;
+                    status = ObjectStatus::Normal;
                 break;
             }
             }
         }
 
-        return color;
+        return int(status);
     }
     else if(idx.column() == NameCol && role == Qt::ToolTipRole)
     {
@@ -25,6 +25,8 @@
 #include "../../../circuits/nodes/screenrelaiscontactnode.h"
 #include "../../../circuits/nodes/screenrelaispowernode.h"
 
+#include "../../../circuits/simulationprofiler.h"
+
 #include "../../../utils/enum_desc.h"
 
 #include <QTimerEvent>
@@ -102,7 +104,7 @@ void ScreenRelais::onReplicaModeChanged(bool on)
     if(!on)
     {
         // Return to local target position
-        mTimer.start(std::chrono::milliseconds(50), this);
+        mTimer.start(scheduler(), std::chrono::milliseconds(50), this);
     }
 }
 
@@ -196,7 +198,7 @@ int ScreenRelais::getReferencingNodes(QVector<AbstractCircuitNode *> *result) co
 
 void ScreenRelais::timerEvent(QTimerEvent *e)
 {
-    if(e->id() == mTimer.id())
+    if(e->timerId() == mTimer.timerId())
     {
         if(isRemoteReplica() || qFuzzyCompare(mTargetPosition, mPosition))
         {
@@ -241,7 +243,7 @@ void ScreenRelais::setPowerState(PowerState newState)
     mTargetPosition = getTargetPosition(screenType(), mState);
 
     if(!mTimer.isActive())
-        mTimer.start(std::chrono::milliseconds(50), this);
+        mTimer.start(scheduler(), std::chrono::milliseconds(50), this);
 }
 
 void ScreenRelais::setPosition(double newPosition)
@@ -264,9 +266,16 @@ void ScreenRelais::setPosition(double newPosition)
     // Update contact state
     const auto stateA = ScreenRelaisContactNode::ContactState(getContactStateA());
     const auto stateB = ScreenRelaisContactNode::ContactState(getContactStateB());
-    for(ScreenRelaisContactNode *node : std::as_const(mContactNodes))
+
     {
-        node->setState(node->isContactA() ? stateA : stateB);
+        // Contacts switch together, circuits are updated once
+        SimulationProfiler::EventScope profile(SimulationProfiler::EventType::RelayMove);
+        AbstractDeviatorNode::ContactBatch batch;
+
+        for(ScreenRelaisContactNode *node : std::as_const(mContactNodes))
+        {
+            node->setState(node->isContactA() ? stateA : stateB);
+        }
     }
 
     emit stateChanged(this);
@@ -316,9 +325,16 @@ void ScreenRelais::setScreenType(ScreenType newType)
     // Update contact state
     const auto stateA = ScreenRelaisContactNode::ContactState(getContactStateA());
     const auto stateB = ScreenRelaisContactNode::ContactState(getContactStateB());
-    for(ScreenRelaisContactNode *node : std::as_const(mContactNodes))
+
     {
-        node->setState(node->isContactA() ? stateA : stateB);
+        // Contacts switch together, circuits are updated once
+        SimulationProfiler::EventScope profile(SimulationProfiler::EventType::RelayMove);
+        AbstractDeviatorNode::ContactBatch batch;
+
+        for(ScreenRelaisContactNode *node : std::as_const(mContactNodes))
+        {
+            node->setState(node->isContactA() ? stateA : stateB);
+        }
     }
 
     emit stateChanged(this);
@@ -25,7 +25,7 @@
 
 #include "../../abstractsimulationobject.h"
 
-#include <QBasicTimer>
+#include "../../../utils/simulationscheduler.h"
 
 class ScreenRelaisPowerNode;
 class ScreenRelaisContactNode;
@@ -165,7 +165,7 @@ class ScreenRelais : public AbstractSimulationObject
     double mPosition = 0.0;
     double mTargetPosition = 0.0;
 
-    QBasicTimer mTimer;
+    SimulationTimer mTimer;
 
     ScreenRelaisPowerNode *mPowerNode = nullptr;
 
@@ -26,13 +26,9 @@
 
 #include "../../../views/modemanager.h"
 
-#include <QColor>
-
 #include <QJsonObject>
 #include <QJsonArray>
 
-#include <QFont>
-
 ScreenRelaisModel::ScreenRelaisModel(ModeManager *mgr, QObject *parent)
     : AbstractSimulationObjectModel(mgr, ScreenRelais::Type, parent)
 {
@@ -26,13 +26,9 @@
 
 #include "../../views/modemanager.h"
 
-#include <QColor>
-
 #include <QJsonObject>
 #include <QJsonArray>
 
-#include <QFont>
-
 AbstractActivableObjectsModel::AbstractActivableObjectsModel(ModeManager *mgr, const QString &type_, QObject *parent)
     : AbstractSimulationObjectModel(mgr, type_, parent)
 {
@@ -44,14 +40,13 @@ QVariant AbstractActivableObjectsModel::data(const QModelIndex &idx, int role) c
     if(!activableObj)
         return QVariant();
 
-    if(idx.column() == NameCol && role == Qt::DecorationRole)
+    if(idx.column() == NameCol && role == StatusRole)
     {
-        // Show a little colored square based on relay state
-        QColor color = Qt::black;
+        // Show a little colored square based on object state
         if(activableObj->state() == AbstractSimpleActivableObject::State::On)
-            color = Qt::red;
+            return int(ObjectStatus::Active);
 
-        return color;
+        return int(ObjectStatus::Normal);
     }
 
     return AbstractSimulationObjectModel::data(idx, role);
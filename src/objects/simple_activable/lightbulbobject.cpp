@@ -52,6 +52,11 @@ void LightBulbObject::getReplicaState(QCborMap &replicaState) const
     replicaState[QLatin1StringView("state")] = int(state());
 }
 
+void LightBulbObject::getSnapshotState(QCborMap &state) const
+{
+    Q_UNUSED(state);
+}
+
 void LightBulbObject::onReplicaModeChanged(bool on)
 {
     if(!on)
@@ -37,6 +37,9 @@ class LightBulbObject : public AbstractSimpleActivableObject
     bool setReplicaState(const QCborMap& replicaState) override;
     void getReplicaState(QCborMap& replicaState) const override;
 
+    // Light follows its circuit
+    void getSnapshotState(QCborMap& state) const override;
+
     State state() const override;
 
 protected:
@@ -0,0 +1,73 @@
+/**
+ * src/objects/simple_activable/soundeffectplayer.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SOUNDEFFECTPLAYER_H
+#define SOUNDEFFECTPLAYER_H
+
+#include <QObject>
+#include <QVector>
+
+#include "abstractsoundplayer.h"
+
+class QSoundEffect;
+
+class QPropertyAnimation;
+
+class SoundEffectPlayer : public QObject, public AbstractSoundPlayer
+{
+    Q_OBJECT
+public:
+    enum SoundState
+    {
+        Stopped = 0,
+        Playing = 1,
+        FadeIn = 2,
+        FadeOut = 3
+    };
+
+    explicit SoundEffectPlayer(QObject *parent = nullptr);
+    ~SoundEffectPlayer();
+
+    void setSoundFile(const QString& fileName) override;
+    void setLoopEnabled(bool enabled) override;
+
+    void setPlaying(bool playing) override;
+
+    SoundState soundState() const;
+    void setSoundState(SoundState newState);
+
+private slots:
+    void onFadeEnd();
+    void onPlayingChanged();
+
+private:
+    QSoundEffect *mSound = nullptr;
+    QPropertyAnimation *mFadeAnimation = nullptr;
+    QVector<QSoundEffect *> mOverlappedSounds;
+
+    SoundState mSoundState = SoundState::Stopped;
+    bool stoppedByNewState = false;
+
+    bool mLoopEnabled = true;
+};
+
+#endif // SOUNDEFFECTPLAYER_H
@@ -21,48 +21,29 @@
  */
 
 #include "soundobject.h"
+#include "abstractsoundplayer.h"
 
 #include "../abstractsimulationobjectmodel.h"
 
 #include "../../views/modemanager.h"
+#include "../../views/modemanagerfrontend.h"
 
 #include <QJsonObject>
 
 #include <QDir>
 
-#include <QSoundEffect>
-
-#include <QPropertyAnimation>
-
-
 SoundObject::SoundObject(AbstractSimulationObjectModel *m)
     : AbstractSimpleActivableObject(m)
 {
-    mSound = new QSoundEffect(this);
-    mSound->setVolume(0);
-
-    mFadeAnimation = new QPropertyAnimation(mSound, "volume", this);
-    connect(mFadeAnimation, &QPropertyAnimation::finished,
-            this, &SoundObject::onFadeEnd);
-    connect(mSound, &QSoundEffect::playingChanged,
-            this, &SoundObject::onPlayingChanged);
-
-    mSound->setLoopCount(QSoundEffect::Infinite);
+    mPlayer = model()->modeMgr()->frontend()->createSoundPlayer();
+    if(mPlayer)
+        mPlayer->setLoopEnabled(mLoopEnabled);
 }
 
 SoundObject::~SoundObject()
 {
-    const auto overlappedCopy = mOverlappedSounds;
-    for(QSoundEffect *sound : overlappedCopy)
-    {
-        sound->stop();
-        delete sound;
-    };
-    Q_ASSERT(mOverlappedSounds.isEmpty());
-
-    mSound->stop();
-    delete mSound;
-    mSound = nullptr;
+    delete mPlayer;
+    mPlayer = nullptr;
 }
 
 QString SoundObject::getType() const
@@ -118,130 +99,22 @@ void SoundObject::saveToJSON(QJsonObject &obj) const
     obj["sound_file"] = soundPath;
 }
 
-SoundObject::SoundState SoundObject::soundState() const
-{
-    return mSoundState;
-}
-
-void SoundObject::setSoundState(SoundState newState)
-{
-    if(newState == mSoundState)
-        return;
-
-    if(mLoopEnabled)
-    {
-        // For loops we implement fade in/fade out
-        // on node activation/deactivation
-        if(newState == SoundState::Playing && mSoundState != SoundState::FadeIn)
-        {
-            setSoundState(SoundState::FadeIn);
-            return;
-        }
-
-        if(newState == SoundState::Stopped && mSoundState != SoundState::FadeOut)
-        {
-            setSoundState(SoundState::FadeOut);
-            return;
-        }
-    }
-
-    // Stop animation
-    stoppedByNewState = true;
-    mFadeAnimation->stop();
-    stoppedByNewState = false;
-
-    mSoundState = newState;
-
-    if(mSoundState == SoundState::Stopped)
-    {
-        // Let single sound go on until end
-        // Stop only loop sounds
-        if(mLoopEnabled)
-            mSound->stop();
-    }
-    else if(mSoundState == SoundState::Playing)
-    {
-        if(mLoopEnabled)
-        {
-            // Nothing to do, FadeIn already put as at max volume
-        }
-        else
-        {
-            QSoundEffect *soundEffect = mSound;
-            if(mSound->isPlaying() && mOverlappedSounds.size() < 3)
-            {
-                // FIXME: still not working properly
-                // Trigger ALSA error if played rapidly many times
-                // "ALSA lib pcm.c:8675:(snd_pcm_recover) underrun occurred"
-
-                // Our sound is already playing
-                // Probably because node has stopped
-                // but audio sample is not finished yet
-
-                // We create a new sound of same file and play it over
-                // original
-
-                soundEffect = new QSoundEffect(this);
-                soundEffect->setSource(mSound->source());
-                mOverlappedSounds.append(soundEffect);
-                connect(soundEffect, &QSoundEffect::playingChanged,
-                        [soundEffect]()
-                {
-                    if(!soundEffect->isPlaying())
-                        soundEffect->deleteLater();
-                });
-                connect(soundEffect, &QObject::destroyed,
-                        [this, soundEffect]()
-                {
-                    mOverlappedSounds.removeOne(soundEffect);
-                });
-            }
-
-            soundEffect->setVolume(1.0);
-            soundEffect->play();
-        }
-    }
-    else if(mSoundState == SoundState::FadeIn)
-    {
-        if(!mSound->isPlaying())
-            mFadeAnimation->setStartValue(0.2);
-        else
-            mFadeAnimation->setStartValue(mSound->volume());
-        mFadeAnimation->setEndValue(1.0);
-        mFadeAnimation->setEasingCurve(QEasingCurve::OutCubic);
-        mFadeAnimation->setDuration(500);
-        mFadeAnimation->start();
-
-        // Start playing
-        if(!mSound->isPlaying())
-            mSound->play();
-    }
-    else if(mSoundState == SoundState::FadeOut)
-    {
-        // Do not stop playing yet
-        mFadeAnimation->setStartValue(mSound->volume());
-        mFadeAnimation->setEndValue(0.0);
-        mFadeAnimation->setEasingCurve(QEasingCurve::OutCubic);
-        mFadeAnimation->setDuration(1000);
-        mFadeAnimation->start();
-    }
-
-    emit stateChanged(this);
-}
-
 QString SoundObject::getSoundFile() const
 {
-    return mSound->source().toLocalFile();
+    return mSoundFile;
 }
 
 void SoundObject::setSoundFile(const QString &fileName)
 {
     QFileInfo info(fileName);
     QString canonicalFile = info.canonicalFilePath();
-    if(getSoundFile() == canonicalFile)
+    if(mSoundFile == canonicalFile)
         return;
 
-    mSound->setSource(QUrl::fromLocalFile(canonicalFile));
+    mSoundFile = canonicalFile;
+
+    if(mPlayer)
+        mPlayer->setSoundFile(mSoundFile);
 
     emit settingsChanged(this);
 }
@@ -258,34 +131,16 @@ void SoundObject::setLoopEnabled(bool newLoopEnabled)
 
     mLoopEnabled = newLoopEnabled;
 
-    mSound->setLoopCount(mLoopEnabled ? QSoundEffect::Infinite : 1);
+    if(mPlayer)
+        mPlayer->setLoopEnabled(mLoopEnabled);
 
     emit settingsChanged(this);
 }
 
-void SoundObject::onFadeEnd()
-{
-    if(stoppedByNewState)
-        return;
-
-    if(mSoundState == SoundState::FadeIn)
-        setSoundState(SoundState::Playing);
-    else if(mSoundState == SoundState::FadeOut)
-        setSoundState(SoundState::Stopped);
-}
-
-void SoundObject::onPlayingChanged()
-{
-    if(!mSound->isPlaying() && !stoppedByNewState)
-        setSoundState(SoundState::Stopped);
-}
-
 void SoundObject::onStateChangedInternal()
 {
-    if(state() == State::On)
-        setSoundState(SoundState::Playing);
-    else
-        setSoundState(SoundState::Stopped);
+    if(mPlayer)
+        mPlayer->setPlaying(state() == State::On);
 
     AbstractSimpleActivableObject::onStateChangedInternal();
 }
@@ -25,23 +25,11 @@
 
 #include "abstractsimpleactivableobject.h"
 
-#include <QVector>
-
-class QSoundEffect;
-
-class QPropertyAnimation;
+class AbstractSoundPlayer;
 
 class SoundObject : public AbstractSimpleActivableObject
 {
 public:
-    enum SoundState
-    {
-        Stopped = 0,
-        Playing = 1,
-        FadeIn = 2,
-        FadeOut = 3
-    };
-
     explicit SoundObject(AbstractSimulationObjectModel *m);
     ~SoundObject();
 
@@ -51,30 +39,20 @@ class SoundObject : public AbstractSimpleActivableObject
     bool loadFromJSON(const QJsonObject& obj, LoadPhase phase) override;
     void saveToJSON(QJsonObject& obj) const override;
 
-    SoundState soundState() const;
-    void setSoundState(SoundState newState);
-
     QString getSoundFile() const;
     void setSoundFile(const QString &fileName);
 
     bool loopEnabled() const;
     void setLoopEnabled(bool newLoopEnabled);
 
-private slots:
-    void onFadeEnd();
-    void onPlayingChanged();
-
 protected:
     virtual void onStateChangedInternal();
 
 private:
-    QSoundEffect *mSound = nullptr;
-    QPropertyAnimation *mFadeAnimation = nullptr;
-    QVector<QSoundEffect *> mOverlappedSounds;
-
-    SoundState mSoundState = SoundState::Stopped;
-    bool stoppedByNewState = false;
+    // Provided by ModeManager frontend, nullptr if sound is not available
+    AbstractSoundPlayer *mPlayer = nullptr;
 
+    QString mSoundFile;
     bool mLoopEnabled = true;
 };
 
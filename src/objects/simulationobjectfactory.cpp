@@ -25,8 +25,6 @@
 #include "abstractsimulationobjectmodel.h"
 #include "abstractsimulationobject.h"
 
-#include "simulationobjectoptionswidget.h"
-
 SimulationObjectFactory::SimulationObjectFactory()
 {
 
@@ -57,29 +55,6 @@ AbstractSimulationObject *SimulationObjectFactory::createItem(AbstractSimulation
     return item;
 }
 
-SimulationObjectOptionsWidget *SimulationObjectFactory::createEditWidget(QWidget *parent,
-                                                                         AbstractSimulationObject *item,
-                                                                         ViewManager *viewMgr) const
-{
-    const FactoryItem *factory = getItemForType(item->getType());
-    if(!factory)
-        return nullptr;
-
-    SimulationObjectOptionsWidget *optionsWidget =
-            new SimulationObjectOptionsWidget(item, viewMgr, parent);
-
-    if(factory->edit)
-    {
-        QWidget *customWidget = factory->edit(item, viewMgr);
-        if(customWidget)
-            optionsWidget->addCustomWidget(customWidget);
-    }
-
-    optionsWidget->fixScrollingChildrenInScrollArea();
-
-    return optionsWidget;
-}
-
 QStringList SimulationObjectFactory::getRegisteredTypes() const
 {
     QStringList result;
@@ -120,11 +95,32 @@ QString SimulationObjectFactory::prettyName(const QString &objType) const
     return factory->prettyName;
 }
 
+SimulationObjectFactory::EditFunc SimulationObjectFactory::editFunc(const QString &objType) const
+{
+    const FactoryItem *factory = getItemForType(objType);
+    if(!factory)
+        return nullptr;
+
+    return factory->edit;
+}
+
 void SimulationObjectFactory::registerFactory(const FactoryItem &factory)
 {
     mItems.append(factory);
 }
 
+void SimulationObjectFactory::setEditFunc(const QString &objType, EditFunc edit)
+{
+    for(FactoryItem& item : mItems)
+    {
+        if(item.objectType == objType)
+        {
+            item.edit = edit;
+            return;
+        }
+    }
+}
+
 const SimulationObjectFactory::FactoryItem *SimulationObjectFactory::getItemForType(const QString &objType) const
 {
     for(const FactoryItem& item : std::as_const(mItems))
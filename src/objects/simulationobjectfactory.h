@@ -29,8 +29,6 @@
 class AbstractSimulationObjectModel;
 class AbstractSimulationObject;
 
-class SimulationObjectOptionsWidget;
-
 class ModeManager;
 class ViewManager;
 
@@ -61,10 +59,6 @@ class SimulationObjectFactory
 
     AbstractSimulationObject *createItem(AbstractSimulationObjectModel *model) const;
 
-    SimulationObjectOptionsWidget *createEditWidget(QWidget *parent,
-                                                    AbstractSimulationObject *item,
-                                                    ViewManager *viewMgr) const;
-
     // Info
     QStringList getRegisteredTypes() const;
     QStringList typesForInterface(const QString& ifaceName) const;
@@ -72,8 +66,12 @@ class SimulationObjectFactory
 
     QString prettyName(const QString& objType) const;
 
+    // Edit widgets are registered separately by GUI
+    EditFunc editFunc(const QString& objType) const;
+
     // Register
     void registerFactory(const FactoryItem& factory);
+    void setEditFunc(const QString& objType, EditFunc edit);
 
 private:
     const FactoryItem *getItemForType(const QString& objType) const;
@@ -35,6 +35,8 @@
 
 #include "../utils/jsondiff.h"
 
+#include "../circuits/graphs/circuitcolors.h"
+
 #include <QVBoxLayout>
 #include <QTableView>
 #include <QPushButton>
@@ -56,6 +58,80 @@
 
 #include <QKeyEvent>
 
+#include <QColor>
+#include <QFont>
+
+// Maps model custom roles to colors and fonts
+class SimulationObjectProxyModel : public QSortFilterProxyModel
+{
+public:
+    typedef AbstractSimulationObjectModel::ObjectStatus ObjectStatus;
+
+    using QSortFilterProxyModel::QSortFilterProxyModel;
+
+    QVariant data(const QModelIndex &idx, int role) const override
+    {
+        switch (role)
+        {
+        case Qt::DecorationRole:
+        {
+            const QVariant status = QSortFilterProxyModel::data(idx, AbstractSimulationObjectModel::StatusRole);
+            if(!status.isValid())
+                break;
+
+            return statusColor(ObjectStatus(status.toInt()));
+        }
+        case Qt::FontRole:
+        {
+            if(QSortFilterProxyModel::data(idx, AbstractSimulationObjectModel::HighlightRole).toBool())
+            {
+                // Bold font
+                QFont f;
+                f.setBold(true);
+                return f;
+            }
+            break;
+        }
+        case Qt::BackgroundRole:
+        {
+            if(QSortFilterProxyModel::data(idx, AbstractSimulationObjectModel::HighlightRole).toBool())
+            {
+                // Light red background
+                return QColor(qRgb(255, 140, 140));
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        return QSortFilterProxyModel::data(idx, role);
+    }
+
+    static QColor statusColor(ObjectStatus status)
+    {
+        switch (status)
+        {
+        case ObjectStatus::Active:
+        case ObjectStatus::Remote:
+            return QColor(CircuitColors::Closed); // Red
+        case ObjectStatus::Transition:
+            return QColor(CircuitColors::Open); // Light blue
+        case ObjectStatus::Encoder:
+            return QColor(Qt::darkCyan);
+        case ObjectStatus::Blinker:
+            return QColor(Qt::darkGreen);
+        case ObjectStatus::Timer:
+            return QColor(Qt::darkMagenta);
+        case ObjectStatus::Normal:
+        default:
+            break;
+        }
+
+        return QColor(Qt::black);
+    }
+};
+
 SimulationObjectListWidget::SimulationObjectListWidget(ViewManager *mgr, AbstractSimulationObjectModel *model, QWidget *parent)
     : QWidget{parent}
     , mViewMgr(mgr)
@@ -83,7 +159,7 @@ SimulationObjectListWidget::SimulationObjectListWidget(ViewManager *mgr, Abstrac
     mView = new QTableView;
     lay->addWidget(mView);
 
-    mProxyModel = new QSortFilterProxyModel(this);
+    mProxyModel = new SimulationObjectProxyModel(this);
     mProxyModel->setSourceModel(mModel);
     mProxyModel->setSortRole(Qt::DisplayRole);
     mProxyModel->sort(0);
@@ -291,15 +367,13 @@ void SimulationObjectListWidget::onBatchEdit()
     QJsonObject origSettings;
     curObj->saveToJSON(origSettings);
 
-    SimulationObjectFactory *factory = mModel->modeMgr()->objectFactory();
-
     QPointer<QDialog> dlg = new QDialog(this);
     dlg->setWindowTitle(tr("Batch Object Edit"));
 
     QVBoxLayout *lay = new QVBoxLayout(dlg);
 
     // Create edit widget
-    SimulationObjectOptionsWidget *w = factory->createEditWidget(nullptr, curObj, mViewMgr);
+    SimulationObjectOptionsWidget *w = SimulationObjectOptionsWidget::createEditWidget(nullptr, curObj, mViewMgr);
     lay->addWidget(w);
 
     QDialogButtonBox *dlgBut = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel,
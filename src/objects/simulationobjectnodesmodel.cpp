@@ -25,7 +25,6 @@
 #include "abstractsimulationobject.h"
 
 #include "../circuits/circuitscene.h"
-#include "../circuits/graphs/abstractnodegraphitem.h"
 #include "../circuits/nodes/abstractcircuitnode.h"
 #include "../circuits/edit/nodeeditfactory.h"
 
@@ -33,6 +32,7 @@
 
 #include "../views/viewmanager.h"
 #include "../views/modemanager.h"
+#include "../views/guimodefrontend.h"
 
 SimulationObjectNodesModel::SimulationObjectNodesModel(ViewManager *viewMgr, QObject *parent)
     : QAbstractTableModel(parent)
@@ -74,20 +74,19 @@ QVariant SimulationObjectNodesModel::data(const QModelIndex &idx, int role) cons
     if (role != Qt::DisplayRole || !idx.isValid() || idx.row() >= mItems.size() || idx.column() >= NCols)
         return QVariant();
 
-    AbstractNodeGraphItem *item = mItems.at(idx.row());
+    const NodeEntry& entry = mItems.at(idx.row());
 
     switch (idx.column())
     {
     case NodeTypeCol:
     {
-        return mViewMgr->modeMgr()->circuitFactory()
-                ->prettyName(item->getAbstractNode()->nodeType());
+        return GuiModeFrontend::get(mViewMgr->modeMgr())->circuitFactory()
+                ->prettyName(entry.node->nodeType());
     }
     case SceneNameCol:
     {
-        CircuitScene *s = item->circuitScene();
-        if(s)
-            return s->circuitSheetName();
+        if(entry.scene)
+            return entry.scene->circuitSheetName();
         break;
     }
     }
@@ -148,7 +147,7 @@ void SimulationObjectNodesModel::refreshNodeList()
 
     mObject->getReferencingNodes(&nodes);
 
-    NodeEditFactory *nodeFactory = mViewMgr->modeMgr()->circuitFactory();
+    NodeEditFactory *nodeFactory = GuiModeFrontend::get(mViewMgr->modeMgr())->circuitFactory();
     QStringList types = nodeFactory->getRegisteredTypes();
 
     // Sort according to type registering order
@@ -161,15 +160,15 @@ void SimulationObjectNodesModel::refreshNodeList()
         return types.indexOf(a->nodeType()) < types.indexOf(b->nodeType());
     });
 
-    auto circuitListModel = mViewMgr->modeMgr()->circuitList();
+    auto circuitListModel = GuiModeFrontend::get(mViewMgr->modeMgr())->circuitList();
 
     for(AbstractCircuitNode *node : nodes)
     {
-        AbstractNodeGraphItem *item = circuitListModel->getGraphForNode(node);
-        if(!item)
+        CircuitScene *scene = circuitListModel->sceneForNode(node);
+        if(!scene)
             continue;
 
-        mItems.append(item);
+        mItems.append({node, scene});
     }
 
     endResetModel();
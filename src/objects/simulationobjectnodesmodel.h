@@ -27,7 +27,8 @@
 #include <QVector>
 
 class AbstractSimulationObject;
-class AbstractNodeGraphItem;
+class AbstractCircuitNode;
+class CircuitScene;
 
 class ViewManager;
 
@@ -42,6 +43,12 @@ class SimulationObjectNodesModel : public QAbstractTableModel
         NCols
     };
 
+    struct NodeEntry
+    {
+        AbstractCircuitNode *node = nullptr;
+        CircuitScene *scene = nullptr;
+    };
+
     explicit SimulationObjectNodesModel(ViewManager *viewMgr,
                                         QObject *parent = nullptr);
 
@@ -57,9 +64,9 @@ class SimulationObjectNodesModel : public QAbstractTableModel
     AbstractSimulationObject *getObject() const;
     void setObject(AbstractSimulationObject *newObject);
 
-    inline AbstractNodeGraphItem *itemAt(int row) const
+    inline NodeEntry entryAt(int row) const
     {
-        return mItems.value(row, nullptr);
+        return mItems.value(row, NodeEntry());
     }
 
 private slots:
@@ -70,7 +77,7 @@ private slots:
     ViewManager *mViewMgr = nullptr;
 
     AbstractSimulationObject *mObject = nullptr;
-    QVector<AbstractNodeGraphItem *> mItems;
+    QVector<NodeEntry> mItems;
 };
 
 #endif // SIMULATION_OBJECT_NODES_MODEL_H
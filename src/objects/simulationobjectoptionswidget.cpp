@@ -24,10 +24,12 @@
 
 #include "abstractsimulationobjectmodel.h"
 #include "abstractsimulationobject.h"
+#include "simulationobjectfactory.h"
 
 #include "simulationobjectnodesmodel.h"
 
 #include "../views/viewmanager.h"
+#include "../views/modemanager.h"
 
 #include <QVBoxLayout>
 #include <QFormLayout>
@@ -115,6 +117,28 @@ SimulationObjectOptionsWidget::SimulationObjectOptionsWidget(AbstractSimulationO
     onNameChanged();
 }
 
+SimulationObjectOptionsWidget *SimulationObjectOptionsWidget::createEditWidget(QWidget *parent,
+                                                                               AbstractSimulationObject *item,
+                                                                               ViewManager *viewMgr)
+{
+    SimulationObjectFactory *factory = viewMgr->modeMgr()->objectFactory();
+
+    SimulationObjectOptionsWidget *optionsWidget =
+            new SimulationObjectOptionsWidget(item, viewMgr, parent);
+
+    SimulationObjectFactory::EditFunc edit = factory->editFunc(item->getType());
+    if(edit)
+    {
+        QWidget *customWidget = edit(item, viewMgr);
+        if(customWidget)
+            optionsWidget->addCustomWidget(customWidget);
+    }
+
+    optionsWidget->fixScrollingChildrenInScrollArea();
+
+    return optionsWidget;
+}
+
 void SimulationObjectOptionsWidget::addCustomWidget(QWidget *w)
 {
     static_cast<QFormLayout *>(scrollArea->widget()->layout())->addRow(w);
@@ -234,11 +258,11 @@ void SimulationObjectOptionsWidget::onNodeClicked(const QModelIndex &idx)
     const bool adjustZoom = !QGuiApplication::keyboardModifiers()
             .testFlag(Qt::AltModifier);
 
-    auto item = mNodesModel->itemAt(idx.row());
-    if(!item)
+    const SimulationObjectNodesModel::NodeEntry entry = mNodesModel->entryAt(idx.row());
+    if(!entry.node)
         return;
 
-    mViewMgr->ensureCircuitItemIsVisible(item, forceNew, adjustZoom);
+    mViewMgr->ensureCircuitNodeIsVisible(entry.scene, entry.node, forceNew, adjustZoom);
 }
 
 void SimulationObjectOptionsWidget::setNameValid(bool valid)
@@ -45,6 +45,11 @@ class SimulationObjectOptionsWidget : public QWidget
                                            ViewManager *viewMgr,
                                            QWidget *parent = nullptr);
 
+    // Adds custom widget registered in object factory
+    static SimulationObjectOptionsWidget *createEditWidget(QWidget *parent,
+                                                           AbstractSimulationObject *item,
+                                                           ViewManager *viewMgr);
+
     void addCustomWidget(QWidget *w);
 
     QString uniqueId() const;
@@ -0,0 +1,469 @@
+/**
+ * src/objects/simulationrecorder.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "simulationrecorder.h"
+
+#include "abstractsimulationobject.h"
+#include "abstractsimulationobjectmodel.h"
+#include "simulationobjectfactory.h"
+#include "simulationsnapshot.h"
+
+#include "interfaces/leverinterface.h"
+#include "interfaces/buttoninterface.h"
+
+#include "circuit_bridge/remotecircuitbridge.h"
+
+#include "traintastic/traintasticsensorobj.h"
+#include "traintastic/traintasticaxlecounterobj.h"
+
+#include "../views/modemanager.h"
+#include "../views/modemanagerfrontend.h"
+
+#include <QFile>
+#include <QCborArray>
+#include <QTimerEvent>
+#include <QRandomGenerator>
+
+static constexpr quint32 RecordMagic = 0x53524543; // SREC
+static constexpr quint16 RecordVersion = 1;
+
+// Precedes type and name of objects on first use
+static constexpr quint8 DefineObjectTag = 0xFF;
+
+SimulationRecorder::SimulationRecorder(ModeManager *mgr)
+    : QObject{mgr}
+    , mModeMgr(mgr)
+{
+
+}
+
+SimulationRecorder::~SimulationRecorder()
+{
+    stopRecording();
+    stopReplay();
+}
+
+bool SimulationRecorder::startRecording(const QString &fileName)
+{
+    if(mModeMgr->mode() != FileMode::Simulation)
+    {
+        mErrorString = tr("Recording needs Simulation mode");
+        return false;
+    }
+
+    if(isRecording() || isReplaying())
+    {
+        mErrorString = tr("Recording or replay already running");
+        return false;
+    }
+
+    QFile *f = new QFile(fileName);
+    if(!f->open(QFile::WriteOnly | QFile::Truncate))
+    {
+        mErrorString = tr("Cannot write file: %1").arg(f->errorString());
+        delete f;
+        return false;
+    }
+
+    mRecordFile = f;
+    mRecordStream.setDevice(mRecordFile);
+    mRecordStream.setVersion(QDataStream::Qt_6_0);
+
+    // Replay will reseed, so relay timings match
+    SimulationScheduler *scheduler = mModeMgr->scheduler();
+    const quint32 seed = QRandomGenerator::global()->generate();
+    scheduler->setRandomSeed(seed);
+
+    mRecordStream << RecordMagic << RecordVersion << seed;
+
+    mRecordBase = scheduler->syncedTime();
+    mLastEventTime = 0;
+
+    writeInitialStates();
+    connectInputObjects(true);
+
+    emit recordingChanged(true);
+    return true;
+}
+
+void SimulationRecorder::stopRecording()
+{
+    if(!mRecordFile)
+        return;
+
+    connectInputObjects(false);
+
+    mRecordStream.setDevice(nullptr);
+    mRecordFile->close();
+    delete mRecordFile;
+    mRecordFile = nullptr;
+
+    mRecordIds.clear();
+    mLastStates.clear();
+
+    emit recordingChanged(false);
+}
+
+bool SimulationRecorder::startReplay(const QString &fileName)
+{
+    if(mModeMgr->mode() != FileMode::Simulation)
+    {
+        mErrorString = tr("Replay needs Simulation mode");
+        return false;
+    }
+
+    if(isRecording() || isReplaying())
+    {
+        mErrorString = tr("Recording or replay already running");
+        return false;
+    }
+
+    QFile f(fileName);
+    if(!f.open(QFile::ReadOnly))
+    {
+        mErrorString = tr("Cannot read file: %1").arg(f.errorString());
+        return false;
+    }
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint32 seed = 0;
+    in >> magic >> version >> seed;
+
+    if(in.status() != QDataStream::Ok || magic != RecordMagic || version > RecordVersion)
+    {
+        mErrorString = tr("Not a valid recording");
+        return false;
+    }
+
+    mReplayObjects.clear();
+    mReplayEvents.clear();
+
+    qint64 time = 0;
+    while(!in.atEnd())
+    {
+        quint8 tag = 0;
+        in >> tag;
+
+        if(tag == DefineObjectTag)
+        {
+            QString objType, name;
+            in >> objType >> name;
+
+            // Missing objects are skipped
+            AbstractSimulationObjectModel *model = mModeMgr->modelForType(objType);
+            mReplayObjects.append(model ? model->getObjectByName(name) : nullptr);
+            continue;
+        }
+
+        quint32 delta = 0;
+        quint32 objIdx = 0;
+        QByteArray args;
+        in >> delta >> objIdx >> args;
+
+        // Recording may be truncated if session was not closed
+        if(in.status() != QDataStream::Ok)
+            break;
+
+        if(tag >= quint8(EventType::NTypes) || objIdx >= quint32(mReplayObjects.size()))
+        {
+            mReplayObjects.clear();
+            mReplayEvents.clear();
+            mErrorString = tr("Recording is corrupted");
+            return false;
+        }
+
+        time += delta;
+
+        Event ev;
+        ev.time = time;
+        ev.type = EventType(tag);
+        ev.objectIdx = int(objIdx);
+        ev.args = QCborValue::fromCbor(args);
+        mReplayEvents.append(ev);
+    }
+
+    // Only recorded inputs must reach simulation
+    mModeMgr->frontend()->disconnectAll();
+
+    // Start from recorded states and seed
+    SimulationScheduler *scheduler = mModeMgr->scheduler();
+    scheduler->setRandomSeed(seed);
+
+    SimulationSnapshot initialState = SimulationSnapshot::captureScheduler(mModeMgr);
+    int pos = 0;
+    for(; pos < mReplayEvents.size() && mReplayEvents.at(pos).time == 0; pos++)
+    {
+        const Event& ev = mReplayEvents.at(pos);
+        AbstractSimulationObject *obj = mReplayObjects.at(ev.objectIdx);
+
+        if(ev.type == EventType::ObjectState && obj)
+            initialState.addObjectState(obj, ev.args.toMap());
+        else
+            applyEvent(ev);
+    }
+
+    initialState.restore(mModeMgr);
+
+    // Objects reacting to restored states may have used random source
+    scheduler->setRandomSeed(seed);
+
+    mReplayPos = pos;
+    mReplayBase = scheduler->syncedTime();
+    mReplaying = true;
+
+    emit replayChanged(true);
+
+    scheduleNextEvent();
+    return true;
+}
+
+void SimulationRecorder::stopReplay()
+{
+    if(!mReplaying)
+        return;
+
+    mReplayTimer.stop();
+    mReplaying = false;
+
+    mReplayObjects.clear();
+    mReplayEvents.clear();
+    mReplayPos = 0;
+
+    emit replayChanged(false);
+}
+
+qint64 SimulationRecorder::timeToNextEvent() const
+{
+    if(!mReplaying || mReplayPos >= mReplayEvents.size())
+        return -1;
+
+    const qint64 deadline = mReplayBase + mReplayEvents.at(mReplayPos).time;
+    return qMax(qint64(0), deadline - mModeMgr->scheduler()->currentTime());
+}
+
+void SimulationRecorder::timerEvent(QTimerEvent *e)
+{
+    if(e->timerId() == mReplayTimer.timerId())
+    {
+        const qint64 now = mModeMgr->scheduler()->currentTime() - mReplayBase;
+
+        while(mReplayPos < mReplayEvents.size() && mReplayEvents.at(mReplayPos).time <= now)
+        {
+            const Event ev = mReplayEvents.at(mReplayPos++);
+            applyEvent(ev);
+
+            if(!mReplaying)
+                return; // Stopped by event
+        }
+
+        scheduleNextEvent();
+        return;
+    }
+
+    QObject::timerEvent(e);
+}
+
+void SimulationRecorder::onObjectStateChanged(AbstractSimulationObject *obj)
+{
+    QCborMap state;
+    obj->getSnapshotState(state);
+
+    // Levers emit for angle and position separately
+    QCborMap &lastState = mLastStates[obj];
+    if(lastState == state)
+        return;
+    lastState = state;
+
+    // Spring return, button return timeout and CommandNode
+    // act from timers, replay reproduces them by itself
+    if(mModeMgr->scheduler()->isDelivering())
+        return;
+
+    record(EventType::ObjectState, obj, state);
+}
+
+void SimulationRecorder::writeEvent(EventType type, AbstractSimulationObject *obj, const QCborValue &args)
+{
+    Q_ASSERT(obj);
+
+    auto it = mRecordIds.constFind(obj);
+    if(it == mRecordIds.constEnd())
+    {
+        it = mRecordIds.insert(obj, mRecordIds.size());
+        mRecordStream << DefineObjectTag << obj->getType() << obj->name();
+    }
+
+    // Store time difference, keeps it small
+    const qint64 time = mModeMgr->scheduler()->syncedTime() - mRecordBase;
+    const quint32 delta = quint32(qMax(qint64(0), time - mLastEventTime));
+    mLastEventTime += delta;
+
+    mRecordStream << quint8(type) << delta << quint32(it.value()) << args.toCbor();
+}
+
+void SimulationRecorder::writeInitialStates()
+{
+    const QStringList types = mModeMgr->objectFactory()->getRegisteredTypes();
+    for(const QString& objType : types)
+    {
+        AbstractSimulationObjectModel *model = mModeMgr->modelForType(objType);
+        if(!model)
+            continue;
+
+        for(int row = 0; row < model->rowCount(); row++)
+        {
+            AbstractSimulationObject *item = model->objectAt(row);
+
+            QCborMap state;
+            if(item->isRemoteReplica())
+            {
+                item->getReplicaState(state);
+                if(!state.isEmpty())
+                    record(EventType::ReplicaState, item, state);
+                continue;
+            }
+
+            item->getSnapshotState(state);
+            if(state.isEmpty())
+                continue;
+
+            mLastStates.insert(item, state);
+            record(EventType::ObjectState, item, state);
+        }
+    }
+}
+
+void SimulationRecorder::connectInputObjects(bool on)
+{
+    const QStringList types = mModeMgr->objectFactory()->getRegisteredTypes();
+    for(const QString& objType : types)
+    {
+        AbstractSimulationObjectModel *model = mModeMgr->modelForType(objType);
+        if(!model)
+            continue;
+
+        for(int row = 0; row < model->rowCount(); row++)
+        {
+            AbstractSimulationObject *item = model->objectAt(row);
+
+            // Replicas are recorded when remote state is received
+            if(item->isRemoteReplica())
+                continue;
+
+            // Only levers and buttons are moved by user
+            if(!item->getInterface<LeverInterface>() && !item->getInterface<ButtonInterface>())
+                continue;
+
+            if(on)
+            {
+                connect(item, &AbstractSimulationObject::stateChanged,
+                        this, &SimulationRecorder::onObjectStateChanged);
+            }
+            else
+            {
+                disconnect(item, &AbstractSimulationObject::stateChanged,
+                           this, &SimulationRecorder::onObjectStateChanged);
+            }
+        }
+    }
+}
+
+void SimulationRecorder::applyEvent(const Event &ev)
+{
+    AbstractSimulationObject *obj = mReplayObjects.at(ev.objectIdx);
+    if(!obj)
+        return;
+
+    switch (ev.type)
+    {
+    case EventType::ObjectState:
+    {
+        obj->setSnapshotState(ev.args.toMap());
+        break;
+    }
+    case EventType::ReplicaState:
+    {
+        obj->setReplicaState(ev.args.toMap());
+        break;
+    }
+    case EventType::SensorState:
+    {
+        TraintasticSensorObj *sensor = qobject_cast<TraintasticSensorObj *>(obj);
+        if(sensor)
+            sensor->setState(int(ev.args.toInteger()));
+        break;
+    }
+    case EventType::AxleCounter:
+    {
+        TraintasticAxleCounterObj *axleCounter = qobject_cast<TraintasticAxleCounterObj *>(obj);
+        const QCborArray args = ev.args.toArray();
+        if(axleCounter && args.size() == 2)
+            axleCounter->axleCounterEvent(int32_t(args.at(0).toInteger()), args.at(1).toBool());
+        break;
+    }
+    case EventType::BridgeRemoteMode:
+    {
+        RemoteCircuitBridge *bridge = qobject_cast<RemoteCircuitBridge *>(obj);
+        const QCborArray args = ev.args.toArray();
+        if(bridge && args.size() == 4)
+        {
+            bridge->onRemoteNodeModeChanged(qint8(args.at(0).toInteger()),
+                                            qint8(args.at(1).toInteger()),
+                                            qint8(args.at(2).toInteger()),
+                                            quint8(args.at(3).toInteger()));
+        }
+        break;
+    }
+    case EventType::BridgeRemoteDisconnected:
+    {
+        RemoteCircuitBridge *bridge = qobject_cast<RemoteCircuitBridge *>(obj);
+        if(bridge)
+            bridge->onRemoteDisconnected();
+        break;
+    }
+    case EventType::BridgeSerialInput:
+    {
+        RemoteCircuitBridge *bridge = qobject_cast<RemoteCircuitBridge *>(obj);
+        if(bridge)
+            bridge->onSerialInputMode(int(ev.args.toInteger()));
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void SimulationRecorder::scheduleNextEvent()
+{
+    if(mReplayPos >= mReplayEvents.size())
+    {
+        // Replay finished
+        stopReplay();
+        return;
+    }
+
+    mReplayTimer.start(mModeMgr->scheduler(), int(timeToNextEvent()), this);
+}
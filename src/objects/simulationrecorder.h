@@ -0,0 +1,157 @@
+/**
+ * src/objects/simulationrecorder.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIMULATIONRECORDER_H
+#define SIMULATIONRECORDER_H
+
+#include <QObject>
+#include <QVector>
+#include <QHash>
+#include <QPointer>
+#include <QCborValue>
+#include <QCborMap>
+#include <QDataStream>
+
+#include "../utils/simulationscheduler.h"
+
+class ModeManager;
+class AbstractSimulationObject;
+
+class QFile;
+
+/*!
+ * \brief The SimulationRecorder class
+ *
+ * Records external inputs with their simulation time
+ * to a compact binary file and replays them back.
+ *
+ * Recording starts with state of all objects and
+ * reseeds simulation random source, so replay starts
+ * from same conditions and is deterministic.
+ * State changes done by simulation timers are not recorded.
+ *
+ * Replay events are delivered by a simulation timer,
+ * so clock mode decides if it runs at real time
+ * or as fast as possible.
+ * While replaying, network and serial inputs are disconnected.
+ */
+class SimulationRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    enum class EventType : quint8
+    {
+        ObjectState = 0,   // Lever or button moved by user, snapshot state
+        ReplicaState,      // Remote source object state received
+        SensorState,       // Traintastic sensor or turnout feedback
+        AxleCounter,       // Traintastic axle counter, [diff, firstSensor]
+        BridgeRemoteMode,  // Remote peer, [mode, pole, replyToMode, flags]
+        BridgeRemoteDisconnected,
+        BridgeSerialInput, // Serial InputChange mode
+        NTypes
+    };
+
+    explicit SimulationRecorder(ModeManager *mgr);
+    ~SimulationRecorder();
+
+    bool startRecording(const QString& fileName);
+    void stopRecording();
+
+    inline bool isRecording() const
+    {
+        return mRecordFile != nullptr;
+    }
+
+    bool startReplay(const QString& fileName);
+    void stopReplay();
+
+    inline bool isReplaying() const
+    {
+        return mReplaying;
+    }
+
+    // Simulation time until next replayed event, -1 if not replaying
+    qint64 timeToNextEvent() const;
+
+    // Called by input sources
+    inline void record(EventType type, AbstractSimulationObject *obj,
+                       const QCborValue& args = QCborValue())
+    {
+        if(mRecordFile)
+            writeEvent(type, obj, args);
+    }
+
+    inline QString errorString() const
+    {
+        return mErrorString;
+    }
+
+signals:
+    void recordingChanged(bool on);
+    void replayChanged(bool on);
+
+protected:
+    void timerEvent(QTimerEvent *e) override;
+
+private slots:
+    void onObjectStateChanged(AbstractSimulationObject *obj);
+
+private:
+    struct Event
+    {
+        qint64 time = 0;
+        EventType type = EventType::NTypes;
+        int objectIdx = -1;
+        QCborValue args;
+    };
+
+    void writeEvent(EventType type, AbstractSimulationObject *obj,
+                    const QCborValue& args);
+    void writeInitialStates();
+    void connectInputObjects(bool on);
+
+    void applyEvent(const Event& ev);
+    void scheduleNextEvent();
+
+private:
+    ModeManager *mModeMgr;
+
+    // Recording
+    QFile *mRecordFile = nullptr;
+    QDataStream mRecordStream;
+    qint64 mRecordBase = 0;
+    qint64 mLastEventTime = 0;
+    QHash<AbstractSimulationObject *, int> mRecordIds;
+    QHash<AbstractSimulationObject *, QCborMap> mLastStates;
+
+    // Replay
+    QVector<QPointer<AbstractSimulationObject>> mReplayObjects;
+    QVector<Event> mReplayEvents;
+    int mReplayPos = 0;
+    qint64 mReplayBase = 0;
+    SimulationTimer mReplayTimer;
+    bool mReplaying = false;
+
+    QString mErrorString;
+};
+
+#endif // SIMULATIONRECORDER_H
@@ -0,0 +1,115 @@
+/**
+ * src/objects/simulationsnapshot.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "simulationsnapshot.h"
+
+#include "abstractsimulationobject.h"
+#include "abstractsimulationobjectmodel.h"
+#include "simulationobjectfactory.h"
+
+#include "../views/modemanager.h"
+
+// Relays moved by restored levers can move other relays
+static constexpr int MaxSettlePasses = 4;
+
+SimulationSnapshot SimulationSnapshot::capture(ModeManager *modeMgr)
+{
+    SimulationSnapshot snapshot = captureScheduler(modeMgr);
+
+    const QStringList types = modeMgr->objectFactory()->getRegisteredTypes();
+    for(const QString& objType : types)
+    {
+        AbstractSimulationObjectModel *model = modeMgr->modelForType(objType);
+        if(!model)
+            continue;
+
+        for(int row = 0; row < model->rowCount(); row++)
+        {
+            AbstractSimulationObject *item = model->objectAt(row);
+
+            // Replicas follow their remote source
+            if(item->isRemoteReplica())
+                continue;
+
+            ObjectState objState;
+            item->getSnapshotState(objState.state);
+            if(objState.state.isEmpty())
+                continue;
+
+            objState.object = item;
+            snapshot.mObjects.append(objState);
+        }
+    }
+
+    return snapshot;
+}
+
+SimulationSnapshot SimulationSnapshot::captureScheduler(ModeManager *modeMgr)
+{
+    SimulationSnapshot snapshot;
+    snapshot.mSimulationTime = modeMgr->scheduler()->currentTime();
+    snapshot.mRandom = *modeMgr->scheduler()->random();
+    return snapshot;
+}
+
+void SimulationSnapshot::addObjectState(AbstractSimulationObject *obj, const QCborMap &state)
+{
+    ObjectState objState;
+    objState.object = obj;
+    objState.state = state;
+    mObjects.append(objState);
+}
+
+int SimulationSnapshot::restore(ModeManager *modeMgr) const
+{
+    *modeMgr->scheduler()->random() = mRandom;
+
+    int changedCount = 0;
+
+    for(int pass = 0; pass < MaxSettlePasses; pass++)
+    {
+        int passChanged = 0;
+
+        for(const ObjectState& objState : mObjects)
+        {
+            AbstractSimulationObject *item = objState.object;
+            if(!item || item->isRemoteReplica())
+                continue; // Removed after capture
+
+            QCborMap curState;
+            item->getSnapshotState(curState);
+            if(curState == objState.state)
+                continue;
+
+            item->setSnapshotState(objState.state);
+            passChanged++;
+        }
+
+        if(pass == 0)
+            changedCount = passChanged;
+
+        if(passChanged == 0)
+            break;
+    }
+
+    return changedCount;
+}
@@ -0,0 +1,93 @@
+/**
+ * src/objects/simulationsnapshot.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIMULATIONSNAPSHOT_H
+#define SIMULATIONSNAPSHOT_H
+
+#include <QVector>
+#include <QPointer>
+#include <QCborMap>
+#include <QRandomGenerator>
+
+class ModeManager;
+class AbstractSimulationObject;
+
+/*!
+ * \brief The SimulationSnapshot class
+ *
+ * In memory copy of simulation state of all objects.
+ * Restoring only applies states of objects which differ,
+ * so circuits are updated incrementally by the changed contacts
+ * instead of reloading file and searching from every power source.
+ *
+ * Objects driven by circuits may react to restored inputs
+ * so states are applied again until they settle.
+ * Simulation clock is not rewound, timers restart from restored states.
+ */
+class SimulationSnapshot
+{
+public:
+    SimulationSnapshot() = default;
+
+    static SimulationSnapshot capture(ModeManager *modeMgr);
+
+    // Only simulation time and random source,
+    // object states are added with addObjectState()
+    static SimulationSnapshot captureScheduler(ModeManager *modeMgr);
+
+    // Returns number of objects which were changed
+    int restore(ModeManager *modeMgr) const;
+
+    // Build snapshot from states stored elsewhere
+    void addObjectState(AbstractSimulationObject *obj, const QCborMap& state);
+
+    inline bool isEmpty() const
+    {
+        return mObjects.isEmpty();
+    }
+
+    // Simulation time at capture
+    inline qint64 simulationTime() const
+    {
+        return mSimulationTime;
+    }
+
+    inline int objectCount() const
+    {
+        return mObjects.size();
+    }
+
+private:
+    struct ObjectState
+    {
+        QPointer<AbstractSimulationObject> object;
+        QCborMap state;
+    };
+
+    QVector<ObjectState> mObjects;
+    qint64 mSimulationTime = 0;
+
+    // Keep simulated timings reproducible after restore
+    QRandomGenerator mRandom;
+};
+
+#endif // SIMULATIONSNAPSHOT_H
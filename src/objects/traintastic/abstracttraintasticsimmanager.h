@@ -0,0 +1,59 @@
+/**
+ * src/objects/traintastic/abstracttraintasticsimmanager.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef ABSTRACTTRAINTASTICSIMMANAGER_H
+#define ABSTRACTTRAINTASTICSIMMANAGER_H
+
+#include "../../network/traintastic-simulator/protocol.hpp"
+
+class TraintasticSensorObj;
+class TraintasticTurnoutObj;
+class TraintasticSpawnObj;
+
+// Connection to Traintastic simulator used by traintastic objects
+class AbstractTraintasticSimManager
+{
+public:
+    virtual ~AbstractTraintasticSimManager() {}
+
+    virtual bool isConnected() const = 0;
+
+    virtual void setTurnoutState(int channel, int address, int state) = 0;
+    virtual void setSpawnState(int address, bool active) = 0;
+
+    virtual void send(const SimulatorProtocol::Message &message) = 0;
+
+protected:
+    friend class TraintasticSensorObj;
+    virtual bool setSensorChannel(TraintasticSensorObj *obj, int newChannel) = 0;
+    virtual bool setSensorAddress(TraintasticSensorObj *obj, int newAddress) = 0;
+
+    friend class TraintasticTurnoutObj;
+    virtual void addTurnout(TraintasticTurnoutObj *obj) = 0;
+    virtual void removeTurnout(TraintasticTurnoutObj *obj) = 0;
+
+    friend class TraintasticSpawnObj;
+    virtual void addSpawn(TraintasticSpawnObj *obj) = 0;
+    virtual void removeSpawn(TraintasticSpawnObj *obj) = 0;
+};
+
+#endif // ABSTRACTTRAINTASTICSIMMANAGER_H
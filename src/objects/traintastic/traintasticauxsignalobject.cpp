@@ -26,9 +26,9 @@
 
 #include "../abstractsimulationobjectmodel.h"
 #include "../../views/modemanager.h"
+#include "../../views/modemanagerfrontend.h"
 
-#include "../../network/traintastic-simulator/traintasticsimmanager.h"
-#include "../../network/traintastic-simulator/protocol.hpp"
+#include "abstracttraintasticsimmanager.h"
 
 #include <QTimerEvent>
 
@@ -128,8 +128,9 @@ void TraintasticAuxSignalObject::sendStatusMsg()
 
     msg.position = mPosition;
 
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    mgr->send(msg);
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr)
+        mgr->send(msg);
 }
 
 void TraintasticAuxSignalObject::onAuxLightDestroyed(QObject *obj)
@@ -24,7 +24,6 @@
 #include "../abstractsimulationobjectmodel.h"
 
 #include "../../views/modemanager.h"
-#include "../../network/traintastic-simulator/traintasticsimmanager.h"
 
 #include "../../circuits/nodes/traintasticaxlecounternode.h"
 
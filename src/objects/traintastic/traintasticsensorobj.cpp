@@ -24,7 +24,8 @@
 #include "../abstractsimulationobjectmodel.h"
 
 #include "../../views/modemanager.h"
-#include "../../network/traintastic-simulator/traintasticsimmanager.h"
+#include "../../views/modemanagerfrontend.h"
+#include "abstracttraintasticsimmanager.h"
 
 #include "../../circuits/nodes/traintasticsensornode.h"
 
@@ -136,8 +137,8 @@ bool TraintasticSensorObj::setChannel(int newChannel)
     if(mChannel == newChannel)
         return true;
 
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    if(!mgr->setSensorChannel(this, newChannel))
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr && !mgr->setSensorChannel(this, newChannel))
         return false;
 
     mChannel = newChannel;
@@ -150,8 +151,8 @@ bool TraintasticSensorObj::setAddress(int newAddress)
     if(mAddress == newAddress)
         return true;
 
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    if(!mgr->setSensorAddress(this, newAddress))
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr && !mgr->setSensorAddress(this, newAddress))
         return false;
 
     mAddress = newAddress;
@@ -334,8 +335,8 @@ bool TraintasticSensorObj::setShuntTurnout(TraintasticTurnoutObj *newShuntTurnou
         mShuntTurnout->setSensor(this);
     }
 
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    if(!mgr->isConnected())
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(!mgr || !mgr->isConnected())
     {
         setState(mShuntTurnout ? mShuntTurnout->state() : TraintasticTurnoutObj::State::Unknown);
     }
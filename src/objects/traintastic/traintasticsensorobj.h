@@ -80,6 +80,7 @@ class TraintasticSensorObj : public AbstractSimulationObject
 private:
     friend class TraintasticSimManager;
     friend class TraintasticTurnoutObj;
+    friend class SimulationRecorder;
     void setState(int newState);
 
     friend class TraintasticSensorNode;
@@ -29,9 +29,9 @@
 
 #include "../abstractsimulationobjectmodel.h"
 #include "../../views/modemanager.h"
+#include "../../views/modemanagerfrontend.h"
 
-#include "../../network/traintastic-simulator/traintasticsimmanager.h"
-#include "../../network/traintastic-simulator/protocol.hpp"
+#include "abstracttraintasticsimmanager.h"
 
 #include <QJsonObject>
 #include <QJsonArray>
@@ -426,8 +426,9 @@ void TraintasticSignalObject::sendStatusMsg()
         }
     }
 
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    mgr->send(msg);
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr)
+        mgr->send(msg);
 }
 
 void TraintasticSignalObject::onScreenPosChanged(AbstractSimulationObject *s)
@@ -26,8 +26,9 @@
 
 #include "../abstractsimulationobjectmodel.h"
 #include "../../views/modemanager.h"
+#include "../../views/modemanagerfrontend.h"
 
-#include "../../network/traintastic-simulator/traintasticsimmanager.h"
+#include "abstracttraintasticsimmanager.h"
 
 #include <QTimerEvent>
 
@@ -36,16 +37,18 @@
 TraintasticSpawnObj::TraintasticSpawnObj(AbstractSimulationObjectModel *m)
     : AbstractSimulationObject(m)
 {
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    mgr->addSpawn(this);
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr)
+        mgr->addSpawn(this);
 }
 
 TraintasticSpawnObj::~TraintasticSpawnObj()
 {
     setNode(nullptr);
 
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    mgr->removeSpawn(this);
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr)
+        mgr->removeSpawn(this);
 }
 
 QString TraintasticSpawnObj::getType() const
@@ -118,8 +121,9 @@ void TraintasticSpawnObj::setActive(bool val)
 
     mActive = val;
 
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    mgr->setSpawnState(address(), isActive());
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr)
+        mgr->setSpawnState(address(), isActive());
 
     emit stateChanged(this);
 }
@@ -27,8 +27,9 @@
 
 #include "../abstractsimulationobjectmodel.h"
 #include "../../views/modemanager.h"
+#include "../../views/modemanagerfrontend.h"
 
-#include "../../network/traintastic-simulator/traintasticsimmanager.h"
+#include "abstracttraintasticsimmanager.h"
 
 #include <QTimerEvent>
 
@@ -37,8 +38,9 @@
 TraintasticTurnoutObj::TraintasticTurnoutObj(AbstractSimulationObjectModel *m)
     : AbstractSimulationObject(m)
 {
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    mgr->addTurnout(this);
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr)
+        mgr->addTurnout(this);
 }
 
 TraintasticTurnoutObj::~TraintasticTurnoutObj()
@@ -48,8 +50,9 @@ TraintasticTurnoutObj::~TraintasticTurnoutObj()
 
     setNode(nullptr);
 
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    mgr->removeTurnout(this);
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr)
+        mgr->removeTurnout(this);
 }
 
 QString TraintasticTurnoutObj::getType() const
@@ -153,10 +156,11 @@ void TraintasticTurnoutObj::setState(State newState)
     mState = newState;
     emit stateChanged(this);
 
-    TraintasticSimManager *mgr = model()->modeMgr()->getTraitasticSimMgr();
-    mgr->setTurnoutState(mChannel, mAddress, int(state()));
+    AbstractTraintasticSimManager *mgr = model()->modeMgr()->frontend()->traintasticSim();
+    if(mgr)
+        mgr->setTurnoutState(mChannel, mAddress, int(state()));
 
-    if(mSensor && !mgr->isConnected())
+    if(mSensor && !(mgr && mgr->isConnected()))
         mSensor->setState(mState);
 }
 
@@ -24,6 +24,9 @@
 
 #include "view/panellistmodel.h"
 #include "../views/modemanager.h"
+#include "../views/guimodefrontend.h"
+
+#include "../utils/phasereport.h"
 
 #include "abstractpanelitem.h"
 
@@ -44,6 +47,8 @@
 
 #include <QToolTip>
 
+#include <QElapsedTimer>
+
 #include "edit/panelitemfactory.h"
 
 #include "graphs/lightrectitem.h"
@@ -327,7 +332,7 @@ bool PanelScene::tryPasteItems(const QPointF &tileHint,
     const QJsonObject rootObj = doc.object();
 
     return insertFragment(tileHint, rootObj,
-                          modeMgr()->panelFactory(),
+                          GuiModeFrontend::get(modeMgr())->panelFactory(),
                           outTopLeft, outBottomRight);
 }
 
@@ -543,7 +548,7 @@ bool PanelScene::checkFragment(const QJsonArray &nodes, const QJsonArray &cables
 {
     fragment.validNodes.reserve(nodes.size());
 
-    const auto validTypes = modeMgr()->panelFactory()->getRegisteredTypes();
+    const auto validTypes = GuiModeFrontend::get(modeMgr())->panelFactory()->getRegisteredTypes();
 
     // Check pasted nodes do not overlap each other
     for(const QJsonValue& v : nodes)
@@ -844,11 +849,18 @@ bool PanelScene::loadFromJSON(const QJsonObject &obj, PanelItemFactory *factory)
         }
     };
 
+    QElapsedTimer timer;
+    timer.start();
+
     for(const QJsonValue& v : nodes)
         loadItem(v);
     for(const QJsonValue& v : lights)
         loadItem(v);
 
+    modeMgr()->loadReport().addTime(QLatin1String("Create items"),
+                                    timer.nsecsElapsed(),
+                                    qint64(nodes.size() + lights.size()));
+
     setHasUnsavedChanges(false);
 
     return true;
@@ -25,6 +25,7 @@
 #include "../abstractpanelitem.h"
 
 #include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
 #include "../../views/viewmanager.h"
 
 #include "../edit/panelitemfactory.h"
@@ -61,19 +62,19 @@ void PanelItemTraits::saveToJSON(Node *node, QJsonObject &obj)
 
 void PanelItemTraits::editItem(Node *node, ViewManager *viewMgr, QWidget *parent)
 {
-    auto editFactory = viewMgr->modeMgr()->panelFactory();
+    auto editFactory = GuiModeFrontend::get(viewMgr->modeMgr())->panelFactory();
     editFactory->editItem(parent, node, viewMgr, false);
 }
 
 QStringList PanelItemTraits::getRegisteredTypes(ModeManager *modeMgr)
 {
-    auto editFactory = modeMgr->panelFactory();
+    auto editFactory = GuiModeFrontend::get(modeMgr)->panelFactory();
     return editFactory->getRegisteredTypes();
 }
 
 QString PanelItemTraits::prettyTypeName(ModeManager *modeMgr, const QString &typeName)
 {
-    auto editFactory = modeMgr->panelFactory();
+    auto editFactory = GuiModeFrontend::get(modeMgr)->panelFactory();
     return editFactory->prettyName(typeName);
 }
 
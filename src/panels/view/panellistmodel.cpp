@@ -25,6 +25,7 @@
 #include "../panelscene.h"
 
 #include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
 
 #include <QJsonObject>
 #include <QJsonArray>
@@ -245,7 +246,7 @@ bool PanelListModel::loadFromJSON(const QJsonObject &obj)
     for(const QJsonValue& v : arr)
     {
         PanelScene *scene = new PanelScene(this);
-        if(!scene->loadFromJSON(v.toObject(), modeMgr()->panelFactory()))
+        if(!scene->loadFromJSON(v.toObject(), GuiModeFrontend::get(modeMgr())->panelFactory()))
         {
             delete scene;
             continue;
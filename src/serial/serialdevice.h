@@ -27,44 +27,46 @@
 #include <QTime>
 #include <QHash>
 
+#include "../objects/circuit_bridge/abstractserialdevice.h"
+
 class QSerialPort;
 
 class RemoteCircuitBridge;
 
 class SerialManager;
 
-class SerialDevice
+class SerialDevice : public AbstractSerialDevice
 {
 public:
     SerialDevice(const QString& name) : mName(name) {}
-    ~SerialDevice();
+    ~SerialDevice() override;
 
-    inline QString getName() const { return mName; }
+    inline QString getName() const override { return mName; }
 
     bool setName(const QString& newName, SerialManager *mgr);
 
     inline bool isConnected() const { return serialPort != nullptr; }
 
-    void onOutputChanged(int outputId, int mode);
+    void onOutputChanged(int outputId, int mode) override;
 
-    inline bool isInputFree(int inputId) const
+    inline bool isInputFree(int inputId) const override
     {
         return !inputs.contains(inputId);
     }
 
-    inline bool isOutputFree(int outputId) const
+    inline bool isOutputFree(int outputId) const override
     {
         return !outputs.contains(outputId);
     }
 
-    void addRemoteBridge(RemoteCircuitBridge *bridge);
-    void removeRemoteBridge(RemoteCircuitBridge *bridge);
+    void addRemoteBridge(RemoteCircuitBridge *bridge) override;
+    void removeRemoteBridge(RemoteCircuitBridge *bridge) override;
 
     bool changeRemoteBridgeInput(RemoteCircuitBridge *bridge,
-                                 int oldValue, int newValue);
+                                 int oldValue, int newValue) override;
 
     bool changeRemoteBridgeOutput(RemoteCircuitBridge *bridge,
-                                  int oldValue, int newValue);
+                                  int oldValue, int newValue) override;
 
 private:
     friend class SerialManager;
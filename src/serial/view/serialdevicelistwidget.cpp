@@ -24,6 +24,7 @@
 
 #include "../../views/viewmanager.h"
 #include "../../views/modemanager.h"
+#include "../../views/guimodefrontend.h"
 
 #include "../serialmanager.h"
 #include "../serialdevicesmodel.h"
@@ -40,7 +41,7 @@ SerialDeviceListWidget::SerialDeviceListWidget(ViewManager *viewMgr, QWidget *pa
     : QWidget{parent}
     , mViewMgr(viewMgr)
 {
-    SerialManager *serialMgr = mViewMgr->modeMgr()->getSerialManager();
+    SerialManager *serialMgr = GuiModeFrontend::get(mViewMgr->modeMgr())->getSerialManager();
     mModel = serialMgr->devicesModel();
 
     QVBoxLayout *lay = new QVBoxLayout(this);
@@ -91,7 +92,7 @@ void SerialDeviceListWidget::addSerialDevice()
     if(mViewMgr->modeMgr()->mode() != FileMode::Editing)
         return;
 
-    SerialManager *serialMgr = mViewMgr->modeMgr()->getSerialManager();
+    SerialManager *serialMgr = GuiModeFrontend::get(mViewMgr->modeMgr())->getSerialManager();
     QString name;
 
     bool first = true;
@@ -139,7 +140,7 @@ void SerialDeviceListWidget::removeSerialDevice()
                                        "This will reset all remote objects set to this device.").arg(name));
     if(ret == QMessageBox::Yes)
     {
-        SerialManager *serialMgr = mViewMgr->modeMgr()->getSerialManager();
+        SerialManager *serialMgr = GuiModeFrontend::get(mViewMgr->modeMgr())->getSerialManager();
         serialMgr->removeDevice(SerialDevice);
     }
 }
@@ -0,0 +1,86 @@
+/**
+ * src/utils/framestack.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef FRAMESTACK_H
+#define FRAMESTACK_H
+
+#include <QVector>
+
+/*!
+ * \brief The FrameStack class
+ *
+ * Explicit stack for iterative traversals.
+ * Frames are allocated once and reused by next pushes,
+ * so they keep their members capacity.
+ * Frame addresses are stable, pushing never moves existing frames.
+ * So a frame can be used while nested traversals push above it.
+ */
+template <typename Frame>
+class FrameStack
+{
+public:
+    FrameStack() = default;
+    ~FrameStack()
+    {
+        qDeleteAll(mFrames);
+    }
+
+    Q_DISABLE_COPY_MOVE(FrameStack)
+
+    inline int size() const { return mTop; }
+    inline bool isEmpty() const { return mTop == 0; }
+
+    // Returned frame has content of its previous use
+    inline Frame *push()
+    {
+        if(mTop == mFrames.size())
+            mFrames.append(new Frame);
+        return mFrames.at(mTop++);
+    }
+
+    inline void pop()
+    {
+        Q_ASSERT(mTop > 0);
+        mTop--;
+    }
+
+    inline Frame *top() const
+    {
+        Q_ASSERT(mTop > 0);
+        return mFrames.at(mTop - 1);
+    }
+
+    // Free frames not in use
+    void squeeze()
+    {
+        for(int i = mTop; i < mFrames.size(); i++)
+            delete mFrames.at(i);
+        mFrames.resize(mTop);
+        mFrames.squeeze();
+    }
+
+private:
+    QVector<Frame *> mFrames;
+    int mTop = 0;
+};
+
+#endif // FRAMESTACK_H
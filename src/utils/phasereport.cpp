@@ -0,0 +1,184 @@
+/**
+ * src/utils/phasereport.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "phasereport.h"
+
+#include <QLocale>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+void PhaseReport::clear()
+{
+    mPhases.clear();
+    mOpenPhases.clear();
+}
+
+int PhaseReport::beginPhase(const QString &name)
+{
+    Phase phase;
+    phase.name = name;
+    phase.depth = mOpenPhases.size();
+
+    OpenPhase open;
+    open.idx = mPhases.size();
+    open.peakAtBegin = peakMemoryUsage();
+    open.timer.start();
+
+    mPhases.append(phase);
+    mOpenPhases.append(open);
+    return open.idx;
+}
+
+void PhaseReport::endPhase(int idx, qint64 count)
+{
+    // Also close children left open
+    while(!mOpenPhases.isEmpty())
+    {
+        const OpenPhase open = mOpenPhases.takeLast();
+
+        Phase &phase = mPhases[open.idx];
+        phase.wallNs = open.timer.nsecsElapsed();
+
+        const qint64 peak = peakMemoryUsage();
+        if(peak > 0 && open.peakAtBegin > 0)
+            phase.peakGrowth = peak - open.peakAtBegin;
+
+        if(open.idx == idx)
+        {
+            if(count >= 0)
+                phase.count = count;
+            break;
+        }
+    }
+}
+
+void PhaseReport::addTime(const QString &name, qint64 wallNs, qint64 count)
+{
+    if(!isRecording())
+        return;
+
+    const int parentIdx = mOpenPhases.last().idx;
+    const int depth = mPhases.at(parentIdx).depth + 1;
+
+    for(int i = parentIdx + 1; i < mPhases.size(); i++)
+    {
+        Phase &phase = mPhases[i];
+        if(phase.depth == depth && phase.name == name)
+        {
+            phase.wallNs += wallNs;
+            phase.count = qMax(qint64(0), phase.count) + count;
+            return;
+        }
+    }
+
+    Phase phase;
+    phase.name = name;
+    phase.depth = depth;
+    phase.wallNs = wallNs;
+    phase.count = count;
+    mPhases.append(phase);
+}
+
+void PhaseReport::addPhase(const QString &name, qint64 wallNs, qint64 count, int position)
+{
+    Phase phase;
+    phase.name = name;
+    phase.wallNs = wallNs;
+    phase.count = count;
+
+    if(position < 0 || position > mPhases.size())
+    {
+        mPhases.append(phase);
+        return;
+    }
+
+    mPhases.insert(position, phase);
+
+    // Keep indexes of open phases valid
+    for(OpenPhase &open : mOpenPhases)
+    {
+        if(open.idx >= position)
+            open.idx++;
+    }
+}
+
+QString PhaseReport::toText() const
+{
+    const QLocale locale = QLocale::c();
+
+    int nameWidth = 0;
+    for(const Phase &phase : mPhases)
+        nameWidth = qMax(nameWidth, int(phase.name.size()) + phase.depth * 2);
+
+    QString result;
+    result += QStringLiteral("%1 %2 %3 %4\n")
+            .arg(QLatin1String("Phase"), -nameWidth)
+            .arg(QLatin1String("Time (ms)"), 12)
+            .arg(QLatin1String("Count"), 10)
+            .arg(QLatin1String("Peak +MiB"), 11);
+
+    for(const Phase &phase : mPhases)
+    {
+        const QString name = QString(phase.depth * 2, QLatin1Char(' ')) + phase.name;
+
+        const QString count = phase.count >= 0 ? locale.toString(phase.count)
+                                               : QString();
+        const QString peak = phase.peakGrowth > 0
+                ? locale.toString(double(phase.peakGrowth) / (1024.0 * 1024.0), 'f', 1)
+                : QString();
+
+        result += QStringLiteral("%1 %2 %3 %4\n")
+                .arg(name, -nameWidth)
+                .arg(locale.toString(double(phase.wallNs) / 1e6, 'f', 2), 12)
+                .arg(count, 10)
+                .arg(peak, 11);
+    }
+
+    return result;
+}
+
+qint64 PhaseReport::peakMemoryUsage()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return qint64(counters.PeakWorkingSetSize);
+    return 0;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(Q_OS_DARWIN)
+    return qint64(usage.ru_maxrss); // Bytes
+#else
+    return qint64(usage.ru_maxrss) * 1024; // KiB
+#endif
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,129 @@
+/**
+ * src/utils/phasereport.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef PHASEREPORT_H
+#define PHASEREPORT_H
+
+#include <QString>
+#include <QVector>
+#include <QElapsedTimer>
+
+/*!
+ * \brief The PhaseReport class
+ *
+ * Wall time, item count and process peak memory growth
+ * of each phase of a long operation like file load or save.
+ *
+ * Phases can be nested, children are listed after their parent
+ * with increased depth. Times added with addTime() are summed
+ * in a child of the innermost open phase, so code called
+ * many times (like loading a single scene) can contribute
+ * without opening a phase on each call.
+ * Nothing is recorded if no phase is open.
+ */
+class PhaseReport
+{
+public:
+    struct Phase
+    {
+        QString name;
+        int depth = 0;
+        qint64 wallNs = 0;
+
+        // Negative if not meaningful
+        qint64 count = -1;
+
+        // Process peak memory growth during phase.
+        // Only for phases opened with beginPhase(), 0 if unknown
+        // or if peak was reached before.
+        qint64 peakGrowth = 0;
+    };
+
+    void clear();
+
+    inline bool isRecording() const { return !mOpenPhases.isEmpty(); }
+
+    // Returns phase index to pass to endPhase()
+    int beginPhase(const QString& name);
+    void endPhase(int idx, qint64 count = -1);
+
+    void addTime(const QString& name, qint64 wallNs, qint64 count);
+
+    // Phase measured outside, like file read before loading starts.
+    // Negative position appends.
+    void addPhase(const QString& name, qint64 wallNs, qint64 count,
+                  int position = -1);
+
+    inline const QVector<Phase>& phases() const { return mPhases; }
+    inline bool isEmpty() const { return mPhases.isEmpty(); }
+
+    QString toText() const;
+
+    static qint64 peakMemoryUsage();
+
+private:
+    QVector<Phase> mPhases;
+
+    struct OpenPhase
+    {
+        int idx = -1;
+        QElapsedTimer timer;
+        qint64 peakAtBegin = 0;
+    };
+
+    QVector<OpenPhase> mOpenPhases;
+};
+
+/*!
+ * \brief The PhaseScope class
+ *
+ * Records a phase from construction to destruction.
+ * Report can be nullptr to disable recording.
+ */
+class PhaseScope
+{
+public:
+    PhaseScope(PhaseReport *report, const QString& name)
+        : mReport(report)
+    {
+        if(mReport)
+            mIdx = mReport->beginPhase(name);
+    }
+
+    ~PhaseScope()
+    {
+        if(mReport)
+            mReport->endPhase(mIdx, mCount);
+    }
+
+    Q_DISABLE_COPY_MOVE(PhaseScope)
+
+    inline void setCount(qint64 count) { mCount = count; }
+
+private:
+    PhaseReport *mReport = nullptr;
+    int mIdx = -1;
+    qint64 mCount = -1;
+};
+
+#endif // PHASEREPORT_H
@@ -0,0 +1,311 @@
+/**
+ * src/utils/projectfile.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "projectfile.h"
+
+#include <QFile>
+#include <QSaveFile>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+
+#include <cmath>
+
+// Self-describe tag 55799 encoded with 2 bytes argument
+static constexpr char CborSignature[] = {char(0xD9), char(0xD9), char(0xF7)};
+
+// Doubles represent integers exactly up to 2^53
+static constexpr double MaxExactInteger = 9007199254740992.0;
+
+static bool readCborString(QCborStreamReader& reader, QString& result)
+{
+    result.clear();
+
+    auto chunk = reader.readString();
+    while(chunk.status == QCborStreamReader::Ok)
+    {
+        result.append(chunk.data);
+        chunk = reader.readString();
+    }
+
+    return chunk.status == QCborStreamReader::EndOfString;
+}
+
+static bool readCborValue(QCborStreamReader& reader, QJsonValue& result);
+
+static bool readCborArray(QCborStreamReader& reader, QJsonArray& result)
+{
+    if(!reader.isArray() || !reader.enterContainer())
+        return false;
+
+    while(reader.hasNext())
+    {
+        QJsonValue value;
+        if(!readCborValue(reader, value))
+            return false;
+        result.append(value);
+    }
+
+    return reader.leaveContainer();
+}
+
+static bool readCborMap(QCborStreamReader& reader, QJsonObject& result)
+{
+    if(!reader.isMap() || !reader.enterContainer())
+        return false;
+
+    QString key;
+    while(reader.hasNext())
+    {
+        // We only write string keys
+        if(!reader.isString() || !readCborString(reader, key))
+            return false;
+
+        QJsonValue value;
+        if(!readCborValue(reader, value))
+            return false;
+        result.insert(key, value);
+    }
+
+    return reader.leaveContainer();
+}
+
+static bool readCborValue(QCborStreamReader& reader, QJsonValue& result)
+{
+    // Skip tags, including self-describe
+    while(reader.isTag())
+    {
+        if(!reader.next())
+            return false;
+    }
+
+    switch (reader.type())
+    {
+    case QCborStreamReader::UnsignedInteger:
+    case QCborStreamReader::NegativeInteger:
+        result = reader.toInteger();
+        break;
+    case QCborStreamReader::Float16:
+        result = double(reader.toFloat16());
+        break;
+    case QCborStreamReader::Float:
+        result = double(reader.toFloat());
+        break;
+    case QCborStreamReader::Double:
+        result = reader.toDouble();
+        break;
+    case QCborStreamReader::SimpleType:
+    {
+        if(reader.isBool())
+            result = reader.toBool();
+        else
+            result = QJsonValue(QJsonValue::Null);
+        break;
+    }
+    case QCborStreamReader::String:
+    {
+        QString str;
+        if(!readCborString(reader, str))
+            return false;
+        result = str;
+        return true;
+    }
+    case QCborStreamReader::Array:
+    {
+        QJsonArray arr;
+        if(!readCborArray(reader, arr))
+            return false;
+        result = arr;
+        return true;
+    }
+    case QCborStreamReader::Map:
+    {
+        QJsonObject obj;
+        if(!readCborMap(reader, obj))
+            return false;
+        result = obj;
+        return true;
+    }
+    default:
+        // Byte strings and invalid data are never written
+        return false;
+    }
+
+    // Advance past simple value
+    return reader.next();
+}
+
+static void writeCborValue(QCborStreamWriter& writer, const QJsonValue& value)
+{
+    switch (value.type())
+    {
+    case QJsonValue::Bool:
+        writer.append(value.toBool());
+        break;
+    case QJsonValue::Double:
+    {
+        // Keep integers as integers so they are read back unchanged
+        const double d = value.toDouble();
+        if(std::trunc(d) == d && std::abs(d) <= MaxExactInteger)
+            writer.append(qint64(d));
+        else
+            writer.append(d);
+        break;
+    }
+    case QJsonValue::String:
+        writer.append(value.toString());
+        break;
+    case QJsonValue::Array:
+    {
+        const QJsonArray arr = value.toArray();
+        writer.startArray(arr.size());
+        for(const QJsonValue& item : arr)
+            writeCborValue(writer, item);
+        writer.endArray();
+        break;
+    }
+    case QJsonValue::Object:
+    {
+        const QJsonObject obj = value.toObject();
+        writer.startMap(obj.size());
+        for(auto it = obj.constBegin(); it != obj.constEnd(); it++)
+        {
+            writer.append(it.key());
+            writeCborValue(writer, it.value());
+        }
+        writer.endMap();
+        break;
+    }
+    default:
+        writer.append(nullptr);
+        break;
+    }
+}
+
+ProjectFile::Format ProjectFile::formatForFileName(const QString &fileName)
+{
+    if(fileName.endsWith(QLatin1String(BinaryExtension), Qt::CaseInsensitive))
+        return Format::CBOR;
+    return Format::JSON;
+}
+
+ProjectFile::Format ProjectFile::detectFormat(QIODevice *dev)
+{
+    const QByteArray header = dev->peek(sizeof(CborSignature));
+    if(header.isEmpty())
+        return Format::Invalid;
+
+    if(header == QByteArray::fromRawData(CborSignature, sizeof(CborSignature)))
+        return Format::CBOR;
+
+    return Format::JSON;
+}
+
+bool ProjectFile::read(const QString &fileName, QJsonObject &result, Format *formatOut)
+{
+    QFile f(fileName);
+    if(!f.open(QFile::ReadOnly))
+        return false;
+
+    const Format format = detectFormat(&f);
+    if(formatOut)
+        *formatOut = format;
+
+    switch (format)
+    {
+    case Format::CBOR:
+        return readCbor(&f, result);
+    case Format::JSON:
+    {
+        QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
+        if(!doc.isObject())
+            return false;
+
+        result = doc.object();
+        return true;
+    }
+    default:
+        break;
+    }
+
+    return false;
+}
+
+bool ProjectFile::write(const QString &fileName, const QJsonObject &obj, Format format)
+{
+    if(format == Format::Invalid)
+        return false;
+
+    QSaveFile f(fileName);
+    if(!f.open(QFile::WriteOnly))
+        return false;
+
+    // Write errors are reported by commit
+    if(format == Format::CBOR)
+        writeCbor(&f, obj);
+    else
+        f.write(QJsonDocument(obj).toJson());
+
+    return f.commit();
+}
+
+bool ProjectFile::readCbor(QIODevice *dev, QJsonObject &result)
+{
+    QCborStreamReader reader(dev);
+
+    while(reader.isTag())
+    {
+        if(!reader.next())
+            return false;
+    }
+
+    QJsonObject obj;
+    if(!readCborMap(reader, obj))
+        return false;
+
+    if(reader.lastError() != QCborError::NoError)
+        return false;
+
+    result = obj;
+    return true;
+}
+
+void ProjectFile::writeCbor(QIODevice *dev, const QJsonObject &obj)
+{
+    QCborStreamWriter writer(dev);
+    writer.append(QCborKnownTags::Signature);
+    writeCborValue(writer, obj);
+}
+
+bool ProjectFile::convert(const QString &inputFile, const QString &outputFile)
+{
+    QJsonObject obj;
+    if(!read(inputFile, obj))
+        return false;
+
+    return write(outputFile, obj, formatForFileName(outputFile));
+}
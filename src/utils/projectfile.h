@@ -0,0 +1,74 @@
+/**
+ * src/utils/projectfile.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef PROJECTFILE_H
+#define PROJECTFILE_H
+
+#include <QString>
+
+class QIODevice;
+class QJsonObject;
+
+/*!
+ * \brief The ProjectFile class
+ *
+ * Reads and writes project files either as JSON text
+ * or as binary CBOR.
+ *
+ * CBOR files start with the self-describe tag so format
+ * is detected from content, not from file extension.
+ * CBOR is streamed directly to and from QJsonObject,
+ * without an intermediate QCborValue tree.
+ * Integral numbers are stored as CBOR integers, so
+ * converting between formats is lossless.
+ */
+class ProjectFile
+{
+public:
+    enum class Format
+    {
+        Invalid = 0,
+        JSON,
+        CBOR
+    };
+
+    static constexpr const char *BinaryExtension = ".simrelaisb";
+
+    // Binary extension selects CBOR, everything else JSON
+    static Format formatForFileName(const QString& fileName);
+
+    static Format detectFormat(QIODevice *dev);
+
+    static bool read(const QString& fileName, QJsonObject& result,
+                     Format *formatOut = nullptr);
+    static bool write(const QString& fileName, const QJsonObject& obj,
+                      Format format);
+
+    static bool readCbor(QIODevice *dev, QJsonObject& result);
+    static void writeCbor(QIODevice *dev, const QJsonObject& obj);
+
+    // Format of output is chosen by its extension
+    static bool convert(const QString& inputFile, const QString& outputFile);
+};
+
+#endif // PROJECTFILE_H
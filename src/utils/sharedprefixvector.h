@@ -0,0 +1,250 @@
+/**
+ * src/utils/sharedprefixvector.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SHAREDPREFIXVECTOR_H
+#define SHAREDPREFIXVECTOR_H
+
+#include <QVector>
+
+#include <iterator>
+
+/*!
+ * \brief The SharedPrefixVector class
+ *
+ * Vector made of an implicitly shared prefix and an owned tail.
+ * Forking the first N elements of another vector does not copy them,
+ * only the shared prefix reference count is increased.
+ * Appending always goes to the tail.
+ * Mutable access to prefix elements detaches (copy on write)
+ * and must be requested explicitly with mutableAt().
+ */
+template <typename T>
+class SharedPrefixVector
+{
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qsizetype difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        const_iterator() = default;
+        const_iterator(const SharedPrefixVector *vec, qsizetype idx)
+            : v(vec), i(idx)
+        {}
+
+        inline const T &operator*() const { return v->at(i); }
+        inline const T *operator->() const { return &v->at(i); }
+        inline const T &operator[](qsizetype n) const { return v->at(i + n); }
+
+        inline const_iterator &operator++() { ++i; return *this; }
+        inline const_iterator operator++(int) { const_iterator it = *this; ++i; return it; }
+        inline const_iterator &operator--() { --i; return *this; }
+        inline const_iterator operator--(int) { const_iterator it = *this; --i; return it; }
+
+        inline const_iterator &operator+=(qsizetype n) { i += n; return *this; }
+        inline const_iterator &operator-=(qsizetype n) { i -= n; return *this; }
+        inline const_iterator operator+(qsizetype n) const { return const_iterator(v, i + n); }
+        inline const_iterator operator-(qsizetype n) const { return const_iterator(v, i - n); }
+        inline qsizetype operator-(const const_iterator &other) const { return i - other.i; }
+
+        inline bool operator==(const const_iterator &other) const { return i == other.i; }
+        inline bool operator!=(const const_iterator &other) const { return i != other.i; }
+        inline bool operator<(const const_iterator &other) const { return i < other.i; }
+        inline bool operator>(const const_iterator &other) const { return i > other.i; }
+        inline bool operator<=(const const_iterator &other) const { return i <= other.i; }
+        inline bool operator>=(const const_iterator &other) const { return i >= other.i; }
+
+    private:
+        const SharedPrefixVector *v = nullptr;
+        qsizetype i = 0;
+    };
+
+    typedef const_iterator iterator;
+
+    inline qsizetype size() const { return mPrefixSize + mTail.size(); }
+    inline bool isEmpty() const { return size() == 0; }
+
+    inline const T &at(qsizetype i) const
+    {
+        Q_ASSERT(i >= 0 && i < size());
+        if(i < mPrefixSize)
+            return mPrefix.at(i);
+        return mTail.at(i - mPrefixSize);
+    }
+
+    inline const T &operator[](qsizetype i) const { return at(i); }
+
+    inline const T &first() const { return at(0); }
+    inline const T &last() const { return at(size() - 1); }
+
+    // Explicit mutable access, so that reading never detaches prefix
+    inline T &mutableAt(qsizetype i)
+    {
+        Q_ASSERT(i >= 0 && i < size());
+        if(i < mPrefixSize)
+            return mPrefix[i]; // Detaches if shared
+        return mTail[i - mPrefixSize];
+    }
+
+    inline T &mutableLast() { return mutableAt(size() - 1); }
+
+    inline const_iterator begin() const { return const_iterator(this, 0); }
+    inline const_iterator end() const { return const_iterator(this, size()); }
+    inline const_iterator cbegin() const { return begin(); }
+    inline const_iterator cend() const { return end(); }
+
+    inline void append(const T &value) { mTail.append(value); }
+
+    inline void reserve(qsizetype n)
+    {
+        if(n > mPrefixSize)
+            mTail.reserve(n - mPrefixSize);
+    }
+
+    inline qsizetype capacity() const { return mTail.capacity(); }
+
+    // Tail capacity is kept if not shared
+    inline void clear()
+    {
+        mPrefix = QVector<T>();
+        mPrefixSize = 0;
+        mTail.clear();
+    }
+
+    void truncate(qsizetype n)
+    {
+        Q_ASSERT(n >= 0 && n <= size());
+        if(n <= mPrefixSize)
+        {
+            mPrefixSize = n;
+            mTail.clear();
+            if(n == 0)
+                mPrefix = QVector<T>();
+            return;
+        }
+
+        mTail.resize(n - mPrefixSize);
+    }
+
+    /*!
+     * \brief Share first \a n elements of \a other
+     *
+     * Current content is replaced, tail storage capacity is kept.
+     * If needed \a other is compacted first so that
+     * its elements are all in a single shareable vector.
+     */
+    void forkFrom(SharedPrefixVector &other, qsizetype n)
+    {
+        Q_ASSERT(n >= 0 && n <= other.size());
+        Q_ASSERT(&other != this);
+
+        if(n > other.mPrefixSize)
+            other.compact();
+
+        mPrefix = other.mPrefix;
+        mPrefixSize = n;
+        mTail.clear();
+
+        if(n == 0)
+            mPrefix = QVector<T>();
+    }
+
+    // Give away tail storage, leaving vector empty
+    inline QVector<T> takeStorage()
+    {
+        mPrefix = QVector<T>();
+        mPrefixSize = 0;
+        mTail.clear();
+        return std::move(mTail);
+    }
+
+    // Reuse storage, leaving vector empty
+    inline void adoptStorage(QVector<T> &&storage)
+    {
+        mPrefix = QVector<T>();
+        mPrefixSize = 0;
+        mTail = std::move(storage);
+        mTail.clear();
+    }
+
+    inline bool operator==(const SharedPrefixVector &other) const
+    {
+        const qsizetype sz = size();
+        if(sz != other.size())
+            return false;
+
+        // Skip elements stored in same shared prefix
+        qsizetype i = 0;
+        if(mPrefix.constData() == other.mPrefix.constData())
+            i = qMin(mPrefixSize, other.mPrefixSize);
+
+        for(; i < sz; i++)
+        {
+            if(!(at(i) == other.at(i)))
+                return false;
+        }
+
+        return true;
+    }
+
+    inline bool operator!=(const SharedPrefixVector &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    void compact()
+    {
+        if(mTail.isEmpty())
+            return;
+
+        if(mPrefixSize == 0)
+        {
+            // Just promote tail to prefix, no copy needed
+            mPrefix = std::move(mTail);
+            mPrefixSize = mPrefix.size();
+            mTail = QVector<T>();
+            return;
+        }
+
+        QVector<T> merged;
+        merged.reserve(size());
+        for(qsizetype i = 0; i < mPrefixSize; i++)
+            merged.append(mPrefix.at(i));
+        merged.append(mTail);
+
+        mPrefix = std::move(merged);
+        mPrefixSize = mPrefix.size();
+        mTail.clear();
+    }
+
+private:
+    QVector<T> mPrefix;
+    qsizetype mPrefixSize = 0;
+    QVector<T> mTail;
+};
+
+#endif // SHAREDPREFIXVECTOR_H
@@ -0,0 +1,438 @@
+/**
+ * src/utils/simulationscheduler.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "simulationscheduler.h"
+
+#include <QCoreApplication>
+#include <QTimerEvent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// In as fast as possible mode, return to event loop
+// after this real time so that UI stays responsive
+static constexpr qint64 MaxBatchRealMillis = 20;
+
+static constexpr double MinSpeedFactor = 0.01;
+static constexpr double MaxSpeedFactor = 100.0;
+
+SimulationScheduler::SimulationScheduler(QObject *parent)
+    : QObject{parent}
+    , mRandom(QRandomGenerator::global()->generate())
+{
+    mRealClock.start();
+}
+
+SimulationScheduler::~SimulationScheduler()
+{
+    // SimulationTimer would unregister on a deleted scheduler
+    Q_ASSERT_X(mTimers.isEmpty(), "~SimulationScheduler",
+               "timers must be stopped before deleting scheduler");
+
+    stopWakeUp();
+}
+
+qint64 SimulationScheduler::syncedTime()
+{
+    if(!mDelivering)
+        syncToRealTime();
+    return mCurrentTime;
+}
+
+int SimulationScheduler::registerTimer(qint64 intervalMillis, QObject *target,
+                                       bool background)
+{
+    Q_ASSERT(target);
+
+    // Timers started from a timer event are relative to its deadline
+    if(!mDelivering)
+        syncToRealTime();
+
+    // Negative ids never collide with Qt timer ids
+    do
+    {
+        if(mLastTimerId == std::numeric_limits<int>::min())
+            mLastTimerId = 0;
+        --mLastTimerId;
+    }
+    while(mTimers.contains(mLastTimerId));
+
+    const int timerId = mLastTimerId;
+
+    TimerData &data = mTimers[timerId];
+    data.target = target;
+    data.interval = qMax(qint64(0), intervalMillis);
+    data.background = background;
+    if(!background)
+        mForegroundTimers++;
+    pushEntry(timerId, data, mCurrentTime + data.interval);
+
+    if(!mDelivering)
+        scheduleWakeUp();
+
+    return timerId;
+}
+
+void SimulationScheduler::unregisterTimer(int timerId)
+{
+    auto it = mTimers.find(timerId);
+    if(it == mTimers.end())
+        return;
+
+    if(!it->background)
+        mForegroundTimers--;
+    mTimers.erase(it);
+
+    // Queue entry is removed lazily
+    mStaleEntries++;
+    if(mStaleEntries > 64 && mStaleEntries > mTimers.size())
+        compactQueue();
+}
+
+void SimulationScheduler::setPaused(bool paused)
+{
+    if(mPaused == paused)
+        return;
+
+    syncToRealTime();
+    mPaused = paused;
+    rebaseRealTime();
+
+    if(mPaused)
+        stopWakeUp();
+    else
+        scheduleWakeUp();
+
+    emit pausedChanged(mPaused);
+}
+
+void SimulationScheduler::setRunMode(RunMode mode)
+{
+    if(mRunMode == mode)
+        return;
+
+    syncToRealTime();
+    mRunMode = mode;
+    rebaseRealTime();
+
+    stopWakeUp();
+    scheduleWakeUp();
+
+    emit runModeChanged(mRunMode);
+}
+
+void SimulationScheduler::setSpeedFactor(double factor)
+{
+    factor = qBound(MinSpeedFactor, factor, MaxSpeedFactor);
+    if(qFuzzyCompare(mSpeedFactor, factor))
+        return;
+
+    syncToRealTime();
+    mSpeedFactor = factor;
+    rebaseRealTime();
+
+    stopWakeUp();
+    scheduleWakeUp();
+
+    emit speedFactorChanged(mSpeedFactor);
+}
+
+void SimulationScheduler::setFixedStepMillis(int millis)
+{
+    millis = qBound(1, millis, 1000);
+    if(mFixedStepMillis == millis)
+        return;
+
+    mFixedStepMillis = millis;
+
+    if(mRunMode == RunMode::FixedStep)
+    {
+        stopWakeUp();
+        scheduleWakeUp();
+    }
+}
+
+void SimulationScheduler::advanceBy(qint64 millis)
+{
+    if(millis < 0 || mDelivering)
+        return;
+
+    syncToRealTime();
+    deliverUntil(mCurrentTime + millis, true);
+    rebaseRealTime();
+
+    scheduleWakeUp();
+}
+
+void SimulationScheduler::step()
+{
+    advanceBy(mFixedStepMillis);
+}
+
+void SimulationScheduler::setRandomSeed(quint32 seed)
+{
+    mRandom.seed(seed);
+}
+
+void SimulationScheduler::timerEvent(QTimerEvent *e)
+{
+    if(e->timerId() != mWakeUpTimer.timerId())
+    {
+        QObject::timerEvent(e);
+        return;
+    }
+
+    switch (mRunMode)
+    {
+    case RunMode::RealTime:
+    {
+        stopWakeUp();
+        syncToRealTime();
+        deliverUntil(mCurrentTime, false);
+        break;
+    }
+    case RunMode::FixedStep:
+    {
+        deliverUntil(mCurrentTime + mFixedStepMillis, false);
+        break;
+    }
+    case RunMode::AsFastAsPossible:
+    {
+        // Jump from one deadline to next
+        QElapsedTimer batchTime;
+        batchTime.start();
+
+        qint64 deadline = 0;
+        while(nextWakeUpDeadline(deadline) && batchTime.elapsed() < MaxBatchRealMillis)
+        {
+            deliverUntil(deadline, true);
+
+            if(mPaused || mRunMode != RunMode::AsFastAsPossible)
+                break;
+        }
+        break;
+    }
+    }
+
+    qint64 deadline = 0;
+    if(!nextWakeUpDeadline(deadline))
+        stopWakeUp(); // Idle
+
+    scheduleWakeUp();
+}
+
+bool SimulationScheduler::isLater(const QueueEntry &a, const QueueEntry &b)
+{
+    if(a.deadline != b.deadline)
+        return a.deadline > b.deadline;
+    return a.seq > b.seq;
+}
+
+void SimulationScheduler::pushEntry(int timerId, TimerData &data, qint64 deadline)
+{
+    data.seq = ++mLastSeq;
+
+    mQueue.append({deadline, data.seq, timerId});
+    std::push_heap(mQueue.begin(), mQueue.end(), isLater);
+}
+
+bool SimulationScheduler::nextDeadline(qint64 &deadline)
+{
+    while(!mQueue.isEmpty())
+    {
+        const QueueEntry &top = mQueue.first();
+
+        auto it = mTimers.constFind(top.timerId);
+        if(it != mTimers.constEnd() && it->seq == top.seq)
+        {
+            deadline = top.deadline;
+            return true;
+        }
+
+        // Timer was stopped, drop its entry
+        std::pop_heap(mQueue.begin(), mQueue.end(), isLater);
+        mQueue.removeLast();
+        mStaleEntries = qMax(0, mStaleEntries - 1);
+    }
+
+    return false;
+}
+
+bool SimulationScheduler::nextWakeUpDeadline(qint64 &deadline)
+{
+    if(!nextDeadline(deadline))
+        return false;
+
+    // Do not fast forward only for background timers
+    if(mRunMode == RunMode::AsFastAsPossible)
+        return mForegroundTimers > 0;
+
+    return true;
+}
+
+void SimulationScheduler::compactQueue()
+{
+    auto isStale = [this](const QueueEntry& entry) -> bool
+    {
+        auto it = mTimers.constFind(entry.timerId);
+        return it == mTimers.constEnd() || it->seq != entry.seq;
+    };
+
+    mQueue.removeIf(isStale);
+    std::make_heap(mQueue.begin(), mQueue.end(), isLater);
+    mStaleEntries = 0;
+}
+
+void SimulationScheduler::deliverUntil(qint64 limit, bool flushPosted)
+{
+    // Nested calls from timer events are ignored,
+    // outer loop will deliver remaining timers
+    if(mDelivering)
+        return;
+
+    mDelivering = true;
+
+    qint64 deadline = 0;
+    while(nextDeadline(deadline) && deadline <= limit)
+    {
+        const QueueEntry entry = mQueue.first();
+        std::pop_heap(mQueue.begin(), mQueue.end(), isLater);
+        mQueue.removeLast();
+
+        mCurrentTime = qMax(mCurrentTime, entry.deadline);
+
+        // Reschedule before delivery so that target can stop or restart it.
+        // Zero interval repeats at next millisecond, otherwise time would not advance
+        TimerData &data = mTimers[entry.timerId];
+        QObject *target = data.target;
+        pushEntry(entry.timerId, data, mCurrentTime + qMax(qint64(1), data.interval));
+
+        QTimerEvent ev(entry.timerId);
+        QCoreApplication::sendEvent(target, &ev);
+
+        // Let posted events run at the simulation time they were posted
+        if(flushPosted)
+            QCoreApplication::sendPostedEvents();
+    }
+
+    mCurrentTime = qMax(mCurrentTime, limit);
+
+    mDelivering = false;
+}
+
+qint64 SimulationScheduler::realTimeNow() const
+{
+    const double elapsed = double(mRealClock.elapsed() - mRealBase);
+    return mSimBase + qint64(elapsed * mSpeedFactor);
+}
+
+void SimulationScheduler::syncToRealTime()
+{
+    // Only real time mode follows wall clock
+    if(mPaused || mRunMode != RunMode::RealTime)
+        return;
+
+    mCurrentTime = qMax(mCurrentTime, realTimeNow());
+}
+
+void SimulationScheduler::rebaseRealTime()
+{
+    mRealBase = mRealClock.elapsed();
+    mSimBase = mCurrentTime;
+}
+
+void SimulationScheduler::scheduleWakeUp()
+{
+    if(mPaused)
+    {
+        stopWakeUp();
+        return;
+    }
+
+    if(mDelivering)
+        return; // Rescheduled after delivery
+
+    qint64 deadline = 0;
+    if(!nextWakeUpDeadline(deadline))
+        return;
+
+    int delay = 0;
+
+    switch (mRunMode)
+    {
+    case RunMode::RealTime:
+    {
+        if(mWakeUpTimer.isActive() && mWakeUpDeadline <= deadline)
+            return; // Already waiting for an earlier deadline
+
+        const double realDelay = double(deadline - realTimeNow()) / mSpeedFactor;
+        delay = qMax(0, int(std::ceil(realDelay)));
+        break;
+    }
+    case RunMode::FixedStep:
+    {
+        if(mWakeUpTimer.isActive())
+            return; // Keep ticking
+
+        delay = qMax(1, qRound(double(mFixedStepMillis) / mSpeedFactor));
+        break;
+    }
+    case RunMode::AsFastAsPossible:
+    {
+        if(mWakeUpTimer.isActive())
+            return;
+
+        delay = 0;
+        break;
+    }
+    }
+
+    mWakeUpDeadline = deadline;
+    mWakeUpTimer.start(delay, Qt::PreciseTimer, this);
+}
+
+void SimulationScheduler::stopWakeUp()
+{
+    mWakeUpTimer.stop();
+    mWakeUpDeadline = -1;
+}
+
+void SimulationTimer::start(SimulationScheduler *scheduler, int msec, QObject *obj)
+{
+    Q_ASSERT(scheduler);
+
+    stop();
+
+    mScheduler = scheduler;
+    mTimerId = mScheduler->registerTimer(msec, obj, mBackground);
+}
+
+void SimulationTimer::stop()
+{
+    if(!mTimerId)
+        return;
+
+    mScheduler->unregisterTimer(mTimerId);
+    mTimerId = 0;
+    mScheduler = nullptr;
+}
@@ -0,0 +1,270 @@
+/**
+ * src/utils/simulationscheduler.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIMULATIONSCHEDULER_H
+#define SIMULATIONSCHEDULER_H
+
+#include <QObject>
+#include <QBasicTimer>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <QHash>
+#include <QVector>
+
+#include <chrono>
+
+/*!
+ * \brief The SimulationScheduler class
+ *
+ * Single simulation clock for all timed behavior.
+ * Timers are kept in a priority queue ordered by simulation time
+ * and delivered as QTimerEvent to their target object.
+ * Only one kernel timer is used to wake up next deadline.
+ *
+ * Simulation time can run at real time scaled by speed factor,
+ * advance in fixed steps, or jump from one deadline to next
+ * as fast as possible. It can also be paused and advanced manually.
+ *
+ * Timer ids are negative so they never collide with Qt timers.
+ * Timers with same deadline are delivered in start order.
+ *
+ * Background timers are periodic housekeeping (like blinking codes)
+ * which never ends by itself. In as fast as possible mode they
+ * do not keep scheduler awake: when only background timers are
+ * left, simulation time stops until a normal timer is started.
+ */
+class SimulationScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    enum class RunMode
+    {
+        RealTime = 0,
+        FixedStep,
+        AsFastAsPossible
+    };
+
+    static constexpr int DefaultFixedStepMillis = 10;
+
+    explicit SimulationScheduler(QObject *parent = nullptr);
+    ~SimulationScheduler();
+
+    // Simulation time in milliseconds
+    inline qint64 currentTime() const
+    {
+        return mCurrentTime;
+    }
+
+    // Current time brought up to wall clock in real time mode.
+    // Use it to timestamp events not coming from timers
+    qint64 syncedTime();
+
+    int registerTimer(qint64 intervalMillis, QObject *target,
+                      bool background = false);
+    void unregisterTimer(int timerId);
+
+    inline bool isTimerActive(int timerId) const
+    {
+        return mTimers.contains(timerId);
+    }
+
+    inline int activeTimersCount() const
+    {
+        return mTimers.size();
+    }
+
+    // Timers which are not background timers
+    inline int foregroundTimersCount() const
+    {
+        return mForegroundTimers;
+    }
+
+    inline bool isPaused() const
+    {
+        return mPaused;
+    }
+
+    void setPaused(bool paused);
+
+    // True while timer events are delivered to their targets
+    inline bool isDelivering() const
+    {
+        return mDelivering;
+    }
+
+    inline RunMode runMode() const
+    {
+        return mRunMode;
+    }
+
+    void setRunMode(RunMode mode);
+
+    inline double speedFactor() const
+    {
+        return mSpeedFactor;
+    }
+
+    void setSpeedFactor(double factor);
+
+    inline int fixedStepMillis() const
+    {
+        return mFixedStepMillis;
+    }
+
+    void setFixedStepMillis(int millis);
+
+    // Manual advance, works also while paused
+    void advanceBy(qint64 millis);
+    void step();
+
+    // Random source for simulated timings, reproducible if seeded
+    inline QRandomGenerator *random()
+    {
+        return &mRandom;
+    }
+
+    void setRandomSeed(quint32 seed);
+
+signals:
+    void pausedChanged(bool paused);
+    void runModeChanged(RunMode mode);
+    void speedFactorChanged(double factor);
+
+protected:
+    void timerEvent(QTimerEvent *e) override;
+
+private:
+    struct QueueEntry
+    {
+        qint64 deadline;
+        quint64 seq;
+        int timerId;
+    };
+
+    struct TimerData
+    {
+        QObject *target = nullptr;
+        qint64 interval = 0;
+        quint64 seq = 0;
+        bool background = false;
+    };
+
+    static bool isLater(const QueueEntry& a, const QueueEntry& b);
+
+    void pushEntry(int timerId, TimerData &data, qint64 deadline);
+    bool nextDeadline(qint64 &deadline);
+    bool nextWakeUpDeadline(qint64 &deadline);
+    void compactQueue();
+
+    void deliverUntil(qint64 limit, bool flushPosted);
+
+    qint64 realTimeNow() const;
+    void syncToRealTime();
+    void rebaseRealTime();
+
+    void scheduleWakeUp();
+    void stopWakeUp();
+
+private:
+    QVector<QueueEntry> mQueue; // Binary heap, earliest first
+    QHash<int, TimerData> mTimers;
+    int mForegroundTimers = 0;
+    int mStaleEntries = 0;
+
+    int mLastTimerId = 0;
+    quint64 mLastSeq = 0;
+
+    qint64 mCurrentTime = 0;
+
+    // Real time reference, simulation time is scaled from it
+    QElapsedTimer mRealClock;
+    qint64 mRealBase = 0;
+    qint64 mSimBase = 0;
+
+    QBasicTimer mWakeUpTimer;
+    qint64 mWakeUpDeadline = -1;
+
+    RunMode mRunMode = RunMode::RealTime;
+    double mSpeedFactor = 1.0;
+    int mFixedStepMillis = DefaultFixedStepMillis;
+    bool mPaused = false;
+    bool mDelivering = false;
+
+    QRandomGenerator mRandom;
+};
+
+/*!
+ * \brief The SimulationTimer class
+ *
+ * Drop-in replacement of QBasicTimer running on simulation time.
+ * Timer repeats until stopped.
+ * Background flag is applied on next start().
+ */
+class SimulationTimer
+{
+public:
+    SimulationTimer() = default;
+    inline ~SimulationTimer()
+    {
+        stop();
+    }
+
+    Q_DISABLE_COPY_MOVE(SimulationTimer)
+
+    inline bool isActive() const
+    {
+        return mTimerId != 0;
+    }
+
+    inline int timerId() const
+    {
+        return mTimerId;
+    }
+
+    inline bool isBackground() const
+    {
+        return mBackground;
+    }
+
+    inline void setBackground(bool background)
+    {
+        mBackground = background;
+    }
+
+    void start(SimulationScheduler *scheduler, int msec, QObject *obj);
+
+    inline void start(SimulationScheduler *scheduler,
+                      std::chrono::milliseconds duration, QObject *obj)
+    {
+        start(scheduler, int(duration.count()), obj);
+    }
+
+    void stop();
+
+private:
+    SimulationScheduler *mScheduler = nullptr;
+    int mTimerId = 0;
+    bool mBackground = false;
+};
+
+#endif // SIMULATIONSCHEDULER_H
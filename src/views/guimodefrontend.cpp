@@ -0,0 +1,239 @@
+/**
+ * src/views/guimodefrontend.cpp
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "guimodefrontend.h"
+
+#include "../circuits/edit/nodeeditfactory.h"
+#include "../circuits/edit/standardnodetypes.h"
+#include "../circuits/view/circuitlistmodel.h"
+
+#include "../panels/edit/panelitemfactory.h"
+#include "../panels/edit/standardpanelitemtypes.h"
+#include "../panels/view/panellistmodel.h"
+
+#include "../objects/standardobjectedits.h"
+#include "../objects/simple_activable/soundeffectplayer.h"
+
+#include "../network/remotemanager.h"
+#include "../network/remotesession.h"
+#include "../serial/serialmanager.h"
+#include "../serial/serialdevice.h"
+
+#include "../network/traintastic-simulator/traintasticsimmanager.h"
+
+#include "../utils/phasereport.h"
+
+#include <QJsonObject>
+
+GuiModeFrontend::GuiModeFrontend(ModeManager *mgr)
+{
+    // Circuits
+    mCircuitFactory = new NodeEditFactory(mgr);
+    StandardNodeTypes::registerTypes(mCircuitFactory);
+
+    mCircuitList = new CircuitListModel(mgr, mgr);
+
+    // Panels
+    mPanelItemFactory = new PanelItemFactory(mgr);
+    StandardPanelItemTypes::registerTypes(mPanelItemFactory);
+
+    mPanelList = new PanelListModel(mgr, mgr);
+
+    // Objects
+    StandardObjectEdits::registerEditFuncs(mgr->objectFactory());
+
+    mRemoteMgr = new RemoteManager(mgr);
+    mSerialMgr = new SerialManager(mgr);
+
+    mTraintasticSim = new TraintasticSimManager(mgr);
+}
+
+GuiModeFrontend::~GuiModeFrontend()
+{
+    shutdown();
+
+    // Delete remote connections AFTER deleting objects
+    delete mRemoteMgr;
+    mRemoteMgr = nullptr;
+
+    delete mSerialMgr;
+    mSerialMgr = nullptr;
+
+    delete mTraintasticSim;
+    mTraintasticSim = nullptr;
+}
+
+void GuiModeFrontend::shutdown()
+{
+    if(!mCircuitList)
+        return; // Already shut down
+
+    // Disable network communication
+    mRemoteMgr->setOnline(false);
+
+    mRemoteMgr->clear();
+
+    mSerialMgr->disconnectAllDevices();
+
+    mTraintasticSim->enableConnection(false);
+
+    // Delete circuits and factory
+    // before objects
+    delete mCircuitList;
+    mCircuitList = nullptr;
+
+    delete mCircuitFactory;
+    mCircuitFactory = nullptr;
+
+    delete mPanelList;
+    mPanelList = nullptr;
+
+    delete mPanelItemFactory;
+    mPanelItemFactory = nullptr;
+}
+
+void GuiModeFrontend::onModeChanged(FileMode newMode, FileMode oldMode)
+{
+    if(newMode != FileMode::Simulation)
+    {
+        // Stop network connections if not in Simulation mode
+        const bool wasOnline = mRemoteMgr->isOnline();
+        mRemoteMgr->setOnline(false);
+        mRemoteMgr->setOnlineByDefault(wasOnline);
+
+        mSerialMgr->disconnectAllDevices();
+
+        mRemoteMgr->setTraintasticDiscoveryEnabled(false);
+        mTraintasticSim->enableConnection(false);
+    }
+    else if(oldMode != FileMode::Simulation)
+    {
+        mSerialMgr->rescanPorts();
+
+        if(mRemoteMgr->onlineByDefault())
+            mRemoteMgr->setOnline(true);
+
+        mRemoteMgr->setTraintasticDiscoveryEnabled(true);
+    }
+
+    mCircuitList->setMode(newMode, oldMode);
+}
+
+void GuiModeFrontend::onCodePhaseChanged()
+{
+    mCircuitList->updateCodeStatus();
+}
+
+void GuiModeFrontend::resetHasUnsavedChanges()
+{
+    mCircuitList->resetHasUnsavedChanges();
+    mPanelList->resetHasUnsavedChanges();
+}
+
+void GuiModeFrontend::clear()
+{
+    mRemoteMgr->clear();
+
+    mCircuitList->clear();
+    mPanelList->clear();
+}
+
+void GuiModeFrontend::loadFromJSON(const QJsonObject &rootObj, PhaseReport *report)
+{
+    mRemoteMgr->setSessionName(rootObj.value("session_name").toString());
+
+    {
+        PhaseScope phase(report, QLatin1String("Load circuits"));
+        QJsonObject circuits = rootObj.value("circuits").toObject();
+        mCircuitList->loadFromJSON(circuits);
+        phase.setCount(mCircuitList->rowCount());
+    }
+
+    {
+        PhaseScope phase(report, QLatin1String("Load panels"));
+        QJsonObject panels = rootObj.value("panels").toObject();
+        mPanelList->loadFromJSON(panels);
+        phase.setCount(mPanelList->rowCount());
+    }
+
+    {
+        PhaseScope phase(report, QLatin1String("Load remote"));
+        mRemoteMgr->loadFromJSON(rootObj.value("remote_mgr").toObject());
+    }
+}
+
+void GuiModeFrontend::saveToJSON(QJsonObject &rootObj, PhaseReport *report) const
+{
+    QJsonObject circuits;
+    {
+        PhaseScope phase(report, QLatin1String("Save circuits"));
+        mCircuitList->saveToJSON(circuits);
+        phase.setCount(mCircuitList->rowCount());
+    }
+
+    QJsonObject panels;
+    {
+        PhaseScope phase(report, QLatin1String("Save panels"));
+        mPanelList->saveToJSON(panels);
+        phase.setCount(mPanelList->rowCount());
+    }
+
+    QJsonObject remoteMgrObj;
+    {
+        PhaseScope phase(report, QLatin1String("Save remote"));
+        mRemoteMgr->saveToJSON(remoteMgrObj);
+    }
+
+    rootObj["session_name"] = mRemoteMgr->sessionName();
+
+    rootObj["circuits"] = circuits;
+    rootObj["panels"] = panels;
+
+    rootObj["remote_mgr"] = remoteMgrObj;
+}
+
+AbstractRemoteSession *GuiModeFrontend::addRemoteSession(const QString &sessionName)
+{
+    return mRemoteMgr->addRemoteSession(sessionName);
+}
+
+AbstractSerialDevice *GuiModeFrontend::addSerialDevice(const QString &devName)
+{
+    return mSerialMgr->addDevice(devName);
+}
+
+AbstractTraintasticSimManager *GuiModeFrontend::traintasticSim() const
+{
+    return mTraintasticSim;
+}
+
+void GuiModeFrontend::disconnectAll()
+{
+    mRemoteMgr->setOnline(false);
+    mSerialMgr->disconnectAllDevices();
+    mTraintasticSim->enableConnection(false);
+}
+
+AbstractSoundPlayer *GuiModeFrontend::createSoundPlayer()
+{
+    return new SoundEffectPlayer;
+}
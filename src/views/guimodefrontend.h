@@ -0,0 +1,120 @@
+/**
+ * src/views/guimodefrontend.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef GUIMODEFRONTEND_H
+#define GUIMODEFRONTEND_H
+
+#include "modemanagerfrontend.h"
+#include "modemanager.h"
+
+class NodeEditFactory;
+class CircuitListModel;
+
+class PanelItemFactory;
+class PanelListModel;
+
+class RemoteManager;
+class SerialManager;
+
+class TraintasticSimManager;
+
+// Circuit and panel scenes, network and serial devices of GUI application
+class GuiModeFrontend : public AbstractModeManagerFrontend
+{
+public:
+    explicit GuiModeFrontend(ModeManager *mgr);
+    ~GuiModeFrontend();
+
+    // Only valid after MainWindow installed it
+    static inline GuiModeFrontend *get(const ModeManager *mgr)
+    {
+        return static_cast<GuiModeFrontend *>(mgr->frontend());
+    }
+
+    void shutdown() override;
+
+    void onModeChanged(FileMode newMode, FileMode oldMode) override;
+    void onCodePhaseChanged() override;
+
+    void resetHasUnsavedChanges() override;
+    void clear() override;
+
+    void loadFromJSON(const QJsonObject& rootObj, PhaseReport *report) override;
+    void saveToJSON(QJsonObject& rootObj, PhaseReport *report) const override;
+
+    AbstractRemoteSession *addRemoteSession(const QString& sessionName) override;
+    AbstractSerialDevice *addSerialDevice(const QString& devName) override;
+    AbstractTraintasticSimManager *traintasticSim() const override;
+
+    void disconnectAll() override;
+
+    AbstractSoundPlayer *createSoundPlayer() override;
+
+    inline NodeEditFactory *circuitFactory() const
+    {
+        return mCircuitFactory;
+    }
+
+    inline CircuitListModel *circuitList() const
+    {
+        return mCircuitList;
+    }
+
+    inline PanelItemFactory *panelFactory() const
+    {
+        return mPanelItemFactory;
+    }
+
+    inline PanelListModel *panelList() const
+    {
+        return mPanelList;
+    }
+
+    inline RemoteManager *getRemoteManager() const
+    {
+        return mRemoteMgr;
+    }
+
+    inline SerialManager *getSerialManager() const
+    {
+        return mSerialMgr;
+    }
+
+    inline TraintasticSimManager *getTraitasticSimMgr() const
+    {
+        return mTraintasticSim;
+    }
+
+private:
+    NodeEditFactory *mCircuitFactory = nullptr;
+    CircuitListModel *mCircuitList = nullptr;
+
+    PanelItemFactory *mPanelItemFactory = nullptr;
+    PanelListModel *mPanelList = nullptr;
+
+    RemoteManager *mRemoteMgr = nullptr;
+    SerialManager *mSerialMgr = nullptr;
+
+    TraintasticSimManager *mTraintasticSim = nullptr;
+};
+
+#endif // GUIMODEFRONTEND_H
@@ -24,6 +24,7 @@
 
 #include "viewmanager.h"
 #include "modemanager.h"
+#include "guimodefrontend.h"
 
 #include "../objects/abstractsimulationobjectmodel.h"
 
@@ -198,7 +199,7 @@ KDDockWidgets::QtWidgets::DockWidget *LayoutLoader::createDockWidget(const QStri
         if(sceneName.isEmpty())
             return nullptr;
 
-        CircuitScene *scene = viewMgr->modeMgr()->circuitList()->sceneByName(sceneName);
+        CircuitScene *scene = GuiModeFrontend::get(viewMgr->modeMgr())->circuitList()->sceneByName(sceneName);
         if(!scene)
             return nullptr;
 
@@ -228,7 +229,7 @@ KDDockWidgets::QtWidgets::DockWidget *LayoutLoader::createDockWidget(const QStri
         if(sceneName.isEmpty())
             return nullptr;
 
-        CircuitScene *scene = viewMgr->modeMgr()->circuitList()->sceneByName(sceneName.toString());
+        CircuitScene *scene = GuiModeFrontend::get(viewMgr->modeMgr())->circuitList()->sceneByName(sceneName.toString());
         if(!scene)
             return nullptr;
 
@@ -254,7 +255,7 @@ KDDockWidgets::QtWidgets::DockWidget *LayoutLoader::createDockWidget(const QStri
         if(sceneName.isEmpty())
             return nullptr;
 
-        PanelScene *scene = viewMgr->modeMgr()->panelList()->sceneByName(sceneName);
+        PanelScene *scene = GuiModeFrontend::get(viewMgr->modeMgr())->panelList()->sceneByName(sceneName);
         if(!scene)
             return nullptr;
 
@@ -284,7 +285,7 @@ KDDockWidgets::QtWidgets::DockWidget *LayoutLoader::createDockWidget(const QStri
         if(sceneName.isEmpty())
             return nullptr;
 
-        PanelScene *scene = viewMgr->modeMgr()->panelList()->sceneByName(sceneName.toString());
+        PanelScene *scene = GuiModeFrontend::get(viewMgr->modeMgr())->panelList()->sceneByName(sceneName.toString());
         if(!scene)
             return nullptr;
 
@@ -360,6 +361,13 @@ KDDockWidgets::QtWidgets::DockWidget *LayoutLoader::createDockWidget(const QStri
         return viewMgr->mSerialDevicesListViewDock.data();
     }
 
+    if(name == QLatin1String("simulation_profiler"))
+    {
+        viewMgr->showSimulationProfilerView();
+        setFlag(viewMgr->mSimulationProfilerDock.data(), false);
+        return viewMgr->mSimulationProfilerDock.data();
+    }
+
     return nullptr;
 }
 
@@ -421,6 +429,7 @@ void LayoutLoader::setDeleteOnClose(bool value)
     setFlag(viewMgr->mRemoteSessionsListViewDock, value);
     setFlag(viewMgr->mReplicaListViewDock, value);
     setFlag(viewMgr->mSerialDevicesListViewDock, value);
+    setFlag(viewMgr->mSimulationProfilerDock, value);
 }
 
 void LayoutLoader::registerLoader()
@@ -21,30 +21,32 @@
  */
 
 #include "modemanager.h"
+#include "modemanagerfrontend.h"
 
-#include "../circuits/edit/nodeeditfactory.h"
-#include "../circuits/edit/standardnodetypes.h"
-#include "../circuits/view/circuitlistmodel.h"
-
-#include "../panels/edit/panelitemfactory.h"
-#include "../panels/edit/standardpanelitemtypes.h"
-#include "../panels/view/panellistmodel.h"
+#include "../circuits/electriccircuit.h"
+#include "../circuits/circuitgraph.h"
+#include "../circuits/circuitchangenotifier.h"
+#include "../circuits/headlesscircuitlist.h"
 
 #include "../objects/simulationobjectfactory.h"
 #include "../objects/standardobjecttypes.h"
 #include "../objects/abstractsimulationobjectmodel.h"
+#include "../objects/simulationrecorder.h"
 
 #include "../enums/loadphase.h"
 
-#include "../network/remotemanager.h"
-#include "../serial/serialmanager.h"
-
-#include "../network/traintastic-simulator/traintasticsimmanager.h"
+#include "../utils/phasereport.h"
 
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
 
+#include <QElapsedTimer>
+
+// Automatic snapshots cover last 2 minutes
+static constexpr int HistoryIntervalMillis = 5000;
+static constexpr int HistoryLength = 24;
+
 QJsonObject convertFileFormatBetaToV1(const QJsonObject& origFile)
 {
     QJsonObject objects;
@@ -405,31 +407,35 @@ QJsonObject convertFileFormatV3ToV4(const QJsonObject& origFile)
     return newFile;
 }
 
-QJsonObject convertOldFileFormat(const QJsonObject& origFile)
+QJsonObject convertOldFileFormat(const QJsonObject& origFile, PhaseReport *report)
 {
     QJsonObject rootObj = origFile;
 
     if(rootObj.value("file_version") == ModeManager::FileVersion::Beta)
     {
         // Old file, try to convert it to V1
+        PhaseScope phase(report, QLatin1String("Beta to V1"));
         rootObj = convertFileFormatBetaToV1(rootObj);
     }
 
     if(rootObj.value("file_version") == ModeManager::FileVersion::V1)
     {
         // V1 file, try to convert it to V2
+        PhaseScope phase(report, QLatin1String("V1 to V2"));
         rootObj = convertFileFormatV1ToV2(rootObj);
     }
 
     if(rootObj.value("file_version") == ModeManager::FileVersion::V2)
     {
         // V2 file, try to convert it to V3
+        PhaseScope phase(report, QLatin1String("V2 to V3"));
         rootObj = convertFileFormatV2ToV3(rootObj);
     }
 
     if(rootObj.value("file_version") == ModeManager::FileVersion::V3)
     {
         // V3 file, try to convert it to V4
+        PhaseScope phase(report, QLatin1String("V3 to V4"));
         rootObj = convertFileFormatV3ToV4(rootObj);
     }
 
@@ -451,17 +457,14 @@ static constexpr inline int timeoutMillisForCode(SignalAspectCode code)
 ModeManager::ModeManager(QObject *parent)
     : QObject{parent}
 {
-    // Circuits
-    mCircuitFactory = new NodeEditFactory(this);
-    StandardNodeTypes::registerTypes(mCircuitFactory);
+    // Simulation clock, needed by timers of all items
+    mScheduler = new SimulationScheduler(this);
 
-    mCircuitList = new CircuitListModel(this, this);
+    // Repaint notifications of nodes and cables
+    mChangeNotifier = new CircuitChangeNotifier(this);
 
-    // Panels
-    mPanelItemFactory = new PanelItemFactory(this);
-    StandardPanelItemTypes::registerTypes(mPanelItemFactory);
-
-    mPanelList = new PanelListModel(this, this);
+    // Circuits without scenes, GUI replaces it
+    mFrontend = new HeadlessCircuitList(this);
 
     // Objects
     mObjectFactory = new SimulationObjectFactory;
@@ -476,55 +479,38 @@ ModeManager::ModeManager(QObject *parent)
         mObjectModels.insert(objType, model);
     }
 
-    mRemoteMgr = new RemoteManager(this);
-    mSerialMgr = new SerialManager(this);
-
-    mTraintasticSim = new TraintasticSimManager(this);
+    // Input recording and replay
+    mRecorder = new SimulationRecorder(this);
 
     for(int i = 0; i < 4; i++)
     {
         const SignalAspectCode code = SignalAspectCode(i + 1);
-        mCodeTimers[i].timer.start(timeoutMillisForCode(code),
-                                   Qt::PreciseTimer,
+        mCodeTimers[i].timer.setBackground(true);
+        mCodeTimers[i].timer.start(mScheduler,
+                                   timeoutMillisForCode(code),
                                    this);
     }
+
+    mHistoryTimer.setBackground(true);
+    mHistoryTimer.start(mScheduler, HistoryIntervalMillis, this);
 }
 
 ModeManager::~ModeManager()
 {
-    // Disable network communication
-    mRemoteMgr->setOnline(false);
-
-    mRemoteMgr->clear();
-
-    mSerialMgr->disconnectAllDevices();
-
-    mTraintasticSim->enableConnection(false);
-
-    // Delete circuits and factory
-    // before objects
-    delete mCircuitList;
-    mCircuitList = nullptr;
-
-    delete mCircuitFactory;
-    mCircuitFactory = nullptr;
-
-    delete mPanelList;
-    mPanelList = nullptr;
+    // Stop before objects are deleted
+    mRecorder->stopRecording();
+    mRecorder->stopReplay();
 
-    delete mPanelItemFactory;
-    mPanelItemFactory = nullptr;
+    // Disable communications and delete circuits before objects
+    mFrontend->shutdown();
 
     // Delete objects and factory
     qDeleteAll(mObjectModels);
     mObjectModels.clear();
 
     // Delete remote connections AFTER deleting objects
-    delete mRemoteMgr;
-    mRemoteMgr = nullptr;
-
-    delete mSerialMgr;
-    mSerialMgr = nullptr;
+    delete mFrontend;
+    mFrontend = nullptr;
 
     // Delete object factory as last
     delete mObjectFactory;
@@ -534,6 +520,16 @@ ModeManager::~ModeManager()
     {
         mCodeTimers[i].timer.stop();
     }
+
+    mHistoryTimer.stop();
+
+    // All nodes and cables are deleted now
+    delete mChangeNotifier;
+    mChangeNotifier = nullptr;
+
+    // Delete scheduler after all timers are stopped
+    delete mScheduler;
+    mScheduler = nullptr;
 }
 
 void ModeManager::setMode(FileMode newMode)
@@ -550,32 +546,23 @@ void ModeManager::setMode(FileMode newMode)
     }
 
     mMode = newMode;
-    emit modeChanged(mMode, oldMode);
 
-    if(newMode != FileMode::Simulation)
-    {
-        // Stop network connections if not in Simulation mode
-        const bool wasOnline = mRemoteMgr->isOnline();
-        mRemoteMgr->setOnline(false);
-        mRemoteMgr->setOnlineByDefault(wasOnline);
+    // Node configuration may have been edited
+    CircuitGraph::invalidateAll();
 
-        mSerialMgr->disconnectAllDevices();
+    emit modeChanged(mMode, oldMode);
 
-        mRemoteMgr->setTraintasticDiscoveryEnabled(false);
-        mTraintasticSim->enableConnection(false);
-    }
-    else if(oldMode != FileMode::Simulation)
+    if(newMode != FileMode::Simulation)
     {
-        mSerialMgr->rescanPorts();
+        // Editing may change objects, history would not apply
+        mHistory.clear();
 
-        if(mRemoteMgr->onlineByDefault())
-            mRemoteMgr->setOnline(true);
-
-        mRemoteMgr->setTraintasticDiscoveryEnabled(true);
+        mRecorder->stopRecording();
+        mRecorder->stopReplay();
     }
 
     // Let widgets receive mode change first, then update all other scenes
-    mCircuitList->setMode(mMode, oldMode);
+    mFrontend->onModeChanged(mMode, oldMode);
 
     // Update file edited because it depends on mode
     emit fileEdited(fileNeedsSaving());
@@ -599,8 +586,7 @@ void ModeManager::resetFileEdited()
 
     mFileWasEdited = false;
 
-    mCircuitList->resetHasUnsavedChanges();
-    mPanelList->resetHasUnsavedChanges();
+    mFrontend->resetHasUnsavedChanges();
 
     for(auto model : mObjectModels)
         model->resetHasUnsavedChanges();
@@ -608,30 +594,31 @@ void ModeManager::resetFileEdited()
     emit fileEdited(false);
 }
 
-NodeEditFactory *ModeManager::circuitFactory() const
+void ModeManager::setFrontend(AbstractModeManagerFrontend *newFrontend)
 {
-    return mCircuitFactory;
-}
-
-CircuitListModel *ModeManager::circuitList() const
-{
-    return mCircuitList;
-}
+    Q_ASSERT(newFrontend);
+    if(mFrontend == newFrontend)
+        return;
 
-PanelItemFactory *ModeManager::panelFactory() const
-{
-    return mPanelItemFactory;
-}
+    if(mFrontend)
+    {
+        mFrontend->shutdown();
+        delete mFrontend;
+    }
 
-PanelListModel *ModeManager::panelList() const
-{
-    return mPanelList;
+    mFrontend = newFrontend;
 }
 
 bool ModeManager::loadFromJSON(const QJsonObject &obj, bool startSim)
 {
-    // Temporarily ignore modified scenes
-    clearAll();
+    mLoadReport.clear();
+    PhaseScope loadPhase(&mLoadReport, QLatin1String("Load project"));
+
+    {
+        // Temporarily ignore modified scenes
+        PhaseScope phase(&mLoadReport, QLatin1String("Clear previous file"));
+        clearAll();
+    }
 
     setMode(FileMode::LoadingFile);
 
@@ -640,7 +627,8 @@ bool ModeManager::loadFromJSON(const QJsonObject &obj, bool startSim)
     if(fileVers < FileVersion::Current)
     {
         // Old file, try to convert it
-        rootObj = convertOldFileFormat(obj);
+        PhaseScope phase(&mLoadReport, QLatin1String("Convert file format"));
+        rootObj = convertOldFileFormat(obj, &mLoadReport);
     }
     else if(fileVers > FileVersion::Current)
     {
@@ -648,85 +636,135 @@ bool ModeManager::loadFromJSON(const QJsonObject &obj, bool startSim)
         return false;
     }
 
-    mRemoteMgr->setSessionName(obj.value("session_name").toString());
-
     for(auto model : mObjectModels)
     {
         model->clear();
     }
 
-    const QJsonObject pool = rootObj.value("objects").toObject();
-    for(auto model : mObjectModels)
+    loadObjects(rootObj.value("objects").toObject());
+
+    // Circuits, panels and remote
+    mFrontend->loadFromJSON(rootObj, &mLoadReport);
+
+    resetFileEdited();
+
     {
-        const QJsonObject modelObj = pool.value(model->getObjectType()).toObject();
-        model->loadFromJSON(modelObj, LoadPhase::Creation);
+        // Turn on power sources and stuff or go Editing.
+        // Starting simulation runs initial circuit search
+        PhaseScope phase(&mLoadReport, startSim ? QLatin1String("Start simulation")
+                                                : QLatin1String("Start editing"));
+        setMode(startSim ? FileMode::Simulation : FileMode::Editing);
     }
 
-    for(auto model : mObjectModels)
+    return true;
+}
+
+void ModeManager::loadObjects(const QJsonObject &pool)
+{
+    typedef AbstractSimulationObjectModel::ParsedObjects ParsedObjects;
+
+    QList<AbstractSimulationObjectModel *> models = mObjectModels.values();
+    std::sort(models.begin(), models.end(),
+              [](AbstractSimulationObjectModel *a, AbstractSimulationObjectModel *b) -> bool
     {
-        const QJsonObject modelObj = pool.value(model->getObjectType()).toObject();
-        model->loadFromJSON(modelObj, LoadPhase::AllCreated);
-    }
+        return a->getObjectType() < b->getObjectType();
+    });
+
+    QVector<ParsedObjects> parsed(models.size());
+    QVector<bool> valid(models.size(), false);
 
-    QJsonObject circuits = rootObj.value("circuits").toObject();
-    mCircuitList->loadFromJSON(circuits);
+    int objectCount = 0;
 
-    QJsonObject panels = rootObj.value("panels").toObject();
-    mPanelList->loadFromJSON(panels);
+    {
+        PhaseScope phase(&mLoadReport, QLatin1String("Create objects"));
 
-    mRemoteMgr->loadFromJSON(rootObj.value("remote_mgr").toObject());
+        QElapsedTimer timer;
+        for(int i = 0; i < models.size(); i++)
+        {
+            const QString objType = models.at(i)->getObjectType();
 
-    resetFileEdited();
+            timer.start();
+            valid[i] = AbstractSimulationObjectModel::parseObjects(pool.value(objType).toObject(),
+                                                                   objType,
+                                                                   parsed[i]);
+            if(!valid.at(i))
+                continue;
 
-    // Turn on power sources and stuff or go Editing
-    setMode(startSim ? FileMode::Simulation : FileMode::Editing);
+            models.at(i)->loadParsed(parsed[i], LoadPhase::Creation);
 
-    return true;
+            const int count = parsed.at(i).objects.size();
+            if(count)
+                mLoadReport.addTime(objType, timer.nsecsElapsed(), count);
+            objectCount += count;
+        }
+
+        phase.setCount(objectCount);
+    }
+
+    {
+        PhaseScope phase(&mLoadReport, QLatin1String("Link objects"));
+        phase.setCount(objectCount);
+
+        QElapsedTimer timer;
+        for(int i = 0; i < models.size(); i++)
+        {
+            if(!valid.at(i))
+                continue;
+
+            timer.start();
+            models.at(i)->loadParsed(parsed[i], LoadPhase::AllCreated);
+
+            const int count = parsed.at(i).objects.size();
+            if(count)
+                mLoadReport.addTime(models.at(i)->getObjectType(),
+                                    timer.nsecsElapsed(), count);
+        }
+    }
 }
 
-void ModeManager::saveToJSON(QJsonObject &obj) const
+void ModeManager::saveToJSON(QJsonObject &obj, PhaseReport *report) const
 {
-    QJsonObject circuits;
-    mCircuitList->saveToJSON(circuits);
+    PhaseScope savePhase(report, QLatin1String("Save project"));
 
-    QJsonObject panels;
-    mPanelList->saveToJSON(panels);
+    // Circuits, panels and remote
+    mFrontend->saveToJSON(obj, report);
 
     QJsonObject pool;
-    for(auto model : mObjectModels)
     {
-        QJsonObject modelObj;
-        model->saveToJSON(modelObj);
-        pool[model->getObjectType()] = modelObj;
-    }
+        PhaseScope phase(report, QLatin1String("Save objects"));
 
-    QJsonObject remoteMgrObj;
-    mRemoteMgr->saveToJSON(remoteMgrObj);
+        int objectCount = 0;
+        for(auto model : mObjectModels)
+        {
+            QJsonObject modelObj;
+            model->saveToJSON(modelObj);
+            pool[model->getObjectType()] = modelObj;
+            objectCount += model->rowCount();
+        }
 
-    obj["file_version"] = FileVersion::Current;
+        phase.setCount(objectCount);
+    }
 
-    obj["session_name"] = mRemoteMgr->sessionName();
+    obj["file_version"] = FileVersion::Current;
 
     obj["objects"] = pool;
-
-    obj["circuits"] = circuits;
-    obj["panels"] = panels;
-
-    obj["remote_mgr"] = remoteMgrObj;
 }
 
 void ModeManager::clearAll()
 {
     setMode(FileMode::LoadingFile);
 
-    mRemoteMgr->clear();
+    mFrontend->clear();
 
-    mCircuitList->clear();
-    mPanelList->clear();
+    mSnapshot = SimulationSnapshot();
+    mHistory.clear();
 
     for(auto model : mObjectModels)
         model->clear();
 
+    // Give back memory cached for circuits of previous file
+    ElectricCircuit::releasePool();
+
     resetFileEdited();
 
     // Wait for new items
@@ -772,14 +810,62 @@ void ModeManager::setFilePath(const QString &newFilePath, bool newFile)
     emit fileChanged(mFilePath, newFile ? QString() : oldFile);
 }
 
+void ModeManager::saveSnapshot()
+{
+    mSnapshot = SimulationSnapshot::capture(this);
+}
+
+bool ModeManager::restoreSnapshot()
+{
+    if(mMode != FileMode::Simulation || mSnapshot.isEmpty())
+        return false;
+
+    mSnapshot.restore(this);
+
+    // Newer states are in the future now
+    mHistory.clear();
+    return true;
+}
+
+bool ModeManager::rewindBy(qint64 millis)
+{
+    if(mMode != FileMode::Simulation)
+        return false;
+
+    const qint64 target = mScheduler->currentTime() - millis;
+
+    for(int i = mHistory.size() - 1; i >= 0; i--)
+    {
+        if(mHistory.at(i).simulationTime() > target)
+            continue;
+
+        mHistory.at(i).restore(this);
+        mHistory.resize(i + 1);
+        return true;
+    }
+
+    return false;
+}
+
 void ModeManager::timerEvent(QTimerEvent *ev)
 {
+    if(ev->timerId() == mHistoryTimer.timerId())
+    {
+        if(mMode == FileMode::Simulation)
+        {
+            if(mHistory.size() >= HistoryLength)
+                mHistory.removeFirst();
+            mHistory.append(SimulationSnapshot::capture(this));
+        }
+        return;
+    }
+
     for(int i = 0; i < 4; i++)
     {
         if(ev->timerId() == mCodeTimers[i].timer.timerId())
         {
             mCodeTimers[i].state = !mCodeTimers[i].state;
-            mCircuitList->updateCodeStatus();
+            mFrontend->onCodePhaseChanged();
             emit codeTimerChanged();
 
             return;
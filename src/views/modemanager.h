@@ -24,30 +24,31 @@
 #define MODEMANAGER_H
 
 #include <QObject>
-#include <QBasicTimer>
 
 #include <QHash>
 
+#include "../utils/simulationscheduler.h"
+
+#include "../objects/simulationsnapshot.h"
+
+#include "../utils/phasereport.h"
+
 #include "../enums/filemodes.h"
 
 #include "../enums/signalaspectcodes.h"
 
-class NodeEditFactory;
-class CircuitListModel;
+class CircuitChangeNotifier;
 
-class PanelItemFactory;
-class PanelListModel;
+class SimulationRecorder;
+
+class AbstractModeManagerFrontend;
 
 class SimulationObjectFactory;
 class AbstractSimulationObjectModel;
+class AbstractSimulationObject;
 
 class QJsonObject;
 
-class RemoteManager;
-class SerialManager;
-
-class TraintasticSimManager;
-
 class ModeManager : public QObject
 {
     Q_OBJECT
@@ -83,16 +84,24 @@ class ModeManager : public QObject
     void setFileEdited();
     void resetFileEdited();
 
-    NodeEditFactory *circuitFactory() const;
-    CircuitListModel *circuitList() const;
+    inline AbstractModeManagerFrontend *frontend() const
+    {
+        return mFrontend;
+    }
 
-    PanelItemFactory *panelFactory() const;
-    PanelListModel *panelList() const;
+    // Takes ownership, must be set before loading objects
+    void setFrontend(AbstractModeManagerFrontend *newFrontend);
 
     bool loadFromJSON(const QJsonObject &obj, bool startSim);
-    void saveToJSON(QJsonObject &obj) const;
+    // Report can be nullptr to skip recording phases
+    void saveToJSON(QJsonObject &obj, PhaseReport *report = nullptr) const;
     void clearAll();
 
+    // Phases of last load.
+    // File read is added by callers.
+    inline const PhaseReport& loadReport() const { return mLoadReport; }
+    inline PhaseReport& loadReport() { return mLoadReport; }
+
     EditingSubMode editingSubMode() const;
     void setEditingSubMode(EditingSubMode newEditingMode);
 
@@ -100,24 +109,42 @@ class ModeManager : public QObject
 
     AbstractSimulationObjectModel *modelForType(const QString& objType) const;
 
+    // Objects of all models by AbstractSimulationObject::uniqueId()
+    inline AbstractSimulationObject *objectByUniqueId(const QString& uniqueId) const
+    {
+        return mObjectIndex.value(uniqueId, nullptr);
+    }
+
     QString filePath() const;
     void setFilePath(const QString &newFilePath, bool newFile = false);
 
-    inline RemoteManager *getRemoteManager() const
+    inline SimulationScheduler *scheduler() const
     {
-        return mRemoteMgr;
+        return mScheduler;
     }
 
-    inline SerialManager *getSerialManager() const
+    inline CircuitChangeNotifier *changeNotifier() const
     {
-        return mSerialMgr;
+        return mChangeNotifier;
     }
 
-    inline TraintasticSimManager *getTraitasticSimMgr() const
+    inline SimulationRecorder *recorder() const
     {
-        return mTraintasticSim;
+        return mRecorder;
     }
 
+    // Manual snapshot, kept until next one or file is closed
+    void saveSnapshot();
+    bool restoreSnapshot();
+
+    inline bool hasSnapshot() const
+    {
+        return !mSnapshot.isEmpty();
+    }
+
+    // Restore latest automatic snapshot at least millis old
+    bool rewindBy(qint64 millis);
+
     inline bool getCodePhase(SignalAspectCode code) const
     {
         const int idx = int(code) - 1;
@@ -141,23 +168,27 @@ class ModeManager : public QObject
     void timerEvent(QTimerEvent *ev) override;
 
 private:
+    // Create objects of all models, then link them
+    void loadObjects(const QJsonObject& pool);
+
     FileMode mMode = FileMode::Editing;
     EditingSubMode mEditingMode = EditingSubMode::Default;
 
-    NodeEditFactory *mCircuitFactory;
-    CircuitListModel *mCircuitList;
-
-    PanelItemFactory *mPanelItemFactory;
-    PanelListModel *mPanelList;
+    AbstractModeManagerFrontend *mFrontend = nullptr;
 
     QHash<QString, AbstractSimulationObjectModel*> mObjectModels;
 
-    SimulationObjectFactory *mObjectFactory;
+    PhaseReport mLoadReport;
+
+    // Maintained by AbstractSimulationObjectModel
+    friend class AbstractSimulationObjectModel;
+    QHash<QString, AbstractSimulationObject *> mObjectIndex;
 
-    RemoteManager *mRemoteMgr = nullptr;
-    SerialManager *mSerialMgr = nullptr;
+    SimulationObjectFactory *mObjectFactory;
 
-    TraintasticSimManager *mTraintasticSim = nullptr;
+    SimulationScheduler *mScheduler = nullptr;
+    CircuitChangeNotifier *mChangeNotifier = nullptr;
+    SimulationRecorder *mRecorder = nullptr;
 
     bool mFileWasEdited = false;
 
@@ -165,11 +196,17 @@ class ModeManager : public QObject
 
     struct CodeTimer
     {
-        QBasicTimer timer;
+        SimulationTimer timer;
         bool state = false;
     };
 
     CodeTimer mCodeTimers[4];
+
+    SimulationSnapshot mSnapshot;
+
+    // Automatic snapshots for rewind, oldest first
+    QVector<SimulationSnapshot> mHistory;
+    SimulationTimer mHistoryTimer;
 };
 
 #endif // MODEMANAGER_H
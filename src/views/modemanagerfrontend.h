@@ -0,0 +1,71 @@
+/**
+ * src/views/modemanagerfrontend.h
+ *
+ * This file is part of the Simulatore Relais Apparato source code.
+ *
+ * Copyright (C) 2025 Filippo Gentile
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MODEMANAGERFRONTEND_H
+#define MODEMANAGERFRONTEND_H
+
+#include "../enums/filemodes.h"
+
+class QJsonObject;
+class QString;
+
+class PhaseReport;
+
+class AbstractRemoteSession;
+class AbstractSerialDevice;
+class AbstractTraintasticSimManager;
+class AbstractSoundPlayer;
+
+// Project parts outside of simulation engine:
+// circuit and panel scenes, network and serial devices.
+// ModeManager defaults to HeadlessCircuitList, GUI installs its own.
+class AbstractModeManagerFrontend
+{
+public:
+    virtual ~AbstractModeManagerFrontend() {}
+
+    // Stop communications and delete circuits before objects are deleted
+    virtual void shutdown() = 0;
+
+    virtual void onModeChanged(FileMode newMode, FileMode oldMode) = 0;
+    virtual void onCodePhaseChanged() = 0;
+
+    virtual void resetHasUnsavedChanges() = 0;
+    virtual void clear() = 0;
+
+    // Called after objects are loaded
+    virtual void loadFromJSON(const QJsonObject& rootObj, PhaseReport *report) = 0;
+    virtual void saveToJSON(QJsonObject& rootObj, PhaseReport *report) const = 0;
+
+    // Return nullptr if not supported
+    virtual AbstractRemoteSession *addRemoteSession(const QString& sessionName) = 0;
+    virtual AbstractSerialDevice *addSerialDevice(const QString& devName) = 0;
+    virtual AbstractTraintasticSimManager *traintasticSim() const = 0;
+
+    // Cut all external inputs, used by replay
+    virtual void disconnectAll() = 0;
+
+    // Caller takes ownership, nullptr if not supported
+    virtual AbstractSoundPlayer *createSoundPlayer() = 0;
+};
+
+#endif // MODEMANAGERFRONTEND_H
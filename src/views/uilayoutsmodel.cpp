@@ -24,6 +24,7 @@
 
 #include "viewmanager.h"
 #include "modemanager.h"
+#include "guimodefrontend.h"
 #include "../network/remotemanager.h"
 
 #include "layoutloader.h"
@@ -156,7 +157,7 @@ void UILayoutsModel::loadFromLayoutFile()
         return;
     }
 
-    RemoteManager *remoteMgr = mViewMgr->modeMgr()->getRemoteManager();
+    RemoteManager *remoteMgr = GuiModeFrontend::get(mViewMgr->modeMgr())->getRemoteManager();
     remoteMgr->setOnlineByDefault(rootObj.value(OnlineByDefaultKey).toBool(false));
     if(remoteMgr->onlineByDefault())
         remoteMgr->setOnline(true);
@@ -263,7 +264,7 @@ bool UILayoutsModel::saveLayout(const QString &layoutName) const
 
     rootObj[LayoutArrayKey] = layoutArr;
     rootObj[StartLayoutKey] = mLayoutToLoadAtStart;
-    rootObj[OnlineByDefaultKey] = mViewMgr->modeMgr()->getRemoteManager()->onlineByDefault();
+    rootObj[OnlineByDefaultKey] = GuiModeFrontend::get(mViewMgr->modeMgr())->getRemoteManager()->onlineByDefault();
 
     saveLayoutFileRoot(rootObj);
     return true;
@@ -24,6 +24,7 @@
 
 #include "../mainwindow.h"
 #include "modemanager.h"
+#include "guimodefrontend.h"
 #include "uilayoutsmodel.h"
 
 #include "../circuits/edit/nodeeditfactory.h"
@@ -32,6 +33,7 @@
 #include "../circuits/view/circuitsview.h"
 #include "../circuits/view/circuitlistwidget.h"
 #include "../circuits/view/circuitlistmodel.h"
+#include "../circuits/view/simulationprofilerwidget.h"
 #include "../circuits/circuitscene.h"
 #include "../circuits/graphs/abstractnodegraphitem.h"
 
@@ -71,7 +73,7 @@ ViewManager::ViewManager(MainWindow *parent)
 
     mLayoutsModel = new UILayoutsModel(this, this);
 
-    CircuitListModel *circuitList = modeMgr->circuitList();
+    CircuitListModel *circuitList = GuiModeFrontend::get(modeMgr)->circuitList();
     connect(circuitList, &CircuitListModel::nodeEditRequested,
             this, &ViewManager::nodeEditRequested);
     connect(circuitList, &CircuitListModel::cableEditRequested,
@@ -79,7 +81,7 @@ ViewManager::ViewManager(MainWindow *parent)
     connect(circuitList, &CircuitListModel::nodeSelectionChanged,
             this, &ViewManager::nodeSelectionChanged);
 
-    PanelListModel *panelList = modeMgr->panelList();
+    PanelListModel *panelList = GuiModeFrontend::get(modeMgr)->panelList();
     connect(panelList, &PanelListModel::itemEditRequested,
             this, &ViewManager::panelItemEditRequested);
 
@@ -360,13 +362,17 @@ AbstractSimulationObject *ViewManager::createNewObjectDlg(const QString &objType
     return SimulationObjectListWidget::addObjectHelper(model, parent);
 }
 
-void ViewManager::ensureCircuitItemIsVisible(AbstractNodeGraphItem *item, bool forceNew, bool adjustZoom)
+void ViewManager::ensureCircuitNodeIsVisible(CircuitScene *s, AbstractCircuitNode *node,
+                                             bool forceNew, bool adjustZoom)
 {
-    if(!item)
+    if(!s || !node)
         return;
 
-    CircuitScene *s = item->circuitScene();
-    if(!s)
+    // View might not be shown yet
+    s->ensureGraphicsLoaded();
+
+    AbstractNodeGraphItem *item = s->getGraphForNode(node);
+    if(!item)
         return;
 
     CircuitWidget *w = addCircuitView(s, forceNew);
@@ -541,7 +547,7 @@ void ViewManager::showObjectProperties(AbstractSimulationObject *item)
     SimulationObjectFactory *factory = mainWin()->modeMgr()->objectFactory();
 
     // Create new edit window
-    SimulationObjectOptionsWidget *w = factory->createEditWidget(nullptr, item, this);
+    SimulationObjectOptionsWidget *w = SimulationObjectOptionsWidget::createEditWidget(nullptr, item, this);
     w->setEditingAllowed(modeMgr()->mode() == FileMode::Editing);
 
     DockWidget *dock = new DockWidget(item->name(),
@@ -635,6 +641,7 @@ void ViewManager::closeAll()
     delete mReplicaListViewDock;
     delete mRemoteSessionsListViewDock;
     delete mSerialDevicesListViewDock;
+    delete mSimulationProfilerDock;
     delete mCircuitListViewDock;
     delete mPanelListViewDock;
 
@@ -651,7 +658,7 @@ void ViewManager::showCircuitListView()
         return;
     }
 
-    CircuitListModel *circuitList = mainWin()->modeMgr()->circuitList();
+    CircuitListModel *circuitList = GuiModeFrontend::get(mainWin()->modeMgr())->circuitList();
     CircuitListWidget *circuitListView = new CircuitListWidget(this, circuitList);
 
     mCircuitListViewDock = new DockWidget(QLatin1String("circuit_list"),
@@ -671,7 +678,7 @@ void ViewManager::showPanelListView()
         return;
     }
 
-    PanelListModel *panelList = mainWin()->modeMgr()->panelList();
+    PanelListModel *panelList = GuiModeFrontend::get(mainWin()->modeMgr())->panelList();
     PanelListWidget *panelListView = new PanelListWidget(this, panelList);
 
     mPanelListViewDock = new DockWidget(QLatin1String("panel_list"),
@@ -778,6 +785,25 @@ void ViewManager::showSerialDeviceListView()
     mainWin()->addDockWidget(mSerialDevicesListViewDock, KDDockWidgets::Location_OnLeft);
 }
 
+void ViewManager::showSimulationProfilerView()
+{
+    if(mSimulationProfilerDock)
+    {
+        mSimulationProfilerDock->raise();
+        mSimulationProfilerDock->activateWindow();
+        return;
+    }
+
+    SimulationProfilerWidget *profilerView = new SimulationProfilerWidget(this);
+
+    mSimulationProfilerDock = new DockWidget(QLatin1String("simulation_profiler"),
+                                             KDDockWidgets::DockWidgetOption_DeleteOnClose);
+    mSimulationProfilerDock->setWidget(profilerView);
+    mSimulationProfilerDock->setTitle(tr("Simulation Profiler"));
+
+    mainWin()->addDockWidget(mSimulationProfilerDock, KDDockWidgets::Location_OnBottom);
+}
+
 bool ViewManager::batchCircuitNodeEdit(bool objectReplace)
 {
     if(!mActiveCircuitView)
@@ -844,7 +870,7 @@ void ViewManager::addNodeToActiveView(const QString &nodeType)
         if(!mActiveCircuitView)
             return;
 
-        const auto circuitFactory = mainWin()->modeMgr()->circuitFactory();
+        const auto circuitFactory = GuiModeFrontend::get(mainWin()->modeMgr())->circuitFactory();
         mActiveCircuitView->addNodeToCenter(circuitFactory, nodeType);
         break;
     }
@@ -853,7 +879,7 @@ void ViewManager::addNodeToActiveView(const QString &nodeType)
         if(!mActivePanelView)
             return;
 
-        const auto panelFactory = mainWin()->modeMgr()->panelFactory();
+        const auto panelFactory = GuiModeFrontend::get(mainWin()->modeMgr())->panelFactory();
         mActivePanelView->addNodeToCenter(panelFactory, nodeType);
         break;
     }
@@ -889,7 +915,7 @@ void ViewManager::nodeEditRequested(AbstractNodeGraphItem *item)
     DockWidget *dock = mCircuitViews.value(mActiveCircuitView);
 
     // Allow delete or custom node options
-    auto editFactory = mainWin()->modeMgr()->circuitFactory();
+    auto editFactory = GuiModeFrontend::get(mainWin()->modeMgr())->circuitFactory();
     editFactory->editItem(dock, item, this);
 }
 
@@ -902,7 +928,7 @@ void ViewManager::cableEditRequested(CableGraphItem *item)
     }
 
     // Allow delete or modify path
-    auto editFactory = mainWin()->modeMgr()->circuitFactory();
+    auto editFactory = GuiModeFrontend::get(mainWin()->modeMgr())->circuitFactory();
     editFactory->editCable(mActiveCircuitView, item);
 }
 
@@ -950,7 +976,7 @@ void ViewManager::panelItemEditRequested(AbstractPanelItem *item)
     DockWidget *dock = mPanelViews.value(mActivePanelView);
 
     // Allow delete or custom node options
-    auto editFactory = mainWin()->modeMgr()->panelFactory();
+    auto editFactory = GuiModeFrontend::get(mainWin()->modeMgr())->panelFactory();
     editFactory->editItem(dock, item, this);
 }
 
@@ -35,6 +35,7 @@ class UILayoutsModel;
 
 class CircuitWidget;
 class CircuitScene;
+class AbstractCircuitNode;
 class AbstractNodeGraphItem;
 class CableGraphItem;
 
@@ -91,7 +92,7 @@ class ViewManager : public QObject
     AbstractSimulationObject *createNewObjectDlg(const QString &objType,
                                                  QWidget *parent);
 
-    void ensureCircuitItemIsVisible(AbstractNodeGraphItem *item,
+    void ensureCircuitNodeIsVisible(CircuitScene *s, AbstractCircuitNode *node,
                                     bool forceNew, bool adjustZoom);
 
     void clearLayouts();
@@ -120,6 +121,7 @@ public slots:
     void showRemoteSessionsListView();
     void showReplicaListView();
     void showSerialDeviceListView();
+    void showSimulationProfilerView();
 
     bool batchCircuitNodeEdit(bool objectReplace);
     bool batchPanelItemEdit(bool objectReplace);
@@ -179,6 +181,8 @@ private slots:
     QPointer<DockWidget> mReplicaListViewDock;
     QPointer<DockWidget> mSerialDevicesListViewDock;
 
+    QPointer<DockWidget> mSimulationProfilerDock;
+
     ViewType mCurrentViewType = ViewType::Circuit;
 };
 